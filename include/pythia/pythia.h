@@ -18,9 +18,11 @@
 #ifndef PYTHIA_PYTHIA_H
 #define PYTHIA_PYTHIA_H
 
+#include "pythia_batch.h"
 #include "pythia_buf.h"
 #include "pythia_buf_sizes.h"
 #include "pythia_init.h"
+#include "pythia_pool.h"
 #include "pythia_wrapper.h"
 
 #endif //PYTHIA_PYTHIA_H
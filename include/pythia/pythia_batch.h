@@ -0,0 +1,127 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_BATCH_H
+#define PYTHIA_PYTHIA_BATCH_H
+
+#include "pythia_buf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Batch of G1 points (blinded passwords, public keys). Coordinates are stored limb by limb in
+/// structure-of-arrays layout: the same limb of consecutive points is contiguous and every row starts
+/// on a cache line, so that batch arithmetic loads several points with one vector load.
+typedef struct pythia_g1_batch pythia_g1_batch_t;
+
+/// Batch of G2 points (transformed tweaks), stored like pythia_g1_batch_t
+typedef struct pythia_g2_batch pythia_g2_batch_t;
+
+/// Batch of GT elements (transformed and deblinded passwords), stored like pythia_g1_batch_t
+typedef struct pythia_gt_batch pythia_gt_batch_t;
+
+/// Creates batch of count G1 points at infinity
+/// \param [in] count number of points.
+/// \param [out] batch created batch.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_g1_batch_new(size_t count, pythia_g1_batch_t **batch);
+
+/// Frees batch of G1 points
+void pythia_w_g1_batch_free(pythia_g1_batch_t *batch);
+
+/// Returns number of points in the batch
+size_t pythia_w_g1_batch_count(const pythia_g1_batch_t *batch);
+
+/// Deserializes pythia_w_g1_batch_count(batch) points into the batch. Every point is validated
+/// as pythia_w_* functions validate single G1 inputs.
+/// \param [out] batch batch of points.
+/// \param [in] G1 bufs array of serialized points.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_g1_batch_read(pythia_g1_batch_t *batch, const pythia_buf_t *bufs);
+
+/// Serializes all points of the batch
+/// \param [out] G1 bufs array of pythia_w_g1_batch_count(batch) buffers.
+/// \param [in] batch batch of points.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_g1_batch_write(pythia_buf_t *bufs, const pythia_g1_batch_t *batch);
+
+/// Creates batch of count G2 points at infinity
+/// \param [in] count number of points.
+/// \param [out] batch created batch.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_g2_batch_new(size_t count, pythia_g2_batch_t **batch);
+
+/// Frees batch of G2 points
+void pythia_w_g2_batch_free(pythia_g2_batch_t *batch);
+
+/// Returns number of points in the batch
+size_t pythia_w_g2_batch_count(const pythia_g2_batch_t *batch);
+
+/// Deserializes pythia_w_g2_batch_count(batch) points into the batch, validating every point
+/// \param [out] batch batch of points.
+/// \param [in] G2 bufs array of serialized points.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_g2_batch_read(pythia_g2_batch_t *batch, const pythia_buf_t *bufs);
+
+/// Serializes all points of the batch
+/// \param [out] G2 bufs array of pythia_w_g2_batch_count(batch) buffers.
+/// \param [in] batch batch of points.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_g2_batch_write(pythia_buf_t *bufs, const pythia_g2_batch_t *batch);
+
+/// Creates batch of count GT elements set to unity
+/// \param [in] count number of elements.
+/// \param [out] batch created batch.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_gt_batch_new(size_t count, pythia_gt_batch_t **batch);
+
+/// Frees batch of GT elements
+void pythia_w_gt_batch_free(pythia_gt_batch_t *batch);
+
+/// Returns number of elements in the batch
+size_t pythia_w_gt_batch_count(const pythia_gt_batch_t *batch);
+
+/// Deserializes pythia_w_gt_batch_count(batch) elements into the batch, validating every element.
+/// Both GT encodings are accepted.
+/// \param [out] batch batch of elements.
+/// \param [in] GT bufs array of serialized elements.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_gt_batch_read(pythia_gt_batch_t *batch, const pythia_buf_t *bufs);
+
+/// Serializes all elements of the batch with encoding selected by pythia_w_set_gt_encoding
+/// \param [out] GT bufs array of pythia_w_gt_batch_count(batch) buffers.
+/// \param [in] batch batch of elements.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_gt_batch_write(pythia_buf_t *bufs, const pythia_gt_batch_t *batch);
+
+/// Updates batch of deblinded passwords with password_update_token without serializing them in between,
+/// so that passwords can be deserialized once and updated with several tokens.
+/// \param [in] deblinded_passwords batch of previous deblinded passwords.
+/// \param [in] BN password_update_token password update token from pythia_get_password_update_token
+/// \param [out] updated_deblinded_passwords batch of new deblinded passwords with the same count,
+/// may be the same batch as deblinded_passwords.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_gt_batch_update_with_token(const pythia_gt_batch_t *deblinded_passwords,
+                                        const pythia_buf_t *password_update_token,
+                                        pythia_gt_batch_t *updated_deblinded_passwords);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_BATCH_H
@@ -27,6 +27,9 @@ extern "C" {
 /// Buffer size for bn_t instances
 const extern size_t PYTHIA_BN_BUF_SIZE;
 
+/// Buffer size for bn_t instances written with PYTHIA_SCALAR_ENCODING_FIXED
+const extern size_t PYTHIA_SCALAR_BUF_SIZE;
+
 /// Buffer size for g1_t instances
 const extern size_t PYTHIA_G1_BUF_SIZE;
 
@@ -36,6 +39,16 @@ const extern size_t PYTHIA_G2_BUF_SIZE;
 /// Buffer size for gt_t instances
 const extern size_t PYTHIA_GT_BUF_SIZE;
 
+/// Buffer size for gt_t instances written with PYTHIA_GT_ENCODING_TORUS: 192 bytes, two Fp2 coordinates
+/// of the T6 torus against 384 bytes of PYTHIA_GT_BUF_SIZE
+const extern size_t PYTHIA_GT_TORUS_BUF_SIZE;
+
+/// Buffer size for raw g1_t instances, see pythia_w_point_to_raw
+const extern size_t PYTHIA_G1_RAW_BUF_SIZE;
+
+/// Buffer size for raw g2_t instances, see pythia_w_point_to_raw
+const extern size_t PYTHIA_G2_RAW_BUF_SIZE;
+
 /// Minimum binary arguments size (e.g. tweak, secrets)
 const extern size_t PYTHIA_BIN_MIN_BUF_SIZE;
 
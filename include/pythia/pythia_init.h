@@ -32,6 +32,45 @@ typedef struct pythia_init_args {
 #endif // RELIC_USE_EXT_RNG
 } pythia_init_args_t;
 
+/// Maps used to hash passwords to G1 and tweaks to G2
+typedef enum pythia_hash_mode {
+    PYTHIA_HASH_MODE_LEGACY = 0,   /// relic's try-and-increment map, used by existing enrollments
+    PYTHIA_HASH_MODE_SSWU = 1      /// Constant-time simplified SWU map of RFC 9380
+} pythia_hash_mode_t;
+
+/// Selects map used to hash passwords to G1. Default is PYTHIA_HASH_MODE_SSWU if pythia is built with
+/// PYTHIA_HASH_G1_SSWU, PYTHIA_HASH_MODE_LEGACY otherwise. Maps give different points, so switching
+/// invalidates transformed passwords of existing enrollments. Should be called before other pythia calls.
+/// \param [in] mode hash to G1 map
+void pythia_set_hash_g1(pythia_hash_mode_t mode);
+
+/// Selects map used to hash tweaks to G2. Default is PYTHIA_HASH_MODE_SSWU if pythia is built with
+/// PYTHIA_HASH_G2_SSWU, PYTHIA_HASH_MODE_LEGACY otherwise. As with pythia_set_hash_g1, switching
+/// invalidates transformed passwords of existing enrollments. Should be called before other pythia calls.
+/// \param [in] mode hash to G2 map
+void pythia_set_hash_g2(pythia_hash_mode_t mode);
+
+/// CPU features used to select arithmetic, hashing and batch kernels
+typedef enum pythia_cpu_feature {
+    PYTHIA_CPU_BMI2_ADX = 1,       /// MULX, ADCX and ADOX, used by field arithmetic of PYTHIA_FP_ASM builds
+    PYTHIA_CPU_AVX2 = 2,           /// 4-lane multi-buffer SHA-384
+    PYTHIA_CPU_AVX512F = 4,        /// 8-lane multi-buffer SHA-384
+    PYTHIA_CPU_AVX512IFMA = 8      /// 8-lane field arithmetic of batch GT exponentiation
+} pythia_cpu_feature_t;
+
+/// All CPU features known to pythia
+#define PYTHIA_CPU_ALL 0xF
+
+/// Limits CPU features kernels may use, e.g. to keep AVX-512 off on machines where it lowers clock frequency.
+/// Features are detected at pythia_init and kernels are bound once, so that the same binary runs the fastest
+/// kernels each CPU supports. Features missing on the CPU are never used. Default mask is PYTHIA_CPU_ALL.
+/// Should be called before pythia_init.
+/// \param [in] mask bitwise OR of pythia_cpu_feature_t values
+void pythia_set_cpu_features_mask(unsigned int mask);
+
+/// \return bitwise OR of pythia_cpu_feature_t values detected at pythia_init and allowed by the mask
+unsigned int pythia_get_cpu_features(void);
+
 /// Initializer pythia. This function is not thread-safe and should be called before any other pythia call
 /// \param init_args initialization arguments
 /// \return 0 if succeeded, -1 otherwise
@@ -0,0 +1,134 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_POOL_H
+#define PYTHIA_PYTHIA_POOL_H
+
+#include "pythia_buf.h"
+#include "pythia_conf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Bounded pool of precomputed blinding factors used by pythia_w_blind_pooled
+typedef struct pythia_blind_pool pythia_blind_pool_t;
+
+/// Creates empty blinding factors pool. Pool should be freed before pythia_deinit is called
+/// \param [in] capacity maximum number of blinding factors kept in the pool.
+/// \param [out] pool created pool.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_blind_pool_new(size_t capacity, pythia_blind_pool_t **pool);
+
+/// Stops pool's background thread if it was started and frees the pool together with all unused blinding factors
+void pythia_w_blind_pool_free(pythia_blind_pool_t *pool);
+
+/// Precomputes up to count blinding factors in the calling thread (e.g. at idle time). Stops when the pool is full.
+/// \param [in] pool blinding factors pool.
+/// \param [in] count maximum number of blinding factors to add.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_blind_pool_fill(pythia_blind_pool_t *pool, size_t count);
+
+/// Returns number of precomputed blinding factors in the pool
+size_t pythia_w_blind_pool_size(pythia_blind_pool_t *pool);
+
+#if RELIC_USE_PTHREAD
+/// Starts background thread that keeps the pool full
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_blind_pool_start(pythia_blind_pool_t *pool);
+
+/// Stops pool's background thread. Precomputed blinding factors are kept
+void pythia_w_blind_pool_stop(pythia_blind_pool_t *pool);
+
+/// Returns number of background threads that stopped because generating a blinding factor failed.
+/// Pool is no longer refilled in the background once its thread stopped, restart it with pythia_w_blind_pool_start
+size_t pythia_w_blind_pool_failures(pythia_blind_pool_t *pool);
+#endif // RELIC_USE_PTHREAD
+
+/// Blinds password like pythia_w_blind does, but takes blinding factor from the pool, so that only hashing
+/// and one scalar multiplication are left. Fresh blinding factor is generated if the pool is empty.
+/// Each blinding factor is used only once.
+/// \param [in] pool blinding factors pool.
+/// \param [in] password end user's password.
+/// \param [out] G1 blinded_password password obfuscated into a pseudo-random string.
+/// \param [out] BN blinding_secret random value used to blind user's password.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_blind_pooled(pythia_blind_pool_t *pool, const pythia_buf_t *password,
+                          pythia_buf_t *blinded_password, pythia_buf_t *blinding_secret);
+
+/// Bounded pool of precomputed proof nonces used by pythia_w_prove_pooled
+typedef struct pythia_nonce_pool pythia_nonce_pool_t;
+
+/// Creates empty proof nonces pool. Pool should be freed before pythia_deinit is called
+/// \param [in] depth maximum number of nonces kept in the pool.
+/// \param [out] pool created pool.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_nonce_pool_new(size_t depth, pythia_nonce_pool_t **pool);
+
+/// Stops pool's background threads if they were started and frees the pool together with all unused nonces
+void pythia_w_nonce_pool_free(pythia_nonce_pool_t *pool);
+
+/// Precomputes up to count nonces in the calling thread. Stops when the pool is full.
+/// \param [in] pool proof nonces pool.
+/// \param [in] count maximum number of nonces to add.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_nonce_pool_fill(pythia_nonce_pool_t *pool, size_t count);
+
+/// Returns number of precomputed nonces in the pool
+size_t pythia_w_nonce_pool_size(pythia_nonce_pool_t *pool);
+
+/// Returns number of times pythia_w_prove_pooled found the pool empty and had to generate nonce on the spot
+size_t pythia_w_nonce_pool_exhausted(pythia_nonce_pool_t *pool);
+
+#if RELIC_USE_PTHREAD
+/// Starts background threads that keep the pool full. Previously started threads are stopped first
+/// \param [in] pool proof nonces pool.
+/// \param [in] threads number of refill threads.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_nonce_pool_start(pythia_nonce_pool_t *pool, size_t threads);
+
+/// Stops pool's background threads. Precomputed nonces are kept
+void pythia_w_nonce_pool_stop(pythia_nonce_pool_t *pool);
+
+/// Returns number of background threads that stopped because generating a nonce failed.
+/// Restart them with pythia_w_nonce_pool_start
+size_t pythia_w_nonce_pool_failures(pythia_nonce_pool_t *pool);
+#endif // RELIC_USE_PTHREAD
+
+/// Generates proof like pythia_w_prove does, but takes nonce v together with commitment v * G from the pool,
+/// saving one scalar multiplication and one serialization. Fresh nonce is generated if the pool is empty.
+/// Each nonce is used only once.
+/// \param [in] pool proof nonces pool.
+/// \param [in] GT transformed_password transformed password from pythia_transform
+/// \param [in] G1 blinded_password blinded password from pythia_blind.
+/// \param [in] G2 transformed_tweak transformed tweak from pythia_transform.
+/// \param [in] BN transformation_private_key transformation private key.
+/// \param [in] G1 transformation_public_key public key corresponding to transformation_private_key.
+/// \param [out] BN proof_value_c first part of proof that transformed+password was created using transformation_private_key.
+/// \param [out] BN proof_value_u second part of proof that transformed+password was created using transformation_private_key.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_prove_pooled(pythia_nonce_pool_t *pool,
+                          const pythia_buf_t *transformed_password, const pythia_buf_t *blinded_password,
+                          const pythia_buf_t *transformed_tweak, const pythia_buf_t *transformation_private_key,
+                          const pythia_buf_t *transformation_public_key,
+                          pythia_buf_t *proof_value_c, pythia_buf_t *proof_value_u);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_POOL_H
@@ -24,6 +24,56 @@
 extern "C" {
 #endif
 
+/// Encodings of GT values (transformed and deblinded passwords)
+typedef enum pythia_gt_encoding {
+    PYTHIA_GT_ENCODING_DEFAULT = 0,   /// Compressed cyclotomic encoding, PYTHIA_GT_BUF_SIZE bytes
+    PYTHIA_GT_ENCODING_TORUS = 1      /// T6 torus encoding, PYTHIA_GT_TORUS_BUF_SIZE (192) bytes
+} pythia_gt_encoding_t;
+
+/// Selects encoding of GT values written by pythia_w_* functions. Should be called once, before other pythia calls.
+/// Functions reading GT values accept both encodings, so stored values don't need to be converted.
+/// \param [in] encoding GT encoding
+void pythia_w_set_gt_encoding(pythia_gt_encoding_t encoding);
+
+/// Encodings of scalars (private keys, blinding secrets, proof values and update tokens)
+typedef enum pythia_scalar_encoding {
+    PYTHIA_SCALAR_ENCODING_DEFAULT = 0,   /// Sign byte followed by minimal big-endian magnitude
+    PYTHIA_SCALAR_ENCODING_FIXED = 1      /// PYTHIA_SCALAR_BUF_SIZE bytes of little-endian magnitude
+} pythia_scalar_encoding_t;
+
+/// Selects encoding of scalars read and written by pythia_w_* functions. Should be called once,
+/// before other pythia calls. Unlike GT encodings, scalar encodings can't be told apart by length,
+/// so stored scalars have to be converted when switching.
+/// \param [in] encoding scalar encoding
+void pythia_w_set_scalar_encoding(pythia_scalar_encoding_t encoding);
+
+/// Handling of raw points (see pythia_w_point_to_raw) passed to pythia_w_* functions
+typedef enum pythia_raw_points {
+    PYTHIA_RAW_POINTS_DISABLED = 0,      /// Raw points are rejected
+    PYTHIA_RAW_POINTS_CHECK_CURVE = 1,   /// Raw points are checked to be on curve, but not in the subgroup
+    PYTHIA_RAW_POINTS_TRUSTED = 2        /// Raw points are copied as is
+} pythia_raw_points_t;
+
+/// Selects handling of raw points. Should be called once, before other pythia calls.
+/// Raw points skip decompression and subgroup checks, so they are only accepted for server-owned inputs:
+/// transformation_public_key and transformed_tweak. Blinded passwords are always fully validated.
+/// Only enable raw points if every raw point comes from storage the server itself wrote.
+/// \param [in] mode raw points handling
+void pythia_w_set_raw_points(pythia_raw_points_t mode);
+
+/// Converts point (transformation public key or transformed tweak) to raw encoding for trusted caches.
+/// Raw encoding is the in-memory representation of affine coordinates and is only valid for the same build.
+/// \param [in] point compressed G1 or G2 point, fully validated during conversion
+/// \param [out] raw_point PYTHIA_G1_RAW_BUF_SIZE or PYTHIA_G2_RAW_BUF_SIZE bytes
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_point_to_raw(const pythia_buf_t *point, pythia_buf_t *raw_point);
+
+/// Exponent (password update token or blinding secret) prepared for repeated use
+typedef struct pythia_prepared_exp pythia_prepared_exp_t;
+
+/// Transformation private key prepared for repeated use
+typedef struct pythia_prepared_key pythia_prepared_key_t;
+
 /// Blinds password. Turns password into a pseudo-random string. This step is necessary to prevent 3rd-parties from knowledge of end user's password.
 /// \param [in] password end user's password.
 /// \param [out] G1 blinded_password password obfuscated into a pseudo-random string.
@@ -108,6 +158,133 @@ int pythia_w_update_deblinded_with_token(const pythia_buf_t *deblinded_password,
                                          const pythia_buf_t *password_update_token,
                                          pythia_buf_t *updated_deblinded_password);
 
+/// Prepares password_update_token or blinding_secret for repeated use. The value is reduced, split and recoded once,
+/// so that updating or deblinding many passwords with it skips this work for every password.
+/// \param [in] BN exponent password update token from pythia_get_password_update_token or blinding secret from pythia_blind.
+/// \param [out] prepared prepared exponent. Should be freed with pythia_w_prepared_exp_free.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_prepare_exp(const pythia_buf_t *exponent, pythia_prepared_exp_t **prepared);
+
+/// Frees prepared exponent
+void pythia_w_prepared_exp_free(pythia_prepared_exp_t *prepared);
+
+/// Updates previously stored deblinded_password with prepared password_update_token. Result is equal to pythia_w_update_deblinded_with_token.
+/// \param [in] GT deblinded_password previous deblinded password from pythia_deblind.
+/// \param [in] password_update_token password update token prepared with pythia_w_prepare_exp
+/// \param [out] GT updated_deblinded_password new deblinded password.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_update_deblinded_with_prepared_token(const pythia_buf_t *deblinded_password,
+                                                  const pythia_prepared_exp_t *password_update_token,
+                                                  pythia_buf_t *updated_deblinded_password);
+
+/// Deblinds transformed_password value with prepared blinding_secret. Result is equal to pythia_w_deblind.
+/// \param [in] GT transformed_password transformed password from pythia_transform.
+/// \param [in] blinding_secret blinding secret prepared with pythia_w_prepare_exp
+/// \param [out] GT deblinded_password deblinded transformed_password value.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_deblind_with_prepared_secret(const pythia_buf_t *transformed_password,
+                                          const pythia_prepared_exp_t *blinding_secret,
+                                          pythia_buf_t *deblinded_password);
+
+/// Prepares transformation private key for repeated use. The key is split and recoded once,
+/// so that transforming many passwords with it skips this work for every password.
+/// \param [in] BN transformation_private_key transformation private key.
+/// \param [out] prepared prepared key. Should be freed with pythia_w_prepared_key_free.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_prepare_transformation_private_key(const pythia_buf_t *transformation_private_key,
+                                                pythia_prepared_key_t **prepared);
+
+/// Frees prepared transformation private key
+void pythia_w_prepared_key_free(pythia_prepared_key_t *prepared);
+
+/// Transforms blinded password using prepared transformation private key. Result is equal to pythia_w_transform.
+/// \param [in] G1 blinded_password password obfuscated into a pseudo-random string.
+/// \param [in] tweak some random value used to identify user
+/// \param [in] transformation_private_key transformation private key prepared with pythia_w_prepare_transformation_private_key.
+/// \param [out] GT transformed_password blinded password, protected using server secret (transformation private key + tweak).
+/// \param [out] G2 transformed_tweak tweak value turned into an elliptic curve point. This value is used by Prove() operation.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_transform_with_prepared_key(const pythia_buf_t *blinded_password, const pythia_buf_t *tweak,
+                                         const pythia_prepared_key_t *transformation_private_key,
+                                         pythia_buf_t *transformed_password, pythia_buf_t *transformed_tweak);
+
+/// Transforms count blinded passwords using the same prepared transformation private key.
+/// \param [in] G1 blinded_passwords array of count passwords obfuscated into a pseudo-random string.
+/// \param [in] tweaks array of count tweaks
+/// \param [in] count number of passwords
+/// \param [in] transformation_private_key transformation private key prepared with pythia_w_prepare_transformation_private_key.
+/// \param [out] GT transformed_passwords array of count transformed passwords.
+/// \param [out] G2 transformed_tweaks array of count transformed tweaks.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_transform_batch(const pythia_buf_t *blinded_passwords, const pythia_buf_t *tweaks, size_t count,
+                             const pythia_prepared_key_t *transformation_private_key,
+                             pythia_buf_t *transformed_passwords, pythia_buf_t *transformed_tweaks);
+
+/// Blinds count passwords at once. Equivalent to calling pythia_w_blind for each password,
+/// but blinding secrets are inverted together, which is much cheaper.
+/// \param [in] passwords array of count end user's passwords.
+/// \param [in] count number of passwords.
+/// \param [out] G1 blinded_passwords array of count passwords obfuscated into a pseudo-random string.
+/// \param [out] BN blinding_secrets array of count random values used to blind user's passwords.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_blind_batch(const pythia_buf_t *passwords, size_t count,
+                         pythia_buf_t *blinded_passwords, pythia_buf_t *blinding_secrets);
+
+/// Generates password update tokens for count key rotations at once (e.g. for many tenants).
+/// Equivalent to calling pythia_w_get_password_update_token for each pair of keys, but previous keys are inverted together,
+/// which is much cheaper.
+/// \param [in] previous_transformation_private_keys array of count previous transformation private keys
+/// \param [in] new_transformation_private_keys array of count new transformation private keys
+/// \param [in] count number of keys
+/// \param [out] BN password_update_tokens array of count password update tokens.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_get_password_update_token_batch(const pythia_buf_t *previous_transformation_private_keys,
+                                             const pythia_buf_t *new_transformation_private_keys, size_t count,
+                                             pythia_buf_t *password_update_tokens);
+
+/// Computes transformation key pairs for count key IDs at once, e.g. to warm up key ring. Equivalent to calling
+/// pythia_w_compute_transformation_key_pair for each key ID, but HMACs are computed by multi-buffer SHA-384.
+/// \param [in] transformation_key_ids array of count ensemble key IDs.
+/// \param [in] count number of key IDs.
+/// \param [in] pythia_secret global common for all secret random Key.
+/// \param [in] pythia_scope_secret ensemble secret generated and versioned transparently.
+/// \param [out] BN transformation_private_keys array of count transformation private keys.
+/// \param [out] G1 transformation_public_keys array of count transformation public keys.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_compute_transformation_key_pair_batch(const pythia_buf_t *transformation_key_ids, size_t count,
+                                                   const pythia_buf_t *pythia_secret,
+                                                   const pythia_buf_t *pythia_scope_secret,
+                                                   pythia_buf_t *transformation_private_keys,
+                                                   pythia_buf_t *transformation_public_keys);
+
+/// Verifies count transformations made with the same transformation public key. Equivalent to calling
+/// pythia_w_verify for each transformation, but tweaks are hashed together and proof transcripts
+/// are hashed by multi-buffer SHA-384.
+/// \param [in] GT transformed_passwords array of count transformed passwords from pythia_transform
+/// \param [in] G1 blinded_passwords array of count blinded passwords from pythia_blind.
+/// \param [in] tweaks array of count tweaks from pythia_transform
+/// \param [in] count number of transformations
+/// \param [in] G1 transformation_public_key transformation public key
+/// \param [in] BN proof_values_c array of count proof values C from pythia_prove
+/// \param [in] BN proof_values_u array of count proof values U from pythia_prove
+/// \param [out] verified array of count results, 0 if verification failed, not 0 - otherwise
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_verify_batch(const pythia_buf_t *transformed_passwords, const pythia_buf_t *blinded_passwords,
+                          const pythia_buf_t *tweaks, size_t count, const pythia_buf_t *transformation_public_key,
+                          const pythia_buf_t *proof_values_c, const pythia_buf_t *proof_values_u, int *verified);
+
+/// Updates count deblinded passwords with the same password_update_token. Equivalent to calling
+/// pythia_w_update_deblinded_with_token for each password, but groups of 8 exponentiations run in lockstep
+/// on AVX-512 IFMA lanes if CPU supports them.
+/// \param [in] GT deblinded_passwords array of count previous deblinded passwords from pythia_deblind.
+/// \param [in] count number of passwords.
+/// \param [in] BN password_update_token password update token from pythia_get_password_update_token
+/// \param [out] GT updated_deblinded_passwords array of count new deblinded passwords.
+/// \return 0 if succeeded, -1 otherwise
+int pythia_w_update_deblinded_with_token_batch(const pythia_buf_t *deblinded_passwords, size_t count,
+                                               const pythia_buf_t *password_update_token,
+                                               pythia_buf_t *updated_deblinded_passwords);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,540 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <relic/relic.h>
+#include <relic/relic_err.h>
+#include "pythia_batch.h"
+#include "pythia_batch_c.h"
+#include "pythia_buf_exports.h"
+#include "pythia_c.h"
+#include "pythia_init_c.h"
+
+// Number of Fp coordinates kept per element
+#define G1_COORDS 2
+#define G2_COORDS 4
+#define GT_COORDS 12
+
+static int rows_init(batch_rows_t *r, size_t count, size_t coords) {
+    const size_t line = PYTHIA_BATCH_ALIGN / sizeof(dig_t);
+    const size_t row_size = coords * FP_DIGS * sizeof(dig_t);
+
+    memset(r, 0, sizeof(batch_rows_t));
+
+    if (count > (SIZE_MAX - PYTHIA_BATCH_ALIGN) / row_size - line)
+        return -1;
+
+    r->count = count;
+    r->stride = count ? (count + line - 1) / line * line : line;
+
+    r->mem = calloc(r->stride * row_size + PYTHIA_BATCH_ALIGN - 1, 1);
+    if (!r->mem)
+        return -1;
+
+    r->rows = (dig_t *)(((uintptr_t)r->mem + PYTHIA_BATCH_ALIGN - 1) & ~(uintptr_t)(PYTHIA_BATCH_ALIGN - 1));
+
+    return 0;
+}
+
+static void rows_cleanup(batch_rows_t *r) {
+    free(r->mem);
+    memset(r, 0, sizeof(batch_rows_t));
+}
+
+static void rows_set(batch_rows_t *r, size_t k, size_t i, const dig_t *a) {
+    for (int j = 0; j < FP_DIGS; j++)
+        batch_row(r, k, j)[i] = a[j];
+}
+
+static void rows_get(dig_t *a, const batch_rows_t *r, size_t k, size_t i) {
+    for (int j = 0; j < FP_DIGS; j++)
+        a[j] = batch_row(r, k, j)[i];
+}
+
+pythia_g1_batch_t *g1_batch_new(size_t count) {
+    pythia_g1_batch_t *b = (pythia_g1_batch_t *)calloc(1, sizeof(pythia_g1_batch_t));
+
+    if (!b || rows_init(&b->r, count, G1_COORDS) || !(b->infty = (uint8_t *)malloc(count ? count : 1))) {
+        g1_batch_free(b);
+        THROW(ERR_NO_MEMORY);
+        return NULL;
+    }
+
+    memset(b->infty, 1, count);
+
+    return b;
+}
+
+void g1_batch_free(pythia_g1_batch_t *b) {
+    if (!b)
+        return;
+
+    rows_cleanup(&b->r);
+    free(b->infty);
+    free(b);
+}
+
+void g1_batch_set(pythia_g1_batch_t *b, size_t i, g1_t p) {
+    const dig_t zero[FP_DIGS] = {0};
+
+    if (g1_is_infty(p)) {
+        for (size_t k = 0; k < G1_COORDS; k++)
+            rows_set(&b->r, k, i, zero);
+        b->infty[i] = 1;
+        return;
+    }
+
+    g1_norm(p, p);
+    rows_set(&b->r, 0, i, p->x);
+    rows_set(&b->r, 1, i, p->y);
+    b->infty[i] = 0;
+}
+
+void g1_batch_get(g1_t p, const pythia_g1_batch_t *b, size_t i) {
+    if (b->infty[i]) {
+        g1_set_infty(p);
+        return;
+    }
+
+    rows_get(p->x, &b->r, 0, i);
+    rows_get(p->y, &b->r, 1, i);
+    fp_set_dig(p->z, 1);
+    p->norm = 1;
+}
+
+pythia_g2_batch_t *g2_batch_new(size_t count) {
+    pythia_g2_batch_t *b = (pythia_g2_batch_t *)calloc(1, sizeof(pythia_g2_batch_t));
+
+    if (!b || rows_init(&b->r, count, G2_COORDS) || !(b->infty = (uint8_t *)malloc(count ? count : 1))) {
+        g2_batch_free(b);
+        THROW(ERR_NO_MEMORY);
+        return NULL;
+    }
+
+    memset(b->infty, 1, count);
+
+    return b;
+}
+
+void g2_batch_free(pythia_g2_batch_t *b) {
+    if (!b)
+        return;
+
+    rows_cleanup(&b->r);
+    free(b->infty);
+    free(b);
+}
+
+void g2_batch_set(pythia_g2_batch_t *b, size_t i, g2_t p) {
+    const dig_t zero[FP_DIGS] = {0};
+
+    if (g2_is_infty(p)) {
+        for (size_t k = 0; k < G2_COORDS; k++)
+            rows_set(&b->r, k, i, zero);
+        b->infty[i] = 1;
+        return;
+    }
+
+    g2_norm(p, p);
+    rows_set(&b->r, 0, i, p->x[0]);
+    rows_set(&b->r, 1, i, p->x[1]);
+    rows_set(&b->r, 2, i, p->y[0]);
+    rows_set(&b->r, 3, i, p->y[1]);
+    b->infty[i] = 0;
+}
+
+void g2_batch_get(g2_t p, const pythia_g2_batch_t *b, size_t i) {
+    if (b->infty[i]) {
+        g2_set_infty(p);
+        return;
+    }
+
+    rows_get(p->x[0], &b->r, 0, i);
+    rows_get(p->x[1], &b->r, 1, i);
+    rows_get(p->y[0], &b->r, 2, i);
+    rows_get(p->y[1], &b->r, 3, i);
+    fp_set_dig(p->z[0], 1);
+    fp_zero(p->z[1]);
+    p->norm = 1;
+}
+
+pythia_gt_batch_t *gt_batch_new(size_t count) {
+    pythia_gt_batch_t *b = (pythia_gt_batch_t *)calloc(1, sizeof(pythia_gt_batch_t));
+    fp_t one; fp_null(one);
+
+    if (!b || rows_init(&b->r, count, GT_COORDS)) {
+        gt_batch_free(b);
+        THROW(ERR_NO_MEMORY);
+        return NULL;
+    }
+
+    TRY {
+        fp_new(one);
+        fp_set_dig(one, 1);
+
+        // Unity has a single non-zero coefficient a[0][0][0]
+        for (size_t i = 0; i < count; i++)
+            rows_set(&b->r, 0, i, one);
+    }
+    CATCH_ANY {
+        gt_batch_free(b);
+        b = NULL;
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp_free(one);
+    }
+
+    return b;
+}
+
+void gt_batch_free(pythia_gt_batch_t *b) {
+    if (!b)
+        return;
+
+    rows_cleanup(&b->r);
+    free(b);
+}
+
+void gt_batch_set(pythia_gt_batch_t *b, size_t i, gt_t a) {
+    for (int x = 0; x < 2; x++)
+        for (int y = 0; y < 3; y++)
+            for (int z = 0; z < 2; z++)
+                rows_set(&b->r, (size_t)((x * 3 + y) * 2 + z), i, a[x][y][z]);
+}
+
+void gt_batch_get(gt_t a, const pythia_gt_batch_t *b, size_t i) {
+    for (int x = 0; x < 2; x++)
+        for (int y = 0; y < 3; y++)
+            for (int z = 0; z < 2; z++)
+                rows_get(a[x][y][z], &b->r, (size_t)((x * 3 + y) * 2 + z), i);
+}
+
+void g1_batch_read_bufs(pythia_g1_batch_t *b, const pythia_buf_t *bufs) {
+    g1_t p; g1_null(p);
+
+    TRY {
+        g1_new(p);
+
+        for (size_t i = 0; i < b->r.count; i++) {
+            g1_read_buf(p, &bufs[i]);
+            g1_batch_set(b, i, p);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(p);
+    }
+}
+
+void g1_batch_write_bufs(pythia_buf_t *bufs, const pythia_g1_batch_t *b) {
+    g1_t p; g1_null(p);
+
+    TRY {
+        g1_new(p);
+
+        for (size_t i = 0; i < b->r.count; i++) {
+            g1_batch_get(p, b, i);
+            g1_write_buf(&bufs[i], p);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(p);
+    }
+}
+
+void g2_batch_read_bufs(pythia_g2_batch_t *b, const pythia_buf_t *bufs) {
+    g2_t p; g2_null(p);
+
+    TRY {
+        g2_new(p);
+
+        for (size_t i = 0; i < b->r.count; i++) {
+            g2_read_buf(p, &bufs[i]);
+            g2_batch_set(b, i, p);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g2_free(p);
+    }
+}
+
+void g2_batch_write_bufs(pythia_buf_t *bufs, const pythia_g2_batch_t *b) {
+    g2_t p; g2_null(p);
+
+    TRY {
+        g2_new(p);
+
+        for (size_t i = 0; i < b->r.count; i++) {
+            g2_batch_get(p, b, i);
+            g2_write_buf(&bufs[i], p);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g2_free(p);
+    }
+}
+
+void gt_batch_read_bufs(pythia_gt_batch_t *b, const pythia_buf_t *bufs) {
+    gt_t a; gt_null(a);
+
+    TRY {
+        // Reject malformed input before decoding and subgroup checks
+        for (size_t i = 0; i < b->r.count; i++)
+            gt_check_buf(&bufs[i]);
+
+        gt_new(a);
+
+        for (size_t i = 0; i < b->r.count; i++) {
+            gt_read_buf(a, &bufs[i]);
+            gt_batch_set(b, i, a);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        gt_free(a);
+    }
+}
+
+void gt_batch_write_bufs(pythia_buf_t *bufs, const pythia_gt_batch_t *b) {
+    gt_t a; gt_null(a);
+
+    TRY {
+        gt_new(a);
+
+        for (size_t i = 0; i < b->r.count; i++) {
+            gt_batch_get(a, b, i);
+            gt_write_buf(&bufs[i], a);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        gt_free(a);
+    }
+}
+
+int pythia_w_g1_batch_new(size_t count, pythia_g1_batch_t **batch) {
+    pythia_err_init();
+
+    if (!batch)
+        return -1;
+
+    TRY {
+        *batch = g1_batch_new(count);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+void pythia_w_g1_batch_free(pythia_g1_batch_t *batch) {
+    g1_batch_free(batch);
+}
+
+size_t pythia_w_g1_batch_count(const pythia_g1_batch_t *batch) {
+    return batch->r.count;
+}
+
+int pythia_w_g1_batch_read(pythia_g1_batch_t *batch, const pythia_buf_t *bufs) {
+    pythia_err_init();
+
+    TRY {
+        g1_batch_read_bufs(batch, bufs);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int pythia_w_g1_batch_write(pythia_buf_t *bufs, const pythia_g1_batch_t *batch) {
+    pythia_err_init();
+
+    TRY {
+        g1_batch_write_bufs(bufs, batch);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int pythia_w_g2_batch_new(size_t count, pythia_g2_batch_t **batch) {
+    pythia_err_init();
+
+    if (!batch)
+        return -1;
+
+    TRY {
+        *batch = g2_batch_new(count);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+void pythia_w_g2_batch_free(pythia_g2_batch_t *batch) {
+    g2_batch_free(batch);
+}
+
+size_t pythia_w_g2_batch_count(const pythia_g2_batch_t *batch) {
+    return batch->r.count;
+}
+
+int pythia_w_g2_batch_read(pythia_g2_batch_t *batch, const pythia_buf_t *bufs) {
+    pythia_err_init();
+
+    TRY {
+        g2_batch_read_bufs(batch, bufs);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int pythia_w_g2_batch_write(pythia_buf_t *bufs, const pythia_g2_batch_t *batch) {
+    pythia_err_init();
+
+    TRY {
+        g2_batch_write_bufs(bufs, batch);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int pythia_w_gt_batch_new(size_t count, pythia_gt_batch_t **batch) {
+    pythia_err_init();
+
+    if (!batch)
+        return -1;
+
+    TRY {
+        *batch = gt_batch_new(count);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+void pythia_w_gt_batch_free(pythia_gt_batch_t *batch) {
+    gt_batch_free(batch);
+}
+
+size_t pythia_w_gt_batch_count(const pythia_gt_batch_t *batch) {
+    return batch->r.count;
+}
+
+int pythia_w_gt_batch_read(pythia_gt_batch_t *batch, const pythia_buf_t *bufs) {
+    pythia_err_init();
+
+    TRY {
+        gt_batch_read_bufs(batch, bufs);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int pythia_w_gt_batch_write(pythia_buf_t *bufs, const pythia_gt_batch_t *batch) {
+    pythia_err_init();
+
+    TRY {
+        gt_batch_write_bufs(bufs, batch);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+int pythia_w_gt_batch_update_with_token(const pythia_gt_batch_t *deblinded_passwords,
+                                        const pythia_buf_t *password_update_token,
+                                        pythia_gt_batch_t *updated_deblinded_passwords) {
+    pythia_err_init();
+
+    if (deblinded_passwords->r.count != updated_deblinded_passwords->r.count)
+        return -1;
+
+    bn_t delta_bn; bn_null(delta_bn);
+
+    TRY {
+        bn_new(delta_bn);
+        bn_read_buf(delta_bn, password_update_token);
+
+        pythia_update_with_delta_gt_batch(deblinded_passwords, delta_bn, updated_deblinded_passwords);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        bn_free(delta_bn);
+
+        return -1;
+    }
+    FINALLY {
+        bn_free(delta_bn);
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_BATCH_C_H
+#define PYTHIA_PYTHIA_BATCH_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <relic/relic.h>
+#include "pythia_batch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Alignment of coordinate rows, one cache line
+#define PYTHIA_BATCH_ALIGN 64
+
+/// Coordinate rows of a batch. Limb j of coordinate k of element i is kept in rows[(k * FP_DIGS + j) * stride + i]
+/// in relic's Montgomery form, rows past count are zero.
+typedef struct batch_rows {
+    size_t count;       /// Number of elements
+    size_t stride;      /// Row length, count rounded up to whole cache lines
+    dig_t *rows;        /// Rows, aligned to PYTHIA_BATCH_ALIGN
+    void *mem;          /// Allocated memory
+} batch_rows_t;
+
+/// Returns row of limb j of coordinate k
+#define batch_row(R, K, J) ((R)->rows + ((size_t)(K) * FP_DIGS + (size_t)(J)) * (R)->stride)
+
+struct pythia_g1_batch {
+    batch_rows_t r;     /// Affine x, y
+    uint8_t *infty;     /// 1 for points at infinity
+};
+
+struct pythia_g2_batch {
+    batch_rows_t r;     /// Affine x[0], x[1], y[0], y[1]
+    uint8_t *infty;     /// 1 for points at infinity
+};
+
+struct pythia_gt_batch {
+    batch_rows_t r;     /// Coefficients a[x][y][z] in order of x, y, z
+};
+
+/// Creates batch of count G1 points at infinity, throws ERR_NO_MEMORY
+pythia_g1_batch_t *g1_batch_new(size_t count);
+
+/// Frees batch of G1 points
+void g1_batch_free(pythia_g1_batch_t *b);
+
+/// Stores point p as element i of the batch, p is normalized
+void g1_batch_set(pythia_g1_batch_t *b, size_t i, g1_t p);
+
+/// Loads element i of the batch to point p
+void g1_batch_get(g1_t p, const pythia_g1_batch_t *b, size_t i);
+
+/// Creates batch of count G2 points at infinity, throws ERR_NO_MEMORY
+pythia_g2_batch_t *g2_batch_new(size_t count);
+
+/// Frees batch of G2 points
+void g2_batch_free(pythia_g2_batch_t *b);
+
+/// Stores point p as element i of the batch, p is normalized
+void g2_batch_set(pythia_g2_batch_t *b, size_t i, g2_t p);
+
+/// Loads element i of the batch to point p
+void g2_batch_get(g2_t p, const pythia_g2_batch_t *b, size_t i);
+
+/// Creates batch of count GT elements set to unity, throws ERR_NO_MEMORY
+pythia_gt_batch_t *gt_batch_new(size_t count);
+
+/// Frees batch of GT elements
+void gt_batch_free(pythia_gt_batch_t *b);
+
+/// Stores a as element i of the batch
+void gt_batch_set(pythia_gt_batch_t *b, size_t i, gt_t a);
+
+/// Loads element i of the batch to a
+void gt_batch_get(gt_t a, const pythia_gt_batch_t *b, size_t i);
+
+/// Reads and validates b->r.count serialized points into the batch
+void g1_batch_read_bufs(pythia_g1_batch_t *b, const pythia_buf_t *bufs);
+
+/// Serializes all points of the batch
+void g1_batch_write_bufs(pythia_buf_t *bufs, const pythia_g1_batch_t *b);
+
+/// Reads and validates b->r.count serialized points into the batch
+void g2_batch_read_bufs(pythia_g2_batch_t *b, const pythia_buf_t *bufs);
+
+/// Serializes all points of the batch
+void g2_batch_write_bufs(pythia_buf_t *bufs, const pythia_g2_batch_t *b);
+
+/// Reads and validates b->r.count serialized elements into the batch
+void gt_batch_read_bufs(pythia_gt_batch_t *b, const pythia_buf_t *bufs);
+
+/// Serializes all elements of the batch
+void gt_batch_write_bufs(pythia_buf_t *bufs, const pythia_gt_batch_t *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_BATCH_C_H
@@ -15,11 +15,32 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include <relic/relic.h>
 #include <relic/relic_err.h>
 #include <pythia.h>
 #include "pythia_buf.h"
 #include "pythia_buf_exports.h"
+#include "pythia_c.h"
+#include "pythia_buf_sizes_c.h"
+
+static pythia_gt_encoding_t gt_encoding = PYTHIA_GT_ENCODING_DEFAULT;
+
+void pythia_w_set_gt_encoding(pythia_gt_encoding_t encoding) {
+    gt_encoding = encoding;
+}
+
+static pythia_scalar_encoding_t scalar_encoding = PYTHIA_SCALAR_ENCODING_DEFAULT;
+
+void pythia_w_set_scalar_encoding(pythia_scalar_encoding_t encoding) {
+    scalar_encoding = encoding;
+}
+
+static pythia_raw_points_t raw_points = PYTHIA_RAW_POINTS_DISABLED;
+
+void pythia_w_set_raw_points(pythia_raw_points_t mode) {
+    raw_points = mode;
+}
 
 static void check_size_read(const pythia_buf_t *buf, size_t min_size, size_t max_size) {
     if (!buf || buf->len < min_size || buf->len > max_size)
@@ -31,48 +52,381 @@ static void check_size_write(const pythia_buf_t *buf, size_t min_size) {
         THROW(ERR_NO_BUFFER);
 }
 
-void bn_read_buf(bn_t b, const pythia_buf_t *buf) {
+/*
+ * Checks that big-endian field element is fully reduced, without converting it.
+ */
+static int fp_bin_is_reduced(const uint8_t *bin) {
+    const dig_t *prime = fp_prime_get();
+
+    for (int i = FP_DIGS - 1; i >= 0; i--) {
+        dig_t d = 0;
+        for (int j = (int)sizeof(dig_t) - 1; j >= 0; j--) {
+            int k = FP_BYTES - 1 - (i * (int)sizeof(dig_t) + j);
+            d = (d << 8) | (k >= 0 ? bin[k] : 0);
+        }
+        if (d != prime[i])
+            return d < prime[i];
+    }
+
+    return 0;
+}
+
+static void check_fp_bin(const uint8_t *bin, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!fp_bin_is_reduced(bin + i * FP_BYTES))
+            THROW(ERR_NO_VALID);
+    }
+}
+
+// Marks torus encodings that keep m0 instead of m1, FP_BITS = 381 leaves top bits of field elements free
+#define GT_TORUS_EXCEPTIONAL 0x80
+
+static void check_torus_bin(const uint8_t *bin) {
+    uint8_t first[FP_BYTES];
+
+    memcpy(first, bin, FP_BYTES);
+    first[0] &= (uint8_t)~GT_TORUS_EXCEPTIONAL;
+    check_fp_bin(first, 1);
+    check_fp_bin(bin + FP_BYTES, 3);
+}
+
+void bn_check_buf(const pythia_buf_t *buf) {
+    if (scalar_encoding == PYTHIA_SCALAR_ENCODING_FIXED) {
+        check_size_read(buf, PYTHIA_SCALAR_BUF_SIZE, PYTHIA_SCALAR_BUF_SIZE);
+        return;
+    }
+
     check_size_read(buf, 2, PYTHIA_BN_BUF_SIZE);
 
-    uint8_t sign = buf->p[0];
+    if (buf->p[0] != BN_POS && buf->p[0] != BN_NEG)
+        THROW(ERR_NO_VALID);
+}
+
+void gt_check_buf(const pythia_buf_t *buf) {
+    check_size_read(buf, 1, PYTHIA_GT_BUF_SIZE);
+
+    if (buf->len == PYTHIA_GT_BUF_SIZE)
+        check_fp_bin(buf->p, 8);
+    else if (buf->len == PYTHIA_GT_TORUS_BUF_SIZE)
+        check_torus_bin(buf->p);
+    else
+        THROW(ERR_NO_VALID);
+}
+
+void g1_check_buf(const pythia_buf_t *buf) {
+    check_size_read(buf, 1, PYTHIA_G1_BUF_SIZE);
 
-    if (sign != BN_POS && sign != BN_NEG)
+    // Point at infinity is a single zero byte, other points are compressed
+    if (buf->len == 1 && buf->p[0] == 0)
+        return;
+
+    if (buf->len != PYTHIA_G1_BUF_SIZE || (buf->p[0] != 2 && buf->p[0] != 3))
         THROW(ERR_NO_VALID);
 
+    check_fp_bin(buf->p + 1, 1);
+}
+
+void g2_check_buf(const pythia_buf_t *buf) {
+    check_size_read(buf, 1, PYTHIA_G2_BUF_SIZE);
+
+    if (buf->len == 1 && buf->p[0] == 0)
+        return;
+
+    if (buf->len != PYTHIA_G2_BUF_SIZE || (buf->p[0] != 2 && buf->p[0] != 3))
+        THROW(ERR_NO_VALID);
+
+    check_fp_bin(buf->p + 1, 2);
+}
+
+void g1_check_buf_trusted(const pythia_buf_t *buf) {
+    if (raw_points != PYTHIA_RAW_POINTS_DISABLED && buf && buf->len == PYTHIA_G1_RAW_BUF_SIZE)
+        return;
+
+    g1_check_buf(buf);
+}
+
+void g2_check_buf_trusted(const pythia_buf_t *buf) {
+    if (raw_points != PYTHIA_RAW_POINTS_DISABLED && buf && buf->len == PYTHIA_G2_RAW_BUF_SIZE)
+        return;
+
+    g2_check_buf(buf);
+}
+
+/*
+ * Fixed scalars are non-negative integers below 2^256 in little-endian order, parsed straight into limbs.
+ */
+static void bn_read_fixed(bn_t b, const uint8_t *bin) {
+    const int digs = DEF_PYTHIA_SCALAR_BUF_SIZE / (int)sizeof(dig_t);
+
+    bn_grow(b, digs);
+
+    for (int i = 0; i < digs; i++) {
+        dig_t d = 0;
+        for (int j = (int)sizeof(dig_t) - 1; j >= 0; j--)
+            d = (d << 8) | bin[i * sizeof(dig_t) + j];
+        b->dp[i] = d;
+    }
+
+    b->used = digs;
+    b->sign = BN_POS;
+    bn_trim(b);
+}
+
+static void bn_write_fixed(uint8_t *bin, bn_t b) {
+    if (b->sign == BN_NEG || bn_bits(b) > 8 * DEF_PYTHIA_SCALAR_BUF_SIZE)
+        THROW(ERR_NO_VALID);
+
+    for (int k = 0; k < DEF_PYTHIA_SCALAR_BUF_SIZE; k++) {
+        int i = k / (int)sizeof(dig_t);
+        bin[k] = i < b->used ? (uint8_t)(b->dp[i] >> (8 * (k % sizeof(dig_t)))) : 0;
+    }
+}
+
+void bn_read_buf(bn_t b, const pythia_buf_t *buf) {
+    bn_check_buf(buf);
+
+    if (scalar_encoding == PYTHIA_SCALAR_ENCODING_FIXED) {
+        bn_read_fixed(b, buf->p);
+        return;
+    }
+
+    uint8_t sign = buf->p[0];
+
     bn_read_bin(b, buf->p + 1, (int)(buf->len - 1));
     b->sign = sign;
 }
 
-void gt_read_buf(gt_t g, const pythia_buf_t *buf) {
-    check_size_read(buf, 1, PYTHIA_GT_BUF_SIZE);
+/*
+ * Elements of GT have norm 1 over Fp6, so g = g0 + g1 * w lies in the torus T2(Fp6) and is represented
+ * by the single Fp6 element m = (1 + g0) / g1, with g = (m + w) / (m - w). Unity is encoded as m = 0.
+ * GT also lies in T6(Fp2), which holds m = m0 + m1 * v + m2 * v^2 to m0 * m1 = xi * m2^2 + 1 / 3
+ * (norm of g over Fp4 is 1). So m0 follows from the other two coordinates and the encoding keeps
+ * m1 and m2, a third of Fp12. Elements with m1 = 0 keep m0 and m2 instead and are marked with
+ * GT_TORUS_EXCEPTIONAL in the first byte.
+ */
+
+// c = xi * a^2 + 1 / 3, the product m0 * m1 of coordinates of T6(Fp2) elements
+static void gt_torus_rhs(fp2_t c, fp2_t a) {
+    fp_t third; fp_null(third);
+
+    TRY {
+        fp_new(third);
+        fp_set_dig(third, 3);
+        fp_inv(third, third);
+
+        fp2_sqr(c, a);
+        fp2_mul_nor(c, c);
+        fp_add(c[0], c[0], third);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp_free(third);
+    }
+}
 
-    //TODO replace with proper sanity check
-    int zeroBytes = 0;
-    for (int i = 0; i < buf->len; i++) {
-        zeroBytes += buf->p[i] == 0;
+static void gt_read_torus(gt_t g, const uint8_t *bin) {
+    uint8_t first[FP_BYTES];
+    const int exceptional = (bin[0] & GT_TORUS_EXCEPTIONAL) != 0;
+    fp2_t c; fp2_null(c);
+    fp6_t m, n, d;
+
+    fp6_null(m);
+    fp6_null(n);
+    fp6_null(d);
+
+    TRY {
+        fp2_new(c);
+        fp6_new(m);
+        fp6_new(n);
+        fp6_new(d);
+
+        memcpy(first, bin, FP_BYTES);
+        first[0] &= (uint8_t)~GT_TORUS_EXCEPTIONAL;
+
+        fp_read_bin(c[0], first, FP_BYTES);
+        fp_read_bin(c[1], bin + FP_BYTES, FP_BYTES);
+        fp_read_bin(m[2][0], bin + 2 * FP_BYTES, FP_BYTES);
+        fp_read_bin(m[2][1], bin + 3 * FP_BYTES, FP_BYTES);
+
+        gt_torus_rhs(n[0], m[2]);
+
+        if (exceptional) {
+            // m1 = 0 is possible only if xi * m2^2 + 1 / 3 = 0
+            if (!fp2_is_zero(n[0]))
+                THROW(ERR_NO_VALID);
+            fp2_copy(m[0], c);
+            fp2_zero(m[1]);
+        } else if (fp2_is_zero(c)) {
+            // Unity, any other element with m1 = 0 is written in exceptional form
+            if (!fp2_is_zero(m[2]))
+                THROW(ERR_NO_VALID);
+            fp6_zero(m);
+        } else {
+            fp2_copy(m[1], c);
+            fp2_inv(c, c);
+            fp2_mul(m[0], n[0], c);
+        }
+
+        if (fp6_is_zero(m)) {
+            gt_set_unity(g);
+        } else {
+            // g0 = (m^2 + v) / (m^2 - v), g1 = 2m / (m^2 - v)
+            fp6_sqr(n, m);
+            fp6_copy(d, n);
+            fp_add_dig(n[1][0], n[1][0], 1);
+            fp_sub_dig(d[1][0], d[1][0], 1);
+            fp6_inv(d, d);
+            fp6_mul(g[0], n, d);
+            fp6_add(m, m, m);
+            fp6_mul(g[1], m, d);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp6_free(d);
+        fp6_free(n);
+        fp6_free(m);
+        fp2_free(c);
     }
-    if (zeroBytes > 24)
+}
+
+static void gt_write_torus(uint8_t *bin, gt_t g) {
+    fp6_t m, t;
+
+    fp6_null(m);
+    fp6_null(t);
+
+    TRY {
+        fp6_new(m);
+        fp6_new(t);
+
+        fp6_copy(t, g[0]);
+        fp_add_dig(t[0][0], t[0][0], 1);
+
+        if (fp6_is_zero(g[1])) {
+            // Only unity and -1 have g1 = 0, and -1 is not in GT
+            if (fp6_is_zero(t))
+                THROW(ERR_NO_VALID);
+            memset(bin, 0, 4 * FP_BYTES);
+        } else {
+            fp6_inv(m, g[1]);
+            fp6_mul(m, m, t);
+
+            if (fp2_is_zero(m[1])) {
+                fp_write_bin(bin, FP_BYTES, m[0][0]);
+                fp_write_bin(bin + FP_BYTES, FP_BYTES, m[0][1]);
+                bin[0] |= GT_TORUS_EXCEPTIONAL;
+            } else {
+                fp_write_bin(bin, FP_BYTES, m[1][0]);
+                fp_write_bin(bin + FP_BYTES, FP_BYTES, m[1][1]);
+            }
+            fp_write_bin(bin + 2 * FP_BYTES, FP_BYTES, m[2][0]);
+            fp_write_bin(bin + 3 * FP_BYTES, FP_BYTES, m[2][1]);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp6_free(m);
+        fp6_free(t);
+    }
+}
+
+void gt_read_buf(gt_t g, const pythia_buf_t *buf) {
+    gt_check_buf(buf);
+
+    if (buf->len == PYTHIA_GT_TORUS_BUF_SIZE)
+        gt_read_torus(g, buf->p);
+    else
+        gt_read_bin(g, buf->p, (int)buf->len);
+
+    if (!gt_is_member(g))
         THROW(ERR_NO_VALID);
+}
 
-    gt_read_bin(g, buf->p, (int)buf->len);
+/*
+ * Raw points are affine coordinates copied as they are kept in memory, so reading them is a memcpy.
+ */
+static void g1_read_raw(g1_t g, const uint8_t *bin) {
+    const size_t fp_size = FP_DIGS * sizeof(dig_t);
 
+    memcpy(g->x, bin, fp_size);
+    memcpy(g->y, bin + fp_size, fp_size);
+    fp_set_dig(g->z, 1);
+    g->norm = 1;
+}
+
+static void g2_read_raw(g2_t g, const uint8_t *bin) {
+    const size_t fp_size = FP_DIGS * sizeof(dig_t);
+
+    memcpy(g->x[0], bin, fp_size);
+    memcpy(g->x[1], bin + fp_size, fp_size);
+    memcpy(g->y[0], bin + 2 * fp_size, fp_size);
+    memcpy(g->y[1], bin + 3 * fp_size, fp_size);
+    fp_set_dig(g->z[0], 1);
+    fp_zero(g->z[1]);
+    g->norm = 1;
 }
 
 void g1_read_buf(g1_t g, const pythia_buf_t *buf) {
-    check_size_read(buf, 1, PYTHIA_G1_BUF_SIZE);
+    g1_check_buf(buf);
+
     g1_read_bin(g, buf->p, (int)buf->len);
-    if (!g1_is_valid(g))
+    if (!g1_is_valid(g) || !g1_is_member(g))
         THROW(ERR_NO_VALID);
 }
 
 void g2_read_buf(g2_t g, const pythia_buf_t *buf) {
-    check_size_read(buf, 1, PYTHIA_G2_BUF_SIZE);
+    g2_check_buf(buf);
+
     g2_read_bin(g, buf->p, (int)buf->len);
-    if (!g2_is_valid(g))
+    if (!g2_is_valid(g) || !g2_is_member(g))
+        THROW(ERR_NO_VALID);
+}
+
+/*
+ * Raw points are only read from server-owned inputs, points coming from clients always go through
+ * g1_read_buf and g2_read_buf.
+ */
+void g1_read_buf_trusted(g1_t g, const pythia_buf_t *buf) {
+    g1_check_buf_trusted(buf);
+
+    if (raw_points == PYTHIA_RAW_POINTS_DISABLED || buf->len != PYTHIA_G1_RAW_BUF_SIZE) {
+        g1_read_buf(g, buf);
+        return;
+    }
+
+    g1_read_raw(g, buf->p);
+    if (raw_points == PYTHIA_RAW_POINTS_CHECK_CURVE && !g1_is_valid(g))
+        THROW(ERR_NO_VALID);
+}
+
+void g2_read_buf_trusted(g2_t g, const pythia_buf_t *buf) {
+    g2_check_buf_trusted(buf);
+
+    if (raw_points == PYTHIA_RAW_POINTS_DISABLED || buf->len != PYTHIA_G2_RAW_BUF_SIZE) {
+        g2_read_buf(g, buf);
+        return;
+    }
+
+    g2_read_raw(g, buf->p);
+    if (raw_points == PYTHIA_RAW_POINTS_CHECK_CURVE && !g2_is_valid(g))
         THROW(ERR_NO_VALID);
 }
 
 void bn_write_buf(pythia_buf_t *buf, bn_t b) {
+    if (scalar_encoding == PYTHIA_SCALAR_ENCODING_FIXED) {
+        check_size_write(buf, PYTHIA_SCALAR_BUF_SIZE);
+        bn_write_fixed(buf->p, b);
+        buf->len = PYTHIA_SCALAR_BUF_SIZE;
+        return;
+    }
+
     int size = bn_size_bin(b) + 1;
     check_size_write(buf, (size_t)size);
     bn_write_bin(buf->p + 1, size - 1, b);
@@ -88,6 +442,13 @@ void g2_write_buf(pythia_buf_t *buf, g2_t e) {
 }
 
 void gt_write_buf(pythia_buf_t *buf, gt_t g) {
+    if (gt_encoding == PYTHIA_GT_ENCODING_TORUS) {
+        check_size_write(buf, PYTHIA_GT_TORUS_BUF_SIZE);
+        gt_write_torus(buf->p, g);
+        buf->len = PYTHIA_GT_TORUS_BUF_SIZE;
+        return;
+    }
+
     int size = gt_size_bin(g, 1);
     check_size_write(buf, (size_t)size);
     gt_write_bin(buf->p, size, g, 1);
@@ -100,3 +461,31 @@ void g1_write_buf(pythia_buf_t *buf, g1_t g) {
     g1_write_bin(buf->p, size, g, 1);
     buf->len = (size_t)size;
 }
+
+void g1_write_buf_raw(pythia_buf_t *buf, g1_t g) {
+    const size_t fp_size = FP_DIGS * sizeof(dig_t);
+
+    check_size_write(buf, PYTHIA_G1_RAW_BUF_SIZE);
+    if (g1_is_infty(g))
+        THROW(ERR_NO_VALID);
+
+    g1_norm(g, g);
+    memcpy(buf->p, g->x, fp_size);
+    memcpy(buf->p + fp_size, g->y, fp_size);
+    buf->len = PYTHIA_G1_RAW_BUF_SIZE;
+}
+
+void g2_write_buf_raw(pythia_buf_t *buf, g2_t g) {
+    const size_t fp_size = FP_DIGS * sizeof(dig_t);
+
+    check_size_write(buf, PYTHIA_G2_RAW_BUF_SIZE);
+    if (g2_is_infty(g))
+        THROW(ERR_NO_VALID);
+
+    g2_norm(g, g);
+    memcpy(buf->p, g->x[0], fp_size);
+    memcpy(buf->p + fp_size, g->x[1], fp_size);
+    memcpy(buf->p + 2 * fp_size, g->y[0], fp_size);
+    memcpy(buf->p + 3 * fp_size, g->y[1], fp_size);
+    buf->len = PYTHIA_G2_RAW_BUF_SIZE;
+}
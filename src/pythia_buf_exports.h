@@ -26,14 +26,24 @@
 extern "C" {
 #endif
 
+void bn_check_buf(const pythia_buf_t *buf);
+void gt_check_buf(const pythia_buf_t *buf);
+void g1_check_buf(const pythia_buf_t *buf);
+void g2_check_buf(const pythia_buf_t *buf);
+void g1_check_buf_trusted(const pythia_buf_t *buf);
+void g2_check_buf_trusted(const pythia_buf_t *buf);
 void bn_read_buf(bn_t b, const pythia_buf_t *buf);
 void gt_read_buf(gt_t g, const pythia_buf_t *buf);
 void g1_read_buf(g1_t g, const pythia_buf_t *buf);
 void g2_read_buf(g2_t g, const pythia_buf_t *buf);
+void g1_read_buf_trusted(g1_t g, const pythia_buf_t *buf);
+void g2_read_buf_trusted(g2_t g, const pythia_buf_t *buf);
 void bn_write_buf(pythia_buf_t *buf, bn_t b);
 void g2_write_buf(pythia_buf_t *buf, g2_t e);
 void gt_write_buf(pythia_buf_t *buf, gt_t g);
 void g1_write_buf(pythia_buf_t *buf, g1_t g);
+void g1_write_buf_raw(pythia_buf_t *buf, g1_t g);
+void g2_write_buf_raw(pythia_buf_t *buf, g2_t g);
 
 #ifdef __cplusplus
 }
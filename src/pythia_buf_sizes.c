@@ -19,8 +19,12 @@
 #include "pythia_buf_sizes_c.h"
 
 const size_t PYTHIA_BN_BUF_SIZE = (size_t)DEF_PYTHIA_BN_BUF_SIZE;
+const size_t PYTHIA_SCALAR_BUF_SIZE = (size_t)DEF_PYTHIA_SCALAR_BUF_SIZE;
 const size_t PYTHIA_G1_BUF_SIZE = (size_t)DEF_PYTHIA_G1_BUF_SIZE;
 const size_t PYTHIA_G2_BUF_SIZE = (size_t)DEF_PYTHIA_G2_BUF_SIZE;
 const size_t PYTHIA_GT_BUF_SIZE = (size_t)DEF_PYTHIA_GT_BUF_SIZE;
+const size_t PYTHIA_GT_TORUS_BUF_SIZE = (size_t)DEF_PYTHIA_GT_TORUS_BUF_SIZE;
+const size_t PYTHIA_G1_RAW_BUF_SIZE = (size_t)DEF_PYTHIA_G1_RAW_BUF_SIZE;
+const size_t PYTHIA_G2_RAW_BUF_SIZE = (size_t)DEF_PYTHIA_G2_RAW_BUF_SIZE;
 const size_t PYTHIA_BIN_MIN_BUF_SIZE = (size_t)DEF_PYTHIA_BIN_MAX_BUF_SIZE;
 const size_t PYTHIA_BIN_MAX_BUF_SIZE = (size_t)DEF_PYTHIA_BIN_MIN_BUF_SIZE;
\ No newline at end of file
@@ -20,13 +20,22 @@
 
 #include <relic/relic.h>
 
-#define DEF_PYTHIA_G1_BUF_SIZE FP_BYTES+1
+#define DEF_PYTHIA_G1_BUF_SIZE (FP_BYTES + 1)
 
-#define DEF_PYTHIA_G2_BUF_SIZE 2*FP_BYTES+1
+#define DEF_PYTHIA_G2_BUF_SIZE (2 * FP_BYTES + 1)
 
-#define DEF_PYTHIA_GT_BUF_SIZE 8*FP_BYTES
+#define DEF_PYTHIA_GT_BUF_SIZE (8 * FP_BYTES)
 
-#define DEF_PYTHIA_BN_BUF_SIZE DEF_PYTHIA_G1_BUF_SIZE + 1
+// T6 torus keeps two Fp2 coordinates, a third of Fp12: 192 bytes for BLS12-381
+#define DEF_PYTHIA_GT_TORUS_BUF_SIZE (4 * FP_BYTES)
+
+#define DEF_PYTHIA_G1_RAW_BUF_SIZE (2 * FP_DIGS * sizeof(dig_t))
+
+#define DEF_PYTHIA_G2_RAW_BUF_SIZE (4 * FP_DIGS * sizeof(dig_t))
+
+#define DEF_PYTHIA_BN_BUF_SIZE (DEF_PYTHIA_G1_BUF_SIZE + 1)
+
+#define DEF_PYTHIA_SCALAR_BUF_SIZE 32
 
 #define DEF_PYTHIA_BIN_MIN_BUF_SIZE 1
 
@@ -21,11 +21,94 @@
 #include "pythia_conf.h"
 #include "pythia_init_c.h"
 #include "pythia_buf_sizes_c.h"
+#include "pythia_scalar.h"
+#include "pythia_hash.h"
+#include "pythia_md.h"
+#include "pythia_fp8.h"
+#include "pythia_fp_asm.h"
+#include "pythia_fp_gen.h"
+#include "pythia_pp.h"
+#include "pythia_cpu.h"
+#include "pythia_batch_c.h"
+
+#if RELIC_USE_PTHREAD
+#include <pthread.h>
+
+static pthread_mutex_t rand_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif // RELIC_USE_PTHREAD
 
 static bn_t g1_ord;
 static g1_t g1_gen;
 static bn_t gt_ord;
 static gt_t gt_gen;
+static bn_t curve_z;
+static int g1_endom_sign;
+static int g2_psi_eigen;
+static pythia_hash_mode_t hash_g1_mode = PYTHIA_HASH_G1_SSWU ? PYTHIA_HASH_MODE_SSWU : PYTHIA_HASH_MODE_LEGACY;
+static pythia_hash_mode_t hash_g2_mode = PYTHIA_HASH_G2_SSWU ? PYTHIA_HASH_MODE_SSWU : PYTHIA_HASH_MODE_LEGACY;
+
+static void g1_endom(g1_t r, g1_t p);
+static void g2_mul_z(g2_t r, g2_t p);
+
+static void endom_setup(void) {
+    bn_t b; bn_null(b);
+    g1_t p; g1_null(p);
+    g1_t q; g1_null(q);
+    g2_t p2; g2_null(p2);
+    g2_t q2; g2_null(q2);
+
+    TRY {
+        bn_new(b);
+        g1_new(p);
+        g1_new(q);
+        g2_new(p2);
+        g2_new(q2);
+
+        // For BLS12 curves r = z^4 - z^2 + 1, so both z^2 - 1 and -z^2 are cube roots of unity modulo r.
+        // One of them is the eigenvalue of endomorphism (x, y) -> (beta * x, y), find out which one.
+        g1_endom_sign = 0;
+
+        if (ep_curve_is_endom()) {
+            g1_endom(p, g1_gen);
+
+            bn_sqr(b, curve_z);
+            bn_sub_dig(b, b, 1);
+            g1_mul(q, g1_gen, b);
+            g1_norm(q, q);
+
+            if (g1_cmp(p, q) == CMP_EQ) {
+                g1_endom_sign = 1;
+            }
+            else {
+                bn_add_dig(b, b, 1);
+                g1_mul(q, g1_gen, b);
+                g1_neg(q, q);
+                g1_norm(q, q);
+
+                if (g1_cmp(p, q) == CMP_EQ)
+                    g1_endom_sign = -1;
+            }
+        }
+
+        // Untwist-Frobenius-twist acts on G2 as multiplication by p = z mod r
+        g2_get_gen(p2);
+        g2_mul_z(q2, p2);
+        g2_norm(q2, q2);
+        ep2_frb(p2, p2, 1);
+        g2_norm(p2, p2);
+        g2_psi_eigen = g2_cmp(p2, q2) == CMP_EQ;
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g2_free(q2);
+        g2_free(p2);
+        g1_free(q);
+        g1_free(p);
+        bn_free(b);
+    }
+}
 
 int pythia_init(const pythia_init_args_t *init_args) {
     if (core_get())
@@ -50,6 +133,7 @@ int pythia_init(const pythia_init_args_t *init_args) {
     g1_null(g1_gen);
     bn_null(gt_ord);
     gt_null(gt_gen);
+    bn_null(curve_z);
 
     TRY {
         bn_new(g1_ord);
@@ -63,8 +147,22 @@ int pythia_init(const pythia_init_args_t *init_args) {
 
         gt_new(gt_gen);
         gt_get_gen(gt_gen);
+
+        bn_new(curve_z);
+        fp_param_get_var(curve_z);
+
+        sc_init(g1_ord);
+        endom_setup();
+        hash_init();
+        cpu_init();
+        md_batch_init();
+        fp8_init();
+        fp_asm_init();
+        fp_gen_init();
+        pp_exp_init();
     }
     CATCH_ANY {
+        bn_free(curve_z);
         gt_free(gt_gen);
         bn_free(gt_ord);
         g1_free(g1_gen);
@@ -79,6 +177,8 @@ int pythia_init(const pythia_init_args_t *init_args) {
 void pythia_deinit(void) {
     core_clean();
 
+    hash_deinit();
+    bn_free(curve_z);
     gt_free(gt_gen);
     bn_free(gt_ord);
     g1_free(g1_gen);
@@ -89,21 +189,149 @@ void pythia_err_init(void) {
     err_core_reset_default();
 }
 
+static void rand_lock(void) {
+#if RELIC_USE_PTHREAD
+    pthread_mutex_lock(&rand_mutex);
+#endif // RELIC_USE_PTHREAD
+}
+
+static void rand_unlock(void) {
+#if RELIC_USE_PTHREAD
+    pthread_mutex_unlock(&rand_mutex);
+#endif // RELIC_USE_PTHREAD
+}
+
 static void random_bn_mod(bn_t r, bn_t max) {
-    if (!max) {
-        bn_rand(r, BN_POS, 256);
+    // Pool threads draw random values in background, while relic's generator state is shared
+    rand_lock();
+
+    TRY {
+        if (!max) {
+            bn_rand(r, BN_POS, 256);
+        }
+        else {
+            bn_rand_mod(r, max);
+        }
+    }
+    CATCH_ANY {
+        rand_unlock();
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {}
+
+    rand_unlock();
+}
+
+static void bn_array_free(bn_t *a, size_t n) {
+    if (!a)
+        return;
+
+    for (size_t i = 0; i < n; i++) {
+        bn_free(a[i]);
+    }
+
+    free(a);
+}
+
+static bn_t *bn_array_new(size_t n) {
+    bn_t *a = (bn_t *)calloc(n, sizeof(bn_t));
+
+    if (!a)
+        THROW(ERR_NO_MEMORY);
+
+    for (size_t i = 0; i < n; i++) {
+        bn_null(a[i]);
+    }
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            bn_new(a[i]);
+        }
+    }
+    CATCH_ANY {
+        bn_array_free(a, n);
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {}
+
+    return a;
+}
+
+// Inverts n values modulo group order with one inversion and 3(n - 1) multiplications (Montgomery's trick)
+static void bn_mod_inv_sim(bn_t *c, bn_t *a, size_t n) {
+    if (!n)
+        return;
+
+    pythia_sc_t *s = (pythia_sc_t *)malloc(n * sizeof(pythia_sc_t));
+    if (!s)
+        THROW(ERR_NO_MEMORY);
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            sc_read_bn(&s[i], a[i]);
+            if (sc_is_zero(&s[i]))
+                THROW(ERR_NO_VALID);
+        }
+
+        sc_inv_sim(s, s, n);
+
+        for (size_t i = 0; i < n; i++) {
+            sc_write_bn(c[i], &s[i]);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
     }
-    else {
-        bn_rand_mod(r, max);
+    FINALLY {
+        free(s);
     }
 }
 
+void pythia_set_hash_g1(pythia_hash_mode_t mode) {
+    hash_g1_mode = mode;
+}
+
+void pythia_set_hash_g2(pythia_hash_mode_t mode) {
+    hash_g2_mode = mode;
+}
+
 static void hashG1(g1_t g1, const uint8_t *msg, size_t msg_size) {
-    g1_map(g1, msg, (int)msg_size);
+    if (hash_g1_mode == PYTHIA_HASH_MODE_SSWU) {
+        g1_map_sswu(g1, msg, msg_size, (const uint8_t *)PYTHIA_HASH_G1_DST, sizeof(PYTHIA_HASH_G1_DST) - 1);
+    } else {
+        g1_map(g1, msg, (int)msg_size);
+    }
 }
 
 static void hashG2(g2_t g2, const uint8_t *msg, size_t msg_size) {
-    g2_map(g2, msg, (int)msg_size);
+    if (hash_g2_mode == PYTHIA_HASH_MODE_SSWU) {
+        g2_map_sswu(g2, msg, msg_size, (const uint8_t *)PYTHIA_HASH_G2_DST, sizeof(PYTHIA_HASH_G2_DST) - 1);
+    } else {
+        g2_map(g2, msg, (int)msg_size);
+    }
+}
+
+// Batch variants share field inversions between messages in SSWU mode, relic's maps are applied one by one
+static void hashG1_batch(g1_t *g1, const uint8_t *const *msg, const size_t *msg_sizes, size_t n) {
+    if (hash_g1_mode == PYTHIA_HASH_MODE_SSWU) {
+        g1_map_sswu_batch(g1, msg, msg_sizes, n,
+                          (const uint8_t *)PYTHIA_HASH_G1_DST, sizeof(PYTHIA_HASH_G1_DST) - 1);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            g1_map(g1[i], msg[i], (int)msg_sizes[i]);
+        }
+    }
+}
+
+static void hashG2_batch(g2_t *g2, const uint8_t *const *msg, const size_t *msg_sizes, size_t n) {
+    if (hash_g2_mode == PYTHIA_HASH_MODE_SSWU) {
+        g2_map_sswu_batch(g2, msg, msg_sizes, n,
+                          (const uint8_t *)PYTHIA_HASH_G2_DST, sizeof(PYTHIA_HASH_G2_DST) - 1);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            g2_map(g2[i], msg[i], (int)msg_sizes[i]);
+        }
+    }
 }
 
 static void compute_kw(bn_t kw, const uint8_t *w, size_t w_size,
@@ -135,6 +363,59 @@ static void compute_kw(bn_t kw, const uint8_t *w, size_t w_size,
     }
 }
 
+// Same as compute_kw for n key IDs, HMACs are computed by multi-buffer SHA-384
+static void compute_kw_batch(bn_t *kw, const uint8_t *const *w, const size_t *w_sizes, size_t n,
+                             const uint8_t *msk, size_t msk_size,
+                             const uint8_t *s, size_t s_size) {
+    uint8_t (*mac)[MD_LEN_SH384] = NULL;
+    uint8_t *zw = NULL;
+    const uint8_t **zw_p = NULL;
+    size_t *zw_sizes = NULL;
+
+    bn_t b; bn_null(b);
+
+    TRY {
+        size_t total_size = 0;
+        for (size_t i = 0; i < n; i++)
+            total_size += s_size + w_sizes[i];
+
+        mac = calloc(n, sizeof(*mac));
+        zw = calloc(total_size, sizeof(uint8_t));
+        zw_p = (const uint8_t **)calloc(n, sizeof(uint8_t *));
+        zw_sizes = (size_t *)calloc(n, sizeof(size_t));
+
+        if (!mac || !zw || !zw_p || !zw_sizes)
+            THROW(ERR_NO_MEMORY);
+
+        uint8_t *p = zw;
+        for (size_t i = 0; i < n; i++) {
+            memcpy(p, s, s_size);
+            memcpy(p + s_size, w[i], w_sizes[i]);
+            zw_p[i] = p;
+            zw_sizes[i] = s_size + w_sizes[i];
+            p += zw_sizes[i];
+        }
+
+        md_hmac_sh384_batch(mac, zw_p, zw_sizes, n, msk, msk_size);
+
+        bn_new(b);
+        for (size_t i = 0; i < n; i++) {
+            bn_read_bin(b, mac[i], MD_LEN_SH384);
+            bn_mod(kw[i], b, gt_ord);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(b);
+        free(zw_sizes);
+        free(zw_p);
+        free(zw);
+        free(mac);
+    }
+}
+
 static void gt_pow(gt_t res, gt_t a, bn_t exp) {
     bn_t e; bn_null(e);
 
@@ -152,239 +433,1011 @@ static void gt_pow(gt_t res, gt_t a, bn_t exp) {
     }
 }
 
-static void scalar_mul_g1(g1_t r, const g1_t p, bn_t a) {
-    bn_t mod; bn_null(mod);
+// Same as gt_pow for n elements, exponentiations run in lockstep on 8-lane Fp arithmetic if CPU supports it
+static void gt_pow_batch(gt_t *res, gt_t *a, bn_t *exp, size_t n) {
+    bn_t *e = NULL;
 
     TRY {
-        bn_new(mod);
-        bn_mod(mod, a, g1_ord);
+        e = (bn_t *)calloc(n, sizeof(bn_t));
+        if (!e)
+            THROW(ERR_NO_MEMORY);
+
+        for (size_t i = 0; i < n; i++)
+            bn_null(e[i]);
 
-        g1_mul(r, p, mod);
+        for (size_t i = 0; i < n; i++) {
+            bn_new(e[i]);
+            bn_mod(e[i], exp[i], gt_ord);
+        }
+
+        gt_exp_batch(res, a, e, n);
     }
     CATCH_ANY {
         THROW(ERR_CAUGHT);
     }
     FINALLY {
-        bn_free(mod);
+        for (size_t i = 0; e && i < n; i++)
+            bn_free(e[i]);
+        free(e);
     }
 }
 
-static void serialize_g1(uint8_t *r, size_t size, const g1_t x) {
-    g1_write_bin(r, (int)size, x, 1);
-}
+static void recode_part(int8_t *naf, int len, bn_t k, int w, int negate) {
+    int8_t rec[PYTHIA_PREP_NAF_CAP];
+    int rec_len = PYTHIA_PREP_NAF_CAP;
 
-static void serialize_gt(uint8_t *r, size_t size, gt_t x) {
-    gt_write_bin(r, (int)size, x, 1);
+    if (bn_bits(k) + 1 > len)
+        THROW(ERR_NO_BUFFER);
+
+    sc_rec_naf(rec, &rec_len, k, w);
+
+    for (int i = 0; i < rec_len; i++) {
+        naf[i] = (int8_t)(negate ? -rec[i] : rec[i]);
+    }
 }
 
-static void hashZ(bn_t hash, const uint8_t* const * args, size_t args_size, const size_t* args_sizes) {
-    const uint8_t tag_msg[31] = "TAG_RELIC_HASH_ZMESSAGE_HASH_Z";
-    uint8_t *c = NULL;
+static void gt_pow_prep(gt_t res, gt_t a, const pythia_exp_prep_t *prep) {
+    const int table_size = 1 << (PYTHIA_EXP_PREP_WIN - 2);
+
+    gt_t table[PYTHIA_EXP_PREP_PARTS][1 << (PYTHIA_EXP_PREP_WIN - 2)];
+    gt_t s; gt_null(s);
+    gt_t r; gt_null(r);
+
+    for (int i = 0; i < PYTHIA_EXP_PREP_PARTS; i++) {
+        for (int j = 0; j < table_size; j++) {
+            gt_null(table[i][j]);
+        }
+    }
 
     TRY {
-        size_t total_size = 0;
-        for (size_t i = 0; i < args_size; i++)
-            total_size += args_sizes[i];
+        gt_new(s);
+        gt_new(r);
 
-        c = calloc((size_t)total_size, sizeof(uint8_t));
+        for (int i = 0; i < prep->parts; i++) {
+            for (int j = 0; j < table_size; j++) {
+                gt_new(table[i][j]);
+            }
+        }
 
-        uint8_t *p = c;
-        for (size_t i = 0; i < args_size; i++) {
-            memcpy(p, args[i], args_sizes[i]);
-            p += args_sizes[i];
+        // Odd powers a, a^3, a^5, ... of the first base
+        gt_copy(table[0][0], a);
+        fp12_sqr_cyc(s, a);
+        for (int j = 1; j < table_size; j++) {
+            gt_mul(table[0][j], table[0][j - 1], s);
         }
 
-        uint8_t mac[MD_LEN];
-        md_hmac(mac, c, (int)total_size, tag_msg, 31);
+        // Other bases are Frobenius images of the first one, so are their powers
+        for (int i = 1; i < prep->parts; i++) {
+            for (int j = 0; j < table_size; j++) {
+                fp12_frb(table[i][j], table[i - 1][j], 1);
+            }
+        }
 
-        bn_read_bin(hash, mac, MD_LEN_SH256); // We need only 256 bits from that number
+        int started = 0;
+        gt_set_unity(r);
+
+        for (int k = prep->len - 1; k >= 0; k--) {
+            if (started)
+                fp12_sqr_cyc(r, r);
+
+            for (int i = 0; i < prep->parts; i++) {
+                int8_t d = prep->naf[i * prep->len + k];
+
+                if (d > 0) {
+                    gt_mul(r, r, table[i][d >> 1]);
+                    started = 1;
+                }
+                else if (d < 0) {
+                    fp12_inv_uni(s, table[i][(-d) >> 1]);
+                    gt_mul(r, r, s);
+                    started = 1;
+                }
+            }
+        }
+
+        gt_copy(res, r);
     }
     CATCH_ANY {
         THROW(ERR_CAUGHT);
     }
     FINALLY {
-        free(c);
-    }
-}
+        for (int i = 0; i < PYTHIA_EXP_PREP_PARTS; i++) {
+            for (int j = 0; j < table_size; j++) {
+                gt_free(table[i][j]);
+            }
+        }
 
-static void check_size(size_t size, size_t min_size, size_t max_size) {
-    if (size < min_size || size > max_size)
-        THROW(ERR_NO_VALID);
+        gt_free(r);
+        gt_free(s);
+    }
 }
 
-void pythia_compute_kw(const uint8_t *w, size_t w_size, const uint8_t *msk, size_t msk_size,
-                       const uint8_t *s, size_t s_size,
-                       bn_t kw, g1_t pi_p) {
-    check_size(w_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
-    check_size(msk_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
-    check_size(s_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
-
-    compute_kw(kw, w, w_size, msk, msk_size, s, s_size);
-
-    scalar_mul_g1(pi_p, g1_gen, kw);
+static void g1_endom(g1_t r, g1_t p) {
+    g1_norm(r, p);
+    fp_mul(r->x, r->x, ep_curve_get_beta());
 }
 
-void pythia_blind(const uint8_t *m, size_t m_size, g1_t x, bn_t rInv) {
-    check_size(m_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
-
-    bn_t r; bn_null(r);
-    bn_t gcd; bn_null(gcd);
-    g1_t g1; g1_null(g1);
+/*
+ * Double-and-add by public non-negative constant. Membership tests multiply points that may lie outside
+ * of G1 and G2, where g1_mul and g2_mul reduce scalar modulo r and split it with endomorphisms,
+ * which makes both sides of the tests equal for every point on curve.
+ */
+static void g1_mul_plain(g1_t r, g1_t p, bn_t k) {
+    g1_t t; g1_null(t);
 
     TRY {
-        bn_new(r);
-        bn_new(gcd);
-
-        random_bn_mod(r, NULL);
-        bn_gcd_ext(gcd, rInv, NULL, r, g1_ord);
-        if (bn_cmp_dig(gcd, (dig_t)1) != CMP_EQ) {
-            THROW(ERR_NO_VALID);
+        g1_new(t);
+        g1_copy(t, p);
+        g1_set_infty(r);
+
+        for (int i = bn_bits(k) - 1; i >= 0; i--) {
+            g1_dbl(r, r);
+            if (bn_get_bit(k, i))
+                g1_add(r, r, t);
         }
-
-        g1_new(g1);
-        hashG1(g1, m, m_size);
-
-        g1_mul(x, g1, r);
     }
     CATCH_ANY {
         THROW(ERR_CAUGHT);
     }
     FINALLY {
-        g1_free(g1);
-        bn_free(gcd);
-        bn_free(r);
+        g1_free(t);
     }
 }
 
-void pythia_deblind(gt_t y, bn_t rInv, gt_t u) {
+static void g2_mul_plain(g2_t r, g2_t p, bn_t k) {
+    g2_t t; g2_null(t);
+
     TRY {
-        gt_pow(u, y, rInv);
+        g2_new(t);
+        g2_copy(t, p);
+        g2_set_infty(r);
+
+        for (int i = bn_bits(k) - 1; i >= 0; i--) {
+            g2_dbl(r, r);
+            if (bn_get_bit(k, i))
+                g2_add(r, r, t);
+        }
     }
     CATCH_ANY {
         THROW(ERR_CAUGHT);
     }
-    FINALLY {}
+    FINALLY {
+        g2_free(t);
+    }
 }
 
-void pythia_eval(g1_t x, const uint8_t *t, size_t t_size,
-                 bn_t kw, gt_t y, g2_t tTilde) {
-    check_size(t_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
-
-    g1_t xKw; g1_null(xKw);
+static void g2_mul_z(g2_t r, g2_t p) {
+    bn_t z; bn_null(z);
 
     TRY {
-        hashG2(tTilde, t, t_size);
+        bn_new(z);
 
-        g1_new(xKw);
-        g1_mul(xKw, x, kw);
-
-        pc_map(y, xKw, tTilde);
+        bn_abs(z, curve_z);
+        g2_mul_plain(r, p, z);
+        if (bn_sign(curve_z) == BN_NEG)
+            g2_neg(r, r);
     }
     CATCH_ANY {
         THROW(ERR_CAUGHT);
     }
     FINALLY {
-        g1_free(xKw);
+        bn_free(z);
     }
 }
 
-void pythia_prove(gt_t y, g1_t x, g2_t tTilde, bn_t kw,
-                  g1_t pi_p, bn_t pi_c, bn_t pi_u) {
-    gt_t beta; gt_null(beta);
-    bn_t v; bn_null(v);
-    g1_t t1; g1_null(t1);
-    gt_t t2; gt_null(t2);
-
-    uint8_t *q_bin = NULL, *p_bin = NULL, *beta_bin = NULL, *y_bin = NULL, *t1_bin = NULL, *t2_bin = NULL;
-
-    bn_t cpkw; bn_null(cpkw);
-    bn_t vscpkw; bn_null(vscpkw);
+/*
+ * Scott's membership tests: a point of E(Fp) lies in G1 iff phi(P) = -z^2 * P, and a point of E'(Fp2)
+ * lies in G2 iff psi(P) = z * P. Both replace a multiplication by r with one by a half or quarter size scalar.
+ * Points are expected to be on curve already.
+ */
+int g1_is_member(g1_t p) {
+    int result = 0;
+    bn_t b; bn_null(b);
+    g1_t q; g1_null(q);
+    g1_t e; g1_null(e);
 
     TRY {
-        gt_new(beta);
-        pc_map(beta, x, tTilde);
+        bn_new(b);
+        g1_new(q);
+        g1_new(e);
 
-        bn_new(v);
+        if (g1_is_infty(p)) {
+            result = 1;
+        }
+        else if (g1_endom_sign) {
+            // -z^2 is the eigenvalue of phi for sign -1, and of phi^2 = -1 - phi for sign 1.
+            // z^2 * P is computed as |z| * (|z| * P), |z| is sparse.
+            bn_abs(b, curve_z);
+            g1_mul_plain(q, p, b);
+            g1_mul_plain(q, q, b);
+            g1_endom(e, p);
+            if (g1_endom_sign > 0)
+                g1_sub(q, q, p);
+            else
+                g1_neg(q, q);
+            g1_norm(q, q);
+            result = g1_cmp(e, q) == CMP_EQ;
+        }
+        else {
+            g1_mul_plain(q, p, g1_ord);
+            result = g1_is_infty(q);
+        }
+    }
+    CATCH_ANY {
+        result = 0;
+    }
+    FINALLY {
+        g1_free(e);
+        g1_free(q);
+        bn_free(b);
+    }
 
-        random_bn_mod(v, gt_ord);
+    return result;
+}
 
-        g1_new(t1);
-        scalar_mul_g1(t1, g1_gen, v);
+int g2_is_member(g2_t p) {
+    int result = 0;
+    g2_t q; g2_null(q);
+    g2_t e; g2_null(e);
 
-        gt_new(t2);
-        gt_pow(t2, beta, v);
+    TRY {
+        g2_new(q);
+        g2_new(e);
 
-        size_t q_bin_size = (size_t)g1_size_bin(g1_gen, 1);
-        q_bin = calloc((size_t) q_bin_size, sizeof(uint8_t));
-        serialize_g1(q_bin, q_bin_size, g1_gen);
+        if (g2_is_infty(p)) {
+            result = 1;
+        }
+        else if (g2_psi_eigen) {
+            g2_mul_z(q, p);
+            g2_norm(q, q);
+            ep2_frb(e, p, 1);
+            g2_norm(e, e);
+            result = g2_cmp(e, q) == CMP_EQ;
+        }
+        else {
+            g2_mul_plain(q, p, g1_ord);
+            result = g2_is_infty(q);
+        }
+    }
+    CATCH_ANY {
+        result = 0;
+    }
+    FINALLY {
+        g2_free(e);
+        g2_free(q);
+    }
 
-        size_t p_bin_size = (size_t)g1_size_bin(pi_p, 1);
-        p_bin = calloc((size_t) p_bin_size, sizeof(uint8_t));
-        serialize_g1(p_bin, p_bin_size, pi_p);
+    return result;
+}
 
-        size_t beta_bin_size = (size_t)gt_size_bin(beta, 1);
-        beta_bin = calloc((size_t) beta_bin_size, sizeof(uint8_t));
-        serialize_gt(beta_bin, beta_bin_size, beta);
+/*
+ * For BLS12 curves GT is exactly the set of elements of the cyclotomic subgroup with g^p = g^z,
+ * where z is the curve parameter. This costs a few Frobenius maps and one exponentiation by |z|,
+ * which is sparse, instead of a full exponentiation by the group order.
+ */
+int gt_is_member(gt_t g) {
+    int result = 0;
+    bn_t z;
+    gt_t t0, t1;
 
-        size_t y_bin_size = (size_t)gt_size_bin(y, 1);
-        y_bin = calloc((size_t) y_bin_size, sizeof(uint8_t));
-        serialize_gt(y_bin, y_bin_size, y);
+    bn_null(z);
+    gt_null(t0);
+    gt_null(t1);
 
-        size_t t1_bin_size = (size_t)g1_size_bin(t1, 1);
-        t1_bin = calloc((size_t) t1_bin_size, sizeof(uint8_t));
-        serialize_g1(t1_bin, t1_bin_size, t1);
+    TRY {
+        bn_new(z);
+        gt_new(t0);
+        gt_new(t1);
+
+        // Zero is not invertible, unity never results from the protocol
+        if (fp12_cmp_dig(g, 0) != CMP_EQ && !gt_is_unity(g)) {
+            // Cyclotomic subgroup: g^(p^4 + 1) = g^(p^2)
+            gt_frb(t0, g, 4);
+            gt_mul(t0, t0, g);
+            gt_frb(t1, g, 2);
+            result = gt_cmp(t0, t1) == CMP_EQ;
+        }
 
-        size_t t2_bin_size = (size_t)gt_size_bin(t2, 1);
-        t2_bin = calloc((size_t) t2_bin_size, sizeof(uint8_t));
-        serialize_gt(t2_bin, t2_bin_size, t2);
+        if (result) {
+            // g^p = g^z, inversion in the cyclotomic subgroup is conjugation
+            bn_abs(z, curve_z);
+            fp12_exp_cyc(t0, g, z);
+            if (bn_sign(curve_z) == BN_NEG)
+                gt_inv(t0, t0);
+            gt_frb(t1, g, 1);
+            result = gt_cmp(t0, t1) == CMP_EQ;
+        }
+    }
+    CATCH_ANY {
+        result = 0;
+    }
+    FINALLY {
+        bn_free(z);
+        gt_free(t0);
+        gt_free(t1);
+    }
+
+    return result;
+}
 
-        const uint8_t *const args[6] = {q_bin, p_bin, beta_bin, y_bin, t1_bin, t2_bin};
-        const size_t args_sizes[6] = {q_bin_size, p_bin_size, beta_bin_size, y_bin_size, t1_bin_size, t2_bin_size};
-        hashZ(pi_c, args, 6, args_sizes);
 
-        bn_new(cpkw);
-        bn_mul(cpkw, pi_c, kw);
+static void g1_mul_prep(g1_t r, g1_t p, const pythia_scalar_prep_t *k) {
+    const int table_size = 1 << (PYTHIA_SCALAR_PREP_WIN - 2);
 
-        bn_new(vscpkw);
-        bn_sub(vscpkw, v, cpkw);
+    g1_t table[PYTHIA_SCALAR_PREP_PARTS][1 << (PYTHIA_SCALAR_PREP_WIN - 2)];
+    g1_t s; g1_null(s);
+    g1_t acc; g1_null(acc);
 
-        bn_mod(pi_u, vscpkw, gt_ord);
+    for (int i = 0; i < PYTHIA_SCALAR_PREP_PARTS; i++) {
+        for (int j = 0; j < table_size; j++) {
+            g1_null(table[i][j]);
+        }
     }
-    CATCH_ANY {
-        THROW(ERR_CAUGHT);
+
+    if (g1_is_infty(p)) {
+        g1_set_infty(r);
+        return;
+    }
+
+    TRY {
+        g1_new(s);
+        g1_new(acc);
+
+        for (int i = 0; i < k->parts; i++) {
+            for (int j = 0; j < table_size; j++) {
+                g1_new(table[i][j]);
+            }
+        }
+
+        // Odd multiples P, 3P, 5P, ... of the first base
+        g1_copy(table[0][0], p);
+        g1_dbl(s, p);
+        for (int j = 1; j < table_size; j++) {
+            g1_add(table[0][j], table[0][j - 1], s);
+        }
+        ep_norm_sim(table[0], (const ep_t *)table[0], table_size);
+
+        // Multiples of the second base are endomorphism images of the first ones
+        for (int i = 1; i < k->parts; i++) {
+            for (int j = 0; j < table_size; j++) {
+                g1_endom(table[i][j], table[i - 1][j]);
+            }
+        }
+
+        g1_set_infty(acc);
+
+        for (int l = k->len - 1; l >= 0; l--) {
+            g1_dbl(acc, acc);
+
+            for (int i = 0; i < k->parts; i++) {
+                int8_t d = k->naf[i * k->len + l];
+
+                if (d > 0) {
+                    g1_add(acc, acc, table[i][d >> 1]);
+                }
+                else if (d < 0) {
+                    g1_neg(s, table[i][(-d) >> 1]);
+                    g1_add(acc, acc, s);
+                }
+            }
+        }
+
+        g1_norm(r, acc);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        for (int i = 0; i < PYTHIA_SCALAR_PREP_PARTS; i++) {
+            for (int j = 0; j < table_size; j++) {
+                g1_free(table[i][j]);
+            }
+        }
+
+        g1_free(acc);
+        g1_free(s);
+    }
+}
+
+static void g2_mul_prep(g2_t r, g2_t p, const pythia_exp_prep_t *k) {
+    const int table_size = 1 << (PYTHIA_EXP_PREP_WIN - 2);
+
+    g2_t table[PYTHIA_EXP_PREP_PARTS][1 << (PYTHIA_EXP_PREP_WIN - 2)];
+    g2_t s; g2_null(s);
+    g2_t acc; g2_null(acc);
+
+    for (int i = 0; i < PYTHIA_EXP_PREP_PARTS; i++) {
+        for (int j = 0; j < table_size; j++) {
+            g2_null(table[i][j]);
+        }
+    }
+
+    if (g2_is_infty(p)) {
+        g2_set_infty(r);
+        return;
+    }
+
+    TRY {
+        g2_new(s);
+        g2_new(acc);
+
+        for (int i = 0; i < k->parts; i++) {
+            for (int j = 0; j < table_size; j++) {
+                g2_new(table[i][j]);
+            }
+        }
+
+        // Odd multiples P, 3P, 5P, ... of the first base
+        g2_copy(table[0][0], p);
+        g2_dbl(s, p);
+        for (int j = 1; j < table_size; j++) {
+            g2_add(table[0][j], table[0][j - 1], s);
+        }
+        ep2_norm_sim(table[0], table[0], table_size);
+
+        // Multiples of other bases are psi images of the previous ones, psi keeps points normalized
+        for (int i = 1; i < k->parts; i++) {
+            for (int j = 0; j < table_size; j++) {
+                ep2_frb(table[i][j], table[i - 1][j], 1);
+            }
+        }
+
+        g2_set_infty(acc);
+
+        for (int l = k->len - 1; l >= 0; l--) {
+            g2_dbl(acc, acc);
+
+            for (int i = 0; i < k->parts; i++) {
+                int8_t d = k->naf[i * k->len + l];
+
+                if (d > 0) {
+                    g2_add(acc, acc, table[i][d >> 1]);
+                }
+                else if (d < 0) {
+                    g2_neg(s, table[i][(-d) >> 1]);
+                    g2_add(acc, acc, s);
+                }
+            }
+        }
+
+        g2_norm(r, acc);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        for (int i = 0; i < PYTHIA_EXP_PREP_PARTS; i++) {
+            for (int j = 0; j < table_size; j++) {
+                g2_free(table[i][j]);
+            }
+        }
+
+        g2_free(acc);
+        g2_free(s);
+    }
+}
+
+void g1_mul_glv(g1_t r, g1_t p, bn_t k) {
+    pythia_scalar_prep_t prep;
+
+    pythia_scalar_prepare(&prep, k);
+    g1_mul_prep(r, p, &prep);
+}
+
+void g2_mul_gls(g2_t r, g2_t p, bn_t k) {
+    pythia_exp_prep_t prep;
+    bn_t mod; bn_null(mod);
+
+    TRY {
+        if (g2_psi_eigen) {
+            // G2 and GT have the same order and their Frobenius maps the same eigenvalue z, so the split is shared
+            pythia_exp_prepare(&prep, k);
+            g2_mul_prep(r, p, &prep);
+        }
+        else {
+            bn_new(mod);
+            bn_mod(mod, k, g1_ord);
+            g2_mul(r, p, mod);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(mod);
+    }
+}
+
+static void serialize_g1(uint8_t *r, size_t size, const g1_t x) {
+    g1_write_bin(r, (int)size, x, 1);
+}
+
+static void serialize_gt(uint8_t *r, size_t size, gt_t x) {
+    gt_write_bin(r, (int)size, x, 1);
+}
+
+static void hashZ(bn_t hash, const uint8_t* const * args, size_t args_size, const size_t* args_sizes) {
+    const uint8_t tag_msg[31] = "TAG_RELIC_HASH_ZMESSAGE_HASH_Z";
+    uint8_t *c = NULL;
+
+    TRY {
+        size_t total_size = 0;
+        for (size_t i = 0; i < args_size; i++)
+            total_size += args_sizes[i];
+
+        c = calloc((size_t)total_size, sizeof(uint8_t));
+
+        uint8_t *p = c;
+        for (size_t i = 0; i < args_size; i++) {
+            memcpy(p, args[i], args_sizes[i]);
+            p += args_sizes[i];
+        }
+
+        uint8_t mac[MD_LEN];
+        md_hmac(mac, c, (int)total_size, tag_msg, 31);
+
+        bn_read_bin(hash, mac, MD_LEN_SH256); // We need only 256 bits from that number
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        free(c);
+    }
+}
+
+// Same as hashZ for n transcripts of args_size arguments each, HMACs are computed by multi-buffer SHA-384
+static void hashZ_batch(bn_t *hash, const uint8_t *const *args, size_t args_size, const size_t *args_sizes,
+                        size_t n) {
+    const uint8_t tag_msg[31] = "TAG_RELIC_HASH_ZMESSAGE_HASH_Z";
+    uint8_t (*mac)[MD_LEN_SH384] = NULL;
+    uint8_t *c = NULL;
+    const uint8_t **c_p = NULL;
+    size_t *c_sizes = NULL;
+
+    TRY {
+        size_t total_size = 0;
+        for (size_t i = 0; i < n * args_size; i++)
+            total_size += args_sizes[i];
+
+        mac = calloc(n, sizeof(*mac));
+        c = calloc(total_size, sizeof(uint8_t));
+        c_p = (const uint8_t **)calloc(n, sizeof(uint8_t *));
+        c_sizes = (size_t *)calloc(n, sizeof(size_t));
+
+        if (!mac || !c || !c_p || !c_sizes)
+            THROW(ERR_NO_MEMORY);
+
+        uint8_t *p = c;
+        for (size_t i = 0; i < n; i++) {
+            c_p[i] = p;
+            for (size_t j = i * args_size; j < (i + 1) * args_size; j++) {
+                memcpy(p, args[j], args_sizes[j]);
+                p += args_sizes[j];
+            }
+            c_sizes[i] = (size_t)(p - c_p[i]);
+        }
+
+        md_hmac_sh384_batch(mac, c_p, c_sizes, n, tag_msg, 31);
+
+        for (size_t i = 0; i < n; i++)
+            bn_read_bin(hash[i], mac[i], MD_LEN_SH256); // We need only 256 bits from that number
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        free(c_sizes);
+        free(c_p);
+        free(c);
+        free(mac);
+    }
+}
+
+static void check_size(size_t size, size_t min_size, size_t max_size) {
+    if (size < min_size || size > max_size)
+        THROW(ERR_NO_VALID);
+}
+
+void pythia_compute_kw(const uint8_t *w, size_t w_size, const uint8_t *msk, size_t msk_size,
+                       const uint8_t *s, size_t s_size,
+                       bn_t kw, g1_t pi_p) {
+    check_size(w_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+    check_size(msk_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+    check_size(s_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+
+    compute_kw(kw, w, w_size, msk, msk_size, s, s_size);
+
+    g1_mul_glv(pi_p, g1_gen, kw);
+}
+
+void pythia_compute_kw_batch(const uint8_t *const *w, const size_t *w_sizes, size_t n,
+                             const uint8_t *msk, size_t msk_size, const uint8_t *s, size_t s_size,
+                             bn_t *kw, g1_t *pi_p) {
+    for (size_t i = 0; i < n; i++)
+        check_size(w_sizes[i], DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+    check_size(msk_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+    check_size(s_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+
+    if (!n)
+        return;
+
+    compute_kw_batch(kw, w, w_sizes, n, msk, msk_size, s, s_size);
+
+    for (size_t i = 0; i < n; i++)
+        g1_mul_glv(pi_p[i], g1_gen, kw[i]);
+}
+
+void pythia_blind_factor(bn_t r, bn_t rInv) {
+    bn_t gcd; bn_null(gcd);
+
+    TRY {
+        bn_new(gcd);
+
+        random_bn_mod(r, NULL);
+        bn_gcd_ext(gcd, rInv, NULL, r, g1_ord);
+        if (bn_cmp_dig(gcd, (dig_t)1) != CMP_EQ) {
+            THROW(ERR_NO_VALID);
+        }
+
+        // Bezout coefficient may be negative, |rInv| < r, while blinding secrets are stored without sign
+        if (bn_sign(rInv) == BN_NEG)
+            bn_add(rInv, rInv, g1_ord);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(gcd);
+    }
+}
+
+void pythia_blind_with_factor(const uint8_t *m, size_t m_size, bn_t r, g1_t x) {
+    check_size(m_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+
+    g1_t g1; g1_null(g1);
+
+    TRY {
+        g1_new(g1);
+        hashG1(g1, m, m_size);
+
+        g1_mul_glv(x, g1, r);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(g1);
+    }
+}
+
+void pythia_blind(const uint8_t *m, size_t m_size, g1_t x, bn_t rInv) {
+    check_size(m_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+
+    bn_t r; bn_null(r);
+
+    TRY {
+        bn_new(r);
+
+        pythia_blind_factor(r, rInv);
+        pythia_blind_with_factor(m, m_size, r, x);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(r);
+    }
+}
+
+void pythia_blind_batch(const uint8_t *const *m, const size_t *m_sizes, size_t n, g1_t *x, bn_t *rInv) {
+    bn_t *r = NULL;
+
+    TRY {
+        r = bn_array_new(n);
+
+        for (size_t i = 0; i < n; i++) {
+            check_size(m_sizes[i], DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+            random_bn_mod(r[i], NULL);
+        }
+
+        bn_mod_inv_sim(rInv, r, n);
+
+        hashG1_batch(x, m, m_sizes, n);
+
+        for (size_t i = 0; i < n; i++) {
+            g1_mul_glv(x[i], x[i], r[i]);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_array_free(r, n);
+    }
+}
+
+void pythia_deblind(gt_t y, bn_t rInv, gt_t u) {
+    TRY {
+        gt_pow(u, y, rInv);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {}
+}
+
+void pythia_deblind_prepared(gt_t y, const pythia_exp_prep_t *rInv, gt_t u) {
+    TRY {
+        gt_pow_prep(u, y, rInv);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {}
+}
+
+void pythia_eval(g1_t x, const uint8_t *t, size_t t_size,
+                 bn_t kw, gt_t y, g2_t tTilde) {
+    check_size(t_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+
+    g1_t xKw; g1_null(xKw);
+
+    TRY {
+        hashG2(tTilde, t, t_size);
+
+        g1_new(xKw);
+        g1_mul_glv(xKw, x, kw);
+
+        pp_map_bls12(y, xKw, tTilde);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(xKw);
+    }
+}
+
+void pythia_eval_prepared(g1_t x, const uint8_t *t, size_t t_size,
+                          const pythia_scalar_prep_t *kw, gt_t y, g2_t tTilde) {
+    check_size(t_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+
+    g1_t xKw; g1_null(xKw);
+
+    TRY {
+        hashG2(tTilde, t, t_size);
+
+        g1_new(xKw);
+        g1_mul_prep(xKw, x, kw);
+
+        pp_map_bls12(y, xKw, tTilde);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(xKw);
+    }
+}
+
+void pythia_eval_batch(g1_t *x, const uint8_t *const *t, const size_t *t_sizes, size_t n,
+                       const pythia_scalar_prep_t *kw, gt_t *y, g2_t *tTilde) {
+    g1_t *xKw = NULL;
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            check_size(t_sizes[i], DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+        }
+
+        hashG2_batch(tTilde, t, t_sizes, n);
+
+        xKw = (g1_t *)calloc(n ? n : 1, sizeof(g1_t));
+        if (!xKw)
+            THROW(ERR_NO_MEMORY);
+
+        for (size_t i = 0; i < n; i++)
+            g1_null(xKw[i]);
+
+        for (size_t i = 0; i < n; i++) {
+            g1_new(xKw[i]);
+            g1_mul_prep(xKw[i], x[i], kw);
+        }
+
+        // Final exponentiations of all pairings share their inversions
+        pc_map_batch(y, xKw, tTilde, n);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        for (size_t i = 0; xKw && i < n; i++)
+            g1_free(xKw[i]);
+        free(xKw);
+    }
+}
+
+size_t pythia_prove_nonce(bn_t v, uint8_t *t1_bin, size_t t1_bin_size) {
+    g1_t t1; g1_null(t1);
+    size_t size = 0;
+
+    TRY {
+        do {
+            random_bn_mod(v, gt_ord);
+        } while (bn_is_zero(v));
+
+        g1_new(t1);
+        g1_mul_glv(t1, g1_gen, v);
+
+        size = (size_t)g1_size_bin(t1, 1);
+        if (size > t1_bin_size)
+            THROW(ERR_NO_BUFFER);
+
+        serialize_g1(t1_bin, size, t1);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(t1);
+    }
+
+    return size;
+}
+
+void pythia_prove(gt_t y, g1_t x, g2_t tTilde, bn_t kw,
+                  g1_t pi_p, bn_t pi_c, bn_t pi_u) {
+    bn_t v; bn_null(v);
+    uint8_t t1_bin[DEF_PYTHIA_G1_BUF_SIZE];
+
+    TRY {
+        bn_new(v);
+
+        size_t t1_bin_size = pythia_prove_nonce(v, t1_bin, sizeof(t1_bin));
+
+        pythia_prove_with_nonce(y, x, tTilde, kw, pi_p, v, t1_bin, t1_bin_size, pi_c, pi_u);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
     }
     FINALLY {
-        bn_free(vscpkw);
-        bn_free(cpkw);
+        bn_free(v);
+    }
+}
+
+void pythia_prove_with_nonce(gt_t y, g1_t x, g2_t tTilde, bn_t kw, g1_t pi_p,
+                             bn_t v, const uint8_t *t1_bin, size_t t1_bin_size, bn_t pi_c, bn_t pi_u) {
+    gt_t beta; gt_null(beta);
+    gt_t t2; gt_null(t2);
+
+    uint8_t *q_bin = NULL, *p_bin = NULL, *beta_bin = NULL, *y_bin = NULL, *t2_bin = NULL;
+
+    TRY {
+        gt_new(beta);
+        pp_map_bls12(beta, x, tTilde);
+
+        gt_new(t2);
+        gt_pow(t2, beta, v);
+
+        size_t q_bin_size = (size_t)g1_size_bin(g1_gen, 1);
+        q_bin = calloc((size_t) q_bin_size, sizeof(uint8_t));
+        serialize_g1(q_bin, q_bin_size, g1_gen);
+
+        size_t p_bin_size = (size_t)g1_size_bin(pi_p, 1);
+        p_bin = calloc((size_t) p_bin_size, sizeof(uint8_t));
+        serialize_g1(p_bin, p_bin_size, pi_p);
+
+        size_t beta_bin_size = (size_t)gt_size_bin(beta, 1);
+        beta_bin = calloc((size_t) beta_bin_size, sizeof(uint8_t));
+        serialize_gt(beta_bin, beta_bin_size, beta);
+
+        size_t y_bin_size = (size_t)gt_size_bin(y, 1);
+        y_bin = calloc((size_t) y_bin_size, sizeof(uint8_t));
+        serialize_gt(y_bin, y_bin_size, y);
+
+        size_t t2_bin_size = (size_t)gt_size_bin(t2, 1);
+        t2_bin = calloc((size_t) t2_bin_size, sizeof(uint8_t));
+        serialize_gt(t2_bin, t2_bin_size, t2);
+
+        const uint8_t *const args[6] = {q_bin, p_bin, beta_bin, y_bin, t1_bin, t2_bin};
+        const size_t args_sizes[6] = {q_bin_size, p_bin_size, beta_bin_size, y_bin_size, t1_bin_size, t2_bin_size};
+        hashZ(pi_c, args, 6, args_sizes);
 
+        // u = v - c * kw mod r
+        pythia_sc_t s_v, s_c, s_kw;
+        sc_read_bn(&s_v, v);
+        sc_read_bn(&s_c, pi_c);
+        sc_read_bn(&s_kw, kw);
+        sc_mul(&s_c, &s_c, &s_kw);
+        sc_sub(&s_v, &s_v, &s_c);
+        sc_write_bn(pi_u, &s_v);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
         free(t2_bin);
-        free(t1_bin);
         free(y_bin);
         free(beta_bin);
         free(p_bin);
         free(q_bin);
 
         gt_free(t2);
-        g1_free(t1);
-        bn_free(v);
         gt_free(beta);
     }
 }
 
+/*
+ * Serializes transcript q, p, beta, y, t1, t2 hashed by verifier into args, given beta = e(x, tTilde),
+ * yc = y^c and betau = beta^u. Buffers are allocated here and should be freed by caller, also on failure.
+ */
+static void verify_transcript(uint8_t **args, size_t *args_sizes, gt_t y, gt_t beta, gt_t yc, gt_t betau,
+                              g1_t pi_p, bn_t pi_c, bn_t pi_u) {
+    g1_t pc; g1_null(pc);
+    g1_t qu; g1_null(qu);
+    g1_t t1; g1_null(t1);
+    gt_t t2; gt_null(t2);
+
+    TRY {
+        g1_new(pc);
+
+        g1_mul_glv(pc, pi_p, pi_c);
+
+        g1_new(qu);
+        g1_mul_glv(qu, g1_gen, pi_u);
+
+        g1_new(t1);
+        g1_add(t1, qu, pc);
+
+        gt_new(t2);
+        gt_mul(t2, betau, yc);
+
+        args_sizes[0] = (size_t)g1_size_bin(g1_gen, 1);
+        args[0] = calloc(args_sizes[0], sizeof(uint8_t));
+        serialize_g1(args[0], args_sizes[0], g1_gen);
+
+        args_sizes[1] = (size_t)g1_size_bin(pi_p, 1);
+        args[1] = calloc(args_sizes[1], sizeof(uint8_t));
+        serialize_g1(args[1], args_sizes[1], pi_p);
+
+        args_sizes[2] = (size_t)gt_size_bin(beta, 1);
+        args[2] = calloc(args_sizes[2], sizeof(uint8_t));
+        serialize_gt(args[2], args_sizes[2], beta);
+
+        args_sizes[3] = (size_t)gt_size_bin(y, 1);
+        args[3] = calloc(args_sizes[3], sizeof(uint8_t));
+        serialize_gt(args[3], args_sizes[3], y);
+
+        args_sizes[4] = (size_t)g1_size_bin(t1, 1);
+        args[4] = calloc(args_sizes[4], sizeof(uint8_t));
+        serialize_g1(args[4], args_sizes[4], t1);
+
+        args_sizes[5] = (size_t)gt_size_bin(t2, 1);
+        args[5] = calloc(args_sizes[5], sizeof(uint8_t));
+        serialize_gt(args[5], args_sizes[5], t2);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        gt_free(t2);
+        g1_free(t1);
+        g1_free(qu);
+        g1_free(pc);
+    }
+}
+
 void pythia_verify(gt_t y, g1_t x, const uint8_t *t, size_t t_size,
                    g1_t pi_p, bn_t pi_c, bn_t pi_u, int *verified) {
     check_size(t_size, DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
 
     g2_t tTilde; g2_null(tTilde);
     gt_t beta; gt_null(beta);
-    g1_t pc; g1_null(pc);
-    g1_t qu; g1_null(qu);
-    g1_t t1; g1_null(t1);
     gt_t yc; gt_null(yc);
     gt_t betau; gt_null(betau);
-    gt_t t2; gt_null(t2);
 
-    uint8_t *q_bin = NULL, *p_bin = NULL, *beta_bin = NULL, *y_bin = NULL, *t1_bin = NULL, *t2_bin = NULL;
+    uint8_t *args[6] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    size_t args_sizes[6];
 
     bn_t cPrime; bn_null(cPrime);
 
@@ -393,17 +1446,7 @@ void pythia_verify(gt_t y, g1_t x, const uint8_t *t, size_t t_size,
         hashG2(tTilde, t, t_size);
 
         gt_new(beta);
-        pc_map(beta, x, tTilde);
-
-        g1_new(pc);
-
-        scalar_mul_g1(pc, pi_p, pi_c);
-
-        g1_new(qu);
-        scalar_mul_g1(qu, g1_gen, pi_u);
-
-        g1_new(t1);
-        g1_add(t1, qu, pc);
+        pp_map_bls12(beta, x, tTilde);
 
         gt_new(yc);
         gt_pow(yc, y, pi_c);
@@ -411,39 +1454,10 @@ void pythia_verify(gt_t y, g1_t x, const uint8_t *t, size_t t_size,
         gt_new(betau);
         gt_pow(betau, beta, pi_u);
 
-        gt_new(t2);
-        gt_mul(t2, betau, yc);
-
-        size_t q_bin_size = (size_t)g1_size_bin(g1_gen, 1);
-        q_bin = calloc((size_t) q_bin_size, sizeof(uint8_t));
-        serialize_g1(q_bin, q_bin_size, g1_gen);
-
-        size_t p_bin_size = (size_t)g1_size_bin(pi_p, 1);
-        p_bin = calloc((size_t) p_bin_size, sizeof(uint8_t));
-        serialize_g1(p_bin, p_bin_size, pi_p);
-
-        size_t beta_bin_size = (size_t)gt_size_bin(beta, 1);
-        beta_bin = calloc((size_t) beta_bin_size, sizeof(uint8_t));
-        serialize_gt(beta_bin, beta_bin_size, beta);
-
-        size_t y_bin_size = (size_t)gt_size_bin(y, 1);
-        y_bin = calloc((size_t) y_bin_size, sizeof(uint8_t));
-        serialize_gt(y_bin, y_bin_size, y);
-
-        size_t t1_bin_size = (size_t)g1_size_bin(t1, 1);
-        t1_bin = calloc((size_t) t1_bin_size, sizeof(uint8_t));
-        serialize_g1(t1_bin, t1_bin_size, t1);
-
-        size_t t2_bin_size = (size_t)gt_size_bin(t2, 1);
-        t2_bin = calloc((size_t) t2_bin_size, sizeof(uint8_t));
-        serialize_gt(t2_bin, t2_bin_size, t2);
-
-        const uint8_t *const args[6] = {q_bin, p_bin, beta_bin, y_bin, t1_bin, t2_bin};
-        const size_t args_sizes[6] = {q_bin_size, p_bin_size, beta_bin_size, y_bin_size, t1_bin_size,
-                                   t2_bin_size};
+        verify_transcript(args, args_sizes, y, beta, yc, betau, pi_p, pi_c, pi_u);
 
         bn_new(cPrime);
-        hashZ(cPrime, args, 6, args_sizes);
+        hashZ(cPrime, (const uint8_t *const *)args, 6, args_sizes);
 
         *verified = bn_cmp(cPrime, pi_c) == CMP_EQ;
     }
@@ -453,50 +1467,145 @@ void pythia_verify(gt_t y, g1_t x, const uint8_t *t, size_t t_size,
     FINALLY {
         bn_free(cPrime)
 
-        free(q_bin);
-        free(p_bin);
-        free(beta_bin);
-        free(y_bin);
-        free(t1_bin);
-        free(t2_bin);
+        for (size_t i = 0; i < 6; i++)
+            free(args[i]);
 
-        gt_free(t2);
         gt_free(betau);
         gt_free(yc);
-        g1_free(t1);
-        g1_free(qu);
-        g1_free(pc);
         gt_free(beta);
         g2_free(tTilde);
     }
 }
 
-void get_delta(bn_t kw0, bn_t kw1, bn_t delta) {
-    bn_t kw0Inv; bn_null(kw0Inv);
-    bn_t gcd; bn_null(gcd);
-    bn_t kw1kw0Inv; bn_null(kw1kw0Inv);
+void pythia_verify_batch(gt_t *y, g1_t *x, const uint8_t *const *t, const size_t *t_sizes, size_t n,
+                         g1_t pi_p, bn_t *pi_c, bn_t *pi_u, int *verified) {
+    for (size_t i = 0; i < n; i++)
+        check_size(t_sizes[i], DEF_PYTHIA_BIN_MIN_BUF_SIZE, DEF_PYTHIA_BIN_MAX_BUF_SIZE);
+
+    if (!n)
+        return;
+
+    g2_t *tTilde = NULL;
+    gt_t *beta = NULL;
+    gt_t *yc = NULL;
+    gt_t *betau = NULL;
+    bn_t *cPrime = NULL;
+    uint8_t **args = NULL;
+    size_t *args_sizes = NULL;
 
     TRY {
-        bn_new(kw0Inv);
-        bn_new(gcd);
+        tTilde = (g2_t *)calloc(n, sizeof(g2_t));
+        beta = (gt_t *)calloc(n, sizeof(gt_t));
+        yc = (gt_t *)calloc(n, sizeof(gt_t));
+        betau = (gt_t *)calloc(n, sizeof(gt_t));
+        cPrime = (bn_t *)calloc(n, sizeof(bn_t));
+        args = (uint8_t **)calloc(6 * n, sizeof(uint8_t *));
+        args_sizes = (size_t *)calloc(6 * n, sizeof(size_t));
+
+        if (!tTilde || !beta || !yc || !betau || !cPrime || !args || !args_sizes)
+            THROW(ERR_NO_MEMORY);
+
+        for (size_t i = 0; i < n; i++) {
+            g2_null(tTilde[i]);
+            gt_null(beta[i]);
+            gt_null(yc[i]);
+            gt_null(betau[i]);
+            bn_null(cPrime[i]);
+        }
 
-        bn_gcd_ext(gcd, kw0Inv, NULL, kw0, gt_ord);
-        if (bn_cmp_dig(gcd, (dig_t)1) != CMP_EQ) {
-            THROW(ERR_NO_VALID);
+        for (size_t i = 0; i < n; i++) {
+            g2_new(tTilde[i]);
+            gt_new(beta[i]);
+            gt_new(yc[i]);
+            gt_new(betau[i]);
+            bn_new(cPrime[i]);
         }
 
-        bn_new(kw1kw0Inv);
-        bn_mul(kw1kw0Inv, kw1, kw0Inv);
+        hashG2_batch(tTilde, t, t_sizes, n);
+
+        pc_map_batch(beta, x, tTilde, n);
+
+        gt_pow_batch(yc, y, pi_c, n);
+        gt_pow_batch(betau, beta, pi_u, n);
+
+        for (size_t i = 0; i < n; i++)
+            verify_transcript(args + 6 * i, args_sizes + 6 * i, y[i], beta[i], yc[i], betau[i],
+                              pi_p, pi_c[i], pi_u[i]);
 
-        bn_mod(delta, kw1kw0Inv, gt_ord);
+        hashZ_batch(cPrime, (const uint8_t *const *)args, 6, args_sizes, n);
+
+        for (size_t i = 0; i < n; i++)
+            verified[i] = bn_cmp(cPrime[i], pi_c[i]) == CMP_EQ;
     }
     CATCH_ANY {
         THROW(ERR_CAUGHT);
     }
     FINALLY {
-        bn_free(kw1kw0Inv);
-        bn_free(gcd);
-        bn_free(kw0Inv);
+        if (args) {
+            for (size_t i = 0; i < 6 * n; i++)
+                free(args[i]);
+        }
+
+        for (size_t i = 0; tTilde && beta && yc && betau && cPrime && i < n; i++) {
+            bn_free(cPrime[i]);
+            gt_free(betau[i]);
+            gt_free(yc[i]);
+            gt_free(beta[i]);
+            g2_free(tTilde[i]);
+        }
+
+        free(args_sizes);
+        free(args);
+        free(cPrime);
+        free(betau);
+        free(yc);
+        free(beta);
+        free(tTilde);
+    }
+}
+
+void get_delta(bn_t kw0, bn_t kw1, bn_t delta) {
+    pythia_sc_t s0, s1;
+
+    sc_read_bn(&s0, kw0);
+    if (sc_is_zero(&s0))
+        THROW(ERR_NO_VALID);
+
+    sc_read_bn(&s1, kw1);
+    sc_inv(&s0, &s0);
+    sc_mul(&s1, &s1, &s0);
+    sc_write_bn(delta, &s1);
+}
+
+void pythia_get_delta_batch(bn_t *kw0, bn_t *kw1, size_t n, bn_t *delta) {
+    if (!n)
+        return;
+
+    pythia_sc_t *s = (pythia_sc_t *)malloc(n * sizeof(pythia_sc_t));
+    if (!s)
+        THROW(ERR_NO_MEMORY);
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            sc_read_bn(&s[i], kw0[i]);
+            if (sc_is_zero(&s[i]))
+                THROW(ERR_NO_VALID);
+        }
+
+        sc_inv_sim(s, s, n);
+
+        for (size_t i = 0; i < n; i++) {
+            pythia_sc_t s1;
+            sc_read_bn(&s1, kw1[i]);
+            sc_mul(&s1, &s1, &s[i]);
+            sc_write_bn(delta[i], &s1);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        free(s);
     }
 }
 
@@ -509,3 +1618,178 @@ void pythia_update_with_delta(gt_t u0, bn_t delta, gt_t u1) {
     }
     FINALLY {}
 }
+
+void pythia_update_with_delta_batch(gt_t *u0, bn_t delta, size_t n, gt_t *u1) {
+    bn_t *e = NULL;
+
+    TRY {
+        e = (bn_t *)calloc(n ? n : 1, sizeof(bn_t));
+        if (!e)
+            THROW(ERR_NO_MEMORY);
+
+        for (size_t i = 0; i < n; i++)
+            bn_null(e[i]);
+
+        for (size_t i = 0; i < n; i++) {
+            bn_new(e[i]);
+            bn_mod(e[i], delta, gt_ord);
+        }
+
+        gt_exp_batch(u1, u0, e, n);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        for (size_t i = 0; e && i < n; i++)
+            bn_free(e[i]);
+        free(e);
+    }
+}
+
+void pythia_update_with_delta_gt_batch(const pythia_gt_batch_t *u0, bn_t delta, pythia_gt_batch_t *u1) {
+    const size_t n = u0->r.count;
+    bn_t *e = NULL;
+
+    TRY {
+        e = (bn_t *)calloc(n ? n : 1, sizeof(bn_t));
+        if (!e)
+            THROW(ERR_NO_MEMORY);
+
+        for (size_t i = 0; i < n; i++)
+            bn_null(e[i]);
+
+        for (size_t i = 0; i < n; i++) {
+            bn_new(e[i]);
+            bn_mod(e[i], delta, gt_ord);
+        }
+
+        gt_batch_exp(u1, u0, e);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        for (size_t i = 0; e && i < n; i++)
+            bn_free(e[i]);
+        free(e);
+    }
+}
+
+void pythia_exp_prepare(pythia_exp_prep_t *prep, bn_t exp) {
+    bn_t e; bn_null(e);
+    bn_t z; bn_null(z);
+    bn_t q; bn_null(q);
+    bn_t d; bn_null(d);
+
+    TRY {
+        bn_new(e);
+        bn_new(z);
+        bn_new(q);
+        bn_new(d);
+
+        memset(prep, 0, sizeof(pythia_exp_prep_t));
+
+        bn_mod(e, exp, gt_ord);
+
+        // GT has order r = z^4 - z^2 + 1, where z is the curve parameter, and Frobenius acts on GT
+        // as exponentiation to p = z (mod r). So g^e = g^e0 * frb(g)^e1 * frb^2(g)^e2 * frb^3(g)^e3
+        // for e = e0 + e1 z + e2 z^2 + e3 z^3, which needs 4 times less squarings.
+        fp_param_get_var(z);
+        bn_sqr(q, z);
+        bn_sqr(d, q);
+        bn_sub(d, d, q);
+        bn_add_dig(d, d, 1);
+
+        if (bn_cmp(d, gt_ord) == CMP_EQ) {
+            int negative = bn_sign(z) == BN_NEG;
+            bn_abs(z, z);
+
+            prep->parts = PYTHIA_EXP_PREP_PARTS;
+            prep->len = PYTHIA_PREP_NAF_CAP / PYTHIA_EXP_PREP_PARTS;
+
+            for (int i = 0; i < prep->parts; i++) {
+                bn_div_rem(q, d, e, z);
+                bn_copy(e, q);
+
+                // |z|^i = (-1)^i * z^i
+                recode_part(prep->naf + i * prep->len, prep->len, d, PYTHIA_EXP_PREP_WIN, negative && (i & 1));
+            }
+
+            if (!bn_is_zero(e))
+                THROW(ERR_NO_VALID);
+        }
+        else {
+            prep->parts = 1;
+            prep->len = PYTHIA_PREP_NAF_CAP;
+
+            recode_part(prep->naf, prep->len, e, PYTHIA_EXP_PREP_WIN, 0);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(d);
+        bn_free(q);
+        bn_free(z);
+        bn_free(e);
+    }
+}
+
+void pythia_scalar_prepare(pythia_scalar_prep_t *prep, bn_t k) {
+    bn_t e; bn_null(e);
+    bn_t b; bn_null(b);
+    bn_t q; bn_null(q);
+    bn_t d; bn_null(d);
+
+    TRY {
+        bn_new(e);
+        bn_new(b);
+        bn_new(q);
+        bn_new(d);
+
+        memset(prep, 0, sizeof(pythia_scalar_prep_t));
+
+        bn_mod(e, k, g1_ord);
+
+        if (g1_endom_sign) {
+            prep->parts = PYTHIA_SCALAR_PREP_PARTS;
+            prep->len = PYTHIA_PREP_NAF_CAP / PYTHIA_SCALAR_PREP_PARTS;
+
+            // e = e0 + e1 * b, where b = z^2 - 1 for sign 1 and b = z^2 for sign -1
+            bn_sqr(b, curve_z);
+            if (g1_endom_sign > 0)
+                bn_sub_dig(b, b, 1);
+            bn_div_rem(q, d, e, b);
+
+            recode_part(prep->naf, prep->len, d, PYTHIA_SCALAR_PREP_WIN, 0);
+            recode_part(prep->naf + prep->len, prep->len, q, PYTHIA_SCALAR_PREP_WIN, g1_endom_sign < 0);
+        }
+        else {
+            prep->parts = 1;
+            prep->len = PYTHIA_PREP_NAF_CAP;
+
+            recode_part(prep->naf, prep->len, e, PYTHIA_SCALAR_PREP_WIN, 0);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(d);
+        bn_free(q);
+        bn_free(b);
+        bn_free(e);
+    }
+}
+
+void pythia_update_with_prepared_delta(gt_t u0, const pythia_exp_prep_t *delta, gt_t u1) {
+    TRY {
+        gt_pow_prep(u1, u0, delta);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {}
+}
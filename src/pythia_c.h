@@ -20,11 +20,41 @@
 
 #include <stdint.h>
 #include <relic/relic.h>
+#include "pythia_batch.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/// Capacity of a prepared scalar recoding (enough to hold an unsplit scalar too)
+#define PYTHIA_PREP_NAF_CAP (8 * FP_BYTES + 1)
+
+/// Maximum number of Frobenius-split parts of a prepared exponent
+#define PYTHIA_EXP_PREP_PARTS 4
+
+/// Window width used to recode parts of a prepared exponent
+#define PYTHIA_EXP_PREP_WIN 4
+
+/// GT exponent prepared once for many exponentiations (reduced, split along Frobenius and recoded)
+typedef struct pythia_exp_prep {
+    int parts;                               /// Number of parts exponent was split into
+    int len;                                 /// Number of digits in each part
+    int8_t naf[PYTHIA_PREP_NAF_CAP];         /// Signed digits of part i are stored at naf[i * len]
+} pythia_exp_prep_t;
+
+/// Maximum number of GLV parts of a prepared G1 scalar
+#define PYTHIA_SCALAR_PREP_PARTS 2
+
+/// Window width used to recode parts of a prepared G1 scalar
+#define PYTHIA_SCALAR_PREP_WIN 5
+
+/// G1 scalar prepared once for many multiplications (reduced, GLV-split and recoded)
+typedef struct pythia_scalar_prep {
+    int parts;                               /// Number of parts scalar was split into
+    int len;                                 /// Number of digits in each part
+    int8_t naf[PYTHIA_PREP_NAF_CAP];         /// Signed digits of part i are stored at naf[i * len]
+} pythia_scalar_prep_t;
+
 /// Blinds password. Turns password into a pseudo-random string. This step is necessary to prevent 3rd-parties from knowledge of end user's password.
 /// \param [in] m end user's password.
 /// \param [in] m_size password size.
@@ -32,12 +62,40 @@ extern "C" {
 /// \param [out] rInv random value used to blind user's password.
 void pythia_blind(const uint8_t *m, size_t m_size, g1_t x, bn_t rInv);
 
+/// Blinds n passwords at once. Blinding factors are inverted together, so that n inversions cost one inversion
+/// and about 3n multiplications. With PYTHIA_HASH_MODE_SSWU passwords are also hashed together, sharing inversions.
+/// \param [in] m array of n end user's passwords.
+/// \param [in] m_sizes array of n password sizes.
+/// \param [in] n number of passwords.
+/// \param [out] x array of n passwords obfuscated into a pseudo-random string.
+/// \param [out] rInv array of n random values used to blind user's passwords.
+void pythia_blind_batch(const uint8_t *const *m, const size_t *m_sizes, size_t n, g1_t *x, bn_t *rInv);
+
+/// Generates blinding factor used by pythia_blind. Factor does not depend on password, so it can be precomputed.
+/// \param [out] r random value used to blind user's password.
+/// \param [out] rInv inverse of r, used to deblind transformed password.
+void pythia_blind_factor(bn_t r, bn_t rInv);
+
+/// Blinds password with blinding factor previously generated by pythia_blind_factor.
+/// \param [in] m end user's password.
+/// \param [in] m_size password size.
+/// \param [in] r random value from pythia_blind_factor.
+/// \param [out] x password obfuscated into a pseudo-random string.
+void pythia_blind_with_factor(const uint8_t *m, size_t m_size, bn_t r, g1_t x);
+
 /// Deblinds transformed_password value with previously returned blinding_secret from pythia_blind.
 /// \param [in] y transformed password from pythia_transform.
 /// \param [in] rInv value that was generated in pythia_blind.
 /// \param [out] u deblinded transformed_password value. This value is not equal to password and is zero-knowledge protected.
 void pythia_deblind(gt_t y, bn_t rInv, gt_t u);
 
+/// Deblinds transformed_password value with blinding secret prepared by pythia_exp_prepare.
+/// Use it when many values are deblinded with the same rInv.
+/// \param [in] y transformed password from pythia_transform.
+/// \param [in] rInv prepared value that was generated in pythia_blind.
+/// \param [out] u deblinded transformed_password value.
+void pythia_deblind_prepared(gt_t y, const pythia_exp_prep_t *rInv, gt_t u);
+
 /// Computes transformation private/public key pair
 /// \param [in] w ensemble key ID used to enclose operations in subsets.
 /// \param [in] w_size transformation_key_id size.
@@ -51,6 +109,21 @@ void pythia_compute_kw(const uint8_t *w, size_t w_size, const uint8_t *msk, size
                        const uint8_t *s, size_t s_size,
                        bn_t kw, g1_t pi_p);
 
+/// Computes n transformation key pairs sharing pythia_secret and pythia_scope_secret, e.g. to warm up key ring.
+/// HMACs of all key IDs are computed together by multi-buffer SHA-384.
+/// \param [in] w array of n transformation key IDs
+/// \param [in] w_sizes array of n transformation key ID sizes
+/// \param [in] n number of key IDs
+/// \param [in] msk global common for all secret random Key.
+/// \param [in] msk_size pythia_secret size.
+/// \param [in] s ensemble secret generated and versioned transparently.
+/// \param [in] s_size pythia_scope_secret size
+/// \param [out] kw array of n transformation private keys.
+/// \param [out] pi_p array of n transformation public keys.
+void pythia_compute_kw_batch(const uint8_t *const *w, const size_t *w_sizes, size_t n,
+                             const uint8_t *msk, size_t msk_size, const uint8_t *s, size_t s_size,
+                             bn_t *kw, g1_t *pi_p);
+
 /// Transforms blinded password using transformation private key.
 /// \param [in] x password obfuscated into a pseudo-random string.
 /// \param [in] t tweak, some random value used to identify user
@@ -60,6 +133,28 @@ void pythia_compute_kw(const uint8_t *w, size_t w_size, const uint8_t *msk, size
 /// \param [out] tTilde tweak value turned into an elliptic curve point. This value is used by Prove() operation.
 void pythia_eval(g1_t x, const uint8_t *t, size_t t_size, bn_t kw, gt_t y, g2_t tTilde);
 
+/// Transforms blinded password using transformation private key prepared by pythia_scalar_prepare.
+/// Results are equal to pythia_eval.
+/// \param [in] x password obfuscated into a pseudo-random string.
+/// \param [in] t tweak, some random value used to identify user
+/// \param [in] t_size tweak size
+/// \param [in] kw prepared transformation private key.
+/// \param [out] y blinded password, protected using server secret (transformation private key + tweak).
+/// \param [out] tTilde tweak value turned into an elliptic curve point. This value is used by Prove() operation.
+void pythia_eval_prepared(g1_t x, const uint8_t *t, size_t t_size, const pythia_scalar_prep_t *kw, gt_t y, g2_t tTilde);
+
+/// Transforms n blinded passwords using the same prepared transformation private key.
+/// With PYTHIA_HASH_MODE_SSWU tweaks are hashed together, sharing field inversions.
+/// \param [in] x array of n passwords obfuscated into a pseudo-random string.
+/// \param [in] t array of n tweaks
+/// \param [in] t_sizes array of n tweak sizes
+/// \param [in] n number of passwords
+/// \param [in] kw prepared transformation private key.
+/// \param [out] y array of n transformed passwords.
+/// \param [out] tTilde array of n transformed tweaks.
+void pythia_eval_batch(g1_t *x, const uint8_t *const *t, const size_t *t_sizes, size_t n,
+                       const pythia_scalar_prep_t *kw, gt_t *y, g2_t *tTilde);
+
 /// Generates proof that server possesses secret values that were used to transform password.
 /// \param [in] y transformed password from pythia_transform
 /// \param [in] x blinded password from pythia_blind.
@@ -70,6 +165,28 @@ void pythia_eval(g1_t x, const uint8_t *t, size_t t_size, bn_t kw, gt_t y, g2_t
 /// \param [out] pi_u second part of proof that transformed+password was created using transformation_private_key.
 void pythia_prove(gt_t y, g1_t x, g2_t tTilde, bn_t kw, g1_t pi_p, bn_t pi_c, bn_t pi_u);
 
+/// Generates nonce used by pythia_prove. Nonce does not depend on request, so it can be precomputed.
+/// \param [out] v random nonce.
+/// \param [out] t1_bin serialized commitment v * G.
+/// \param [in] t1_bin_size t1_bin size, should be at least DEF_PYTHIA_G1_BUF_SIZE.
+/// \return size of serialized commitment.
+size_t pythia_prove_nonce(bn_t v, uint8_t *t1_bin, size_t t1_bin_size);
+
+/// Generates proof like pythia_prove does, but uses nonce previously generated by pythia_prove_nonce.
+/// Nonce must never be used twice.
+/// \param [in] y transformed password from pythia_transform
+/// \param [in] x blinded password from pythia_blind.
+/// \param [in] tTilde transformed tweak from pythia_transform.
+/// \param [in] kw transformation private key.
+/// \param [in] pi_p public key corresponding to kw.
+/// \param [in] v nonce from pythia_prove_nonce.
+/// \param [in] t1_bin serialized commitment from pythia_prove_nonce.
+/// \param [in] t1_bin_size serialized commitment size.
+/// \param [out] pi_c first part of proof that transformed+password was created using transformation_private_key.
+/// \param [out] pi_u second part of proof that transformed+password was created using transformation_private_key.
+void pythia_prove_with_nonce(gt_t y, g1_t x, g2_t tTilde, bn_t kw, g1_t pi_p,
+                             bn_t v, const uint8_t *t1_bin, size_t t1_bin_size, bn_t pi_c, bn_t pi_u);
+
 /// This operation allows client to verify that the output of pythia_transform is correct, assuming that client has previously stored transformation public key pi_p.
 /// \param [in] y transformed password from pythia_transform
 /// \param [in] x blinded password from pythia_blind.
@@ -81,18 +198,105 @@ void pythia_prove(gt_t y, g1_t x, g2_t tTilde, bn_t kw, g1_t pi_p, bn_t pi_c, bn
 /// \param [out] verified 0 if verification failed, not 0 - otherwise
 void pythia_verify(gt_t y, g1_t x, const uint8_t *t, size_t t_size, g1_t pi_p, bn_t pi_c, bn_t pi_u, int *verified);
 
+/// Verifies n transformations made with the same transformation public key. Tweaks are hashed to G2 together,
+/// exponentiations in GT run in lockstep on AVX-512 IFMA lanes and proof transcripts are hashed by multi-buffer SHA-384.
+/// \param [in] y array of n transformed passwords from pythia_transform
+/// \param [in] x array of n blinded passwords from pythia_blind.
+/// \param [in] t array of n tweaks
+/// \param [in] t_sizes array of n tweak sizes
+/// \param [in] n number of transformations
+/// \param [in] pi_p transformation public key
+/// \param [in] pi_c array of n proof values C from pythia_prove
+/// \param [in] pi_u array of n proof values U from pythia_prove
+/// \param [out] verified array of n results, 0 if verification failed, not 0 - otherwise
+void pythia_verify_batch(gt_t *y, g1_t *x, const uint8_t *const *t, const size_t *t_sizes, size_t n,
+                         g1_t pi_p, bn_t *pi_c, bn_t *pi_u, int *verified);
+
 /// Rotates old transformation key to new transformation key and generates a password_update_token that can update deblinded passwords. This action should increment version of the pythia_scope_secret.
 /// \param [in] kw0 previous transformation private key
 /// \param [in] kw1 new transformation private key
 /// \param [out] password_update_token value that allows to update all deblinded passwords (one by one) after server issued new pythia_secret or pythia_scope_secret.
 void get_delta(bn_t kw0, bn_t kw1, bn_t password_update_token);
 
+/// Computes password update tokens for n key rotations at once. Previous keys are inverted together,
+/// so that n inversions cost one inversion and about 3n multiplications.
+/// \param [in] kw0 array of n previous transformation private keys
+/// \param [in] kw1 array of n new transformation private keys
+/// \param [in] n number of keys
+/// \param [out] password_update_token array of n password update tokens.
+void pythia_get_delta_batch(bn_t *kw0, bn_t *kw1, size_t n, bn_t *password_update_token);
+
 /// Updates previously stored deblinded_password with password_update_token.
 /// \param [in] u0 previous deblinded password from pythia_deblind.
 /// \param [in] delta password update token
 /// \param [out] u1 new deblinded password.
 void pythia_update_with_delta(gt_t u0, bn_t delta, gt_t u1);
 
+/// Updates n deblinded passwords with the same password_update_token. Groups of 8 exponentiations run in lockstep
+/// on AVX-512 IFMA lanes if CPU supports them. Results are equal to pythia_update_with_delta.
+/// \param [in] u0 array of n previous deblinded passwords from pythia_deblind.
+/// \param [in] delta password update token
+/// \param [in] n number of deblinded passwords
+/// \param [out] u1 array of n new deblinded passwords.
+void pythia_update_with_delta_batch(gt_t *u0, bn_t delta, size_t n, gt_t *u1);
+
+/// Updates batch of deblinded passwords with the same password_update_token like pythia_update_with_delta_batch,
+/// but lanes are loaded straight from structure-of-arrays rows.
+/// \param [in] u0 batch of previous deblinded passwords.
+/// \param [in] delta password update token
+/// \param [out] u1 batch of new deblinded passwords with the same count, may be u0.
+void pythia_update_with_delta_gt_batch(const pythia_gt_batch_t *u0, bn_t delta, pythia_gt_batch_t *u1);
+
+/// Prepares exponent for repeated exponentiations in GT. Exponent is reduced, split into short parts
+/// using Frobenius endomorphism and recoded, so that each following exponentiation skips this work.
+/// \param [out] prep prepared exponent.
+/// \param [in] exp exponent, e.g. password update token or blinding secret.
+void pythia_exp_prepare(pythia_exp_prep_t *prep, bn_t exp);
+
+/// Prepares G1 scalar (e.g. transformation private key) for repeated multiplications. Scalar is reduced,
+/// split into two short parts using GLV endomorphism and recoded, so that each following multiplication skips this work.
+/// \param [out] prep prepared scalar.
+/// \param [in] k scalar.
+void pythia_scalar_prepare(pythia_scalar_prep_t *prep, bn_t k);
+
+/// Updates previously stored deblinded_password with prepared password_update_token.
+/// Results are equal to pythia_update_with_delta, but are faster to obtain when rotating many records.
+/// \param [in] u0 previous deblinded password from pythia_deblind.
+/// \param [in] delta password update token prepared by pythia_exp_prepare
+/// \param [out] u1 new deblinded password.
+void pythia_update_with_prepared_delta(gt_t u0, const pythia_exp_prep_t *delta, gt_t u1);
+
+/// Multiplies point of G1 by scalar with GLV method: k = k0 + k1 * lambda, where phi(P) = lambda * P,
+/// so that two half size scalars are processed at once with interleaved wNAF.
+/// Falls back to g1_mul if curve has no suitable endomorphism.
+/// \param [out] r result
+/// \param [in] p point in G1
+/// \param [in] k scalar
+void g1_mul_glv(g1_t r, g1_t p, bn_t k);
+
+/// Multiplies point of G2 by scalar with GLS method: k = k0 + k1 z + k2 z^2 + k3 z^3, where psi(P) = z * P,
+/// so that four quarter size scalars are processed at once with interleaved wNAF.
+/// Falls back to g2_mul if psi doesn't act as multiplication by z.
+/// \param [out] r result
+/// \param [in] p point in G2
+/// \param [in] k scalar
+void g2_mul_gls(g2_t r, g2_t p, bn_t k);
+
+/// Checks that point, which is already known to be on curve, belongs to G1
+/// \param [in] p point
+/// \return 1 if p is in G1, 0 otherwise
+int g1_is_member(g1_t p);
+
+/// Checks that point, which is already known to be on curve, belongs to G2
+/// \param [in] p point
+/// \return 1 if p is in G2, 0 otherwise
+int g2_is_member(g2_t p);
+
+/// Checks that element belongs to GT and is not unity
+/// \param [in] g element
+/// \return 1 if g is in GT, 0 otherwise
+int gt_is_member(gt_t g);
+
 #ifdef __cplusplus
 }
 #endif
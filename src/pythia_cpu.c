@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include "pythia_cpu.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CPU_X86 1
+#include <cpuid.h>
+#else
+#define CPU_X86 0
+#endif
+
+static unsigned int cpu_detected = 0;
+static unsigned int cpu_mask = PYTHIA_CPU_ALL;
+
+#if CPU_X86
+
+// Register state enabled by OS in XCR0
+#define XCR0_AVX (0x2u | 0x4u)
+#define XCR0_AVX512 (0x20u | 0x40u | 0x80u)
+
+static unsigned int xgetbv0(void) {
+    unsigned int lo, hi;
+
+    __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+
+    return lo;
+}
+
+static unsigned int cpu_detect(void) {
+    unsigned int eax, ebx, ecx, edx, ebx7;
+    unsigned int xcr0 = 0, features = 0;
+
+    if (__get_cpuid_max(0, NULL) < 7)
+        return 0;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    if (ecx & bit_OSXSAVE)
+        xcr0 = xgetbv0();
+
+    __cpuid_count(7, 0, eax, ebx7, ecx, edx);
+
+    if ((ebx7 & bit_BMI2) && (ebx7 & bit_ADX))
+        features |= PYTHIA_CPU_BMI2_ADX;
+
+    // Vector features are usable only if OS saves their registers on context switch
+    if ((xcr0 & XCR0_AVX) == XCR0_AVX && (ebx7 & bit_AVX2))
+        features |= PYTHIA_CPU_AVX2;
+
+    if ((xcr0 & (XCR0_AVX | XCR0_AVX512)) == (XCR0_AVX | XCR0_AVX512) && (ebx7 & bit_AVX512F)) {
+        features |= PYTHIA_CPU_AVX512F;
+        if (ebx7 & bit_AVX512IFMA)
+            features |= PYTHIA_CPU_AVX512IFMA;
+    }
+
+    return features;
+}
+
+#endif
+
+void cpu_init(void) {
+#if CPU_X86
+    cpu_detected = cpu_detect();
+#else
+    cpu_detected = 0;
+#endif
+}
+
+unsigned int cpu_features(void) {
+    return cpu_detected & cpu_mask;
+}
+
+void pythia_set_cpu_features_mask(unsigned int mask) {
+    cpu_mask = mask;
+}
+
+unsigned int pythia_get_cpu_features(void) {
+    return cpu_features();
+}
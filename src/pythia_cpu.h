@@ -0,0 +1,37 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_CPU_H
+#define PYTHIA_PYTHIA_CPU_H
+
+#include "pythia_init.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Detects CPU features, should be called once during initialization before kernels are selected
+void cpu_init(void);
+
+/// \return bitwise OR of pythia_cpu_feature_t values detected by cpu_init and allowed by the mask
+unsigned int cpu_features(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_CPU_H
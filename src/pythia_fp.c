@@ -0,0 +1,131 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <relic/relic.h>
+#include <relic/relic_err.h>
+#include "pythia_fp.h"
+#include "pythia_fp_asm.h"
+#include "pythia_fp_gen.h"
+
+// Relic's field functions are macros, so they are wrapped to be bound to pointers
+static void relic_fp_mul(fp_t c, const fp_t a, const fp_t b) {
+    fp_mul(c, a, b);
+}
+
+static void relic_fp_sqr(fp_t c, const fp_t a) {
+    fp_sqr(c, a);
+}
+
+static void relic_fp2_mul(fp2_t c, fp2_t a, fp2_t b) {
+    fp2_mul(c, a, b);
+}
+
+static void relic_fp2_sqr(fp2_t c, fp2_t a) {
+    fp2_sqr(c, a);
+}
+
+// Fermat's inversion, relic's fp_inv takes time that depends on the input
+static void fermat_fp_inv(fp_t c, const fp_t a) {
+    bn_t e; bn_null(e);
+
+    TRY {
+        bn_new(e);
+        bn_read_raw(e, fp_prime_get(), FP_DIGS);
+        bn_sub_dig(e, e, 2);
+        pythia_fp_exp(c, a, e);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(e);
+    }
+}
+
+// Backends are bound once, so that calls don't test which of them are enabled
+static void (*fp_mul_f)(fp_t c, const fp_t a, const fp_t b) = relic_fp_mul;
+static void (*fp_sqr_f)(fp_t c, const fp_t a) = relic_fp_sqr;
+static void (*fp_inv_f)(fp_t c, const fp_t a) = fermat_fp_inv;
+static void (*fp2_mul_f)(fp2_t c, fp2_t a, fp2_t b) = relic_fp2_mul;
+static void (*fp2_sqr_f)(fp2_t c, fp2_t a) = relic_fp2_sqr;
+
+void fp_bind(void) {
+    // Generated code covers all entry points, the assembly backend only multiplication and squaring
+    if (fp_gen_enabled()) {
+        fp_mul_f = fp_gen_mul;
+        fp_sqr_f = fp_gen_sqr;
+        fp_inv_f = fp_gen_inv;
+        fp2_mul_f = fp2_gen_mul;
+        fp2_sqr_f = fp2_gen_sqr;
+        return;
+    }
+
+    fp_mul_f = fp_asm_enabled() ? fp_asm_mul : relic_fp_mul;
+    fp_sqr_f = fp_asm_enabled() ? fp_asm_sqr : relic_fp_sqr;
+    fp_inv_f = fermat_fp_inv;
+    fp2_mul_f = relic_fp2_mul;
+    fp2_sqr_f = relic_fp2_sqr;
+}
+
+int fp_backend(void) {
+    if (fp_mul_f == fp_gen_mul)
+        return PYTHIA_FP_BACKEND_GEN;
+
+    return fp_mul_f == fp_asm_mul ? PYTHIA_FP_BACKEND_ASM : PYTHIA_FP_BACKEND_RELIC;
+}
+
+void pythia_fp_mul(fp_t c, const fp_t a, const fp_t b) {
+    fp_mul_f(c, a, b);
+}
+
+void pythia_fp_sqr(fp_t c, const fp_t a) {
+    fp_sqr_f(c, a);
+}
+
+void pythia_fp_inv(fp_t c, const fp_t a) {
+    fp_inv_f(c, a);
+}
+
+void pythia_fp2_mul(fp2_t c, fp2_t a, fp2_t b) {
+    fp2_mul_f(c, a, b);
+}
+
+void pythia_fp2_sqr(fp2_t c, fp2_t a) {
+    fp2_sqr_f(c, a);
+}
+
+void pythia_fp_exp(fp_t c, const fp_t a, bn_t e) {
+    fp_t t; fp_null(t);
+
+    TRY {
+        fp_new(t);
+        fp_copy(t, a);
+        fp_set_dig(c, 1);
+
+        for (int i = bn_bits(e) - 1; i >= 0; i--) {
+            fp_sqr_f(c, c);
+            if (bn_get_bit(e, i))
+                fp_mul_f(c, c, t);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp_free(t);
+    }
+}
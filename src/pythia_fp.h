@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_FP_H
+#define PYTHIA_PYTHIA_FP_H
+
+#include <relic/relic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Values returned by fp_backend
+#define PYTHIA_FP_BACKEND_RELIC 0   /// relic's own field arithmetic
+#define PYTHIA_FP_BACKEND_ASM 1     /// x86-64 assembly backend of pythia_fp_asm.c
+#define PYTHIA_FP_BACKEND_GEN 2     /// generated straight-line code of pythia_fp_gen.c
+
+/*
+ * Field arithmetic of pythia's own code: hash to curve maps and fallbacks of batch kernels.
+ * Calls are dispatched to the fastest enabled backend. Relic's field, extension field and pairing code
+ * keeps relic's arithmetic, pythia doesn't interpose on relic's functions.
+ */
+
+/// Binds entry points below to enabled backends. Backends call it after they are enabled or disabled.
+void fp_bind(void);
+
+/// \return PYTHIA_FP_BACKEND_* value entry points below are bound to
+int fp_backend(void);
+
+/// c = a * b
+void pythia_fp_mul(fp_t c, const fp_t a, const fp_t b);
+
+/// c = a^2
+void pythia_fp_sqr(fp_t c, const fp_t a);
+
+/// c = a^-1, or 0 if a is 0. Takes time independent of a with every backend.
+void pythia_fp_inv(fp_t c, const fp_t a);
+
+/// c = a * b in Fp2
+void pythia_fp2_mul(fp2_t c, fp2_t a, fp2_t b);
+
+/// c = a^2 in Fp2
+void pythia_fp2_sqr(fp2_t c, fp2_t a);
+
+/// c = a^e by square-and-multiply over pythia_fp_mul and pythia_fp_sqr, e is public
+void pythia_fp_exp(fp_t c, const fp_t a, bn_t e);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_FP_H
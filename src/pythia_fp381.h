@@ -0,0 +1,1909 @@
+/*
+ * Generated by tools/gen_fp381.py, do not edit.
+ *
+ * Montgomery arithmetic modulo the BLS12-381 base field prime
+ * p = 0x1a0111ea397fe69a4b1ba7b6434bacd764774b84f38512bf6730d2a0f6b0f6241eabfffeb153ffffb9feffffffffaaab
+ * with 6 words of 64 bits, R = 2^384.
+ */
+
+#ifndef PYTHIA_PYTHIA_FP381_H
+#define PYTHIA_PYTHIA_FP381_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Modulus the functions are specialized for
+static const uint64_t fiat_bls12_381_fp_modulus[6] = {UINT64_C(0xb9feffffffffaaab), UINT64_C(0x1eabfffeb153ffff), UINT64_C(0x6730d2a0f6b0f624), UINT64_C(0x64774b84f38512bf), UINT64_C(0x4b1ba7b6434bacd7), UINT64_C(0x1a0111ea397fe69a)};
+
+typedef unsigned char fiat_bls12_381_fp_uint1;
+typedef unsigned __int128 fiat_bls12_381_fp_uint128;
+
+// GCC doesn't recognize carry chains written with 128-bit additions, the intrinsics keep them in the flags
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+
+static void fiat_bls12_381_fp_addcarryx_u64(uint64_t *out1, fiat_bls12_381_fp_uint1 *out2, fiat_bls12_381_fp_uint1 arg1, uint64_t arg2,
+                                        uint64_t arg3) {
+    unsigned long long x1;
+    *out2 = _addcarry_u64(arg1, arg2, arg3, &x1);
+    *out1 = x1;
+}
+
+static void fiat_bls12_381_fp_subborrowx_u64(uint64_t *out1, fiat_bls12_381_fp_uint1 *out2, fiat_bls12_381_fp_uint1 arg1, uint64_t arg2,
+                                         uint64_t arg3) {
+    unsigned long long x1;
+    *out2 = _subborrow_u64(arg1, arg2, arg3, &x1);
+    *out1 = x1;
+}
+#else
+static void fiat_bls12_381_fp_addcarryx_u64(uint64_t *out1, fiat_bls12_381_fp_uint1 *out2, fiat_bls12_381_fp_uint1 arg1, uint64_t arg2,
+                                        uint64_t arg3) {
+    fiat_bls12_381_fp_uint128 x1 = ((fiat_bls12_381_fp_uint128)arg1 + arg2) + arg3;
+    *out1 = (uint64_t)x1;
+    *out2 = (fiat_bls12_381_fp_uint1)(x1 >> 64);
+}
+
+static void fiat_bls12_381_fp_subborrowx_u64(uint64_t *out1, fiat_bls12_381_fp_uint1 *out2, fiat_bls12_381_fp_uint1 arg1, uint64_t arg2,
+                                         uint64_t arg3) {
+    fiat_bls12_381_fp_uint128 x1 = ((fiat_bls12_381_fp_uint128)arg2 - arg1) - arg3;
+    *out1 = (uint64_t)x1;
+    *out2 = (fiat_bls12_381_fp_uint1)(0x0 - (uint64_t)(x1 >> 64));
+}
+#endif
+
+static void fiat_bls12_381_fp_mulx_u64(uint64_t *out1, uint64_t *out2, uint64_t arg1, uint64_t arg2) {
+    fiat_bls12_381_fp_uint128 x1 = (fiat_bls12_381_fp_uint128)arg1 * arg2;
+    *out1 = (uint64_t)x1;
+    *out2 = (uint64_t)(x1 >> 64);
+}
+
+// out1 = arg1 ? arg3 : arg2 without branches
+static void fiat_bls12_381_fp_cmovznz_u64(uint64_t *out1, fiat_bls12_381_fp_uint1 arg1, uint64_t arg2, uint64_t arg3) {
+    uint64_t x1 = 0x0 - (uint64_t)(!!arg1);
+    *out1 = (x1 & arg3) | (~x1 & arg2);
+}
+
+// out1 = arg1 * arg2 / R mod p
+static void fiat_bls12_381_fp_mul(uint64_t out1[6], const uint64_t arg1[6], const uint64_t arg2[6]) {
+    uint64_t x1;
+    uint64_t x2;
+    fiat_bls12_381_fp_mulx_u64(&x1, &x2, arg1[0], arg2[0]);
+    uint64_t x3;
+    uint64_t x4;
+    fiat_bls12_381_fp_mulx_u64(&x3, &x4, arg1[1], arg2[0]);
+    uint64_t x5;
+    uint64_t x6;
+    fiat_bls12_381_fp_mulx_u64(&x5, &x6, arg1[2], arg2[0]);
+    uint64_t x7;
+    uint64_t x8;
+    fiat_bls12_381_fp_mulx_u64(&x7, &x8, arg1[3], arg2[0]);
+    uint64_t x9;
+    uint64_t x10;
+    fiat_bls12_381_fp_mulx_u64(&x9, &x10, arg1[4], arg2[0]);
+    uint64_t x11;
+    uint64_t x12;
+    fiat_bls12_381_fp_mulx_u64(&x11, &x12, arg1[5], arg2[0]);
+    uint64_t x13;
+    fiat_bls12_381_fp_uint1 x14;
+    fiat_bls12_381_fp_addcarryx_u64(&x13, &x14, 0x0, x3, x2);
+    uint64_t x15;
+    fiat_bls12_381_fp_uint1 x16;
+    fiat_bls12_381_fp_addcarryx_u64(&x15, &x16, x14, x5, x4);
+    uint64_t x17;
+    fiat_bls12_381_fp_uint1 x18;
+    fiat_bls12_381_fp_addcarryx_u64(&x17, &x18, x16, x7, x6);
+    uint64_t x19;
+    fiat_bls12_381_fp_uint1 x20;
+    fiat_bls12_381_fp_addcarryx_u64(&x19, &x20, x18, x9, x8);
+    uint64_t x21;
+    fiat_bls12_381_fp_uint1 x22;
+    fiat_bls12_381_fp_addcarryx_u64(&x21, &x22, x20, x11, x10);
+    uint64_t x23;
+    fiat_bls12_381_fp_uint1 x24;
+    fiat_bls12_381_fp_addcarryx_u64(&x23, &x24, x22, x12, 0x0);
+    uint64_t x25;
+    x25 = x1 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x26;
+    uint64_t x27;
+    fiat_bls12_381_fp_mulx_u64(&x26, &x27, UINT64_C(0xb9feffffffffaaab), x25);
+    uint64_t x28;
+    uint64_t x29;
+    fiat_bls12_381_fp_mulx_u64(&x28, &x29, UINT64_C(0x1eabfffeb153ffff), x25);
+    uint64_t x30;
+    uint64_t x31;
+    fiat_bls12_381_fp_mulx_u64(&x30, &x31, UINT64_C(0x6730d2a0f6b0f624), x25);
+    uint64_t x32;
+    uint64_t x33;
+    fiat_bls12_381_fp_mulx_u64(&x32, &x33, UINT64_C(0x64774b84f38512bf), x25);
+    uint64_t x34;
+    uint64_t x35;
+    fiat_bls12_381_fp_mulx_u64(&x34, &x35, UINT64_C(0x4b1ba7b6434bacd7), x25);
+    uint64_t x36;
+    uint64_t x37;
+    fiat_bls12_381_fp_mulx_u64(&x36, &x37, UINT64_C(0x1a0111ea397fe69a), x25);
+    uint64_t x38;
+    fiat_bls12_381_fp_uint1 x39;
+    fiat_bls12_381_fp_addcarryx_u64(&x38, &x39, 0x0, x28, x27);
+    uint64_t x40;
+    fiat_bls12_381_fp_uint1 x41;
+    fiat_bls12_381_fp_addcarryx_u64(&x40, &x41, x39, x30, x29);
+    uint64_t x42;
+    fiat_bls12_381_fp_uint1 x43;
+    fiat_bls12_381_fp_addcarryx_u64(&x42, &x43, x41, x32, x31);
+    uint64_t x44;
+    fiat_bls12_381_fp_uint1 x45;
+    fiat_bls12_381_fp_addcarryx_u64(&x44, &x45, x43, x34, x33);
+    uint64_t x46;
+    fiat_bls12_381_fp_uint1 x47;
+    fiat_bls12_381_fp_addcarryx_u64(&x46, &x47, x45, x36, x35);
+    uint64_t x48;
+    fiat_bls12_381_fp_uint1 x49;
+    fiat_bls12_381_fp_addcarryx_u64(&x48, &x49, x47, x37, 0x0);
+    uint64_t x50;
+    fiat_bls12_381_fp_uint1 x51;
+    fiat_bls12_381_fp_addcarryx_u64(&x50, &x51, 0x0, x1, x26);
+    uint64_t x52;
+    fiat_bls12_381_fp_uint1 x53;
+    fiat_bls12_381_fp_addcarryx_u64(&x52, &x53, x51, x13, x38);
+    uint64_t x54;
+    fiat_bls12_381_fp_uint1 x55;
+    fiat_bls12_381_fp_addcarryx_u64(&x54, &x55, x53, x15, x40);
+    uint64_t x56;
+    fiat_bls12_381_fp_uint1 x57;
+    fiat_bls12_381_fp_addcarryx_u64(&x56, &x57, x55, x17, x42);
+    uint64_t x58;
+    fiat_bls12_381_fp_uint1 x59;
+    fiat_bls12_381_fp_addcarryx_u64(&x58, &x59, x57, x19, x44);
+    uint64_t x60;
+    fiat_bls12_381_fp_uint1 x61;
+    fiat_bls12_381_fp_addcarryx_u64(&x60, &x61, x59, x21, x46);
+    uint64_t x62;
+    fiat_bls12_381_fp_uint1 x63;
+    fiat_bls12_381_fp_addcarryx_u64(&x62, &x63, x61, x23, x48);
+    uint64_t x64;
+    fiat_bls12_381_fp_uint1 x65;
+    fiat_bls12_381_fp_addcarryx_u64(&x64, &x65, x63, 0x0, 0x0);
+    uint64_t x66;
+    uint64_t x67;
+    fiat_bls12_381_fp_mulx_u64(&x66, &x67, arg1[0], arg2[1]);
+    uint64_t x68;
+    uint64_t x69;
+    fiat_bls12_381_fp_mulx_u64(&x68, &x69, arg1[1], arg2[1]);
+    uint64_t x70;
+    uint64_t x71;
+    fiat_bls12_381_fp_mulx_u64(&x70, &x71, arg1[2], arg2[1]);
+    uint64_t x72;
+    uint64_t x73;
+    fiat_bls12_381_fp_mulx_u64(&x72, &x73, arg1[3], arg2[1]);
+    uint64_t x74;
+    uint64_t x75;
+    fiat_bls12_381_fp_mulx_u64(&x74, &x75, arg1[4], arg2[1]);
+    uint64_t x76;
+    uint64_t x77;
+    fiat_bls12_381_fp_mulx_u64(&x76, &x77, arg1[5], arg2[1]);
+    uint64_t x78;
+    fiat_bls12_381_fp_uint1 x79;
+    fiat_bls12_381_fp_addcarryx_u64(&x78, &x79, 0x0, x68, x67);
+    uint64_t x80;
+    fiat_bls12_381_fp_uint1 x81;
+    fiat_bls12_381_fp_addcarryx_u64(&x80, &x81, x79, x70, x69);
+    uint64_t x82;
+    fiat_bls12_381_fp_uint1 x83;
+    fiat_bls12_381_fp_addcarryx_u64(&x82, &x83, x81, x72, x71);
+    uint64_t x84;
+    fiat_bls12_381_fp_uint1 x85;
+    fiat_bls12_381_fp_addcarryx_u64(&x84, &x85, x83, x74, x73);
+    uint64_t x86;
+    fiat_bls12_381_fp_uint1 x87;
+    fiat_bls12_381_fp_addcarryx_u64(&x86, &x87, x85, x76, x75);
+    uint64_t x88;
+    fiat_bls12_381_fp_uint1 x89;
+    fiat_bls12_381_fp_addcarryx_u64(&x88, &x89, x87, x77, 0x0);
+    uint64_t x90;
+    fiat_bls12_381_fp_uint1 x91;
+    fiat_bls12_381_fp_addcarryx_u64(&x90, &x91, 0x0, x52, x66);
+    uint64_t x92;
+    fiat_bls12_381_fp_uint1 x93;
+    fiat_bls12_381_fp_addcarryx_u64(&x92, &x93, x91, x54, x78);
+    uint64_t x94;
+    fiat_bls12_381_fp_uint1 x95;
+    fiat_bls12_381_fp_addcarryx_u64(&x94, &x95, x93, x56, x80);
+    uint64_t x96;
+    fiat_bls12_381_fp_uint1 x97;
+    fiat_bls12_381_fp_addcarryx_u64(&x96, &x97, x95, x58, x82);
+    uint64_t x98;
+    fiat_bls12_381_fp_uint1 x99;
+    fiat_bls12_381_fp_addcarryx_u64(&x98, &x99, x97, x60, x84);
+    uint64_t x100;
+    fiat_bls12_381_fp_uint1 x101;
+    fiat_bls12_381_fp_addcarryx_u64(&x100, &x101, x99, x62, x86);
+    uint64_t x102;
+    fiat_bls12_381_fp_uint1 x103;
+    fiat_bls12_381_fp_addcarryx_u64(&x102, &x103, x101, x64, x88);
+    uint64_t x104;
+    x104 = x90 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x105;
+    uint64_t x106;
+    fiat_bls12_381_fp_mulx_u64(&x105, &x106, UINT64_C(0xb9feffffffffaaab), x104);
+    uint64_t x107;
+    uint64_t x108;
+    fiat_bls12_381_fp_mulx_u64(&x107, &x108, UINT64_C(0x1eabfffeb153ffff), x104);
+    uint64_t x109;
+    uint64_t x110;
+    fiat_bls12_381_fp_mulx_u64(&x109, &x110, UINT64_C(0x6730d2a0f6b0f624), x104);
+    uint64_t x111;
+    uint64_t x112;
+    fiat_bls12_381_fp_mulx_u64(&x111, &x112, UINT64_C(0x64774b84f38512bf), x104);
+    uint64_t x113;
+    uint64_t x114;
+    fiat_bls12_381_fp_mulx_u64(&x113, &x114, UINT64_C(0x4b1ba7b6434bacd7), x104);
+    uint64_t x115;
+    uint64_t x116;
+    fiat_bls12_381_fp_mulx_u64(&x115, &x116, UINT64_C(0x1a0111ea397fe69a), x104);
+    uint64_t x117;
+    fiat_bls12_381_fp_uint1 x118;
+    fiat_bls12_381_fp_addcarryx_u64(&x117, &x118, 0x0, x107, x106);
+    uint64_t x119;
+    fiat_bls12_381_fp_uint1 x120;
+    fiat_bls12_381_fp_addcarryx_u64(&x119, &x120, x118, x109, x108);
+    uint64_t x121;
+    fiat_bls12_381_fp_uint1 x122;
+    fiat_bls12_381_fp_addcarryx_u64(&x121, &x122, x120, x111, x110);
+    uint64_t x123;
+    fiat_bls12_381_fp_uint1 x124;
+    fiat_bls12_381_fp_addcarryx_u64(&x123, &x124, x122, x113, x112);
+    uint64_t x125;
+    fiat_bls12_381_fp_uint1 x126;
+    fiat_bls12_381_fp_addcarryx_u64(&x125, &x126, x124, x115, x114);
+    uint64_t x127;
+    fiat_bls12_381_fp_uint1 x128;
+    fiat_bls12_381_fp_addcarryx_u64(&x127, &x128, x126, x116, 0x0);
+    uint64_t x129;
+    fiat_bls12_381_fp_uint1 x130;
+    fiat_bls12_381_fp_addcarryx_u64(&x129, &x130, 0x0, x90, x105);
+    uint64_t x131;
+    fiat_bls12_381_fp_uint1 x132;
+    fiat_bls12_381_fp_addcarryx_u64(&x131, &x132, x130, x92, x117);
+    uint64_t x133;
+    fiat_bls12_381_fp_uint1 x134;
+    fiat_bls12_381_fp_addcarryx_u64(&x133, &x134, x132, x94, x119);
+    uint64_t x135;
+    fiat_bls12_381_fp_uint1 x136;
+    fiat_bls12_381_fp_addcarryx_u64(&x135, &x136, x134, x96, x121);
+    uint64_t x137;
+    fiat_bls12_381_fp_uint1 x138;
+    fiat_bls12_381_fp_addcarryx_u64(&x137, &x138, x136, x98, x123);
+    uint64_t x139;
+    fiat_bls12_381_fp_uint1 x140;
+    fiat_bls12_381_fp_addcarryx_u64(&x139, &x140, x138, x100, x125);
+    uint64_t x141;
+    fiat_bls12_381_fp_uint1 x142;
+    fiat_bls12_381_fp_addcarryx_u64(&x141, &x142, x140, x102, x127);
+    uint64_t x143;
+    fiat_bls12_381_fp_uint1 x144;
+    fiat_bls12_381_fp_addcarryx_u64(&x143, &x144, x142, x103, 0x0);
+    uint64_t x145;
+    uint64_t x146;
+    fiat_bls12_381_fp_mulx_u64(&x145, &x146, arg1[0], arg2[2]);
+    uint64_t x147;
+    uint64_t x148;
+    fiat_bls12_381_fp_mulx_u64(&x147, &x148, arg1[1], arg2[2]);
+    uint64_t x149;
+    uint64_t x150;
+    fiat_bls12_381_fp_mulx_u64(&x149, &x150, arg1[2], arg2[2]);
+    uint64_t x151;
+    uint64_t x152;
+    fiat_bls12_381_fp_mulx_u64(&x151, &x152, arg1[3], arg2[2]);
+    uint64_t x153;
+    uint64_t x154;
+    fiat_bls12_381_fp_mulx_u64(&x153, &x154, arg1[4], arg2[2]);
+    uint64_t x155;
+    uint64_t x156;
+    fiat_bls12_381_fp_mulx_u64(&x155, &x156, arg1[5], arg2[2]);
+    uint64_t x157;
+    fiat_bls12_381_fp_uint1 x158;
+    fiat_bls12_381_fp_addcarryx_u64(&x157, &x158, 0x0, x147, x146);
+    uint64_t x159;
+    fiat_bls12_381_fp_uint1 x160;
+    fiat_bls12_381_fp_addcarryx_u64(&x159, &x160, x158, x149, x148);
+    uint64_t x161;
+    fiat_bls12_381_fp_uint1 x162;
+    fiat_bls12_381_fp_addcarryx_u64(&x161, &x162, x160, x151, x150);
+    uint64_t x163;
+    fiat_bls12_381_fp_uint1 x164;
+    fiat_bls12_381_fp_addcarryx_u64(&x163, &x164, x162, x153, x152);
+    uint64_t x165;
+    fiat_bls12_381_fp_uint1 x166;
+    fiat_bls12_381_fp_addcarryx_u64(&x165, &x166, x164, x155, x154);
+    uint64_t x167;
+    fiat_bls12_381_fp_uint1 x168;
+    fiat_bls12_381_fp_addcarryx_u64(&x167, &x168, x166, x156, 0x0);
+    uint64_t x169;
+    fiat_bls12_381_fp_uint1 x170;
+    fiat_bls12_381_fp_addcarryx_u64(&x169, &x170, 0x0, x131, x145);
+    uint64_t x171;
+    fiat_bls12_381_fp_uint1 x172;
+    fiat_bls12_381_fp_addcarryx_u64(&x171, &x172, x170, x133, x157);
+    uint64_t x173;
+    fiat_bls12_381_fp_uint1 x174;
+    fiat_bls12_381_fp_addcarryx_u64(&x173, &x174, x172, x135, x159);
+    uint64_t x175;
+    fiat_bls12_381_fp_uint1 x176;
+    fiat_bls12_381_fp_addcarryx_u64(&x175, &x176, x174, x137, x161);
+    uint64_t x177;
+    fiat_bls12_381_fp_uint1 x178;
+    fiat_bls12_381_fp_addcarryx_u64(&x177, &x178, x176, x139, x163);
+    uint64_t x179;
+    fiat_bls12_381_fp_uint1 x180;
+    fiat_bls12_381_fp_addcarryx_u64(&x179, &x180, x178, x141, x165);
+    uint64_t x181;
+    fiat_bls12_381_fp_uint1 x182;
+    fiat_bls12_381_fp_addcarryx_u64(&x181, &x182, x180, x143, x167);
+    uint64_t x183;
+    x183 = x169 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x184;
+    uint64_t x185;
+    fiat_bls12_381_fp_mulx_u64(&x184, &x185, UINT64_C(0xb9feffffffffaaab), x183);
+    uint64_t x186;
+    uint64_t x187;
+    fiat_bls12_381_fp_mulx_u64(&x186, &x187, UINT64_C(0x1eabfffeb153ffff), x183);
+    uint64_t x188;
+    uint64_t x189;
+    fiat_bls12_381_fp_mulx_u64(&x188, &x189, UINT64_C(0x6730d2a0f6b0f624), x183);
+    uint64_t x190;
+    uint64_t x191;
+    fiat_bls12_381_fp_mulx_u64(&x190, &x191, UINT64_C(0x64774b84f38512bf), x183);
+    uint64_t x192;
+    uint64_t x193;
+    fiat_bls12_381_fp_mulx_u64(&x192, &x193, UINT64_C(0x4b1ba7b6434bacd7), x183);
+    uint64_t x194;
+    uint64_t x195;
+    fiat_bls12_381_fp_mulx_u64(&x194, &x195, UINT64_C(0x1a0111ea397fe69a), x183);
+    uint64_t x196;
+    fiat_bls12_381_fp_uint1 x197;
+    fiat_bls12_381_fp_addcarryx_u64(&x196, &x197, 0x0, x186, x185);
+    uint64_t x198;
+    fiat_bls12_381_fp_uint1 x199;
+    fiat_bls12_381_fp_addcarryx_u64(&x198, &x199, x197, x188, x187);
+    uint64_t x200;
+    fiat_bls12_381_fp_uint1 x201;
+    fiat_bls12_381_fp_addcarryx_u64(&x200, &x201, x199, x190, x189);
+    uint64_t x202;
+    fiat_bls12_381_fp_uint1 x203;
+    fiat_bls12_381_fp_addcarryx_u64(&x202, &x203, x201, x192, x191);
+    uint64_t x204;
+    fiat_bls12_381_fp_uint1 x205;
+    fiat_bls12_381_fp_addcarryx_u64(&x204, &x205, x203, x194, x193);
+    uint64_t x206;
+    fiat_bls12_381_fp_uint1 x207;
+    fiat_bls12_381_fp_addcarryx_u64(&x206, &x207, x205, x195, 0x0);
+    uint64_t x208;
+    fiat_bls12_381_fp_uint1 x209;
+    fiat_bls12_381_fp_addcarryx_u64(&x208, &x209, 0x0, x169, x184);
+    uint64_t x210;
+    fiat_bls12_381_fp_uint1 x211;
+    fiat_bls12_381_fp_addcarryx_u64(&x210, &x211, x209, x171, x196);
+    uint64_t x212;
+    fiat_bls12_381_fp_uint1 x213;
+    fiat_bls12_381_fp_addcarryx_u64(&x212, &x213, x211, x173, x198);
+    uint64_t x214;
+    fiat_bls12_381_fp_uint1 x215;
+    fiat_bls12_381_fp_addcarryx_u64(&x214, &x215, x213, x175, x200);
+    uint64_t x216;
+    fiat_bls12_381_fp_uint1 x217;
+    fiat_bls12_381_fp_addcarryx_u64(&x216, &x217, x215, x177, x202);
+    uint64_t x218;
+    fiat_bls12_381_fp_uint1 x219;
+    fiat_bls12_381_fp_addcarryx_u64(&x218, &x219, x217, x179, x204);
+    uint64_t x220;
+    fiat_bls12_381_fp_uint1 x221;
+    fiat_bls12_381_fp_addcarryx_u64(&x220, &x221, x219, x181, x206);
+    uint64_t x222;
+    fiat_bls12_381_fp_uint1 x223;
+    fiat_bls12_381_fp_addcarryx_u64(&x222, &x223, x221, x182, 0x0);
+    uint64_t x224;
+    uint64_t x225;
+    fiat_bls12_381_fp_mulx_u64(&x224, &x225, arg1[0], arg2[3]);
+    uint64_t x226;
+    uint64_t x227;
+    fiat_bls12_381_fp_mulx_u64(&x226, &x227, arg1[1], arg2[3]);
+    uint64_t x228;
+    uint64_t x229;
+    fiat_bls12_381_fp_mulx_u64(&x228, &x229, arg1[2], arg2[3]);
+    uint64_t x230;
+    uint64_t x231;
+    fiat_bls12_381_fp_mulx_u64(&x230, &x231, arg1[3], arg2[3]);
+    uint64_t x232;
+    uint64_t x233;
+    fiat_bls12_381_fp_mulx_u64(&x232, &x233, arg1[4], arg2[3]);
+    uint64_t x234;
+    uint64_t x235;
+    fiat_bls12_381_fp_mulx_u64(&x234, &x235, arg1[5], arg2[3]);
+    uint64_t x236;
+    fiat_bls12_381_fp_uint1 x237;
+    fiat_bls12_381_fp_addcarryx_u64(&x236, &x237, 0x0, x226, x225);
+    uint64_t x238;
+    fiat_bls12_381_fp_uint1 x239;
+    fiat_bls12_381_fp_addcarryx_u64(&x238, &x239, x237, x228, x227);
+    uint64_t x240;
+    fiat_bls12_381_fp_uint1 x241;
+    fiat_bls12_381_fp_addcarryx_u64(&x240, &x241, x239, x230, x229);
+    uint64_t x242;
+    fiat_bls12_381_fp_uint1 x243;
+    fiat_bls12_381_fp_addcarryx_u64(&x242, &x243, x241, x232, x231);
+    uint64_t x244;
+    fiat_bls12_381_fp_uint1 x245;
+    fiat_bls12_381_fp_addcarryx_u64(&x244, &x245, x243, x234, x233);
+    uint64_t x246;
+    fiat_bls12_381_fp_uint1 x247;
+    fiat_bls12_381_fp_addcarryx_u64(&x246, &x247, x245, x235, 0x0);
+    uint64_t x248;
+    fiat_bls12_381_fp_uint1 x249;
+    fiat_bls12_381_fp_addcarryx_u64(&x248, &x249, 0x0, x210, x224);
+    uint64_t x250;
+    fiat_bls12_381_fp_uint1 x251;
+    fiat_bls12_381_fp_addcarryx_u64(&x250, &x251, x249, x212, x236);
+    uint64_t x252;
+    fiat_bls12_381_fp_uint1 x253;
+    fiat_bls12_381_fp_addcarryx_u64(&x252, &x253, x251, x214, x238);
+    uint64_t x254;
+    fiat_bls12_381_fp_uint1 x255;
+    fiat_bls12_381_fp_addcarryx_u64(&x254, &x255, x253, x216, x240);
+    uint64_t x256;
+    fiat_bls12_381_fp_uint1 x257;
+    fiat_bls12_381_fp_addcarryx_u64(&x256, &x257, x255, x218, x242);
+    uint64_t x258;
+    fiat_bls12_381_fp_uint1 x259;
+    fiat_bls12_381_fp_addcarryx_u64(&x258, &x259, x257, x220, x244);
+    uint64_t x260;
+    fiat_bls12_381_fp_uint1 x261;
+    fiat_bls12_381_fp_addcarryx_u64(&x260, &x261, x259, x222, x246);
+    uint64_t x262;
+    x262 = x248 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x263;
+    uint64_t x264;
+    fiat_bls12_381_fp_mulx_u64(&x263, &x264, UINT64_C(0xb9feffffffffaaab), x262);
+    uint64_t x265;
+    uint64_t x266;
+    fiat_bls12_381_fp_mulx_u64(&x265, &x266, UINT64_C(0x1eabfffeb153ffff), x262);
+    uint64_t x267;
+    uint64_t x268;
+    fiat_bls12_381_fp_mulx_u64(&x267, &x268, UINT64_C(0x6730d2a0f6b0f624), x262);
+    uint64_t x269;
+    uint64_t x270;
+    fiat_bls12_381_fp_mulx_u64(&x269, &x270, UINT64_C(0x64774b84f38512bf), x262);
+    uint64_t x271;
+    uint64_t x272;
+    fiat_bls12_381_fp_mulx_u64(&x271, &x272, UINT64_C(0x4b1ba7b6434bacd7), x262);
+    uint64_t x273;
+    uint64_t x274;
+    fiat_bls12_381_fp_mulx_u64(&x273, &x274, UINT64_C(0x1a0111ea397fe69a), x262);
+    uint64_t x275;
+    fiat_bls12_381_fp_uint1 x276;
+    fiat_bls12_381_fp_addcarryx_u64(&x275, &x276, 0x0, x265, x264);
+    uint64_t x277;
+    fiat_bls12_381_fp_uint1 x278;
+    fiat_bls12_381_fp_addcarryx_u64(&x277, &x278, x276, x267, x266);
+    uint64_t x279;
+    fiat_bls12_381_fp_uint1 x280;
+    fiat_bls12_381_fp_addcarryx_u64(&x279, &x280, x278, x269, x268);
+    uint64_t x281;
+    fiat_bls12_381_fp_uint1 x282;
+    fiat_bls12_381_fp_addcarryx_u64(&x281, &x282, x280, x271, x270);
+    uint64_t x283;
+    fiat_bls12_381_fp_uint1 x284;
+    fiat_bls12_381_fp_addcarryx_u64(&x283, &x284, x282, x273, x272);
+    uint64_t x285;
+    fiat_bls12_381_fp_uint1 x286;
+    fiat_bls12_381_fp_addcarryx_u64(&x285, &x286, x284, x274, 0x0);
+    uint64_t x287;
+    fiat_bls12_381_fp_uint1 x288;
+    fiat_bls12_381_fp_addcarryx_u64(&x287, &x288, 0x0, x248, x263);
+    uint64_t x289;
+    fiat_bls12_381_fp_uint1 x290;
+    fiat_bls12_381_fp_addcarryx_u64(&x289, &x290, x288, x250, x275);
+    uint64_t x291;
+    fiat_bls12_381_fp_uint1 x292;
+    fiat_bls12_381_fp_addcarryx_u64(&x291, &x292, x290, x252, x277);
+    uint64_t x293;
+    fiat_bls12_381_fp_uint1 x294;
+    fiat_bls12_381_fp_addcarryx_u64(&x293, &x294, x292, x254, x279);
+    uint64_t x295;
+    fiat_bls12_381_fp_uint1 x296;
+    fiat_bls12_381_fp_addcarryx_u64(&x295, &x296, x294, x256, x281);
+    uint64_t x297;
+    fiat_bls12_381_fp_uint1 x298;
+    fiat_bls12_381_fp_addcarryx_u64(&x297, &x298, x296, x258, x283);
+    uint64_t x299;
+    fiat_bls12_381_fp_uint1 x300;
+    fiat_bls12_381_fp_addcarryx_u64(&x299, &x300, x298, x260, x285);
+    uint64_t x301;
+    fiat_bls12_381_fp_uint1 x302;
+    fiat_bls12_381_fp_addcarryx_u64(&x301, &x302, x300, x261, 0x0);
+    uint64_t x303;
+    uint64_t x304;
+    fiat_bls12_381_fp_mulx_u64(&x303, &x304, arg1[0], arg2[4]);
+    uint64_t x305;
+    uint64_t x306;
+    fiat_bls12_381_fp_mulx_u64(&x305, &x306, arg1[1], arg2[4]);
+    uint64_t x307;
+    uint64_t x308;
+    fiat_bls12_381_fp_mulx_u64(&x307, &x308, arg1[2], arg2[4]);
+    uint64_t x309;
+    uint64_t x310;
+    fiat_bls12_381_fp_mulx_u64(&x309, &x310, arg1[3], arg2[4]);
+    uint64_t x311;
+    uint64_t x312;
+    fiat_bls12_381_fp_mulx_u64(&x311, &x312, arg1[4], arg2[4]);
+    uint64_t x313;
+    uint64_t x314;
+    fiat_bls12_381_fp_mulx_u64(&x313, &x314, arg1[5], arg2[4]);
+    uint64_t x315;
+    fiat_bls12_381_fp_uint1 x316;
+    fiat_bls12_381_fp_addcarryx_u64(&x315, &x316, 0x0, x305, x304);
+    uint64_t x317;
+    fiat_bls12_381_fp_uint1 x318;
+    fiat_bls12_381_fp_addcarryx_u64(&x317, &x318, x316, x307, x306);
+    uint64_t x319;
+    fiat_bls12_381_fp_uint1 x320;
+    fiat_bls12_381_fp_addcarryx_u64(&x319, &x320, x318, x309, x308);
+    uint64_t x321;
+    fiat_bls12_381_fp_uint1 x322;
+    fiat_bls12_381_fp_addcarryx_u64(&x321, &x322, x320, x311, x310);
+    uint64_t x323;
+    fiat_bls12_381_fp_uint1 x324;
+    fiat_bls12_381_fp_addcarryx_u64(&x323, &x324, x322, x313, x312);
+    uint64_t x325;
+    fiat_bls12_381_fp_uint1 x326;
+    fiat_bls12_381_fp_addcarryx_u64(&x325, &x326, x324, x314, 0x0);
+    uint64_t x327;
+    fiat_bls12_381_fp_uint1 x328;
+    fiat_bls12_381_fp_addcarryx_u64(&x327, &x328, 0x0, x289, x303);
+    uint64_t x329;
+    fiat_bls12_381_fp_uint1 x330;
+    fiat_bls12_381_fp_addcarryx_u64(&x329, &x330, x328, x291, x315);
+    uint64_t x331;
+    fiat_bls12_381_fp_uint1 x332;
+    fiat_bls12_381_fp_addcarryx_u64(&x331, &x332, x330, x293, x317);
+    uint64_t x333;
+    fiat_bls12_381_fp_uint1 x334;
+    fiat_bls12_381_fp_addcarryx_u64(&x333, &x334, x332, x295, x319);
+    uint64_t x335;
+    fiat_bls12_381_fp_uint1 x336;
+    fiat_bls12_381_fp_addcarryx_u64(&x335, &x336, x334, x297, x321);
+    uint64_t x337;
+    fiat_bls12_381_fp_uint1 x338;
+    fiat_bls12_381_fp_addcarryx_u64(&x337, &x338, x336, x299, x323);
+    uint64_t x339;
+    fiat_bls12_381_fp_uint1 x340;
+    fiat_bls12_381_fp_addcarryx_u64(&x339, &x340, x338, x301, x325);
+    uint64_t x341;
+    x341 = x327 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x342;
+    uint64_t x343;
+    fiat_bls12_381_fp_mulx_u64(&x342, &x343, UINT64_C(0xb9feffffffffaaab), x341);
+    uint64_t x344;
+    uint64_t x345;
+    fiat_bls12_381_fp_mulx_u64(&x344, &x345, UINT64_C(0x1eabfffeb153ffff), x341);
+    uint64_t x346;
+    uint64_t x347;
+    fiat_bls12_381_fp_mulx_u64(&x346, &x347, UINT64_C(0x6730d2a0f6b0f624), x341);
+    uint64_t x348;
+    uint64_t x349;
+    fiat_bls12_381_fp_mulx_u64(&x348, &x349, UINT64_C(0x64774b84f38512bf), x341);
+    uint64_t x350;
+    uint64_t x351;
+    fiat_bls12_381_fp_mulx_u64(&x350, &x351, UINT64_C(0x4b1ba7b6434bacd7), x341);
+    uint64_t x352;
+    uint64_t x353;
+    fiat_bls12_381_fp_mulx_u64(&x352, &x353, UINT64_C(0x1a0111ea397fe69a), x341);
+    uint64_t x354;
+    fiat_bls12_381_fp_uint1 x355;
+    fiat_bls12_381_fp_addcarryx_u64(&x354, &x355, 0x0, x344, x343);
+    uint64_t x356;
+    fiat_bls12_381_fp_uint1 x357;
+    fiat_bls12_381_fp_addcarryx_u64(&x356, &x357, x355, x346, x345);
+    uint64_t x358;
+    fiat_bls12_381_fp_uint1 x359;
+    fiat_bls12_381_fp_addcarryx_u64(&x358, &x359, x357, x348, x347);
+    uint64_t x360;
+    fiat_bls12_381_fp_uint1 x361;
+    fiat_bls12_381_fp_addcarryx_u64(&x360, &x361, x359, x350, x349);
+    uint64_t x362;
+    fiat_bls12_381_fp_uint1 x363;
+    fiat_bls12_381_fp_addcarryx_u64(&x362, &x363, x361, x352, x351);
+    uint64_t x364;
+    fiat_bls12_381_fp_uint1 x365;
+    fiat_bls12_381_fp_addcarryx_u64(&x364, &x365, x363, x353, 0x0);
+    uint64_t x366;
+    fiat_bls12_381_fp_uint1 x367;
+    fiat_bls12_381_fp_addcarryx_u64(&x366, &x367, 0x0, x327, x342);
+    uint64_t x368;
+    fiat_bls12_381_fp_uint1 x369;
+    fiat_bls12_381_fp_addcarryx_u64(&x368, &x369, x367, x329, x354);
+    uint64_t x370;
+    fiat_bls12_381_fp_uint1 x371;
+    fiat_bls12_381_fp_addcarryx_u64(&x370, &x371, x369, x331, x356);
+    uint64_t x372;
+    fiat_bls12_381_fp_uint1 x373;
+    fiat_bls12_381_fp_addcarryx_u64(&x372, &x373, x371, x333, x358);
+    uint64_t x374;
+    fiat_bls12_381_fp_uint1 x375;
+    fiat_bls12_381_fp_addcarryx_u64(&x374, &x375, x373, x335, x360);
+    uint64_t x376;
+    fiat_bls12_381_fp_uint1 x377;
+    fiat_bls12_381_fp_addcarryx_u64(&x376, &x377, x375, x337, x362);
+    uint64_t x378;
+    fiat_bls12_381_fp_uint1 x379;
+    fiat_bls12_381_fp_addcarryx_u64(&x378, &x379, x377, x339, x364);
+    uint64_t x380;
+    fiat_bls12_381_fp_uint1 x381;
+    fiat_bls12_381_fp_addcarryx_u64(&x380, &x381, x379, x340, 0x0);
+    uint64_t x382;
+    uint64_t x383;
+    fiat_bls12_381_fp_mulx_u64(&x382, &x383, arg1[0], arg2[5]);
+    uint64_t x384;
+    uint64_t x385;
+    fiat_bls12_381_fp_mulx_u64(&x384, &x385, arg1[1], arg2[5]);
+    uint64_t x386;
+    uint64_t x387;
+    fiat_bls12_381_fp_mulx_u64(&x386, &x387, arg1[2], arg2[5]);
+    uint64_t x388;
+    uint64_t x389;
+    fiat_bls12_381_fp_mulx_u64(&x388, &x389, arg1[3], arg2[5]);
+    uint64_t x390;
+    uint64_t x391;
+    fiat_bls12_381_fp_mulx_u64(&x390, &x391, arg1[4], arg2[5]);
+    uint64_t x392;
+    uint64_t x393;
+    fiat_bls12_381_fp_mulx_u64(&x392, &x393, arg1[5], arg2[5]);
+    uint64_t x394;
+    fiat_bls12_381_fp_uint1 x395;
+    fiat_bls12_381_fp_addcarryx_u64(&x394, &x395, 0x0, x384, x383);
+    uint64_t x396;
+    fiat_bls12_381_fp_uint1 x397;
+    fiat_bls12_381_fp_addcarryx_u64(&x396, &x397, x395, x386, x385);
+    uint64_t x398;
+    fiat_bls12_381_fp_uint1 x399;
+    fiat_bls12_381_fp_addcarryx_u64(&x398, &x399, x397, x388, x387);
+    uint64_t x400;
+    fiat_bls12_381_fp_uint1 x401;
+    fiat_bls12_381_fp_addcarryx_u64(&x400, &x401, x399, x390, x389);
+    uint64_t x402;
+    fiat_bls12_381_fp_uint1 x403;
+    fiat_bls12_381_fp_addcarryx_u64(&x402, &x403, x401, x392, x391);
+    uint64_t x404;
+    fiat_bls12_381_fp_uint1 x405;
+    fiat_bls12_381_fp_addcarryx_u64(&x404, &x405, x403, x393, 0x0);
+    uint64_t x406;
+    fiat_bls12_381_fp_uint1 x407;
+    fiat_bls12_381_fp_addcarryx_u64(&x406, &x407, 0x0, x368, x382);
+    uint64_t x408;
+    fiat_bls12_381_fp_uint1 x409;
+    fiat_bls12_381_fp_addcarryx_u64(&x408, &x409, x407, x370, x394);
+    uint64_t x410;
+    fiat_bls12_381_fp_uint1 x411;
+    fiat_bls12_381_fp_addcarryx_u64(&x410, &x411, x409, x372, x396);
+    uint64_t x412;
+    fiat_bls12_381_fp_uint1 x413;
+    fiat_bls12_381_fp_addcarryx_u64(&x412, &x413, x411, x374, x398);
+    uint64_t x414;
+    fiat_bls12_381_fp_uint1 x415;
+    fiat_bls12_381_fp_addcarryx_u64(&x414, &x415, x413, x376, x400);
+    uint64_t x416;
+    fiat_bls12_381_fp_uint1 x417;
+    fiat_bls12_381_fp_addcarryx_u64(&x416, &x417, x415, x378, x402);
+    uint64_t x418;
+    fiat_bls12_381_fp_uint1 x419;
+    fiat_bls12_381_fp_addcarryx_u64(&x418, &x419, x417, x380, x404);
+    uint64_t x420;
+    x420 = x406 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x421;
+    uint64_t x422;
+    fiat_bls12_381_fp_mulx_u64(&x421, &x422, UINT64_C(0xb9feffffffffaaab), x420);
+    uint64_t x423;
+    uint64_t x424;
+    fiat_bls12_381_fp_mulx_u64(&x423, &x424, UINT64_C(0x1eabfffeb153ffff), x420);
+    uint64_t x425;
+    uint64_t x426;
+    fiat_bls12_381_fp_mulx_u64(&x425, &x426, UINT64_C(0x6730d2a0f6b0f624), x420);
+    uint64_t x427;
+    uint64_t x428;
+    fiat_bls12_381_fp_mulx_u64(&x427, &x428, UINT64_C(0x64774b84f38512bf), x420);
+    uint64_t x429;
+    uint64_t x430;
+    fiat_bls12_381_fp_mulx_u64(&x429, &x430, UINT64_C(0x4b1ba7b6434bacd7), x420);
+    uint64_t x431;
+    uint64_t x432;
+    fiat_bls12_381_fp_mulx_u64(&x431, &x432, UINT64_C(0x1a0111ea397fe69a), x420);
+    uint64_t x433;
+    fiat_bls12_381_fp_uint1 x434;
+    fiat_bls12_381_fp_addcarryx_u64(&x433, &x434, 0x0, x423, x422);
+    uint64_t x435;
+    fiat_bls12_381_fp_uint1 x436;
+    fiat_bls12_381_fp_addcarryx_u64(&x435, &x436, x434, x425, x424);
+    uint64_t x437;
+    fiat_bls12_381_fp_uint1 x438;
+    fiat_bls12_381_fp_addcarryx_u64(&x437, &x438, x436, x427, x426);
+    uint64_t x439;
+    fiat_bls12_381_fp_uint1 x440;
+    fiat_bls12_381_fp_addcarryx_u64(&x439, &x440, x438, x429, x428);
+    uint64_t x441;
+    fiat_bls12_381_fp_uint1 x442;
+    fiat_bls12_381_fp_addcarryx_u64(&x441, &x442, x440, x431, x430);
+    uint64_t x443;
+    fiat_bls12_381_fp_uint1 x444;
+    fiat_bls12_381_fp_addcarryx_u64(&x443, &x444, x442, x432, 0x0);
+    uint64_t x445;
+    fiat_bls12_381_fp_uint1 x446;
+    fiat_bls12_381_fp_addcarryx_u64(&x445, &x446, 0x0, x406, x421);
+    uint64_t x447;
+    fiat_bls12_381_fp_uint1 x448;
+    fiat_bls12_381_fp_addcarryx_u64(&x447, &x448, x446, x408, x433);
+    uint64_t x449;
+    fiat_bls12_381_fp_uint1 x450;
+    fiat_bls12_381_fp_addcarryx_u64(&x449, &x450, x448, x410, x435);
+    uint64_t x451;
+    fiat_bls12_381_fp_uint1 x452;
+    fiat_bls12_381_fp_addcarryx_u64(&x451, &x452, x450, x412, x437);
+    uint64_t x453;
+    fiat_bls12_381_fp_uint1 x454;
+    fiat_bls12_381_fp_addcarryx_u64(&x453, &x454, x452, x414, x439);
+    uint64_t x455;
+    fiat_bls12_381_fp_uint1 x456;
+    fiat_bls12_381_fp_addcarryx_u64(&x455, &x456, x454, x416, x441);
+    uint64_t x457;
+    fiat_bls12_381_fp_uint1 x458;
+    fiat_bls12_381_fp_addcarryx_u64(&x457, &x458, x456, x418, x443);
+    uint64_t x459;
+    fiat_bls12_381_fp_uint1 x460;
+    fiat_bls12_381_fp_addcarryx_u64(&x459, &x460, x458, x419, 0x0);
+    uint64_t x461;
+    fiat_bls12_381_fp_uint1 x462;
+    fiat_bls12_381_fp_subborrowx_u64(&x461, &x462, 0x0, x447, UINT64_C(0xb9feffffffffaaab));
+    uint64_t x463;
+    fiat_bls12_381_fp_uint1 x464;
+    fiat_bls12_381_fp_subborrowx_u64(&x463, &x464, x462, x449, UINT64_C(0x1eabfffeb153ffff));
+    uint64_t x465;
+    fiat_bls12_381_fp_uint1 x466;
+    fiat_bls12_381_fp_subborrowx_u64(&x465, &x466, x464, x451, UINT64_C(0x6730d2a0f6b0f624));
+    uint64_t x467;
+    fiat_bls12_381_fp_uint1 x468;
+    fiat_bls12_381_fp_subborrowx_u64(&x467, &x468, x466, x453, UINT64_C(0x64774b84f38512bf));
+    uint64_t x469;
+    fiat_bls12_381_fp_uint1 x470;
+    fiat_bls12_381_fp_subborrowx_u64(&x469, &x470, x468, x455, UINT64_C(0x4b1ba7b6434bacd7));
+    uint64_t x471;
+    fiat_bls12_381_fp_uint1 x472;
+    fiat_bls12_381_fp_subborrowx_u64(&x471, &x472, x470, x457, UINT64_C(0x1a0111ea397fe69a));
+    uint64_t x473;
+    fiat_bls12_381_fp_uint1 x474;
+    fiat_bls12_381_fp_subborrowx_u64(&x473, &x474, x472, x459, 0x0);
+    uint64_t x475;
+    fiat_bls12_381_fp_cmovznz_u64(&x475, x474, x461, x447);
+    uint64_t x476;
+    fiat_bls12_381_fp_cmovznz_u64(&x476, x474, x463, x449);
+    uint64_t x477;
+    fiat_bls12_381_fp_cmovznz_u64(&x477, x474, x465, x451);
+    uint64_t x478;
+    fiat_bls12_381_fp_cmovznz_u64(&x478, x474, x467, x453);
+    uint64_t x479;
+    fiat_bls12_381_fp_cmovznz_u64(&x479, x474, x469, x455);
+    uint64_t x480;
+    fiat_bls12_381_fp_cmovznz_u64(&x480, x474, x471, x457);
+    out1[0] = x475;
+    out1[1] = x476;
+    out1[2] = x477;
+    out1[3] = x478;
+    out1[4] = x479;
+    out1[5] = x480;
+}
+
+// out1 = arg1^2 / R mod p
+static void fiat_bls12_381_fp_square(uint64_t out1[6], const uint64_t arg1[6]) {
+    uint64_t x1;
+    uint64_t x2;
+    fiat_bls12_381_fp_mulx_u64(&x1, &x2, arg1[0], arg1[0]);
+    uint64_t x3;
+    uint64_t x4;
+    fiat_bls12_381_fp_mulx_u64(&x3, &x4, arg1[1], arg1[0]);
+    uint64_t x5;
+    uint64_t x6;
+    fiat_bls12_381_fp_mulx_u64(&x5, &x6, arg1[2], arg1[0]);
+    uint64_t x7;
+    uint64_t x8;
+    fiat_bls12_381_fp_mulx_u64(&x7, &x8, arg1[3], arg1[0]);
+    uint64_t x9;
+    uint64_t x10;
+    fiat_bls12_381_fp_mulx_u64(&x9, &x10, arg1[4], arg1[0]);
+    uint64_t x11;
+    uint64_t x12;
+    fiat_bls12_381_fp_mulx_u64(&x11, &x12, arg1[5], arg1[0]);
+    uint64_t x13;
+    fiat_bls12_381_fp_uint1 x14;
+    fiat_bls12_381_fp_addcarryx_u64(&x13, &x14, 0x0, x3, x2);
+    uint64_t x15;
+    fiat_bls12_381_fp_uint1 x16;
+    fiat_bls12_381_fp_addcarryx_u64(&x15, &x16, x14, x5, x4);
+    uint64_t x17;
+    fiat_bls12_381_fp_uint1 x18;
+    fiat_bls12_381_fp_addcarryx_u64(&x17, &x18, x16, x7, x6);
+    uint64_t x19;
+    fiat_bls12_381_fp_uint1 x20;
+    fiat_bls12_381_fp_addcarryx_u64(&x19, &x20, x18, x9, x8);
+    uint64_t x21;
+    fiat_bls12_381_fp_uint1 x22;
+    fiat_bls12_381_fp_addcarryx_u64(&x21, &x22, x20, x11, x10);
+    uint64_t x23;
+    fiat_bls12_381_fp_uint1 x24;
+    fiat_bls12_381_fp_addcarryx_u64(&x23, &x24, x22, x12, 0x0);
+    uint64_t x25;
+    x25 = x1 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x26;
+    uint64_t x27;
+    fiat_bls12_381_fp_mulx_u64(&x26, &x27, UINT64_C(0xb9feffffffffaaab), x25);
+    uint64_t x28;
+    uint64_t x29;
+    fiat_bls12_381_fp_mulx_u64(&x28, &x29, UINT64_C(0x1eabfffeb153ffff), x25);
+    uint64_t x30;
+    uint64_t x31;
+    fiat_bls12_381_fp_mulx_u64(&x30, &x31, UINT64_C(0x6730d2a0f6b0f624), x25);
+    uint64_t x32;
+    uint64_t x33;
+    fiat_bls12_381_fp_mulx_u64(&x32, &x33, UINT64_C(0x64774b84f38512bf), x25);
+    uint64_t x34;
+    uint64_t x35;
+    fiat_bls12_381_fp_mulx_u64(&x34, &x35, UINT64_C(0x4b1ba7b6434bacd7), x25);
+    uint64_t x36;
+    uint64_t x37;
+    fiat_bls12_381_fp_mulx_u64(&x36, &x37, UINT64_C(0x1a0111ea397fe69a), x25);
+    uint64_t x38;
+    fiat_bls12_381_fp_uint1 x39;
+    fiat_bls12_381_fp_addcarryx_u64(&x38, &x39, 0x0, x28, x27);
+    uint64_t x40;
+    fiat_bls12_381_fp_uint1 x41;
+    fiat_bls12_381_fp_addcarryx_u64(&x40, &x41, x39, x30, x29);
+    uint64_t x42;
+    fiat_bls12_381_fp_uint1 x43;
+    fiat_bls12_381_fp_addcarryx_u64(&x42, &x43, x41, x32, x31);
+    uint64_t x44;
+    fiat_bls12_381_fp_uint1 x45;
+    fiat_bls12_381_fp_addcarryx_u64(&x44, &x45, x43, x34, x33);
+    uint64_t x46;
+    fiat_bls12_381_fp_uint1 x47;
+    fiat_bls12_381_fp_addcarryx_u64(&x46, &x47, x45, x36, x35);
+    uint64_t x48;
+    fiat_bls12_381_fp_uint1 x49;
+    fiat_bls12_381_fp_addcarryx_u64(&x48, &x49, x47, x37, 0x0);
+    uint64_t x50;
+    fiat_bls12_381_fp_uint1 x51;
+    fiat_bls12_381_fp_addcarryx_u64(&x50, &x51, 0x0, x1, x26);
+    uint64_t x52;
+    fiat_bls12_381_fp_uint1 x53;
+    fiat_bls12_381_fp_addcarryx_u64(&x52, &x53, x51, x13, x38);
+    uint64_t x54;
+    fiat_bls12_381_fp_uint1 x55;
+    fiat_bls12_381_fp_addcarryx_u64(&x54, &x55, x53, x15, x40);
+    uint64_t x56;
+    fiat_bls12_381_fp_uint1 x57;
+    fiat_bls12_381_fp_addcarryx_u64(&x56, &x57, x55, x17, x42);
+    uint64_t x58;
+    fiat_bls12_381_fp_uint1 x59;
+    fiat_bls12_381_fp_addcarryx_u64(&x58, &x59, x57, x19, x44);
+    uint64_t x60;
+    fiat_bls12_381_fp_uint1 x61;
+    fiat_bls12_381_fp_addcarryx_u64(&x60, &x61, x59, x21, x46);
+    uint64_t x62;
+    fiat_bls12_381_fp_uint1 x63;
+    fiat_bls12_381_fp_addcarryx_u64(&x62, &x63, x61, x23, x48);
+    uint64_t x64;
+    fiat_bls12_381_fp_uint1 x65;
+    fiat_bls12_381_fp_addcarryx_u64(&x64, &x65, x63, 0x0, 0x0);
+    uint64_t x66;
+    uint64_t x67;
+    fiat_bls12_381_fp_mulx_u64(&x66, &x67, arg1[0], arg1[1]);
+    uint64_t x68;
+    uint64_t x69;
+    fiat_bls12_381_fp_mulx_u64(&x68, &x69, arg1[1], arg1[1]);
+    uint64_t x70;
+    uint64_t x71;
+    fiat_bls12_381_fp_mulx_u64(&x70, &x71, arg1[2], arg1[1]);
+    uint64_t x72;
+    uint64_t x73;
+    fiat_bls12_381_fp_mulx_u64(&x72, &x73, arg1[3], arg1[1]);
+    uint64_t x74;
+    uint64_t x75;
+    fiat_bls12_381_fp_mulx_u64(&x74, &x75, arg1[4], arg1[1]);
+    uint64_t x76;
+    uint64_t x77;
+    fiat_bls12_381_fp_mulx_u64(&x76, &x77, arg1[5], arg1[1]);
+    uint64_t x78;
+    fiat_bls12_381_fp_uint1 x79;
+    fiat_bls12_381_fp_addcarryx_u64(&x78, &x79, 0x0, x68, x67);
+    uint64_t x80;
+    fiat_bls12_381_fp_uint1 x81;
+    fiat_bls12_381_fp_addcarryx_u64(&x80, &x81, x79, x70, x69);
+    uint64_t x82;
+    fiat_bls12_381_fp_uint1 x83;
+    fiat_bls12_381_fp_addcarryx_u64(&x82, &x83, x81, x72, x71);
+    uint64_t x84;
+    fiat_bls12_381_fp_uint1 x85;
+    fiat_bls12_381_fp_addcarryx_u64(&x84, &x85, x83, x74, x73);
+    uint64_t x86;
+    fiat_bls12_381_fp_uint1 x87;
+    fiat_bls12_381_fp_addcarryx_u64(&x86, &x87, x85, x76, x75);
+    uint64_t x88;
+    fiat_bls12_381_fp_uint1 x89;
+    fiat_bls12_381_fp_addcarryx_u64(&x88, &x89, x87, x77, 0x0);
+    uint64_t x90;
+    fiat_bls12_381_fp_uint1 x91;
+    fiat_bls12_381_fp_addcarryx_u64(&x90, &x91, 0x0, x52, x66);
+    uint64_t x92;
+    fiat_bls12_381_fp_uint1 x93;
+    fiat_bls12_381_fp_addcarryx_u64(&x92, &x93, x91, x54, x78);
+    uint64_t x94;
+    fiat_bls12_381_fp_uint1 x95;
+    fiat_bls12_381_fp_addcarryx_u64(&x94, &x95, x93, x56, x80);
+    uint64_t x96;
+    fiat_bls12_381_fp_uint1 x97;
+    fiat_bls12_381_fp_addcarryx_u64(&x96, &x97, x95, x58, x82);
+    uint64_t x98;
+    fiat_bls12_381_fp_uint1 x99;
+    fiat_bls12_381_fp_addcarryx_u64(&x98, &x99, x97, x60, x84);
+    uint64_t x100;
+    fiat_bls12_381_fp_uint1 x101;
+    fiat_bls12_381_fp_addcarryx_u64(&x100, &x101, x99, x62, x86);
+    uint64_t x102;
+    fiat_bls12_381_fp_uint1 x103;
+    fiat_bls12_381_fp_addcarryx_u64(&x102, &x103, x101, x64, x88);
+    uint64_t x104;
+    x104 = x90 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x105;
+    uint64_t x106;
+    fiat_bls12_381_fp_mulx_u64(&x105, &x106, UINT64_C(0xb9feffffffffaaab), x104);
+    uint64_t x107;
+    uint64_t x108;
+    fiat_bls12_381_fp_mulx_u64(&x107, &x108, UINT64_C(0x1eabfffeb153ffff), x104);
+    uint64_t x109;
+    uint64_t x110;
+    fiat_bls12_381_fp_mulx_u64(&x109, &x110, UINT64_C(0x6730d2a0f6b0f624), x104);
+    uint64_t x111;
+    uint64_t x112;
+    fiat_bls12_381_fp_mulx_u64(&x111, &x112, UINT64_C(0x64774b84f38512bf), x104);
+    uint64_t x113;
+    uint64_t x114;
+    fiat_bls12_381_fp_mulx_u64(&x113, &x114, UINT64_C(0x4b1ba7b6434bacd7), x104);
+    uint64_t x115;
+    uint64_t x116;
+    fiat_bls12_381_fp_mulx_u64(&x115, &x116, UINT64_C(0x1a0111ea397fe69a), x104);
+    uint64_t x117;
+    fiat_bls12_381_fp_uint1 x118;
+    fiat_bls12_381_fp_addcarryx_u64(&x117, &x118, 0x0, x107, x106);
+    uint64_t x119;
+    fiat_bls12_381_fp_uint1 x120;
+    fiat_bls12_381_fp_addcarryx_u64(&x119, &x120, x118, x109, x108);
+    uint64_t x121;
+    fiat_bls12_381_fp_uint1 x122;
+    fiat_bls12_381_fp_addcarryx_u64(&x121, &x122, x120, x111, x110);
+    uint64_t x123;
+    fiat_bls12_381_fp_uint1 x124;
+    fiat_bls12_381_fp_addcarryx_u64(&x123, &x124, x122, x113, x112);
+    uint64_t x125;
+    fiat_bls12_381_fp_uint1 x126;
+    fiat_bls12_381_fp_addcarryx_u64(&x125, &x126, x124, x115, x114);
+    uint64_t x127;
+    fiat_bls12_381_fp_uint1 x128;
+    fiat_bls12_381_fp_addcarryx_u64(&x127, &x128, x126, x116, 0x0);
+    uint64_t x129;
+    fiat_bls12_381_fp_uint1 x130;
+    fiat_bls12_381_fp_addcarryx_u64(&x129, &x130, 0x0, x90, x105);
+    uint64_t x131;
+    fiat_bls12_381_fp_uint1 x132;
+    fiat_bls12_381_fp_addcarryx_u64(&x131, &x132, x130, x92, x117);
+    uint64_t x133;
+    fiat_bls12_381_fp_uint1 x134;
+    fiat_bls12_381_fp_addcarryx_u64(&x133, &x134, x132, x94, x119);
+    uint64_t x135;
+    fiat_bls12_381_fp_uint1 x136;
+    fiat_bls12_381_fp_addcarryx_u64(&x135, &x136, x134, x96, x121);
+    uint64_t x137;
+    fiat_bls12_381_fp_uint1 x138;
+    fiat_bls12_381_fp_addcarryx_u64(&x137, &x138, x136, x98, x123);
+    uint64_t x139;
+    fiat_bls12_381_fp_uint1 x140;
+    fiat_bls12_381_fp_addcarryx_u64(&x139, &x140, x138, x100, x125);
+    uint64_t x141;
+    fiat_bls12_381_fp_uint1 x142;
+    fiat_bls12_381_fp_addcarryx_u64(&x141, &x142, x140, x102, x127);
+    uint64_t x143;
+    fiat_bls12_381_fp_uint1 x144;
+    fiat_bls12_381_fp_addcarryx_u64(&x143, &x144, x142, x103, 0x0);
+    uint64_t x145;
+    uint64_t x146;
+    fiat_bls12_381_fp_mulx_u64(&x145, &x146, arg1[0], arg1[2]);
+    uint64_t x147;
+    uint64_t x148;
+    fiat_bls12_381_fp_mulx_u64(&x147, &x148, arg1[1], arg1[2]);
+    uint64_t x149;
+    uint64_t x150;
+    fiat_bls12_381_fp_mulx_u64(&x149, &x150, arg1[2], arg1[2]);
+    uint64_t x151;
+    uint64_t x152;
+    fiat_bls12_381_fp_mulx_u64(&x151, &x152, arg1[3], arg1[2]);
+    uint64_t x153;
+    uint64_t x154;
+    fiat_bls12_381_fp_mulx_u64(&x153, &x154, arg1[4], arg1[2]);
+    uint64_t x155;
+    uint64_t x156;
+    fiat_bls12_381_fp_mulx_u64(&x155, &x156, arg1[5], arg1[2]);
+    uint64_t x157;
+    fiat_bls12_381_fp_uint1 x158;
+    fiat_bls12_381_fp_addcarryx_u64(&x157, &x158, 0x0, x147, x146);
+    uint64_t x159;
+    fiat_bls12_381_fp_uint1 x160;
+    fiat_bls12_381_fp_addcarryx_u64(&x159, &x160, x158, x149, x148);
+    uint64_t x161;
+    fiat_bls12_381_fp_uint1 x162;
+    fiat_bls12_381_fp_addcarryx_u64(&x161, &x162, x160, x151, x150);
+    uint64_t x163;
+    fiat_bls12_381_fp_uint1 x164;
+    fiat_bls12_381_fp_addcarryx_u64(&x163, &x164, x162, x153, x152);
+    uint64_t x165;
+    fiat_bls12_381_fp_uint1 x166;
+    fiat_bls12_381_fp_addcarryx_u64(&x165, &x166, x164, x155, x154);
+    uint64_t x167;
+    fiat_bls12_381_fp_uint1 x168;
+    fiat_bls12_381_fp_addcarryx_u64(&x167, &x168, x166, x156, 0x0);
+    uint64_t x169;
+    fiat_bls12_381_fp_uint1 x170;
+    fiat_bls12_381_fp_addcarryx_u64(&x169, &x170, 0x0, x131, x145);
+    uint64_t x171;
+    fiat_bls12_381_fp_uint1 x172;
+    fiat_bls12_381_fp_addcarryx_u64(&x171, &x172, x170, x133, x157);
+    uint64_t x173;
+    fiat_bls12_381_fp_uint1 x174;
+    fiat_bls12_381_fp_addcarryx_u64(&x173, &x174, x172, x135, x159);
+    uint64_t x175;
+    fiat_bls12_381_fp_uint1 x176;
+    fiat_bls12_381_fp_addcarryx_u64(&x175, &x176, x174, x137, x161);
+    uint64_t x177;
+    fiat_bls12_381_fp_uint1 x178;
+    fiat_bls12_381_fp_addcarryx_u64(&x177, &x178, x176, x139, x163);
+    uint64_t x179;
+    fiat_bls12_381_fp_uint1 x180;
+    fiat_bls12_381_fp_addcarryx_u64(&x179, &x180, x178, x141, x165);
+    uint64_t x181;
+    fiat_bls12_381_fp_uint1 x182;
+    fiat_bls12_381_fp_addcarryx_u64(&x181, &x182, x180, x143, x167);
+    uint64_t x183;
+    x183 = x169 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x184;
+    uint64_t x185;
+    fiat_bls12_381_fp_mulx_u64(&x184, &x185, UINT64_C(0xb9feffffffffaaab), x183);
+    uint64_t x186;
+    uint64_t x187;
+    fiat_bls12_381_fp_mulx_u64(&x186, &x187, UINT64_C(0x1eabfffeb153ffff), x183);
+    uint64_t x188;
+    uint64_t x189;
+    fiat_bls12_381_fp_mulx_u64(&x188, &x189, UINT64_C(0x6730d2a0f6b0f624), x183);
+    uint64_t x190;
+    uint64_t x191;
+    fiat_bls12_381_fp_mulx_u64(&x190, &x191, UINT64_C(0x64774b84f38512bf), x183);
+    uint64_t x192;
+    uint64_t x193;
+    fiat_bls12_381_fp_mulx_u64(&x192, &x193, UINT64_C(0x4b1ba7b6434bacd7), x183);
+    uint64_t x194;
+    uint64_t x195;
+    fiat_bls12_381_fp_mulx_u64(&x194, &x195, UINT64_C(0x1a0111ea397fe69a), x183);
+    uint64_t x196;
+    fiat_bls12_381_fp_uint1 x197;
+    fiat_bls12_381_fp_addcarryx_u64(&x196, &x197, 0x0, x186, x185);
+    uint64_t x198;
+    fiat_bls12_381_fp_uint1 x199;
+    fiat_bls12_381_fp_addcarryx_u64(&x198, &x199, x197, x188, x187);
+    uint64_t x200;
+    fiat_bls12_381_fp_uint1 x201;
+    fiat_bls12_381_fp_addcarryx_u64(&x200, &x201, x199, x190, x189);
+    uint64_t x202;
+    fiat_bls12_381_fp_uint1 x203;
+    fiat_bls12_381_fp_addcarryx_u64(&x202, &x203, x201, x192, x191);
+    uint64_t x204;
+    fiat_bls12_381_fp_uint1 x205;
+    fiat_bls12_381_fp_addcarryx_u64(&x204, &x205, x203, x194, x193);
+    uint64_t x206;
+    fiat_bls12_381_fp_uint1 x207;
+    fiat_bls12_381_fp_addcarryx_u64(&x206, &x207, x205, x195, 0x0);
+    uint64_t x208;
+    fiat_bls12_381_fp_uint1 x209;
+    fiat_bls12_381_fp_addcarryx_u64(&x208, &x209, 0x0, x169, x184);
+    uint64_t x210;
+    fiat_bls12_381_fp_uint1 x211;
+    fiat_bls12_381_fp_addcarryx_u64(&x210, &x211, x209, x171, x196);
+    uint64_t x212;
+    fiat_bls12_381_fp_uint1 x213;
+    fiat_bls12_381_fp_addcarryx_u64(&x212, &x213, x211, x173, x198);
+    uint64_t x214;
+    fiat_bls12_381_fp_uint1 x215;
+    fiat_bls12_381_fp_addcarryx_u64(&x214, &x215, x213, x175, x200);
+    uint64_t x216;
+    fiat_bls12_381_fp_uint1 x217;
+    fiat_bls12_381_fp_addcarryx_u64(&x216, &x217, x215, x177, x202);
+    uint64_t x218;
+    fiat_bls12_381_fp_uint1 x219;
+    fiat_bls12_381_fp_addcarryx_u64(&x218, &x219, x217, x179, x204);
+    uint64_t x220;
+    fiat_bls12_381_fp_uint1 x221;
+    fiat_bls12_381_fp_addcarryx_u64(&x220, &x221, x219, x181, x206);
+    uint64_t x222;
+    fiat_bls12_381_fp_uint1 x223;
+    fiat_bls12_381_fp_addcarryx_u64(&x222, &x223, x221, x182, 0x0);
+    uint64_t x224;
+    uint64_t x225;
+    fiat_bls12_381_fp_mulx_u64(&x224, &x225, arg1[0], arg1[3]);
+    uint64_t x226;
+    uint64_t x227;
+    fiat_bls12_381_fp_mulx_u64(&x226, &x227, arg1[1], arg1[3]);
+    uint64_t x228;
+    uint64_t x229;
+    fiat_bls12_381_fp_mulx_u64(&x228, &x229, arg1[2], arg1[3]);
+    uint64_t x230;
+    uint64_t x231;
+    fiat_bls12_381_fp_mulx_u64(&x230, &x231, arg1[3], arg1[3]);
+    uint64_t x232;
+    uint64_t x233;
+    fiat_bls12_381_fp_mulx_u64(&x232, &x233, arg1[4], arg1[3]);
+    uint64_t x234;
+    uint64_t x235;
+    fiat_bls12_381_fp_mulx_u64(&x234, &x235, arg1[5], arg1[3]);
+    uint64_t x236;
+    fiat_bls12_381_fp_uint1 x237;
+    fiat_bls12_381_fp_addcarryx_u64(&x236, &x237, 0x0, x226, x225);
+    uint64_t x238;
+    fiat_bls12_381_fp_uint1 x239;
+    fiat_bls12_381_fp_addcarryx_u64(&x238, &x239, x237, x228, x227);
+    uint64_t x240;
+    fiat_bls12_381_fp_uint1 x241;
+    fiat_bls12_381_fp_addcarryx_u64(&x240, &x241, x239, x230, x229);
+    uint64_t x242;
+    fiat_bls12_381_fp_uint1 x243;
+    fiat_bls12_381_fp_addcarryx_u64(&x242, &x243, x241, x232, x231);
+    uint64_t x244;
+    fiat_bls12_381_fp_uint1 x245;
+    fiat_bls12_381_fp_addcarryx_u64(&x244, &x245, x243, x234, x233);
+    uint64_t x246;
+    fiat_bls12_381_fp_uint1 x247;
+    fiat_bls12_381_fp_addcarryx_u64(&x246, &x247, x245, x235, 0x0);
+    uint64_t x248;
+    fiat_bls12_381_fp_uint1 x249;
+    fiat_bls12_381_fp_addcarryx_u64(&x248, &x249, 0x0, x210, x224);
+    uint64_t x250;
+    fiat_bls12_381_fp_uint1 x251;
+    fiat_bls12_381_fp_addcarryx_u64(&x250, &x251, x249, x212, x236);
+    uint64_t x252;
+    fiat_bls12_381_fp_uint1 x253;
+    fiat_bls12_381_fp_addcarryx_u64(&x252, &x253, x251, x214, x238);
+    uint64_t x254;
+    fiat_bls12_381_fp_uint1 x255;
+    fiat_bls12_381_fp_addcarryx_u64(&x254, &x255, x253, x216, x240);
+    uint64_t x256;
+    fiat_bls12_381_fp_uint1 x257;
+    fiat_bls12_381_fp_addcarryx_u64(&x256, &x257, x255, x218, x242);
+    uint64_t x258;
+    fiat_bls12_381_fp_uint1 x259;
+    fiat_bls12_381_fp_addcarryx_u64(&x258, &x259, x257, x220, x244);
+    uint64_t x260;
+    fiat_bls12_381_fp_uint1 x261;
+    fiat_bls12_381_fp_addcarryx_u64(&x260, &x261, x259, x222, x246);
+    uint64_t x262;
+    x262 = x248 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x263;
+    uint64_t x264;
+    fiat_bls12_381_fp_mulx_u64(&x263, &x264, UINT64_C(0xb9feffffffffaaab), x262);
+    uint64_t x265;
+    uint64_t x266;
+    fiat_bls12_381_fp_mulx_u64(&x265, &x266, UINT64_C(0x1eabfffeb153ffff), x262);
+    uint64_t x267;
+    uint64_t x268;
+    fiat_bls12_381_fp_mulx_u64(&x267, &x268, UINT64_C(0x6730d2a0f6b0f624), x262);
+    uint64_t x269;
+    uint64_t x270;
+    fiat_bls12_381_fp_mulx_u64(&x269, &x270, UINT64_C(0x64774b84f38512bf), x262);
+    uint64_t x271;
+    uint64_t x272;
+    fiat_bls12_381_fp_mulx_u64(&x271, &x272, UINT64_C(0x4b1ba7b6434bacd7), x262);
+    uint64_t x273;
+    uint64_t x274;
+    fiat_bls12_381_fp_mulx_u64(&x273, &x274, UINT64_C(0x1a0111ea397fe69a), x262);
+    uint64_t x275;
+    fiat_bls12_381_fp_uint1 x276;
+    fiat_bls12_381_fp_addcarryx_u64(&x275, &x276, 0x0, x265, x264);
+    uint64_t x277;
+    fiat_bls12_381_fp_uint1 x278;
+    fiat_bls12_381_fp_addcarryx_u64(&x277, &x278, x276, x267, x266);
+    uint64_t x279;
+    fiat_bls12_381_fp_uint1 x280;
+    fiat_bls12_381_fp_addcarryx_u64(&x279, &x280, x278, x269, x268);
+    uint64_t x281;
+    fiat_bls12_381_fp_uint1 x282;
+    fiat_bls12_381_fp_addcarryx_u64(&x281, &x282, x280, x271, x270);
+    uint64_t x283;
+    fiat_bls12_381_fp_uint1 x284;
+    fiat_bls12_381_fp_addcarryx_u64(&x283, &x284, x282, x273, x272);
+    uint64_t x285;
+    fiat_bls12_381_fp_uint1 x286;
+    fiat_bls12_381_fp_addcarryx_u64(&x285, &x286, x284, x274, 0x0);
+    uint64_t x287;
+    fiat_bls12_381_fp_uint1 x288;
+    fiat_bls12_381_fp_addcarryx_u64(&x287, &x288, 0x0, x248, x263);
+    uint64_t x289;
+    fiat_bls12_381_fp_uint1 x290;
+    fiat_bls12_381_fp_addcarryx_u64(&x289, &x290, x288, x250, x275);
+    uint64_t x291;
+    fiat_bls12_381_fp_uint1 x292;
+    fiat_bls12_381_fp_addcarryx_u64(&x291, &x292, x290, x252, x277);
+    uint64_t x293;
+    fiat_bls12_381_fp_uint1 x294;
+    fiat_bls12_381_fp_addcarryx_u64(&x293, &x294, x292, x254, x279);
+    uint64_t x295;
+    fiat_bls12_381_fp_uint1 x296;
+    fiat_bls12_381_fp_addcarryx_u64(&x295, &x296, x294, x256, x281);
+    uint64_t x297;
+    fiat_bls12_381_fp_uint1 x298;
+    fiat_bls12_381_fp_addcarryx_u64(&x297, &x298, x296, x258, x283);
+    uint64_t x299;
+    fiat_bls12_381_fp_uint1 x300;
+    fiat_bls12_381_fp_addcarryx_u64(&x299, &x300, x298, x260, x285);
+    uint64_t x301;
+    fiat_bls12_381_fp_uint1 x302;
+    fiat_bls12_381_fp_addcarryx_u64(&x301, &x302, x300, x261, 0x0);
+    uint64_t x303;
+    uint64_t x304;
+    fiat_bls12_381_fp_mulx_u64(&x303, &x304, arg1[0], arg1[4]);
+    uint64_t x305;
+    uint64_t x306;
+    fiat_bls12_381_fp_mulx_u64(&x305, &x306, arg1[1], arg1[4]);
+    uint64_t x307;
+    uint64_t x308;
+    fiat_bls12_381_fp_mulx_u64(&x307, &x308, arg1[2], arg1[4]);
+    uint64_t x309;
+    uint64_t x310;
+    fiat_bls12_381_fp_mulx_u64(&x309, &x310, arg1[3], arg1[4]);
+    uint64_t x311;
+    uint64_t x312;
+    fiat_bls12_381_fp_mulx_u64(&x311, &x312, arg1[4], arg1[4]);
+    uint64_t x313;
+    uint64_t x314;
+    fiat_bls12_381_fp_mulx_u64(&x313, &x314, arg1[5], arg1[4]);
+    uint64_t x315;
+    fiat_bls12_381_fp_uint1 x316;
+    fiat_bls12_381_fp_addcarryx_u64(&x315, &x316, 0x0, x305, x304);
+    uint64_t x317;
+    fiat_bls12_381_fp_uint1 x318;
+    fiat_bls12_381_fp_addcarryx_u64(&x317, &x318, x316, x307, x306);
+    uint64_t x319;
+    fiat_bls12_381_fp_uint1 x320;
+    fiat_bls12_381_fp_addcarryx_u64(&x319, &x320, x318, x309, x308);
+    uint64_t x321;
+    fiat_bls12_381_fp_uint1 x322;
+    fiat_bls12_381_fp_addcarryx_u64(&x321, &x322, x320, x311, x310);
+    uint64_t x323;
+    fiat_bls12_381_fp_uint1 x324;
+    fiat_bls12_381_fp_addcarryx_u64(&x323, &x324, x322, x313, x312);
+    uint64_t x325;
+    fiat_bls12_381_fp_uint1 x326;
+    fiat_bls12_381_fp_addcarryx_u64(&x325, &x326, x324, x314, 0x0);
+    uint64_t x327;
+    fiat_bls12_381_fp_uint1 x328;
+    fiat_bls12_381_fp_addcarryx_u64(&x327, &x328, 0x0, x289, x303);
+    uint64_t x329;
+    fiat_bls12_381_fp_uint1 x330;
+    fiat_bls12_381_fp_addcarryx_u64(&x329, &x330, x328, x291, x315);
+    uint64_t x331;
+    fiat_bls12_381_fp_uint1 x332;
+    fiat_bls12_381_fp_addcarryx_u64(&x331, &x332, x330, x293, x317);
+    uint64_t x333;
+    fiat_bls12_381_fp_uint1 x334;
+    fiat_bls12_381_fp_addcarryx_u64(&x333, &x334, x332, x295, x319);
+    uint64_t x335;
+    fiat_bls12_381_fp_uint1 x336;
+    fiat_bls12_381_fp_addcarryx_u64(&x335, &x336, x334, x297, x321);
+    uint64_t x337;
+    fiat_bls12_381_fp_uint1 x338;
+    fiat_bls12_381_fp_addcarryx_u64(&x337, &x338, x336, x299, x323);
+    uint64_t x339;
+    fiat_bls12_381_fp_uint1 x340;
+    fiat_bls12_381_fp_addcarryx_u64(&x339, &x340, x338, x301, x325);
+    uint64_t x341;
+    x341 = x327 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x342;
+    uint64_t x343;
+    fiat_bls12_381_fp_mulx_u64(&x342, &x343, UINT64_C(0xb9feffffffffaaab), x341);
+    uint64_t x344;
+    uint64_t x345;
+    fiat_bls12_381_fp_mulx_u64(&x344, &x345, UINT64_C(0x1eabfffeb153ffff), x341);
+    uint64_t x346;
+    uint64_t x347;
+    fiat_bls12_381_fp_mulx_u64(&x346, &x347, UINT64_C(0x6730d2a0f6b0f624), x341);
+    uint64_t x348;
+    uint64_t x349;
+    fiat_bls12_381_fp_mulx_u64(&x348, &x349, UINT64_C(0x64774b84f38512bf), x341);
+    uint64_t x350;
+    uint64_t x351;
+    fiat_bls12_381_fp_mulx_u64(&x350, &x351, UINT64_C(0x4b1ba7b6434bacd7), x341);
+    uint64_t x352;
+    uint64_t x353;
+    fiat_bls12_381_fp_mulx_u64(&x352, &x353, UINT64_C(0x1a0111ea397fe69a), x341);
+    uint64_t x354;
+    fiat_bls12_381_fp_uint1 x355;
+    fiat_bls12_381_fp_addcarryx_u64(&x354, &x355, 0x0, x344, x343);
+    uint64_t x356;
+    fiat_bls12_381_fp_uint1 x357;
+    fiat_bls12_381_fp_addcarryx_u64(&x356, &x357, x355, x346, x345);
+    uint64_t x358;
+    fiat_bls12_381_fp_uint1 x359;
+    fiat_bls12_381_fp_addcarryx_u64(&x358, &x359, x357, x348, x347);
+    uint64_t x360;
+    fiat_bls12_381_fp_uint1 x361;
+    fiat_bls12_381_fp_addcarryx_u64(&x360, &x361, x359, x350, x349);
+    uint64_t x362;
+    fiat_bls12_381_fp_uint1 x363;
+    fiat_bls12_381_fp_addcarryx_u64(&x362, &x363, x361, x352, x351);
+    uint64_t x364;
+    fiat_bls12_381_fp_uint1 x365;
+    fiat_bls12_381_fp_addcarryx_u64(&x364, &x365, x363, x353, 0x0);
+    uint64_t x366;
+    fiat_bls12_381_fp_uint1 x367;
+    fiat_bls12_381_fp_addcarryx_u64(&x366, &x367, 0x0, x327, x342);
+    uint64_t x368;
+    fiat_bls12_381_fp_uint1 x369;
+    fiat_bls12_381_fp_addcarryx_u64(&x368, &x369, x367, x329, x354);
+    uint64_t x370;
+    fiat_bls12_381_fp_uint1 x371;
+    fiat_bls12_381_fp_addcarryx_u64(&x370, &x371, x369, x331, x356);
+    uint64_t x372;
+    fiat_bls12_381_fp_uint1 x373;
+    fiat_bls12_381_fp_addcarryx_u64(&x372, &x373, x371, x333, x358);
+    uint64_t x374;
+    fiat_bls12_381_fp_uint1 x375;
+    fiat_bls12_381_fp_addcarryx_u64(&x374, &x375, x373, x335, x360);
+    uint64_t x376;
+    fiat_bls12_381_fp_uint1 x377;
+    fiat_bls12_381_fp_addcarryx_u64(&x376, &x377, x375, x337, x362);
+    uint64_t x378;
+    fiat_bls12_381_fp_uint1 x379;
+    fiat_bls12_381_fp_addcarryx_u64(&x378, &x379, x377, x339, x364);
+    uint64_t x380;
+    fiat_bls12_381_fp_uint1 x381;
+    fiat_bls12_381_fp_addcarryx_u64(&x380, &x381, x379, x340, 0x0);
+    uint64_t x382;
+    uint64_t x383;
+    fiat_bls12_381_fp_mulx_u64(&x382, &x383, arg1[0], arg1[5]);
+    uint64_t x384;
+    uint64_t x385;
+    fiat_bls12_381_fp_mulx_u64(&x384, &x385, arg1[1], arg1[5]);
+    uint64_t x386;
+    uint64_t x387;
+    fiat_bls12_381_fp_mulx_u64(&x386, &x387, arg1[2], arg1[5]);
+    uint64_t x388;
+    uint64_t x389;
+    fiat_bls12_381_fp_mulx_u64(&x388, &x389, arg1[3], arg1[5]);
+    uint64_t x390;
+    uint64_t x391;
+    fiat_bls12_381_fp_mulx_u64(&x390, &x391, arg1[4], arg1[5]);
+    uint64_t x392;
+    uint64_t x393;
+    fiat_bls12_381_fp_mulx_u64(&x392, &x393, arg1[5], arg1[5]);
+    uint64_t x394;
+    fiat_bls12_381_fp_uint1 x395;
+    fiat_bls12_381_fp_addcarryx_u64(&x394, &x395, 0x0, x384, x383);
+    uint64_t x396;
+    fiat_bls12_381_fp_uint1 x397;
+    fiat_bls12_381_fp_addcarryx_u64(&x396, &x397, x395, x386, x385);
+    uint64_t x398;
+    fiat_bls12_381_fp_uint1 x399;
+    fiat_bls12_381_fp_addcarryx_u64(&x398, &x399, x397, x388, x387);
+    uint64_t x400;
+    fiat_bls12_381_fp_uint1 x401;
+    fiat_bls12_381_fp_addcarryx_u64(&x400, &x401, x399, x390, x389);
+    uint64_t x402;
+    fiat_bls12_381_fp_uint1 x403;
+    fiat_bls12_381_fp_addcarryx_u64(&x402, &x403, x401, x392, x391);
+    uint64_t x404;
+    fiat_bls12_381_fp_uint1 x405;
+    fiat_bls12_381_fp_addcarryx_u64(&x404, &x405, x403, x393, 0x0);
+    uint64_t x406;
+    fiat_bls12_381_fp_uint1 x407;
+    fiat_bls12_381_fp_addcarryx_u64(&x406, &x407, 0x0, x368, x382);
+    uint64_t x408;
+    fiat_bls12_381_fp_uint1 x409;
+    fiat_bls12_381_fp_addcarryx_u64(&x408, &x409, x407, x370, x394);
+    uint64_t x410;
+    fiat_bls12_381_fp_uint1 x411;
+    fiat_bls12_381_fp_addcarryx_u64(&x410, &x411, x409, x372, x396);
+    uint64_t x412;
+    fiat_bls12_381_fp_uint1 x413;
+    fiat_bls12_381_fp_addcarryx_u64(&x412, &x413, x411, x374, x398);
+    uint64_t x414;
+    fiat_bls12_381_fp_uint1 x415;
+    fiat_bls12_381_fp_addcarryx_u64(&x414, &x415, x413, x376, x400);
+    uint64_t x416;
+    fiat_bls12_381_fp_uint1 x417;
+    fiat_bls12_381_fp_addcarryx_u64(&x416, &x417, x415, x378, x402);
+    uint64_t x418;
+    fiat_bls12_381_fp_uint1 x419;
+    fiat_bls12_381_fp_addcarryx_u64(&x418, &x419, x417, x380, x404);
+    uint64_t x420;
+    x420 = x406 * UINT64_C(0x89f3fffcfffcfffd);
+    uint64_t x421;
+    uint64_t x422;
+    fiat_bls12_381_fp_mulx_u64(&x421, &x422, UINT64_C(0xb9feffffffffaaab), x420);
+    uint64_t x423;
+    uint64_t x424;
+    fiat_bls12_381_fp_mulx_u64(&x423, &x424, UINT64_C(0x1eabfffeb153ffff), x420);
+    uint64_t x425;
+    uint64_t x426;
+    fiat_bls12_381_fp_mulx_u64(&x425, &x426, UINT64_C(0x6730d2a0f6b0f624), x420);
+    uint64_t x427;
+    uint64_t x428;
+    fiat_bls12_381_fp_mulx_u64(&x427, &x428, UINT64_C(0x64774b84f38512bf), x420);
+    uint64_t x429;
+    uint64_t x430;
+    fiat_bls12_381_fp_mulx_u64(&x429, &x430, UINT64_C(0x4b1ba7b6434bacd7), x420);
+    uint64_t x431;
+    uint64_t x432;
+    fiat_bls12_381_fp_mulx_u64(&x431, &x432, UINT64_C(0x1a0111ea397fe69a), x420);
+    uint64_t x433;
+    fiat_bls12_381_fp_uint1 x434;
+    fiat_bls12_381_fp_addcarryx_u64(&x433, &x434, 0x0, x423, x422);
+    uint64_t x435;
+    fiat_bls12_381_fp_uint1 x436;
+    fiat_bls12_381_fp_addcarryx_u64(&x435, &x436, x434, x425, x424);
+    uint64_t x437;
+    fiat_bls12_381_fp_uint1 x438;
+    fiat_bls12_381_fp_addcarryx_u64(&x437, &x438, x436, x427, x426);
+    uint64_t x439;
+    fiat_bls12_381_fp_uint1 x440;
+    fiat_bls12_381_fp_addcarryx_u64(&x439, &x440, x438, x429, x428);
+    uint64_t x441;
+    fiat_bls12_381_fp_uint1 x442;
+    fiat_bls12_381_fp_addcarryx_u64(&x441, &x442, x440, x431, x430);
+    uint64_t x443;
+    fiat_bls12_381_fp_uint1 x444;
+    fiat_bls12_381_fp_addcarryx_u64(&x443, &x444, x442, x432, 0x0);
+    uint64_t x445;
+    fiat_bls12_381_fp_uint1 x446;
+    fiat_bls12_381_fp_addcarryx_u64(&x445, &x446, 0x0, x406, x421);
+    uint64_t x447;
+    fiat_bls12_381_fp_uint1 x448;
+    fiat_bls12_381_fp_addcarryx_u64(&x447, &x448, x446, x408, x433);
+    uint64_t x449;
+    fiat_bls12_381_fp_uint1 x450;
+    fiat_bls12_381_fp_addcarryx_u64(&x449, &x450, x448, x410, x435);
+    uint64_t x451;
+    fiat_bls12_381_fp_uint1 x452;
+    fiat_bls12_381_fp_addcarryx_u64(&x451, &x452, x450, x412, x437);
+    uint64_t x453;
+    fiat_bls12_381_fp_uint1 x454;
+    fiat_bls12_381_fp_addcarryx_u64(&x453, &x454, x452, x414, x439);
+    uint64_t x455;
+    fiat_bls12_381_fp_uint1 x456;
+    fiat_bls12_381_fp_addcarryx_u64(&x455, &x456, x454, x416, x441);
+    uint64_t x457;
+    fiat_bls12_381_fp_uint1 x458;
+    fiat_bls12_381_fp_addcarryx_u64(&x457, &x458, x456, x418, x443);
+    uint64_t x459;
+    fiat_bls12_381_fp_uint1 x460;
+    fiat_bls12_381_fp_addcarryx_u64(&x459, &x460, x458, x419, 0x0);
+    uint64_t x461;
+    fiat_bls12_381_fp_uint1 x462;
+    fiat_bls12_381_fp_subborrowx_u64(&x461, &x462, 0x0, x447, UINT64_C(0xb9feffffffffaaab));
+    uint64_t x463;
+    fiat_bls12_381_fp_uint1 x464;
+    fiat_bls12_381_fp_subborrowx_u64(&x463, &x464, x462, x449, UINT64_C(0x1eabfffeb153ffff));
+    uint64_t x465;
+    fiat_bls12_381_fp_uint1 x466;
+    fiat_bls12_381_fp_subborrowx_u64(&x465, &x466, x464, x451, UINT64_C(0x6730d2a0f6b0f624));
+    uint64_t x467;
+    fiat_bls12_381_fp_uint1 x468;
+    fiat_bls12_381_fp_subborrowx_u64(&x467, &x468, x466, x453, UINT64_C(0x64774b84f38512bf));
+    uint64_t x469;
+    fiat_bls12_381_fp_uint1 x470;
+    fiat_bls12_381_fp_subborrowx_u64(&x469, &x470, x468, x455, UINT64_C(0x4b1ba7b6434bacd7));
+    uint64_t x471;
+    fiat_bls12_381_fp_uint1 x472;
+    fiat_bls12_381_fp_subborrowx_u64(&x471, &x472, x470, x457, UINT64_C(0x1a0111ea397fe69a));
+    uint64_t x473;
+    fiat_bls12_381_fp_uint1 x474;
+    fiat_bls12_381_fp_subborrowx_u64(&x473, &x474, x472, x459, 0x0);
+    uint64_t x475;
+    fiat_bls12_381_fp_cmovznz_u64(&x475, x474, x461, x447);
+    uint64_t x476;
+    fiat_bls12_381_fp_cmovznz_u64(&x476, x474, x463, x449);
+    uint64_t x477;
+    fiat_bls12_381_fp_cmovznz_u64(&x477, x474, x465, x451);
+    uint64_t x478;
+    fiat_bls12_381_fp_cmovznz_u64(&x478, x474, x467, x453);
+    uint64_t x479;
+    fiat_bls12_381_fp_cmovznz_u64(&x479, x474, x469, x455);
+    uint64_t x480;
+    fiat_bls12_381_fp_cmovznz_u64(&x480, x474, x471, x457);
+    out1[0] = x475;
+    out1[1] = x476;
+    out1[2] = x477;
+    out1[3] = x478;
+    out1[4] = x479;
+    out1[5] = x480;
+}
+
+// out1 = arg1 + arg2 mod p
+static void fiat_bls12_381_fp_add(uint64_t out1[6], const uint64_t arg1[6], const uint64_t arg2[6]) {
+    uint64_t x1;
+    fiat_bls12_381_fp_uint1 x2;
+    fiat_bls12_381_fp_addcarryx_u64(&x1, &x2, 0x0, arg1[0], arg2[0]);
+    uint64_t x3;
+    fiat_bls12_381_fp_uint1 x4;
+    fiat_bls12_381_fp_addcarryx_u64(&x3, &x4, x2, arg1[1], arg2[1]);
+    uint64_t x5;
+    fiat_bls12_381_fp_uint1 x6;
+    fiat_bls12_381_fp_addcarryx_u64(&x5, &x6, x4, arg1[2], arg2[2]);
+    uint64_t x7;
+    fiat_bls12_381_fp_uint1 x8;
+    fiat_bls12_381_fp_addcarryx_u64(&x7, &x8, x6, arg1[3], arg2[3]);
+    uint64_t x9;
+    fiat_bls12_381_fp_uint1 x10;
+    fiat_bls12_381_fp_addcarryx_u64(&x9, &x10, x8, arg1[4], arg2[4]);
+    uint64_t x11;
+    fiat_bls12_381_fp_uint1 x12;
+    fiat_bls12_381_fp_addcarryx_u64(&x11, &x12, x10, arg1[5], arg2[5]);
+    uint64_t x13;
+    fiat_bls12_381_fp_uint1 x14;
+    fiat_bls12_381_fp_subborrowx_u64(&x13, &x14, 0x0, x1, UINT64_C(0xb9feffffffffaaab));
+    uint64_t x15;
+    fiat_bls12_381_fp_uint1 x16;
+    fiat_bls12_381_fp_subborrowx_u64(&x15, &x16, x14, x3, UINT64_C(0x1eabfffeb153ffff));
+    uint64_t x17;
+    fiat_bls12_381_fp_uint1 x18;
+    fiat_bls12_381_fp_subborrowx_u64(&x17, &x18, x16, x5, UINT64_C(0x6730d2a0f6b0f624));
+    uint64_t x19;
+    fiat_bls12_381_fp_uint1 x20;
+    fiat_bls12_381_fp_subborrowx_u64(&x19, &x20, x18, x7, UINT64_C(0x64774b84f38512bf));
+    uint64_t x21;
+    fiat_bls12_381_fp_uint1 x22;
+    fiat_bls12_381_fp_subborrowx_u64(&x21, &x22, x20, x9, UINT64_C(0x4b1ba7b6434bacd7));
+    uint64_t x23;
+    fiat_bls12_381_fp_uint1 x24;
+    fiat_bls12_381_fp_subborrowx_u64(&x23, &x24, x22, x11, UINT64_C(0x1a0111ea397fe69a));
+    uint64_t x25;
+    fiat_bls12_381_fp_uint1 x26;
+    fiat_bls12_381_fp_subborrowx_u64(&x25, &x26, x24, x12, 0x0);
+    uint64_t x27;
+    fiat_bls12_381_fp_cmovznz_u64(&x27, x26, x13, x1);
+    uint64_t x28;
+    fiat_bls12_381_fp_cmovznz_u64(&x28, x26, x15, x3);
+    uint64_t x29;
+    fiat_bls12_381_fp_cmovznz_u64(&x29, x26, x17, x5);
+    uint64_t x30;
+    fiat_bls12_381_fp_cmovznz_u64(&x30, x26, x19, x7);
+    uint64_t x31;
+    fiat_bls12_381_fp_cmovznz_u64(&x31, x26, x21, x9);
+    uint64_t x32;
+    fiat_bls12_381_fp_cmovznz_u64(&x32, x26, x23, x11);
+    out1[0] = x27;
+    out1[1] = x28;
+    out1[2] = x29;
+    out1[3] = x30;
+    out1[4] = x31;
+    out1[5] = x32;
+}
+
+// out1 = arg1 - arg2 mod p
+static void fiat_bls12_381_fp_sub(uint64_t out1[6], const uint64_t arg1[6], const uint64_t arg2[6]) {
+    uint64_t x1;
+    fiat_bls12_381_fp_uint1 x2;
+    fiat_bls12_381_fp_subborrowx_u64(&x1, &x2, 0x0, arg1[0], arg2[0]);
+    uint64_t x3;
+    fiat_bls12_381_fp_uint1 x4;
+    fiat_bls12_381_fp_subborrowx_u64(&x3, &x4, x2, arg1[1], arg2[1]);
+    uint64_t x5;
+    fiat_bls12_381_fp_uint1 x6;
+    fiat_bls12_381_fp_subborrowx_u64(&x5, &x6, x4, arg1[2], arg2[2]);
+    uint64_t x7;
+    fiat_bls12_381_fp_uint1 x8;
+    fiat_bls12_381_fp_subborrowx_u64(&x7, &x8, x6, arg1[3], arg2[3]);
+    uint64_t x9;
+    fiat_bls12_381_fp_uint1 x10;
+    fiat_bls12_381_fp_subborrowx_u64(&x9, &x10, x8, arg1[4], arg2[4]);
+    uint64_t x11;
+    fiat_bls12_381_fp_uint1 x12;
+    fiat_bls12_381_fp_subborrowx_u64(&x11, &x12, x10, arg1[5], arg2[5]);
+    uint64_t x13;
+    fiat_bls12_381_fp_cmovznz_u64(&x13, x12, 0x0, UINT64_C(0xffffffffffffffff));
+    uint64_t x14;
+    x14 = x13 & UINT64_C(0xb9feffffffffaaab);
+    uint64_t x15;
+    x15 = x13 & UINT64_C(0x1eabfffeb153ffff);
+    uint64_t x16;
+    x16 = x13 & UINT64_C(0x6730d2a0f6b0f624);
+    uint64_t x17;
+    x17 = x13 & UINT64_C(0x64774b84f38512bf);
+    uint64_t x18;
+    x18 = x13 & UINT64_C(0x4b1ba7b6434bacd7);
+    uint64_t x19;
+    x19 = x13 & UINT64_C(0x1a0111ea397fe69a);
+    uint64_t x20;
+    fiat_bls12_381_fp_uint1 x21;
+    fiat_bls12_381_fp_addcarryx_u64(&x20, &x21, 0x0, x1, x14);
+    uint64_t x22;
+    fiat_bls12_381_fp_uint1 x23;
+    fiat_bls12_381_fp_addcarryx_u64(&x22, &x23, x21, x3, x15);
+    uint64_t x24;
+    fiat_bls12_381_fp_uint1 x25;
+    fiat_bls12_381_fp_addcarryx_u64(&x24, &x25, x23, x5, x16);
+    uint64_t x26;
+    fiat_bls12_381_fp_uint1 x27;
+    fiat_bls12_381_fp_addcarryx_u64(&x26, &x27, x25, x7, x17);
+    uint64_t x28;
+    fiat_bls12_381_fp_uint1 x29;
+    fiat_bls12_381_fp_addcarryx_u64(&x28, &x29, x27, x9, x18);
+    uint64_t x30;
+    fiat_bls12_381_fp_uint1 x31;
+    fiat_bls12_381_fp_addcarryx_u64(&x30, &x31, x29, x11, x19);
+    out1[0] = x20;
+    out1[1] = x22;
+    out1[2] = x24;
+    out1[3] = x26;
+    out1[4] = x28;
+    out1[5] = x30;
+}
+
+/*
+ * out1 = arg1^(p - 2): 377 squarings and 67 multiplications after the table of odd powers.
+ * The chain depends only on p, so inversion takes the same time for every input.
+ */
+static void fiat_bls12_381_fp_inv(uint64_t out1[6], const uint64_t arg1[6]) {
+    uint64_t t[16][6], x[6];
+    int i;
+
+    // t[k] = arg1^(2k + 1)
+    fiat_bls12_381_fp_square(x, arg1);
+    memcpy(t[0], arg1, sizeof(t[0]));
+    for (i = 1; i < 16; i++)
+        fiat_bls12_381_fp_mul(t[i], t[i - 1], x);
+
+    memcpy(x, t[6], sizeof(x));
+    for (i = 0; i < 13; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[8]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[7]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[2]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[3]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[11]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[12]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[2]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[4]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[1]);
+    for (i = 0; i < 8; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[13]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[2]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[7]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[13]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[0]);
+    for (i = 0; i < 8; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[11]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[5]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[14]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[4]);
+    for (i = 0; i < 8; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[14]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[11]);
+    for (i = 0; i < 9; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[9]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[12]);
+    for (i = 0; i < 2; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[1]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[2]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[4]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[11]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[14]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[9]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[9]);
+    for (i = 0; i < 8; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[10]);
+    for (i = 0; i < 9; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[7]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[1]);
+    for (i = 0; i < 8; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[7]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[1]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[4]);
+    for (i = 0; i < 9; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[7]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[10]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[1]);
+    for (i = 0; i < 8; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[10]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[7]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[3]);
+    for (i = 0; i < 7; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[14]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 5; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[15]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[6]);
+    for (i = 0; i < 6; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[10]);
+    for (i = 0; i < 4; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[2]);
+    for (i = 0; i < 3; i++)
+        fiat_bls12_381_fp_square(x, x);
+    fiat_bls12_381_fp_mul(x, x, t[0]);
+
+    memcpy(out1, x, sizeof(x));
+}
+
+/*
+ * Fp2 = Fp[i] / (i^2 + 1). Outputs are written after all reads, so they may alias inputs.
+ */
+static void fiat_bls12_381_fp2_mul(uint64_t out1[6], uint64_t out2[6], const uint64_t a0[6], const uint64_t a1[6],
+                       const uint64_t b0[6], const uint64_t b1[6]) {
+    uint64_t t0[6], t1[6], t2[6], t3[6];
+
+    // Karatsuba: (a0 b0 - a1 b1) + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) i
+    fiat_bls12_381_fp_mul(t0, a0, b0);
+    fiat_bls12_381_fp_mul(t1, a1, b1);
+    fiat_bls12_381_fp_add(t2, a0, a1);
+    fiat_bls12_381_fp_add(t3, b0, b1);
+    fiat_bls12_381_fp_mul(t2, t2, t3);
+    fiat_bls12_381_fp_sub(t2, t2, t0);
+    fiat_bls12_381_fp_sub(t2, t2, t1);
+    fiat_bls12_381_fp_sub(out1, t0, t1);
+    memcpy(out2, t2, sizeof(t2));
+}
+
+static void fiat_bls12_381_fp2_square(uint64_t out1[6], uint64_t out2[6], const uint64_t a0[6], const uint64_t a1[6]) {
+    uint64_t t0[6], t1[6], t2[6];
+
+    // (a0 + a1)(a0 - a1) + 2 a0 a1 i
+    fiat_bls12_381_fp_add(t0, a0, a1);
+    fiat_bls12_381_fp_sub(t1, a0, a1);
+    fiat_bls12_381_fp_mul(t2, a0, a1);
+    fiat_bls12_381_fp_mul(out1, t0, t1);
+    fiat_bls12_381_fp_add(out2, t2, t2);
+}
+
+#endif //PYTHIA_PYTHIA_FP381_H
@@ -0,0 +1,1229 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <relic/relic.h>
+#include <relic/relic_err.h>
+#include "pythia_fp8.h"
+#include "pythia_cpu.h"
+#include "pythia_fp.h"
+#include "pythia_batch_c.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && DIGIT == 64 && FP_DIGS == 6
+#define FP8_IFMA 1
+#include <immintrin.h>
+#else
+#define FP8_IFMA 0
+#endif
+
+#define LANES PYTHIA_FP8_LANES
+#define LIMBS 8
+#define MASK52 0xFFFFFFFFFFFFFULL
+
+static int fp8_supported = 0;
+static int fp8_on = 0;
+
+#if FP8_IFMA
+
+/*
+ * Field elements are kept in 8 limbs of 52 bits, in Montgomery form with R = 2^416 and fully reduced,
+ * so that results can be copied back to relic digit by digit. Vector j holds limb j of all lanes.
+ */
+static uint64_t fp8_p[LIMBS];    // modulus
+static uint64_t fp8_pinv;        // -p^-1 mod 2^52
+static uint64_t fp8_to[LIMBS];   // R^2 / R_relic mod p, converts relic digits to lanes
+static uint64_t fp8_from[LIMBS]; // R_relic mod p, converts lanes back to relic digits
+static uint64_t fp8_one[LIMBS];  // R mod p
+static uint64_t fp8_xi[2][LIMBS];
+static int fp8_xi_one_plus_i;    // non-residue of Fp6 is 1 + i, so multiplication by it takes two additions
+
+#define FP8_TARGET __attribute__((target("avx512f,avx512ifma")))
+
+typedef struct {
+    __m512i l[LIMBS];
+} lane_fp_t;
+
+typedef struct {
+    lane_fp_t c[2];
+} lane_fp2_t;
+
+typedef struct {
+    lane_fp2_t c[3];
+} lane_fp6_t;
+
+typedef struct {
+    lane_fp6_t c[2];
+} lane_fp12_t;
+
+#define FP12_VECS (sizeof(lane_fp12_t) / sizeof(__m512i))
+
+static void digs_to_limbs(uint64_t *l, const dig_t *d) {
+    for (int i = 0; i < LIMBS; i++) {
+        int w = 52 * i / 64, s = 52 * i % 64;
+        uint64_t v = d[w] >> s;
+        if (s > 12 && w + 1 < FP_DIGS)
+            v |= d[w + 1] << (64 - s);
+        l[i] = v & MASK52;
+    }
+}
+
+static void limbs_to_digs(dig_t *d, const uint64_t *l) {
+    memset(d, 0, FP_DIGS * sizeof(dig_t));
+    for (int i = 0; i < LIMBS; i++) {
+        int w = 52 * i / 64, s = 52 * i % 64;
+        d[w] |= l[i] << s;
+        if (s > 12 && w + 1 < FP_DIGS)
+            d[w + 1] |= l[i] >> (64 - s);
+    }
+}
+
+FP8_TARGET
+static void lfp_set1(lane_fp_t *c, const uint64_t *a) {
+    for (int j = 0; j < LIMBS; j++)
+        c->l[j] = _mm512_set1_epi64((long long)a[j]);
+}
+
+// Propagates carries of t < 2p and subtracts p if needed
+FP8_TARGET
+static void lfp_norm(lane_fp_t *c, __m512i *t) {
+    const __m512i mask = _mm512_set1_epi64((long long)MASK52);
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i d[LIMBS], carry = zero;
+
+    for (int j = 0; j < LIMBS - 1; j++) {
+        t[j + 1] = _mm512_add_epi64(t[j + 1], _mm512_srli_epi64(t[j], 52));
+        t[j] = _mm512_and_si512(t[j], mask);
+    }
+
+    for (int j = 0; j < LIMBS; j++) {
+        __m512i x = _mm512_add_epi64(_mm512_sub_epi64(t[j], _mm512_set1_epi64((long long)fp8_p[j])), carry);
+        d[j] = _mm512_and_si512(x, mask);
+        carry = _mm512_srai_epi64(x, 52);
+    }
+
+    __mmask8 lt = _mm512_cmplt_epi64_mask(carry, zero);
+    for (int j = 0; j < LIMBS; j++)
+        c->l[j] = _mm512_mask_blend_epi64(lt, d[j], t[j]);
+}
+
+/*
+ * Montgomery multiplication, operand scanning. Low and high halves of 52-bit products are accumulated
+ * in separate 64-bit columns, which have enough room for all 8 rounds without intermediate carries.
+ */
+FP8_TARGET
+static void lfp_mul(lane_fp_t *c, const lane_fp_t *a, const lane_fp_t *b) {
+    const __m512i mask = _mm512_set1_epi64((long long)MASK52);
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i pinv = _mm512_set1_epi64((long long)fp8_pinv);
+    __m512i p[LIMBS], t[LIMBS + 1];
+
+    for (int j = 0; j < LIMBS; j++) {
+        p[j] = _mm512_set1_epi64((long long)fp8_p[j]);
+        t[j] = zero;
+    }
+    t[LIMBS] = zero;
+
+    for (int i = 0; i < LIMBS; i++) {
+        __m512i bi = b->l[i];
+
+        for (int j = 0; j < LIMBS; j++)
+            t[j] = _mm512_madd52lo_epu64(t[j], a->l[j], bi);
+        for (int j = 0; j < LIMBS; j++)
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a->l[j], bi);
+
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+        t[0] = _mm512_and_si512(t[0], mask);
+
+        __m512i m = _mm512_madd52lo_epu64(zero, t[0], pinv);
+
+        for (int j = 0; j < LIMBS; j++)
+            t[j] = _mm512_madd52lo_epu64(t[j], m, p[j]);
+        for (int j = 0; j < LIMBS; j++)
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], m, p[j]);
+
+        // Lowest column is now 0 or 2^52
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+        for (int j = 0; j < LIMBS; j++)
+            t[j] = t[j + 1];
+        t[LIMBS] = zero;
+    }
+
+    lfp_norm(c, t);
+}
+
+FP8_TARGET
+static void lfp_add(lane_fp_t *c, const lane_fp_t *a, const lane_fp_t *b) {
+    __m512i t[LIMBS];
+
+    for (int j = 0; j < LIMBS; j++)
+        t[j] = _mm512_add_epi64(a->l[j], b->l[j]);
+
+    lfp_norm(c, t);
+}
+
+FP8_TARGET
+static void lfp_sub(lane_fp_t *c, const lane_fp_t *a, const lane_fp_t *b) {
+    const __m512i mask = _mm512_set1_epi64((long long)MASK52);
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i d[LIMBS], e[LIMBS], carry = zero;
+
+    for (int j = 0; j < LIMBS; j++) {
+        __m512i x = _mm512_add_epi64(_mm512_sub_epi64(a->l[j], b->l[j]), carry);
+        d[j] = _mm512_and_si512(x, mask);
+        carry = _mm512_srai_epi64(x, 52);
+    }
+
+    __mmask8 neg = _mm512_cmplt_epi64_mask(carry, zero);
+
+    // Difference wrapped modulo 2^416, adding p and dropping the top carry gives a - b + p
+    carry = zero;
+    for (int j = 0; j < LIMBS; j++) {
+        __m512i x = _mm512_add_epi64(_mm512_add_epi64(d[j], _mm512_set1_epi64((long long)fp8_p[j])), carry);
+        e[j] = _mm512_and_si512(x, mask);
+        carry = _mm512_srli_epi64(x, 52);
+    }
+
+    for (int j = 0; j < LIMBS; j++)
+        c->l[j] = _mm512_mask_blend_epi64(neg, d[j], e[j]);
+}
+
+/*
+ * Tower arithmetic follows relic: Fp2 = Fp[i] / (i^2 + 1), Fp6 = Fp2[v] / (v^3 - xi), Fp12 = Fp6[w] / (w^2 - v),
+ * where xi is the non-residue used by fp2_mul_nor. Outputs may alias inputs.
+ */
+FP8_TARGET
+static void lfp2_add(lane_fp2_t *c, const lane_fp2_t *a, const lane_fp2_t *b) {
+    lfp_add(&c->c[0], &a->c[0], &b->c[0]);
+    lfp_add(&c->c[1], &a->c[1], &b->c[1]);
+}
+
+FP8_TARGET
+static void lfp2_sub(lane_fp2_t *c, const lane_fp2_t *a, const lane_fp2_t *b) {
+    lfp_sub(&c->c[0], &a->c[0], &b->c[0]);
+    lfp_sub(&c->c[1], &a->c[1], &b->c[1]);
+}
+
+FP8_TARGET
+static void lfp2_mul(lane_fp2_t *c, const lane_fp2_t *a, const lane_fp2_t *b) {
+    lane_fp_t t0, t1, t2, t3;
+
+    lfp_mul(&t0, &a->c[0], &b->c[0]);
+    lfp_mul(&t1, &a->c[1], &b->c[1]);
+    lfp_add(&t2, &a->c[0], &a->c[1]);
+    lfp_add(&t3, &b->c[0], &b->c[1]);
+    lfp_mul(&t2, &t2, &t3);
+
+    lfp_sub(&t2, &t2, &t0);
+    lfp_sub(&c->c[1], &t2, &t1);
+    lfp_sub(&c->c[0], &t0, &t1);
+}
+
+FP8_TARGET
+static void lfp2_mul_nor(lane_fp2_t *c, const lane_fp2_t *a) {
+    if (fp8_xi_one_plus_i) {
+        lane_fp_t t;
+
+        lfp_sub(&t, &a->c[0], &a->c[1]);
+        lfp_add(&c->c[1], &a->c[0], &a->c[1]);
+        c->c[0] = t;
+    } else {
+        lane_fp2_t xi;
+
+        lfp_set1(&xi.c[0], fp8_xi[0]);
+        lfp_set1(&xi.c[1], fp8_xi[1]);
+        lfp2_mul(c, a, &xi);
+    }
+}
+
+FP8_TARGET
+static void lfp6_add(lane_fp6_t *c, const lane_fp6_t *a, const lane_fp6_t *b) {
+    for (int i = 0; i < 3; i++)
+        lfp2_add(&c->c[i], &a->c[i], &b->c[i]);
+}
+
+FP8_TARGET
+static void lfp6_sub(lane_fp6_t *c, const lane_fp6_t *a, const lane_fp6_t *b) {
+    for (int i = 0; i < 3; i++)
+        lfp2_sub(&c->c[i], &a->c[i], &b->c[i]);
+}
+
+// Karatsuba multiplication, 6 multiplications in Fp2
+FP8_TARGET
+static void lfp6_mul(lane_fp6_t *c, const lane_fp6_t *a, const lane_fp6_t *b) {
+    lane_fp2_t v0, v1, v2, s, t;
+    lane_fp6_t r;
+
+    lfp2_mul(&v0, &a->c[0], &b->c[0]);
+    lfp2_mul(&v1, &a->c[1], &b->c[1]);
+    lfp2_mul(&v2, &a->c[2], &b->c[2]);
+
+    // c0 = ((a1 + a2)(b1 + b2) - v1 - v2) * xi + v0
+    lfp2_add(&s, &a->c[1], &a->c[2]);
+    lfp2_add(&t, &b->c[1], &b->c[2]);
+    lfp2_mul(&s, &s, &t);
+    lfp2_sub(&s, &s, &v1);
+    lfp2_sub(&s, &s, &v2);
+    lfp2_mul_nor(&s, &s);
+    lfp2_add(&r.c[0], &s, &v0);
+
+    // c1 = (a0 + a1)(b0 + b1) - v0 - v1 + v2 * xi
+    lfp2_add(&s, &a->c[0], &a->c[1]);
+    lfp2_add(&t, &b->c[0], &b->c[1]);
+    lfp2_mul(&s, &s, &t);
+    lfp2_sub(&s, &s, &v0);
+    lfp2_sub(&s, &s, &v1);
+    lfp2_mul_nor(&t, &v2);
+    lfp2_add(&r.c[1], &s, &t);
+
+    // c2 = (a0 + a2)(b0 + b2) - v0 - v2 + v1
+    lfp2_add(&s, &a->c[0], &a->c[2]);
+    lfp2_add(&t, &b->c[0], &b->c[2]);
+    lfp2_mul(&s, &s, &t);
+    lfp2_sub(&s, &s, &v0);
+    lfp2_sub(&s, &s, &v2);
+    lfp2_add(&r.c[2], &s, &v1);
+
+    *c = r;
+}
+
+// Multiplication by v
+FP8_TARGET
+static void lfp6_mul_art(lane_fp6_t *c, const lane_fp6_t *a) {
+    lane_fp2_t t;
+
+    lfp2_mul_nor(&t, &a->c[2]);
+    c->c[2] = a->c[1];
+    c->c[1] = a->c[0];
+    c->c[0] = t;
+}
+
+FP8_TARGET
+static void lfp12_mul(lane_fp12_t *c, const lane_fp12_t *a, const lane_fp12_t *b) {
+    lane_fp6_t t0, t1, s, t;
+
+    lfp6_mul(&t0, &a->c[0], &b->c[0]);
+    lfp6_mul(&t1, &a->c[1], &b->c[1]);
+
+    lfp6_add(&s, &a->c[0], &a->c[1]);
+    lfp6_add(&t, &b->c[0], &b->c[1]);
+    lfp6_mul(&s, &s, &t);
+    lfp6_sub(&s, &s, &t0);
+    lfp6_sub(&c->c[1], &s, &t1);
+
+    lfp6_mul_art(&t1, &t1);
+    lfp6_add(&c->c[0], &t0, &t1);
+}
+
+FP8_TARGET
+static void lfp2_sqr(lane_fp2_t *c, const lane_fp2_t *a) {
+    lane_fp_t t0, t1;
+
+    lfp_add(&t0, &a->c[0], &a->c[1]);
+    lfp_sub(&t1, &a->c[0], &a->c[1]);
+    lfp_mul(&c->c[1], &a->c[0], &a->c[1]);
+    lfp_add(&c->c[1], &c->c[1], &c->c[1]);
+    lfp_mul(&c->c[0], &t0, &t1);
+}
+
+// Squaring in Fp4 = Fp2[w] / (w^2 - xi): c0 = a^2 + b^2 xi, c1 = 2ab
+FP8_TARGET
+static void lfp4_sqr(lane_fp2_t *c0, lane_fp2_t *c1, const lane_fp2_t *a, const lane_fp2_t *b) {
+    lane_fp2_t t0, t1, t2;
+
+    lfp2_sqr(&t0, a);
+    lfp2_sqr(&t1, b);
+    lfp2_mul_nor(&t2, &t1);
+    lfp2_add(&t2, &t2, &t0);
+
+    lfp2_add(c1, a, b);
+    lfp2_sqr(c1, c1);
+    lfp2_sub(c1, c1, &t0);
+    lfp2_sub(c1, c1, &t1);
+    *c0 = t2;
+}
+
+// z = 3t - 2z
+FP8_TARGET
+static void lfp2_cyc_sub(lane_fp2_t *z, const lane_fp2_t *t) {
+    lfp2_sub(z, t, z);
+    lfp2_add(z, z, z);
+    lfp2_add(z, z, t);
+}
+
+// z = 3t + 2z
+FP8_TARGET
+static void lfp2_cyc_add(lane_fp2_t *z, const lane_fp2_t *t) {
+    lfp2_add(z, t, z);
+    lfp2_add(z, z, z);
+    lfp2_add(z, z, t);
+}
+
+/*
+ * Granger-Scott squaring of elements of the cyclotomic subgroup, which contains GT, 9 squarings in Fp2 instead of 2 multiplications in Fp6.
+ * Fp12 is viewed as Fp4^3 with pairs (z0, z1), (z2, z3), (z4, z5) below.
+ */
+FP8_TARGET
+static void lfp12_sqr_cyc(lane_fp12_t *c, const lane_fp12_t *a) {
+    lane_fp2_t z0 = a->c[0].c[0], z4 = a->c[0].c[1], z3 = a->c[0].c[2];
+    lane_fp2_t z2 = a->c[1].c[0], z1 = a->c[1].c[1], z5 = a->c[1].c[2];
+    lane_fp2_t t0, t1, t2, t3;
+
+    lfp4_sqr(&t0, &t1, &z0, &z1);
+    lfp2_cyc_sub(&z0, &t0);
+    lfp2_cyc_add(&z1, &t1);
+
+    lfp4_sqr(&t0, &t1, &z2, &z3);
+    lfp4_sqr(&t2, &t3, &z4, &z5);
+
+    lfp2_cyc_sub(&z4, &t0);
+    lfp2_cyc_add(&z5, &t1);
+
+    lfp2_mul_nor(&t0, &t3);
+    lfp2_cyc_add(&z2, &t0);
+    lfp2_cyc_sub(&z3, &t2);
+
+    c->c[0].c[0] = z0;
+    c->c[0].c[1] = z4;
+    c->c[0].c[2] = z3;
+    c->c[1].c[0] = z2;
+    c->c[1].c[1] = z1;
+    c->c[1].c[2] = z5;
+}
+
+FP8_TARGET
+static void lfp12_set_one(lane_fp12_t *c) {
+    memset(c, 0, sizeof(*c));
+    lfp_set1(&c->c[0].c[0].c[0], fp8_one);
+}
+
+// Loads count field elements into lanes, unused lanes repeat the first element
+FP8_TARGET
+static void lfp_load(lane_fp_t *c, fp_t *a, size_t count) {
+    uint64_t l[LANES][LIMBS];
+    lane_fp_t t, to;
+
+    for (size_t i = 0; i < LANES; i++)
+        digs_to_limbs(l[i], a[i < count ? i : 0]);
+
+    for (int j = 0; j < LIMBS; j++)
+        t.l[j] = _mm512_set_epi64((long long)l[7][j], (long long)l[6][j], (long long)l[5][j], (long long)l[4][j],
+                                  (long long)l[3][j], (long long)l[2][j], (long long)l[1][j], (long long)l[0][j]);
+
+    lfp_set1(&to, fp8_to);
+    lfp_mul(c, &t, &to);
+}
+
+FP8_TARGET
+static void lfp_store(fp_t *c, const lane_fp_t *a, size_t count) {
+    uint64_t l[LIMBS][LANES];
+    lane_fp_t t, from;
+
+    lfp_set1(&from, fp8_from);
+    lfp_mul(&t, a, &from);
+
+    for (int j = 0; j < LIMBS; j++)
+        _mm512_storeu_si512((void *)l[j], t.l[j]);
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t v[LIMBS];
+        for (int j = 0; j < LIMBS; j++)
+            v[j] = l[j][i];
+        limbs_to_digs(c[i], v);
+    }
+}
+
+FP8_TARGET
+static void lfp12_load(lane_fp12_t *c, gt_t *a, size_t count) {
+    fp_t f[LANES];
+
+    for (int x = 0; x < 2; x++)
+        for (int y = 0; y < 3; y++)
+            for (int z = 0; z < 2; z++) {
+                for (size_t i = 0; i < count; i++)
+                    f[i] = a[i][x][y][z];
+                lfp_load(&c->c[x].c[y].c[z], f, count);
+            }
+}
+
+FP8_TARGET
+static void lfp12_store(gt_t *c, const lane_fp12_t *a, size_t count) {
+    fp_t f[LANES];
+
+    for (int x = 0; x < 2; x++)
+        for (int y = 0; y < 3; y++)
+            for (int z = 0; z < 2; z++) {
+                for (size_t i = 0; i < count; i++)
+                    f[i] = c[i][x][y][z];
+                lfp_store(f, &a->c[x].c[y].c[z], count);
+            }
+}
+
+/*
+ * Rows of a batch hold the same digit of 8 consecutive elements in one aligned vector, so that digits are
+ * regrouped into 52-bit limbs with vector shifts. Stores are masked to keep rows past count zero.
+ */
+FP8_TARGET
+static void lfp_load_rows(lane_fp_t *c, const batch_rows_t *r, size_t k, size_t i) {
+    const __m512i mask = _mm512_set1_epi64((long long)MASK52);
+    __m512i d[FP_DIGS];
+    lane_fp_t t, to;
+
+    for (int j = 0; j < FP_DIGS; j++)
+        d[j] = _mm512_load_si512((const void *)(batch_row(r, k, j) + i));
+
+    for (int j = 0; j < LIMBS; j++) {
+        int w = 52 * j / 64, s = 52 * j % 64;
+        __m512i v = _mm512_srlv_epi64(d[w], _mm512_set1_epi64(s));
+        if (s > 12 && w + 1 < FP_DIGS)
+            v = _mm512_or_si512(v, _mm512_sllv_epi64(d[w + 1], _mm512_set1_epi64(64 - s)));
+        t.l[j] = _mm512_and_si512(v, mask);
+    }
+
+    lfp_set1(&to, fp8_to);
+    lfp_mul(c, &t, &to);
+}
+
+FP8_TARGET
+static void lfp_store_rows(batch_rows_t *r, size_t k, size_t i, const lane_fp_t *a) {
+    __mmask8 m = r->count - i < LANES ? (__mmask8)((1u << (r->count - i)) - 1) : (__mmask8)0xFF;
+    __m512i d[FP_DIGS];
+    lane_fp_t t, from;
+
+    lfp_set1(&from, fp8_from);
+    lfp_mul(&t, a, &from);
+
+    for (int j = 0; j < FP_DIGS; j++)
+        d[j] = _mm512_setzero_si512();
+
+    for (int j = 0; j < LIMBS; j++) {
+        int w = 52 * j / 64, s = 52 * j % 64;
+        d[w] = _mm512_or_si512(d[w], _mm512_sllv_epi64(t.l[j], _mm512_set1_epi64(s)));
+        if (s > 12 && w + 1 < FP_DIGS)
+            d[w + 1] = _mm512_or_si512(d[w + 1], _mm512_srlv_epi64(t.l[j], _mm512_set1_epi64(64 - s)));
+    }
+
+    for (int j = 0; j < FP_DIGS; j++)
+        _mm512_mask_store_epi64((void *)(batch_row(r, k, j) + i), m, d[j]);
+}
+
+FP8_TARGET
+static void lfp12_load_rows(lane_fp12_t *c, const batch_rows_t *r, size_t i) {
+    for (int x = 0; x < 2; x++)
+        for (int y = 0; y < 3; y++)
+            for (int z = 0; z < 2; z++)
+                lfp_load_rows(&c->c[x].c[y].c[z], r, (size_t)((x * 3 + y) * 2 + z), i);
+}
+
+FP8_TARGET
+static void lfp12_store_rows(batch_rows_t *r, size_t i, const lane_fp12_t *a) {
+    for (int x = 0; x < 2; x++)
+        for (int y = 0; y < 3; y++)
+            for (int z = 0; z < 2; z++)
+                lfp_store_rows(r, (size_t)((x * 3 + y) * 2 + z), i, &a->c[x].c[y].c[z]);
+}
+
+/*
+ * Fixed-window exponentiation. digits[w * LANES + i] is 4-bit window w of exponent of lane i, every window
+ * multiplies by table entry selected per lane, so that all lanes run the same instructions.
+ */
+FP8_TARGET
+static void lfp12_exp(lane_fp12_t *c, const lane_fp12_t *a, const uint8_t *digits, size_t windows,
+                      lane_fp12_t *table) {
+    lane_fp12_t sel;
+
+    lfp12_set_one(&table[0]);
+    table[1] = *a;
+    for (int k = 2; k < 16; k++)
+        lfp12_mul(&table[k], &table[k - 1], a);
+
+    lfp12_set_one(c);
+
+    for (size_t w = windows; w > 0; w--) {
+        const uint8_t *d = digits + (w - 1) * LANES;
+        __m512i dv = _mm512_set_epi64(d[7], d[6], d[5], d[4], d[3], d[2], d[1], d[0]);
+        __m512i *s = (__m512i *)&sel;
+
+        sel = table[0];
+        for (int k = 1; k < 16; k++) {
+            __mmask8 m = _mm512_cmpeq_epi64_mask(dv, _mm512_set1_epi64(k));
+            const __m512i *t = (const __m512i *)&table[k];
+
+            for (size_t v = 0; v < FP12_VECS; v++)
+                s[v] = _mm512_mask_blend_epi64(m, s[v], t[v]);
+        }
+
+        if (w != windows) {
+            for (int i = 0; i < 4; i++)
+                lfp12_sqr_cyc(c, c);
+            lfp12_mul(c, c, &sel);
+        } else {
+            *c = sel;
+        }
+    }
+}
+
+/*
+ * Miller loop of the optimal ate pairing on BLS12 curves with M-type twist. Points of G2 are kept in Jacobian
+ * coordinates, doubling and addition steps are algorithms 26 and 27 of Beuchat et al., eprint 2010/354.
+ * Line through them evaluated at P = (xp, yp) is l0 + l1 xp v + l2 yp v w, lines differ from relic's ones
+ * by factors in proper subfields of Fp12, which final exponentiation removes.
+ */
+typedef struct {
+    lane_fp_t x, y;
+} lane_g1_t;
+
+typedef struct {
+    lane_fp2_t x, y, z;
+} lane_g2_t;
+
+FP8_TARGET
+static void lfp2_neg(lane_fp2_t *c, const lane_fp2_t *a) {
+    lane_fp2_t zero;
+
+    memset(&zero, 0, sizeof(zero));
+    lfp2_sub(c, &zero, a);
+}
+
+FP8_TARGET
+static void lfp6_neg(lane_fp6_t *c, const lane_fp6_t *a) {
+    for (int i = 0; i < 3; i++)
+        lfp2_neg(&c->c[i], &a->c[i]);
+}
+
+// Multiplication by an element of Fp
+FP8_TARGET
+static void lfp2_mul_fp(lane_fp2_t *c, const lane_fp2_t *a, const lane_fp_t *b) {
+    lfp_mul(&c->c[0], &a->c[0], b);
+    lfp_mul(&c->c[1], &a->c[1], b);
+}
+
+// Multiplication by b0 + b1 v
+FP8_TARGET
+static void lfp6_mul01(lane_fp6_t *c, const lane_fp6_t *a, const lane_fp2_t *b0, const lane_fp2_t *b1) {
+    lane_fp2_t v0, v1, s, t;
+    lane_fp6_t r;
+
+    lfp2_mul(&v0, &a->c[0], b0);
+    lfp2_mul(&v1, &a->c[1], b1);
+
+    lfp2_mul(&s, &a->c[2], b1);
+    lfp2_mul_nor(&s, &s);
+    lfp2_add(&r.c[0], &s, &v0);
+
+    lfp2_add(&s, &a->c[0], &a->c[1]);
+    lfp2_add(&t, b0, b1);
+    lfp2_mul(&s, &s, &t);
+    lfp2_sub(&s, &s, &v0);
+    lfp2_sub(&r.c[1], &s, &v1);
+
+    lfp2_mul(&s, &a->c[2], b0);
+    lfp2_add(&r.c[2], &s, &v1);
+
+    *c = r;
+}
+
+// Multiplication by b1 v
+FP8_TARGET
+static void lfp6_mul1(lane_fp6_t *c, const lane_fp6_t *a, const lane_fp2_t *b1) {
+    lane_fp2_t t;
+
+    lfp2_mul(&t, &a->c[2], b1);
+    lfp2_mul_nor(&t, &t);
+    lfp2_mul(&c->c[2], &a->c[1], b1);
+    lfp2_mul(&c->c[1], &a->c[0], b1);
+    c->c[0] = t;
+}
+
+// Multiplication by line b0 + b1 v + b4 v w, 13 multiplications in Fp2 instead of 18
+FP8_TARGET
+static void lfp12_mul_line(lane_fp12_t *c, const lane_fp12_t *a, const lane_fp2_t *b0, const lane_fp2_t *b1,
+                           const lane_fp2_t *b4) {
+    lane_fp6_t t0, t1, s;
+    lane_fp2_t t;
+
+    lfp6_mul01(&t0, &a->c[0], b0, b1);
+    lfp6_mul1(&t1, &a->c[1], b4);
+
+    lfp2_add(&t, b1, b4);
+    lfp6_add(&s, &a->c[0], &a->c[1]);
+    lfp6_mul01(&s, &s, b0, &t);
+    lfp6_sub(&s, &s, &t0);
+    lfp6_sub(&c->c[1], &s, &t1);
+
+    lfp6_mul_art(&t1, &t1);
+    lfp6_add(&c->c[0], &t0, &t1);
+}
+
+// Complex squaring, Miller loop values are not in the cyclotomic subgroup
+FP8_TARGET
+static void lfp12_sqr(lane_fp12_t *c, const lane_fp12_t *a) {
+    lane_fp6_t t0, t1, s;
+
+    lfp6_mul(&t0, &a->c[0], &a->c[1]);
+    lfp6_add(&s, &a->c[0], &a->c[1]);
+    lfp6_mul_art(&t1, &a->c[1]);
+    lfp6_add(&t1, &t1, &a->c[0]);
+    lfp6_mul(&s, &s, &t1);
+    lfp6_sub(&s, &s, &t0);
+    lfp6_mul_art(&t1, &t0);
+    lfp6_sub(&c->c[0], &s, &t1);
+    lfp6_add(&c->c[1], &t0, &t0);
+}
+
+// r = 2r, l = (l0, l1, l2) is the tangent line at r
+FP8_TARGET
+static void lg2_dbl(lane_fp2_t *l, lane_g2_t *r) {
+    lane_fp2_t t0, t1, t2, t3, t4, t5, t6, zz;
+
+    lfp2_sqr(&t0, &r->x);
+    lfp2_sqr(&t1, &r->y);
+    lfp2_sqr(&t2, &t1);
+    lfp2_add(&t3, &t1, &r->x);
+    lfp2_sqr(&t3, &t3);
+    lfp2_sub(&t3, &t3, &t0);
+    lfp2_sub(&t3, &t3, &t2);
+    lfp2_add(&t3, &t3, &t3);
+    lfp2_add(&t4, &t0, &t0);
+    lfp2_add(&t4, &t4, &t0);
+    lfp2_add(&t6, &r->x, &t4);
+    lfp2_sqr(&t5, &t4);
+    lfp2_sqr(&zz, &r->z);
+
+    lfp2_sub(&r->x, &t5, &t3);
+    lfp2_sub(&r->x, &r->x, &t3);
+    lfp2_add(&r->z, &r->z, &r->y);
+    lfp2_sqr(&r->z, &r->z);
+    lfp2_sub(&r->z, &r->z, &t1);
+    lfp2_sub(&r->z, &r->z, &zz);
+    lfp2_sub(&r->y, &t3, &r->x);
+    lfp2_mul(&r->y, &r->y, &t4);
+    lfp2_add(&t2, &t2, &t2);
+    lfp2_add(&t2, &t2, &t2);
+    lfp2_add(&t2, &t2, &t2);
+    lfp2_sub(&r->y, &r->y, &t2);
+
+    lfp2_sqr(&t6, &t6);
+    lfp2_sub(&t6, &t6, &t0);
+    lfp2_sub(&t6, &t6, &t5);
+    lfp2_add(&t1, &t1, &t1);
+    lfp2_add(&t1, &t1, &t1);
+    lfp2_sub(&l[0], &t6, &t1);
+
+    lfp2_mul(&t3, &t4, &zz);
+    lfp2_add(&t3, &t3, &t3);
+    lfp2_neg(&l[1], &t3);
+
+    lfp2_mul(&l[2], &r->z, &zz);
+    lfp2_add(&l[2], &l[2], &l[2]);
+}
+
+// r = r + q for affine q, l = (l0, l1, l2) is the line through r and q
+FP8_TARGET
+static void lg2_add(lane_fp2_t *l, lane_g2_t *r, const lane_fp2_t *qx, const lane_fp2_t *qy) {
+    lane_fp2_t t0, t1, t2, t3, t4, t5, t6, t7, t9, zz, yy;
+
+    lfp2_sqr(&zz, &r->z);
+    lfp2_sqr(&yy, qy);
+    lfp2_mul(&t0, &zz, qx);
+    lfp2_add(&t1, qy, &r->z);
+    lfp2_sqr(&t1, &t1);
+    lfp2_sub(&t1, &t1, &yy);
+    lfp2_sub(&t1, &t1, &zz);
+    lfp2_mul(&t1, &t1, &zz);
+    lfp2_sub(&t2, &t0, &r->x);
+    lfp2_sqr(&t3, &t2);
+    lfp2_add(&t4, &t3, &t3);
+    lfp2_add(&t4, &t4, &t4);
+    lfp2_mul(&t5, &t4, &t2);
+    lfp2_sub(&t6, &t1, &r->y);
+    lfp2_sub(&t6, &t6, &r->y);
+    lfp2_mul(&t9, &t6, qx);
+    lfp2_mul(&t7, &t4, &r->x);
+
+    lfp2_sqr(&r->x, &t6);
+    lfp2_sub(&r->x, &r->x, &t5);
+    lfp2_sub(&r->x, &r->x, &t7);
+    lfp2_sub(&r->x, &r->x, &t7);
+    lfp2_add(&r->z, &r->z, &t2);
+    lfp2_sqr(&r->z, &r->z);
+    lfp2_sub(&r->z, &r->z, &zz);
+    lfp2_sub(&r->z, &r->z, &t3);
+    lfp2_sub(&t7, &t7, &r->x);
+    lfp2_mul(&t7, &t7, &t6);
+    lfp2_mul(&t0, &r->y, &t5);
+    lfp2_add(&t0, &t0, &t0);
+    lfp2_sub(&r->y, &t7, &t0);
+
+    // l0 = 2 t9 - (qy + z)^2 + yy + z^2 with the new z
+    lfp2_add(&t0, qy, &r->z);
+    lfp2_sqr(&t0, &t0);
+    lfp2_sub(&t0, &t0, &yy);
+    lfp2_sqr(&t1, &r->z);
+    lfp2_sub(&t0, &t0, &t1);
+    lfp2_add(&t9, &t9, &t9);
+    lfp2_sub(&l[0], &t9, &t0);
+
+    lfp2_add(&t6, &t6, &t6);
+    lfp2_neg(&l[1], &t6);
+
+    lfp2_add(&l[2], &r->z, &r->z);
+}
+
+// f = f * l evaluated at p
+FP8_TARGET
+static void lfp12_mul_eval(lane_fp12_t *f, lane_fp2_t *l, const lane_g1_t *p) {
+    lfp2_mul_fp(&l[1], &l[1], &p->x);
+    lfp2_mul_fp(&l[2], &l[2], &p->y);
+    lfp12_mul_line(f, f, &l[0], &l[1], &l[2]);
+}
+
+/*
+ * f = f_{z,q}(p) for z = -(2^z_bits[0] + ... + 2^z_bits[terms - 1]), bits in increasing order.
+ * All lanes follow the same bits, so they never diverge.
+ */
+FP8_TARGET
+static void lfp12_mil(lane_fp12_t *f, const lane_g1_t *p, const lane_fp2_t *qx, const lane_fp2_t *qy,
+                      const int *z_bits, int terms) {
+    lane_g2_t t;
+    lane_fp2_t l[3];
+
+    t.x = *qx;
+    t.y = *qy;
+    memset(&t.z, 0, sizeof(t.z));
+    lfp_set1(&t.z.c[0], fp8_one);
+    lfp12_set_one(f);
+
+    for (int i = z_bits[terms - 1] - 1, j = terms - 2; i >= 0; i--) {
+        lfp12_sqr(f, f);
+        lg2_dbl(l, &t);
+        lfp12_mul_eval(f, l, p);
+
+        if (j >= 0 && i == z_bits[j]) {
+            lg2_add(l, &t, qx, qy);
+            lfp12_mul_eval(f, l, p);
+            j--;
+        }
+    }
+
+    // z is negative, f_{z,Q} = 1 / f_{|z|,Q}, which final exponentiation maps to the same value as the conjugate
+    lfp6_neg(&f->c[1], &f->c[1]);
+}
+
+#endif
+
+void fp8_init(void) {
+    fp8_supported = 0;
+    fp8_on = 0;
+
+#if FP8_IFMA
+    if (!(cpu_features() & PYTHIA_CPU_AVX512IFMA) || fp_prime_get_qnr() != -1)
+        return;
+
+    bn_t p; bn_null(p);
+    bn_t r; bn_null(r);
+    bn_t t; bn_null(t);
+    bn_t g; bn_null(g);
+    fp_t one; fp_null(one);
+    fp2_t xi; fp2_null(xi);
+
+    TRY {
+        dig_t d[FP_DIGS];
+
+        bn_new(p);
+        bn_new(r);
+        bn_new(t);
+        bn_new(g);
+        fp_new(one);
+        fp2_new(xi);
+
+        bn_read_raw(p, fp_prime_get(), FP_DIGS);
+        digs_to_limbs(fp8_p, fp_prime_get());
+
+        // Newton iteration doubles number of correct low bits of p^-1
+        uint64_t inv = 1;
+        for (int i = 0; i < 6; i++)
+            inv *= 2 - fp8_p[0] * inv;
+        fp8_pinv = (0 - inv) & MASK52;
+
+        // Digits of relic's one are its Montgomery radix R_relic mod p
+        fp_set_dig(one, 1);
+        digs_to_limbs(fp8_from, one);
+
+        bn_read_raw(r, one, FP_DIGS);
+        bn_gcd_ext(g, t, NULL, r, p);
+        bn_mod(t, t, p);
+        bn_set_2b(r, 2 * 52 * LIMBS);
+        bn_mod(r, r, p);
+        bn_mul(t, t, r);
+        bn_mod(t, t, p);
+        bn_write_raw(d, FP_DIGS, t);
+        digs_to_limbs(fp8_to, d);
+
+        bn_set_2b(r, 52 * LIMBS);
+        bn_mod(r, r, p);
+        bn_write_raw(d, FP_DIGS, r);
+        digs_to_limbs(fp8_one, d);
+
+        fp_set_dig(xi[0], 1);
+        fp_zero(xi[1]);
+        fp2_mul_nor(xi, xi);
+
+        fp8_xi_one_plus_i = 1;
+        for (int k = 0; k < 2; k++) {
+            fp_prime_back(t, xi[k]);
+            fp8_xi_one_plus_i &= bn_cmp_dig(t, (dig_t)1) == CMP_EQ;
+
+            bn_mul(t, t, r);
+            bn_mod(t, t, p);
+            bn_write_raw(d, FP_DIGS, t);
+            digs_to_limbs(fp8_xi[k], d);
+        }
+
+        fp8_supported = 1;
+        fp8_on = 1;
+    }
+    CATCH_ANY {
+        fp8_supported = 0;
+        fp8_on = 0;
+    }
+    FINALLY {
+        fp2_free(xi);
+        fp_free(one);
+        bn_free(g);
+        bn_free(t);
+        bn_free(r);
+        bn_free(p);
+    }
+#endif
+}
+
+int fp8_enabled(void) {
+    return fp8_on;
+}
+
+void fp8_set_enabled(int enabled) {
+    fp8_on = enabled && fp8_supported;
+}
+
+void fp_mul_batch(fp_t *c, fp_t *a, fp_t *b, size_t n) {
+#if FP8_IFMA
+    if (fp8_on) {
+        for (size_t i = 0; i < n; i += LANES) {
+            size_t count = n - i < LANES ? n - i : LANES;
+            lane_fp_t x, y;
+
+            lfp_load(&x, a + i, count);
+            lfp_load(&y, b + i, count);
+            lfp_mul(&x, &x, &y);
+            lfp_store(c + i, &x, count);
+        }
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < n; i++)
+        pythia_fp_mul(c[i], a[i], b[i]);
+}
+
+#if FP8_IFMA
+
+// Returns number of 4-bit windows of the longest exponent, or -1 if lanes can't be used
+static long exp_windows(bn_t *e, size_t n) {
+    int bits = 0;
+
+    if (!fp8_on || !n)
+        return -1;
+
+    for (size_t i = 0; i < n; i++) {
+        if (bn_sign(e[i]) == BN_NEG)
+            return -1;
+        if (bn_bits(e[i]) > bits)
+            bits = bn_bits(e[i]);
+    }
+
+    return (bits + 3) / 4;
+}
+
+static void exp_digits(uint8_t *digits, size_t windows, bn_t *e, size_t count) {
+    memset(digits, 0, windows * LANES);
+    for (size_t j = 0; j < count; j++) {
+        int b = bn_bits(e[j]);
+        for (int k = 0; k < b; k++)
+            digits[(size_t)(k / 4) * LANES + j] |= (uint8_t)(bn_get_bit(e[j], k) << (k % 4));
+    }
+}
+
+/*
+ * Lanes square with cyclotomic squarings, which are only valid in the cyclotomic subgroup,
+ * a^(p^4 - p^2 + 1) = 1. It is checked with two Frobenius maps as a^(p^4) * a = a^(p^2).
+ */
+static int fp12_is_cyc(fp12_t a) {
+    int result = 0;
+    fp12_t t0; fp12_null(t0);
+    fp12_t t1; fp12_null(t1);
+
+    TRY {
+        fp12_new(t0);
+        fp12_new(t1);
+
+        fp12_frb(t0, a, 4);
+        fp12_mul(t0, t0, a);
+        fp12_frb(t1, a, 2);
+        result = fp12_cmp(t0, t1) == CMP_EQ;
+    }
+    CATCH_ANY {
+        result = 0;
+    }
+    FINALLY {
+        fp12_free(t1);
+        fp12_free(t0);
+    }
+
+    return result;
+}
+
+static int gt_all_cyc(gt_t *a, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (!fp12_is_cyc(a[i]))
+            return 0;
+    }
+
+    return 1;
+}
+
+static int gt_batch_all_cyc(const pythia_gt_batch_t *a) {
+    int result = 1;
+    gt_t t; gt_null(t);
+
+    TRY {
+        gt_new(t);
+
+        for (size_t i = 0; result && i < a->r.count; i++) {
+            gt_batch_get(t, a, i);
+            result = fp12_is_cyc(t);
+        }
+    }
+    CATCH_ANY {
+        result = 0;
+    }
+    FINALLY {
+        gt_free(t);
+    }
+
+    return result;
+}
+
+/*
+ * Allocates digits and one aligned block for the window table followed by the loaded lanes.
+ * Returns block to be freed, throws ERR_NO_MEMORY.
+ */
+static void *exp_alloc(size_t windows, uint8_t **digits, lane_fp12_t **table) {
+    void *mem = malloc(17 * sizeof(lane_fp12_t) + 63);
+
+    *digits = (uint8_t *)calloc(windows ? windows * LANES : 1, sizeof(uint8_t));
+
+    if (!*digits || !mem) {
+        free(mem);
+        free(*digits);
+        THROW(ERR_NO_MEMORY);
+        return NULL;
+    }
+
+    *table = (lane_fp12_t *)(((uintptr_t)mem + 63) & ~(uintptr_t)63);
+
+    return mem;
+}
+
+#endif
+
+void gt_exp_batch(gt_t *c, gt_t *a, bn_t *e, size_t n) {
+#if FP8_IFMA
+    long windows = exp_windows(e, n);
+
+    // Elements outside of the cyclotomic subgroup are left to relic
+    if (windows >= 0 && gt_all_cyc(a, n)) {
+        uint8_t *digits;
+        lane_fp12_t *table;
+        void *mem = exp_alloc((size_t)windows, &digits, &table);
+        lane_fp12_t *x = table + 16;
+
+        if (!mem)
+            return;
+
+        for (size_t i = 0; i < n; i += LANES) {
+            size_t count = n - i < LANES ? n - i : LANES;
+
+            exp_digits(digits, (size_t)windows, e + i, count);
+            lfp12_load(x, a + i, count);
+            lfp12_exp(x, x, digits, (size_t)windows, table);
+            lfp12_store(c + i, x, count);
+        }
+
+        free(mem);
+        free(digits);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < n; i++)
+        gt_exp(c[i], a[i], e[i]);
+}
+
+void gt_batch_exp(pythia_gt_batch_t *c, const pythia_gt_batch_t *a, bn_t *e) {
+    const size_t n = a->r.count;
+
+#if FP8_IFMA
+    long windows = exp_windows(e, n);
+
+    if (windows >= 0 && gt_batch_all_cyc(a)) {
+        uint8_t *digits;
+        lane_fp12_t *table;
+        void *mem = exp_alloc((size_t)windows, &digits, &table);
+        lane_fp12_t *x = table + 16;
+
+        if (!mem)
+            return;
+
+        for (size_t i = 0; i < n; i += LANES) {
+            size_t count = n - i < LANES ? n - i : LANES;
+
+            exp_digits(digits, (size_t)windows, e + i, count);
+            lfp12_load_rows(x, &a->r, i);
+            lfp12_exp(x, x, digits, (size_t)windows, table);
+            lfp12_store_rows(&c->r, i, x);
+        }
+
+        free(mem);
+        free(digits);
+        return;
+    }
+#endif
+
+    gt_t t; gt_null(t);
+
+    TRY {
+        gt_new(t);
+
+        for (size_t i = 0; i < n; i++) {
+            gt_batch_get(t, a, i);
+            gt_exp(t, t, e[i]);
+            gt_batch_set(c, i, t);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        gt_free(t);
+    }
+}
+
+#if FP8_IFMA
+
+// Miller loops of count normalized pairs, result of pair k goes to r[idx[k]]
+FP8_TARGET
+static void mil_lanes(fp12_t *r, const size_t *idx, g1_t *p, g2_t *q, size_t count, const int *z_bits,
+                      int terms) {
+    fp_t f[LANES];
+    lane_g1_t lp;
+    lane_fp2_t qx, qy;
+    lane_fp12_t m;
+
+    for (size_t k = 0; k < count; k++)
+        f[k] = p[k]->x;
+    lfp_load(&lp.x, f, count);
+    for (size_t k = 0; k < count; k++)
+        f[k] = p[k]->y;
+    lfp_load(&lp.y, f, count);
+
+    for (int c = 0; c < 2; c++) {
+        for (size_t k = 0; k < count; k++)
+            f[k] = q[k]->x[c];
+        lfp_load(&qx.c[c], f, count);
+        for (size_t k = 0; k < count; k++)
+            f[k] = q[k]->y[c];
+        lfp_load(&qy.c[c], f, count);
+    }
+
+    lfp12_mil(&m, &lp, &qx, &qy, z_bits, terms);
+
+    for (int x = 0; x < 2; x++)
+        for (int y = 0; y < 3; y++)
+            for (int z = 0; z < 2; z++) {
+                for (size_t k = 0; k < count; k++)
+                    f[k] = r[idx[k]][x][y][z];
+                lfp_store(f, &m.c[x].c[y].c[z], count);
+            }
+}
+
+#endif
+
+int pp_mil_batch(fp12_t *r, g1_t *p, g2_t *q, size_t n, const int *z_bits, int terms) {
+#if FP8_IFMA
+    if (fp8_on) {
+        g1_t np[LANES];
+        g2_t nq[LANES];
+        size_t idx[LANES], k = 0;
+
+        for (size_t i = 0; i < LANES; i++) {
+            g1_null(np[i]);
+            g2_null(nq[i]);
+        }
+
+        TRY {
+            for (size_t i = 0; i < LANES; i++) {
+                g1_new(np[i]);
+                g2_new(nq[i]);
+            }
+
+            for (size_t s = 0; s < n; s++) {
+                // Pairs with a point at infinity contribute unity and don't take a lane
+                if (g1_is_infty(p[s]) || g2_is_infty(q[s])) {
+                    fp12_set_dig(r[s], 1);
+                    continue;
+                }
+
+                g1_norm(np[k], p[s]);
+                g2_norm(nq[k], q[s]);
+                idx[k++] = s;
+
+                if (k == LANES) {
+                    mil_lanes(r, idx, np, nq, k, z_bits, terms);
+                    k = 0;
+                }
+            }
+
+            if (k > 0)
+                mil_lanes(r, idx, np, nq, k, z_bits, terms);
+        }
+        CATCH_ANY {
+            THROW(ERR_CAUGHT);
+        }
+        FINALLY {
+            for (size_t i = 0; i < LANES; i++) {
+                g2_free(nq[i]);
+                g1_free(np[i]);
+            }
+        }
+
+        return 1;
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_FP8_H
+#define PYTHIA_PYTHIA_FP8_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <relic/relic.h>
+#include "pythia_batch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of independent operations processed in lockstep by 8-lane Fp arithmetic
+#define PYTHIA_FP8_LANES 8
+
+/// Enables 8-lane Fp arithmetic with 52-bit limbs if cpu_init found AVX-512 IFMA and prepares its constants,
+/// should be called once during initialization, after cpu_init
+void fp8_init(void);
+
+/// \return 1 if batch operations run on AVX-512 IFMA lanes, 0 if they fall back to relic
+int fp8_enabled(void);
+
+/// Enables or disables IFMA lanes, so that both paths can be tested and benchmarked.
+/// Lanes are never enabled on CPUs without AVX-512 IFMA.
+/// \param [in] enabled 1 to use IFMA lanes, 0 to fall back to relic
+void fp8_set_enabled(int enabled);
+
+/// Computes c[i] = a[i] * b[i] for n pairs of field elements, 8 multiplications at a time
+/// \param [out] c array of n products
+/// \param [in] a array of n field elements
+/// \param [in] b array of n field elements
+/// \param [in] n number of products
+void fp_mul_batch(fp_t *c, fp_t *a, fp_t *b, size_t n);
+
+/// Computes c[i] = a[i]^e[i] for n elements of GT. Groups of 8 exponentiations run in lockstep
+/// with fixed 4-bit windows, so lanes with different exponents never diverge.
+/// Lanes use cyclotomic squarings, so they only run if every a[i] is in the cyclotomic subgroup,
+/// which holds for GT and is checked with two Frobenius maps per element. Otherwise all n
+/// exponentiations fall back to gt_exp.
+/// \param [out] c array of n results
+/// \param [in] a array of n elements of GT, or any elements of Fp12
+/// \param [in] e array of n non-negative exponents
+/// \param [in] n number of exponentiations
+void gt_exp_batch(gt_t *c, gt_t *a, bn_t *e, size_t n);
+
+/// Computes c[i] = a[i]^e[i] for all elements of batch a like gt_exp_batch. Lanes are loaded from and stored
+/// to structure-of-arrays rows with aligned vector moves, without gathering digits of separate elements.
+/// Elements are checked and fall back to gt_exp the same way.
+/// \param [out] c batch of results with the same count, may be a
+/// \param [in] a batch of elements of GT, or any elements of Fp12
+/// \param [in] e array of non-negative exponents, one per element
+void gt_batch_exp(pythia_gt_batch_t *c, const pythia_gt_batch_t *a, bn_t *e);
+
+/// Computes Miller loops r[i] = f_{z,q[i]}(p[i]) of n optimal ate pairings on a BLS12 curve with M-type twist,
+/// up to factors that final exponentiation removes. Groups of 8 loops run in lockstep with Jacobian
+/// doubling and addition steps over lanes, pairs with a point at infinity give unity and don't take a lane.
+/// Results only match relic's Miller loop after final exponentiation, callers check that once for their curve.
+/// \param [out] r array of n Miller loop outputs
+/// \param [in] p array of n points in G1
+/// \param [in] q array of n points in G2
+/// \param [in] n number of pairings
+/// \param [in] z_bits set bits of |z| in increasing order, z is the negative curve parameter
+/// \param [in] terms number of set bits
+/// \return 1 if lanes computed r, 0 if lanes are disabled and r is untouched
+int pp_mil_batch(fp12_t *r, g1_t *p, g2_t *q, size_t n, const int *z_bits, int terms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_FP8_H
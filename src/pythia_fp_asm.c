@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <relic/relic.h>
+#include "pythia_conf.h"
+#include "pythia_cpu.h"
+#include "pythia_fp.h"
+#include "pythia_fp_asm.h"
+
+#if PYTHIA_FP_ASM && defined(__x86_64__) && FP_DIGS == 6 && DIGIT == 64
+#define FP_ASM 1
+#else
+#define FP_ASM 0
+#endif
+
+static int fp_asm_supported = 0;
+static int fp_asm_on = 0;
+
+#if FP_ASM
+
+extern const dig_t pythia_fp_x64_p[FP_DIGS];
+
+void pythia_fp_muln_x64(dig_t *c, const dig_t *a, const dig_t *b);
+void pythia_fp_sqrn_x64(dig_t *c, const dig_t *a);
+void pythia_fp_rdcn_x64(dig_t *c, dig_t *a);
+
+void fp_asm_mul(fp_t c, const fp_t a, const fp_t b) {
+    dig_t t[2 * FP_DIGS];
+
+    pythia_fp_muln_x64(t, a, b);
+    pythia_fp_rdcn_x64(c, t);
+}
+
+void fp_asm_sqr(fp_t c, const fp_t a) {
+    dig_t t[2 * FP_DIGS];
+
+    pythia_fp_sqrn_x64(t, a);
+    pythia_fp_rdcn_x64(c, t);
+}
+
+#else
+
+// Never bound, fp_asm_enabled is always 0 without the backend
+void fp_asm_mul(fp_t c, const fp_t a, const fp_t b) {
+    fp_mul(c, a, b);
+}
+
+void fp_asm_sqr(fp_t c, const fp_t a) {
+    fp_sqr(c, a);
+}
+
+#endif
+
+void fp_asm_init(void) {
+    fp_asm_supported = 0;
+    fp_asm_on = 0;
+
+#if FP_ASM
+    // Constants of the backend are fixed, so it is used only with the prime relic was configured with
+    if ((cpu_features() & PYTHIA_CPU_BMI2_ADX)
+        && memcmp(fp_prime_get(), pythia_fp_x64_p, sizeof(pythia_fp_x64_p)) == 0) {
+        fp_asm_supported = 1;
+        fp_asm_on = 1;
+    }
+#endif
+
+    fp_bind();
+}
+
+int fp_asm_enabled(void) {
+    return fp_asm_on;
+}
+
+void fp_asm_set_enabled(int enabled) {
+    fp_asm_on = enabled && fp_asm_supported;
+    fp_bind();
+}
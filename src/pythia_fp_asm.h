@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_FP_ASM_H
+#define PYTHIA_PYTHIA_FP_ASM_H
+
+#include <relic/relic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Enables the x86-64 assembly backend for 381-bit multiplication and squaring of pythia_fp.h entry points
+/// if cpu_init found BMI2 and ADX. Does nothing unless library is built with PYTHIA_FP_ASM.
+/// Should be called once during initialization, after cpu_init.
+void fp_asm_init(void);
+
+/// \return 1 if pythia_fp.h entry points run on the assembly backend, 0 if they run on relic's code
+int fp_asm_enabled(void);
+
+/// Enables or disables the assembly backend, so that both backends can be compared and benchmarked.
+/// Backend is never enabled on CPUs without BMI2 and ADX or if the field is not BLS12-381 base field.
+/// \param [in] enabled 1 to use the assembly backend, 0 to use relic's own code
+void fp_asm_set_enabled(int enabled);
+
+/// Montgomery multiplication c = a * b on the assembly backend, may be called only if fp_asm_enabled
+void fp_asm_mul(fp_t c, const fp_t a, const fp_t b);
+
+/// Montgomery squaring c = a^2 on the assembly backend, may be called only if fp_asm_enabled
+void fp_asm_sqr(fp_t c, const fp_t a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_FP_ASM_H
@@ -0,0 +1,104 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <relic/relic.h>
+#include "pythia_conf.h"
+#include "pythia_fp.h"
+#include "pythia_fp_gen.h"
+
+#if PYTHIA_FP_GEN && FP_DIGS == 6 && DIGIT == 64
+#define FP_GEN 1
+#include "pythia_fp381.h"
+#else
+#define FP_GEN 0
+#endif
+
+static int fp_gen_supported = 0;
+static int fp_gen_on = 0;
+
+#if FP_GEN
+
+void fp_gen_mul(fp_t c, const fp_t a, const fp_t b) {
+    fiat_bls12_381_fp_mul(c, a, b);
+}
+
+void fp_gen_sqr(fp_t c, const fp_t a) {
+    fiat_bls12_381_fp_square(c, a);
+}
+
+void fp_gen_inv(fp_t c, const fp_t a) {
+    // Addition chain for a^(p - 2), so zero is mapped to zero
+    fiat_bls12_381_fp_inv(c, a);
+}
+
+void fp2_gen_mul(fp2_t c, fp2_t a, fp2_t b) {
+    fiat_bls12_381_fp2_mul(c[0], c[1], a[0], a[1], b[0], b[1]);
+}
+
+void fp2_gen_sqr(fp2_t c, fp2_t a) {
+    fiat_bls12_381_fp2_square(c[0], c[1], a[0], a[1]);
+}
+
+#else
+
+// Never bound, fp_gen_enabled is always 0 without generated code
+void fp_gen_mul(fp_t c, const fp_t a, const fp_t b) {
+    fp_mul(c, a, b);
+}
+
+void fp_gen_sqr(fp_t c, const fp_t a) {
+    fp_sqr(c, a);
+}
+
+void fp_gen_inv(fp_t c, const fp_t a) {
+    fp_inv(c, a);
+}
+
+void fp2_gen_mul(fp2_t c, fp2_t a, fp2_t b) {
+    fp2_mul(c, a, b);
+}
+
+void fp2_gen_sqr(fp2_t c, fp2_t a) {
+    fp2_sqr(c, a);
+}
+
+#endif
+
+void fp_gen_init(void) {
+    fp_gen_supported = 0;
+    fp_gen_on = 0;
+
+#if FP_GEN
+    // Generated code has the modulus baked in
+    if (memcmp(fp_prime_get(), fiat_bls12_381_fp_modulus, sizeof(fiat_bls12_381_fp_modulus)) == 0) {
+        fp_gen_supported = 1;
+        fp_gen_on = 1;
+    }
+#endif
+
+    fp_bind();
+}
+
+int fp_gen_enabled(void) {
+    return fp_gen_on;
+}
+
+void fp_gen_set_enabled(int enabled) {
+    fp_gen_on = enabled && fp_gen_supported;
+    fp_bind();
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_FP_GEN_H
+#define PYTHIA_PYTHIA_FP_GEN_H
+
+#include <relic/relic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Enables straight-line code generated by tools/gen_fp381.py for pythia_fp.h entry points
+/// if relic is configured with BLS12-381 base field.
+/// Does nothing unless library is built with PYTHIA_FP_GEN. Should be called once during initialization.
+void fp_gen_init(void);
+
+/// \return 1 if pythia_fp.h entry points run on generated code, 0 otherwise
+int fp_gen_enabled(void);
+
+/// Enables or disables generated field code, so that it can be compared and benchmarked against relic.
+/// Generated code is never enabled if the field is not BLS12-381 base field.
+/// \param [in] enabled 1 to use generated code, 0 to use relic's own code
+void fp_gen_set_enabled(int enabled);
+
+/// Generated Montgomery multiplication c = a * b, may be called only if fp_gen_enabled
+void fp_gen_mul(fp_t c, const fp_t a, const fp_t b);
+
+/// Generated Montgomery squaring c = a^2, may be called only if fp_gen_enabled
+void fp_gen_sqr(fp_t c, const fp_t a);
+
+/// Generated constant-time inversion c = a^(p - 2), may be called only if fp_gen_enabled
+void fp_gen_inv(fp_t c, const fp_t a);
+
+/// Generated multiplication in Fp2 c = a * b, may be called only if fp_gen_enabled
+void fp2_gen_mul(fp2_t c, fp2_t a, fp2_t b);
+
+/// Generated squaring in Fp2 c = a^2, may be called only if fp_gen_enabled
+void fp2_gen_sqr(fp2_t c, fp2_t a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_FP_GEN_H
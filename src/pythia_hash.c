@@ -0,0 +1,1169 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <relic/relic.h>
+#include <relic/relic_err.h>
+#include "pythia_fp.h"
+#include "pythia_hash.h"
+
+/*
+ * BLS12-381 G1 suite of RFC 9380. The curve y^2 = x^3 + 4 has A = 0, so simplified SWU maps to the
+ * 11-isogenous curve y^2 = x^3 + A'x + B' and the isogeny (appendix E.2) maps result back.
+ * Isogeny denominators are monic, their leading coefficients are omitted.
+ */
+static const char *g1_sswu_a = "144698A3B8E9433D693A02C96D4982B0EA985383EE66A8D8E8981AEFD881AC98936F8DA0E0F97F5CF428082D584C1D";
+static const char *g1_sswu_b = "12E2908D11688030018B12E8753EEE3B2016C1F0F24F4070A0B9C14FCEF35EF55A23215A316CEAA5D1CC48E98E172BE0";
+static const dig_t g1_sswu_z = 11;
+static const uint64_t g1_h_eff = 0xD201000000010001;
+
+static const char *g1_iso_xnum[] = {
+        "11A05F2B1E833340B809101DD99815856B303E88A2D7005FF2627B56CDB4E2C85610C2D5F2E62D6EAEAC1662734649B7",
+        "17294ED3E943AB2F0588BAB22147A81C7C17E75B2F6A8417F565E33C70D1E86B4838F2A6F318C356E834EEF1B3CB83BB",
+        "0D54005DB97678EC1D1048C5D10A9A1BCE032473295983E56878E501EC68E25C958C3E3D2A09729FE0179F9DAC9EDCB0",
+        "1778E7166FCC6DB74E0609D307E55412D7F5E4656A8DBF25F1B33289F1B330835336E25CE3107193C5B388641D9B6861",
+        "0E99726A3199F4436642B4B3E4118E5499DB995A1257FB3F086EEB65982FAC18985A286F301E77C451154CE9AC8895D9",
+        "1630C3250D7313FF01D1201BF7A74AB5DB3CB17DD952799B9ED3AB9097E68F90A0870D2DCAE73D19CD13C1C66F652983",
+        "0D6ED6553FE44D296A3726C38AE652BFB11586264F0F8CE19008E218F9C86B2A8DA25128C1052ECADDD7F225A139ED84",
+        "17B81E7701ABDBE2E8743884D1117E53356DE5AB275B4DB1A682C62EF0F2753339B7C8F8C8F475AF9CCB5618E3F0C88E",
+        "080D3CF1F9A78FC47B90B33563BE990DC43B756CE79F5574A2C596C928C5D1DE4FA295F296B74E956D71986A8497E317",
+        "169B1F8E1BCFA7C42E0C37515D138F22DD2ECB803A0C5C99676314BAF4BB1B7FA3190B2EDC0327797F241067BE390C9E",
+        "10321DA079CE07E272D8EC09D2565B0DFA7DCCDDE6787F96D50AF36003B14866F69B771F8C285DECCA67DF3F1605FB7B",
+        "06E08C248E260E70BD1E962381EDEE3D31D79D7E22C837BC23C0BF1BC24C6B68C24B1B80B64D391FA9C8BA2E8BA2D229"
+};
+
+static const char *g1_iso_xden[] = {
+        "08CA8D548CFF19AE18B2E62F4BD3FA6F01D5EF4BA35B48BA9C9588617FC8AC62B558D681BE343DF8993CF9FA40D21B1C",
+        "12561A5DEB559C4348B4711298E536367041E8CA0CF0800C0126C2588C48BF5713DAA8846CB026E9E5C8276EC82B3BFF",
+        "0B2962FE57A3225E8137E629BFF2991F6F89416F5A718CD1FCA64E00B11ACEACD6A3D0967C94FEDCFCC239BA5CB83E19",
+        "03425581A58AE2FEC83AAFEF7C40EB545B08243F16B1655154CCA8ABC28D6FD04976D5243EECF5C4130DE8938DC62CD8",
+        "13A8E162022914A80A6F1D5F43E7A07DFFDFC759A12062BB8D6B44E833B306DA9BD29BA81F35781D539D395B3532A21E",
+        "0E7355F8E4E667B955390F7F0506C6E9395735E9CE9CAD4D0A43BCEF24B8982F7400D24BC4228F11C02DF9A29F6304A5",
+        "0772CAACF16936190F3E0C63E0596721570F5799AF53A1894E2E073062AEDE9CEA73B3538F0DE06CEC2574496EE84A3A",
+        "14A7AC2A9D64A8B230B3F5B074CF01996E7F63C21BCA68A81996E1CDF9822C580FA5B9489D11E2D311F7D99BBDCC5A5E",
+        "0A10ECF6ADA54F825E920B3DAFC7A3CCE07F8D1D7161366B74100DA67F39883503826692ABBA43704776EC3A79A1D641",
+        "095FC13AB9E92AD4476D6E3EB3A56680F682B4EE96F7D03776DF533978F31C1593174E4B4B7865002D6384D168ECDD0A"
+};
+
+static const char *g1_iso_ynum[] = {
+        "090D97C81BA24EE0259D1F094980DCFA11AD138E48A869522B52AF6C956543D3CD0C7AEE9B3BA3C2BE9845719707BB33",
+        "134996A104EE5811D51036D776FB46831223E96C254F383D0F906343EB67AD34D6C56711962FA8BFE097E75A2E41C696",
+        "00CC786BAA966E66F4A384C86A3B49942552E2D658A31CE2C344BE4B91400DA7D26D521628B00523B8DFE240C72DE1F6",
+        "01F86376E8981C217898751AD8746757D42AA7B90EEB791C09E4A3EC03251CF9DE405ABA9EC61DECA6355C77B0E5F4CB",
+        "08CC03FDEFE0FF135CAF4FE2A21529C4195536FBE3CE50B879833FD221351ADC2EE7F8DC099040A841B6DAECF2E8FEDB",
+        "16603FCA40634B6A2211E11DB8F0A6A074A7D0D4AFADB7BD76505C3D3AD5544E203F6326C95A807299B23AB13633A5F0",
+        "04AB0B9BCFAC1BBCB2C977D027796B3CE75BB8CA2BE184CB5231413C4D634F3747A87AC2460F415EC961F8855FE9D6F2",
+        "0987C8D5333AB86FDE9926BD2CA6C674170A05BFE3BDD81FFD038DA6C26C842642F64550FEDFE935A15E4CA31870FB29",
+        "09FC4018BD96684BE88C9E221E4DA1BB8F3ABD16679DC26C1E8B6E6A1F20CABE69D65201C78607A360370E577BDBA587",
+        "0E1BBA7A1186BDB5223ABDE7ADA14A23C42A0CA7915AF6FE06985E7ED1E4D43B9B3F7055DD4EBA6F2BAFAAEBCA731C30",
+        "19713E47937CD1BE0DFD0B8F1D43FB93CD2FCBCB6CAF493FD1183E416389E61031BF3A5CCE3FBAFCE813711AD011C132",
+        "18B46A908F36F6DEB918C143FED2EDCC523559B8AAF0C2462E6BFE7F911F643249D9CDF41B44D606CE07C8A4D0074D8E",
+        "0B182CAC101B9399D155096004F53F447AA7B12A3426B08EC02710E807B4633F06C851C1919211F20D4C04F00B971EF8",
+        "0245A394AD1ECA9B72FC00AE7BE315DC757B3B080D4C158013E6632D3C40659CC6CF90AD1C232A6442D9D3F5DB980133",
+        "05C129645E44CF1102A159F748C4A3FC5E673D81D7E86568D9AB0F5D396A7CE46BA1049B6579AFB7866B1E715475224B",
+        "15E6BE4E990F03CE4EA50B3B42DF2EB5CB181D8F84965A3957ADD4FA95AF01B2B665027EFEC01C7704B456BE69C8B604"
+};
+
+static const char *g1_iso_yden[] = {
+        "16112C4C3A9C98B252181140FAD0EAE9601A6DE578980BE6EEC3232B5BE72E7A07F3688EF60C206D01479253B03663C1",
+        "1962D75C2381201E1A0CBD6C43C348B885C84FF731C4D59CA4A10356F453E01F78A4260763529E3532F6102C2E49A03D",
+        "058DF3306640DA276FAAAE7D6E8EB15778C4855551AE7F310C35A5DD279CD2ECA6757CD636F96F891E2538B53DBF67F2",
+        "16B7D288798E5395F20D23BF89EDB4D1D115C5DBDDBCD30E123DA489E726AF41727364F2C28297ADA8D26D98445F5416",
+        "0BE0E079545F43E4B00CC912F8228DDCC6D19C9F0F69BBB0542EDA0FC9DEC916A20B15DC0FD2EDEDDA39142311A5001D",
+        "08D9E5297186DB2D9FB266EAAC783182B70152C65550D881C5ECD87B6F0F5A6449F38DB9DFA9CCE202C6477FAAF9B7AC",
+        "166007C08A99DB2FC3BA8734ACE9824B5EECFDFA8D0CF8EF5DD365BC400A0051D5FA9C01A58B1FB93D1A1399126A775C",
+        "16A3EF08BE3EA7EA03BCDDFABBA6FF6EE5A4375EFA1F4FD7FEB34FD206357132B920F5B00801DEE460EE415A15812ED9",
+        "1866C8ED336C61231A1BE54FD1D74CC4F9FB0CE4C6AF5920ABC5750C4BF39B4852CFE2F7BB9248836B233D9D55535D4A",
+        "167A55CDA70A6E1CEA820597D94A84903216F763E13D87BB5308592E7EA7D4FBC7385EA3D529B35E346EF48BB8913F55",
+        "04D2F259EEA405BD48F010A01AD2911D9C6DD039BB61A6290E591B36E636A5C871A5C29F4F83060400F8B49CBA8F6AA8",
+        "0ACCBB67481D033FF5852C1E48C50C477F94FF8AEFCE42D28C0F9A88CEA7913516F968986F7EBBEA9684B529E2561092",
+        "0AD6B9514C767FE3C3613144B45F1496543346D98ADF02267D5CEEF9A00D9B8693000763E3B90AC11E99B138573345CC",
+        "02660400EB2E4F3B628BDD0D53CD76F2BF565B94E72927C1CB748DF27942480E420517BD8714CC80D1FADC1326ED06F7",
+        "0E0FA1D816DDC03E6B24255E0D7819C171C40F65E273B853324EFCD6356CAA205CA2F570F13497804415473A1D634B8F"
+};
+
+/*
+ * BLS12-381 G2 suite of RFC 9380. The twist y^2 = x^3 + 4(1 + i) is 3-isogenous to
+ * y^2 = x^3 + 240i x + 1012(1 + i) (appendix E.3), where simplified SWU is applied with Z = -(2 + i).
+ * Field elements are given as real and imaginary parts.
+ */
+static const dig_t g2_sswu_a = 240;
+static const dig_t g2_sswu_b = 1012;
+static const uint64_t curve_z_abs = 0xD201000000010000;   // |z|, z is negative
+
+static const char *g2_iso_xnum[][2] = {
+        { "05C759507E8E333EBB5B7A9A47D7ED8532C52D39FD3A042A88B58423C50AE15D5C2638E343D9C71C6238AAAAAAAA97D6",
+          "05C759507E8E333EBB5B7A9A47D7ED8532C52D39FD3A042A88B58423C50AE15D5C2638E343D9C71C6238AAAAAAAA97D6" },
+        { "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+          "11560BF17BAA99BC32126FCED787C88F984F87ADF7AE0C7F9A208C6B4F20A4181472AAA9CB8D555526A9FFFFFFFFC71A" },
+        { "11560BF17BAA99BC32126FCED787C88F984F87ADF7AE0C7F9A208C6B4F20A4181472AAA9CB8D555526A9FFFFFFFFC71E",
+          "08AB05F8BDD54CDE190937E76BC3E447CC27C3D6FBD7063FCD104635A790520C0A395554E5C6AAAA9354FFFFFFFFE38D" },
+        { "171D6541FA38CCFAED6DEA691F5FB614CB14B4E7F4E810AA22D6108F142B85757098E38D0F671C7188E2AAAAAAAA5ED1",
+          "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000" }
+};
+
+static const char *g2_iso_xden[][2] = {
+        { "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+          "1A0111EA397FE69A4B1BA7B6434BACD764774B84F38512BF6730D2A0F6B0F6241EABFFFEB153FFFFB9FEFFFFFFFFAA63" },
+        { "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000C",
+          "1A0111EA397FE69A4B1BA7B6434BACD764774B84F38512BF6730D2A0F6B0F6241EABFFFEB153FFFFB9FEFFFFFFFFAA9F" }
+};
+
+static const char *g2_iso_ynum[][2] = {
+        { "1530477C7AB4113B59A4C18B076D11930F7DA5D4A07F649BF54439D87D27E500FC8C25EBF8C92F6812CFC71C71C6D706",
+          "1530477C7AB4113B59A4C18B076D11930F7DA5D4A07F649BF54439D87D27E500FC8C25EBF8C92F6812CFC71C71C6D706" },
+        { "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+          "05C759507E8E333EBB5B7A9A47D7ED8532C52D39FD3A042A88B58423C50AE15D5C2638E343D9C71C6238AAAAAAAA97BE" },
+        { "11560BF17BAA99BC32126FCED787C88F984F87ADF7AE0C7F9A208C6B4F20A4181472AAA9CB8D555526A9FFFFFFFFC71C",
+          "08AB05F8BDD54CDE190937E76BC3E447CC27C3D6FBD7063FCD104635A790520C0A395554E5C6AAAA9354FFFFFFFFE38F" },
+        { "124C9AD43B6CF79BFBF7043DE3811AD0761B0F37A1E26286B0E977C69AA274524E79097A56DC4BD9E1B371C71C718B10",
+          "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000" }
+};
+
+static const char *g2_iso_yden[][2] = {
+        { "1A0111EA397FE69A4B1BA7B6434BACD764774B84F38512BF6730D2A0F6B0F6241EABFFFEB153FFFFB9FEFFFFFFFFA8FB",
+          "1A0111EA397FE69A4B1BA7B6434BACD764774B84F38512BF6730D2A0F6B0F6241EABFFFEB153FFFFB9FEFFFFFFFFA8FB" },
+        { "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+          "1A0111EA397FE69A4B1BA7B6434BACD764774B84F38512BF6730D2A0F6B0F6241EABFFFEB153FFFFB9FEFFFFFFFFA9D3" },
+        { "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000012",
+          "1A0111EA397FE69A4B1BA7B6434BACD764774B84F38512BF6730D2A0F6B0F6241EABFFFEB153FFFFB9FEFFFFFFFFAA99" }
+};
+
+// Untwist-Frobenius-twist endomorphism psi(x, y) = (c1 * conj(x), c2 * conj(y))
+static const char *g2_psi_c[][2] = {
+        { "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+          "1A0111EA397FE699EC02408663D4DE85AA0D857D89759AD4897D29650FB85F9B409427EB4F49FFFD8BFD00000000AAAD" },
+        { "135203E60180A68EE2E9C448D77A2CD91C3DEDD930B1CF60EF396489F61EB45E304466CF3E67FA0AF1EE7B04121BDEA2",
+          "06AF0E0437FF400B6831E36D6BD17FFE48395DABC2D3435E77F76E17009241C5EE67992F72EC05F4C81084FBEDE3CC09" }
+};
+
+#define G1_XNUM_LEN (sizeof(g1_iso_xnum) / sizeof(g1_iso_xnum[0]))
+#define G1_XDEN_LEN (sizeof(g1_iso_xden) / sizeof(g1_iso_xden[0]))
+#define G1_YNUM_LEN (sizeof(g1_iso_ynum) / sizeof(g1_iso_ynum[0]))
+#define G1_YDEN_LEN (sizeof(g1_iso_yden) / sizeof(g1_iso_yden[0]))
+#define G2_XNUM_LEN (sizeof(g2_iso_xnum) / sizeof(g2_iso_xnum[0]))
+#define G2_XDEN_LEN (sizeof(g2_iso_xden) / sizeof(g2_iso_xden[0]))
+#define G2_YNUM_LEN (sizeof(g2_iso_ynum) / sizeof(g2_iso_ynum[0]))
+#define G2_YDEN_LEN (sizeof(g2_iso_yden) / sizeof(g2_iso_yden[0]))
+
+/// Length of field element drawn from expand_message_xmd output, leaves 128 bits of bias margin
+#define HASH_FIELD_LEN 64
+
+static fp_st iso_xnum[G1_XNUM_LEN];
+static fp_st iso_xden[G1_XDEN_LEN];
+static fp_st iso_ynum[G1_YNUM_LEN];
+static fp_st iso_yden[G1_YDEN_LEN];
+
+static fp_st sswu_a;
+static fp_st sswu_b;
+static fp_st sswu_z;
+static fp_st sswu_c1;    // -B' / A'
+static fp_st sswu_c2;    // B' / (Z * A')
+
+// Fp2 elements are stored as pairs of fp_st and accessed through fp2_view
+static fp_st iso2_xnum[G2_XNUM_LEN][2];
+static fp_st iso2_xden[G2_XDEN_LEN][2];
+static fp_st iso2_ynum[G2_YNUM_LEN][2];
+static fp_st iso2_yden[G2_YDEN_LEN][2];
+
+static fp_st sswu2_a[2];
+static fp_st sswu2_b[2];
+static fp_st sswu2_z[2];
+static fp_st sswu2_c1[2];   // -B' / A'
+static fp_st sswu2_c2[2];   // B' / (Z * A')
+static fp_st psi_c1[2];
+static fp_st psi_c2[2];
+static fp_st fp2_minus_one[2];
+
+static bn_t hash_prime;
+static bn_t exp_sqrt;    // (p + 1) / 4, p = 3 mod 4
+static bn_t exp_sqrt2;   // (p - 3) / 4
+static bn_t exp_half;    // (p - 1) / 2
+
+static void fp2_view(fp2_t v, fp_st *c) {
+    v[0] = c[0];
+    v[1] = c[1];
+}
+
+static void read_fp_array(fp_st *c, const char **str, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        fp_read_str(c[i], str[i], (int)strlen(str[i]), 16);
+    }
+}
+
+static void read_fp2_array(fp_st (*c)[2], const char *(*str)[2], size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        read_fp_array(c[i], str[i], 2);
+    }
+}
+
+void hash_init(void) {
+    fp_t t; fp_null(t);
+    fp2_t t2; fp2_null(t2);
+    fp2_t a2, b2, z2, c2;
+
+    bn_null(hash_prime);
+    bn_null(exp_sqrt);
+    bn_null(exp_sqrt2);
+    bn_null(exp_half);
+
+    TRY {
+        fp_new(t);
+        fp2_new(t2);
+
+        bn_new(hash_prime);
+        bn_read_raw(hash_prime, fp_prime_get(), FP_DIGS);
+
+        bn_new(exp_sqrt);
+        bn_add_dig(exp_sqrt, hash_prime, 1);
+        bn_rsh(exp_sqrt, exp_sqrt, 2);
+
+        bn_new(exp_sqrt2);
+        bn_sub_dig(exp_sqrt2, hash_prime, 3);
+        bn_rsh(exp_sqrt2, exp_sqrt2, 2);
+
+        bn_new(exp_half);
+        bn_sub_dig(exp_half, hash_prime, 1);
+        bn_hlv(exp_half, exp_half);
+
+        read_fp_array(iso_xnum, g1_iso_xnum, G1_XNUM_LEN);
+        read_fp_array(iso_xden, g1_iso_xden, G1_XDEN_LEN);
+        read_fp_array(iso_ynum, g1_iso_ynum, G1_YNUM_LEN);
+        read_fp_array(iso_yden, g1_iso_yden, G1_YDEN_LEN);
+
+        fp_read_str(sswu_a, g1_sswu_a, (int)strlen(g1_sswu_a), 16);
+        fp_read_str(sswu_b, g1_sswu_b, (int)strlen(g1_sswu_b), 16);
+        fp_set_dig(sswu_z, g1_sswu_z);
+
+        fp_inv(t, sswu_a);
+        fp_mul(sswu_c1, sswu_b, t);
+        fp_neg(sswu_c1, sswu_c1);
+
+        fp_inv(t, sswu_z);
+        fp_mul(sswu_c2, sswu_c1, t);
+        fp_neg(sswu_c2, sswu_c2);
+
+        read_fp2_array(iso2_xnum, g2_iso_xnum, G2_XNUM_LEN);
+        read_fp2_array(iso2_xden, g2_iso_xden, G2_XDEN_LEN);
+        read_fp2_array(iso2_ynum, g2_iso_ynum, G2_YNUM_LEN);
+        read_fp2_array(iso2_yden, g2_iso_yden, G2_YDEN_LEN);
+        read_fp_array(psi_c1, g2_psi_c[0], 2);
+        read_fp_array(psi_c2, g2_psi_c[1], 2);
+
+        fp_zero(sswu2_a[0]);
+        fp_set_dig(sswu2_a[1], g2_sswu_a);
+        fp_set_dig(sswu2_b[0], g2_sswu_b);
+        fp_set_dig(sswu2_b[1], g2_sswu_b);
+        fp_set_dig(sswu2_z[0], 2);
+        fp_set_dig(sswu2_z[1], 1);
+        fp_neg(sswu2_z[0], sswu2_z[0]);
+        fp_neg(sswu2_z[1], sswu2_z[1]);
+        fp_set_dig(fp2_minus_one[0], 1);
+        fp_neg(fp2_minus_one[0], fp2_minus_one[0]);
+        fp_zero(fp2_minus_one[1]);
+
+        fp2_view(a2, sswu2_a);
+        fp2_view(b2, sswu2_b);
+        fp2_view(z2, sswu2_z);
+
+        fp2_inv(t2, a2);
+        fp2_view(c2, sswu2_c1);
+        fp2_mul(c2, b2, t2);
+        fp2_neg(c2, c2);
+
+        fp2_inv(t2, z2);
+        fp2_mul(t2, c2, t2);
+        fp2_view(c2, sswu2_c2);
+        fp2_neg(c2, t2);
+    }
+    CATCH_ANY {
+        hash_deinit();
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp2_free(t2);
+        fp_free(t);
+    }
+}
+
+void hash_deinit(void) {
+    bn_free(exp_half);
+    bn_free(exp_sqrt2);
+    bn_free(exp_sqrt);
+    bn_free(hash_prime);
+}
+
+/*
+ * Branch-free helpers, field elements are always fully reduced.
+ */
+static void fp_cmov(fp_t c, const fp_t a, dig_t bit) {
+    dig_t mask = (dig_t)0 - bit;
+    for (int i = 0; i < FP_DIGS; i++)
+        c[i] ^= mask & (c[i] ^ a[i]);
+}
+
+static dig_t fp_eq_ct(const fp_t a, const fp_t b) {
+    dig_t t = 0;
+    for (int i = 0; i < FP_DIGS; i++)
+        t |= a[i] ^ b[i];
+    return ((t | ((dig_t)0 - t)) >> (DIGIT - 1)) ^ 1;
+}
+
+static dig_t fp_is_zero_ct(const fp_t a) {
+    dig_t t = 0;
+    for (int i = 0; i < FP_DIGS; i++)
+        t |= a[i];
+    return ((t | ((dig_t)0 - t)) >> (DIGIT - 1)) ^ 1;
+}
+
+// Parity of canonical representative, t is scratch space
+static dig_t fp_sgn0(const fp_t a, bn_t t) {
+    fp_prime_back(t, a);
+    return (dig_t)bn_get_bit(t, 0);
+}
+
+static void fp_array_free(fp_t *a, size_t n) {
+    if (!a)
+        return;
+
+    for (size_t i = 0; i < n; i++) {
+        fp_free(a[i]);
+    }
+
+    free(a);
+}
+
+static fp_t *fp_array_new(size_t n) {
+    fp_t *a = (fp_t *)calloc(n, sizeof(fp_t));
+
+    if (!a)
+        THROW(ERR_NO_MEMORY);
+
+    for (size_t i = 0; i < n; i++) {
+        fp_null(a[i]);
+    }
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            fp_new(a[i]);
+        }
+    }
+    CATCH_ANY {
+        fp_array_free(a, n);
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {}
+
+    return a;
+}
+
+// Replaces n values with inv0 of them using one constant-time inversion and 3(n - 1) multiplications
+// (Montgomery's trick). Zeros are swapped for ones in the running product without branching.
+static void fp_inv0_sim(fp_t *a, size_t n) {
+    fp_t *prefix = NULL;
+    fp_t acc; fp_null(acc);
+    fp_t t; fp_null(t);
+    fp_t one; fp_null(one);
+    fp_t zero; fp_null(zero);
+
+    TRY {
+        prefix = fp_array_new(n);
+        fp_new(acc);
+        fp_new(t);
+        fp_new(one);
+        fp_new(zero);
+        fp_set_dig(one, 1);
+        fp_zero(zero);
+
+        fp_copy(acc, one);
+        for (size_t i = 0; i < n; i++) {
+            fp_copy(t, a[i]);
+            fp_cmov(t, one, fp_is_zero_ct(a[i]));
+            pythia_fp_mul(acc, acc, t);
+            fp_copy(prefix[i], acc);
+        }
+
+        pythia_fp_inv(acc, acc);
+
+        for (size_t i = n; i-- > 0;) {
+            dig_t is_zero = fp_is_zero_ct(a[i]);
+
+            fp_copy(t, a[i]);
+            fp_cmov(t, one, is_zero);
+
+            if (i > 0) {
+                pythia_fp_mul(a[i], acc, prefix[i - 1]);
+            } else {
+                fp_copy(a[i], acc);
+            }
+            pythia_fp_mul(acc, acc, t);
+            fp_cmov(a[i], zero, is_zero);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp_free(zero);
+        fp_free(one);
+        fp_free(t);
+        fp_free(acc);
+        fp_array_free(prefix, n);
+    }
+}
+
+// c = x^3 + A'x + B'
+static void sswu_curve_rhs(fp_t c, const fp_t x) {
+    pythia_fp_sqr(c, x);
+    fp_add(c, c, sswu_a);
+    pythia_fp_mul(c, c, x);
+    fp_add(c, c, sswu_b);
+}
+
+// Computes zu2 = Z u^2 and denominator t = Z^2 u^4 + Z u^2 of sswu_map
+static void sswu_den(fp_t t, fp_t zu2, const fp_t u) {
+    pythia_fp_sqr(zu2, u);
+    pythia_fp_mul(zu2, zu2, sswu_z);
+    pythia_fp_sqr(t, zu2);
+    fp_add(t, t, zu2);
+}
+
+// Simplified SWU map to the isogenous curve, straight-line version of RFC 9380 section 6.6.2.
+// Takes zu2 and inv0 of denominator computed by sswu_den, so that inversions can be shared.
+static void sswu_map(fp_t x, fp_t y, const fp_t u, const fp_t zu2, const fp_t t_inv) {
+    fp_t t; fp_null(t);
+    fp_t x2; fp_null(x2);
+    fp_t y2; fp_null(y2);
+    fp_t gx1; fp_null(gx1);
+    fp_t gx2; fp_null(gx2);
+    bn_t b; bn_null(b);
+
+    TRY {
+        fp_new(t);
+        fp_new(x2);
+        fp_new(y2);
+        fp_new(gx1);
+        fp_new(gx2);
+        bn_new(b);
+
+        // x1 = -B' / A' * (1 + t_inv), or B' / (Z * A') when denominator is 0
+        fp_set_dig(x, 1);
+        fp_add(x, x, t_inv);
+        pythia_fp_mul(x, x, sswu_c1);
+        fp_cmov(x, sswu_c2, fp_is_zero_ct(t_inv));
+
+        // x2 = Z u^2 x1, exactly one of g(x1), g(x2) is a square
+        pythia_fp_mul(x2, zu2, x);
+        sswu_curve_rhs(gx1, x);
+        sswu_curve_rhs(gx2, x2);
+
+        pythia_fp_exp(y, gx1, exp_sqrt);
+        pythia_fp_exp(y2, gx2, exp_sqrt);
+        pythia_fp_sqr(t, y);
+
+        dig_t gx1_square = fp_eq_ct(t, gx1);
+        fp_cmov(x, x2, gx1_square ^ 1);
+        fp_cmov(y, y2, gx1_square ^ 1);
+
+        // sgn0(y) = sgn0(u)
+        fp_neg(t, y);
+        fp_cmov(y, t, fp_sgn0(u, b) ^ fp_sgn0(y, b));
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(b);
+        fp_free(gx2);
+        fp_free(gx1);
+        fp_free(y2);
+        fp_free(x2);
+        fp_free(t);
+    }
+}
+
+// Horner's evaluation of polynomial with n coefficients, monic polynomials have implicit leading 1
+static void poly_eval(fp_t c, fp_st *coef, size_t n, int monic, const fp_t x) {
+    size_t i = n - 1;
+
+    if (monic) {
+        fp_add(c, x, coef[i]);
+    } else {
+        fp_copy(c, coef[i]);
+    }
+
+    while (i-- > 0) {
+        pythia_fp_mul(c, c, x);
+        fp_add(c, c, coef[i]);
+    }
+}
+
+// Maps point of the isogenous curve to G1 curve, result is left in Jacobian coordinates to skip inversions
+static void iso_map(g1_t p, const fp_t x, const fp_t y) {
+    fp_t xn; fp_null(xn);
+    fp_t xd; fp_null(xd);
+    fp_t yn; fp_null(yn);
+    fp_t yd; fp_null(yd);
+    fp_t t; fp_null(t);
+
+    TRY {
+        fp_new(xn);
+        fp_new(xd);
+        fp_new(yn);
+        fp_new(yd);
+        fp_new(t);
+
+        poly_eval(xn, iso_xnum, G1_XNUM_LEN, 0, x);
+        poly_eval(xd, iso_xden, G1_XDEN_LEN, 1, x);
+        poly_eval(yn, iso_ynum, G1_YNUM_LEN, 0, x);
+        poly_eval(yd, iso_yden, G1_YDEN_LEN, 1, x);
+
+        // Z = xd * yd, X = xn * xd * yd^2, Y = y * yn * xd^3 * yd^2. Kernel points get Z = 0, i.e. infinity.
+        pythia_fp_mul(p->z, xd, yd);
+        pythia_fp_sqr(t, yd);
+        pythia_fp_mul(t, t, xd);
+        pythia_fp_mul(p->x, xn, t);
+        pythia_fp_sqr(xd, xd);
+        pythia_fp_mul(t, t, xd);
+        pythia_fp_mul(t, t, yn);
+        pythia_fp_mul(p->y, t, y);
+        p->norm = 0;
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp_free(t);
+        fp_free(yd);
+        fp_free(yn);
+        fp_free(xd);
+        fp_free(xn);
+    }
+}
+
+// expand_message_xmd of RFC 9380 section 5.3.1 with SHA-256
+static void expand_message_xmd(uint8_t *out, size_t out_size, const uint8_t *msg, size_t msg_size,
+                               const uint8_t *dst, size_t dst_size) {
+    uint8_t b0[MD_LEN_SH256], bi[MD_LEN_SH256];
+    size_t ell = (out_size + MD_LEN_SH256 - 1) / MD_LEN_SH256;
+
+    if (ell > 255 || dst_size > 255)
+        THROW(ERR_NO_VALID);
+
+    // Z_pad || msg || l_i_b_str || I2OSP(0, 1) || DST_prime, also fits b_i inputs
+    size_t in_size = 64 + msg_size + 3 + dst_size + 1;
+    uint8_t *in = (uint8_t *)malloc(in_size);
+    if (!in)
+        THROW(ERR_NO_MEMORY);
+
+    TRY {
+        size_t pos = 64;
+
+        memset(in, 0, pos);
+        if (msg_size) {
+            memcpy(in + pos, msg, msg_size);
+            pos += msg_size;
+        }
+        in[pos++] = (uint8_t)(out_size >> 8);
+        in[pos++] = (uint8_t)out_size;
+        in[pos++] = 0;
+        memcpy(in + pos, dst, dst_size);
+        pos += dst_size;
+        in[pos++] = (uint8_t)dst_size;
+
+        md_map_sh256(b0, in, (int)pos);
+
+        // b_i = H(strxor(b_0, b_(i - 1)) || I2OSP(i, 1) || DST_prime), b_1 hashes b_0 itself
+        memset(bi, 0, sizeof(bi));
+        for (size_t i = 1; i <= ell; i++) {
+            for (size_t j = 0; j < MD_LEN_SH256; j++)
+                in[j] = b0[j] ^ bi[j];
+            in[MD_LEN_SH256] = (uint8_t)i;
+            memcpy(in + MD_LEN_SH256 + 1, dst, dst_size);
+            in[MD_LEN_SH256 + 1 + dst_size] = (uint8_t)dst_size;
+
+            md_map_sh256(bi, in, (int)(MD_LEN_SH256 + 2 + dst_size));
+
+            size_t off = (i - 1) * MD_LEN_SH256;
+            memcpy(out + off, bi, out_size - off < MD_LEN_SH256 ? out_size - off : MD_LEN_SH256);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        free(in);
+    }
+}
+
+// hash_to_field of RFC 9380 section 5.2, count elements of Fp (m = 1) or count / 2 elements of Fp2 (m = 2)
+static void hash_to_fp(fp_t *e, size_t count, const uint8_t *msg, size_t msg_size,
+                       const uint8_t *dst, size_t dst_size) {
+    uint8_t uniform[4 * HASH_FIELD_LEN];
+
+    bn_t b; bn_null(b);
+
+    TRY {
+        bn_new(b);
+
+        expand_message_xmd(uniform, count * HASH_FIELD_LEN, msg, msg_size, dst, dst_size);
+
+        for (size_t i = 0; i < count; i++) {
+            bn_read_bin(b, uniform + i * HASH_FIELD_LEN, HASH_FIELD_LEN);
+            bn_mod(b, b, hash_prime);
+            fp_prime_conv(e[i], b);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(b);
+    }
+}
+
+// Double-and-add by public constant. Points before cofactor clearing lie outside of G1, where
+// endomorphism-based multiplication of relic doesn't apply.
+static void g1_mul_u64(g1_t r, g1_t p, uint64_t k) {
+    g1_t t; g1_null(t);
+
+    TRY {
+        g1_new(t);
+        g1_copy(t, p);
+        g1_copy(r, p);
+
+        int i = 63;
+        while (!((k >> i) & 1))
+            i--;
+
+        while (i-- > 0) {
+            g1_dbl(r, r);
+            if ((k >> i) & 1)
+                g1_add(r, r, t);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(t);
+    }
+}
+
+void g1_map_sswu(g1_t p, const uint8_t *msg, size_t msg_size, const uint8_t *dst, size_t dst_size) {
+    g1_map_sswu_batch(&p, &msg, &msg_size, 1, dst, dst_size);
+}
+
+void g1_map_sswu_batch(g1_t *p, const uint8_t *const *msg, const size_t *msg_sizes, size_t n,
+                       const uint8_t *dst, size_t dst_size) {
+    size_t m = 2 * n;
+
+    fp_t *u = NULL;
+    fp_t *zu2 = NULL;
+    fp_t *t = NULL;
+    fp_t x; fp_null(x);
+    fp_t y; fp_null(y);
+    g1_t q; g1_null(q);
+
+    if (!n)
+        return;
+
+    TRY {
+        u = fp_array_new(m);
+        zu2 = fp_array_new(m);
+        t = fp_array_new(m);
+        fp_new(x);
+        fp_new(y);
+        g1_new(q);
+
+        for (size_t i = 0; i < n; i++) {
+            hash_to_fp(u + 2 * i, 2, msg[i], msg_sizes[i], dst, dst_size);
+        }
+
+        for (size_t j = 0; j < m; j++) {
+            sswu_den(t[j], zu2[j], u[j]);
+        }
+        fp_inv0_sim(t, m);
+
+        for (size_t i = 0; i < n; i++) {
+            sswu_map(x, y, u[2 * i], zu2[2 * i], t[2 * i]);
+            iso_map(p[i], x, y);
+            sswu_map(x, y, u[2 * i + 1], zu2[2 * i + 1], t[2 * i + 1]);
+            iso_map(q, x, y);
+
+            g1_add(p[i], p[i], q);
+            g1_mul_u64(p[i], p[i], g1_h_eff);
+        }
+
+        // Points are still in Jacobian coordinates, they share the last inversion too
+        ep_norm_sim(p, (const ep_t *)p, (int)n);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g1_free(q);
+        fp_free(y);
+        fp_free(x);
+        fp_array_free(t, m);
+        fp_array_free(zu2, m);
+        fp_array_free(u, m);
+    }
+}
+
+/*
+ * Fp2 helpers of the G2 map, branch-free like the Fp ones.
+ */
+static void fp2_cmov(fp2_t c, fp2_t a, dig_t bit) {
+    fp_cmov(c[0], a[0], bit);
+    fp_cmov(c[1], a[1], bit);
+}
+
+static dig_t fp2_eq_ct(fp2_t a, fp2_t b) {
+    return fp_eq_ct(a[0], b[0]) & fp_eq_ct(a[1], b[1]);
+}
+
+static dig_t fp2_is_zero_ct(fp2_t a) {
+    return fp_is_zero_ct(a[0]) & fp_is_zero_ct(a[1]);
+}
+
+// sgn0 of RFC 9380 section 4.1 for extension degree 2
+static dig_t fp2_sgn0(fp2_t a, bn_t t) {
+    dig_t sign0 = fp_sgn0(a[0], t);
+    dig_t zero0 = fp_is_zero_ct(a[0]);
+    dig_t sign1 = fp_sgn0(a[1], t);
+
+    return sign0 | (zero0 & sign1);
+}
+
+// c = a^e by square-and-multiply, e is public
+static void fp2_exp_pub(fp2_t c, fp2_t a, bn_t e) {
+    fp2_t t; fp2_null(t);
+
+    TRY {
+        fp2_new(t);
+        fp2_copy(t, a);
+        fp2_set_dig(c, 1);
+
+        for (int i = bn_bits(e) - 1; i >= 0; i--) {
+            pythia_fp2_sqr(c, c);
+            if (bn_get_bit(e, i))
+                pythia_fp2_mul(c, c, t);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp2_free(t);
+    }
+}
+
+static void fp2_array_free(fp2_t *a, size_t n) {
+    if (!a)
+        return;
+
+    for (size_t i = 0; i < n; i++) {
+        fp2_free(a[i]);
+    }
+
+    free(a);
+}
+
+static fp2_t *fp2_array_new(size_t n) {
+    fp2_t *a = (fp2_t *)calloc(n, sizeof(fp2_t));
+
+    if (!a)
+        THROW(ERR_NO_MEMORY);
+
+    for (size_t i = 0; i < n; i++) {
+        fp2_null(a[i]);
+    }
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            fp2_new(a[i]);
+        }
+    }
+    CATCH_ANY {
+        fp2_array_free(a, n);
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {}
+
+    return a;
+}
+
+// Replaces n values with inv0 of them, a^-1 = conj(a) / (a0^2 + a1^2) with norms inverted together
+static void fp2_inv0_sim(fp2_t *a, size_t n) {
+    fp_t *norm = NULL;
+    fp_t t; fp_null(t);
+
+    TRY {
+        norm = fp_array_new(n);
+        fp_new(t);
+
+        for (size_t i = 0; i < n; i++) {
+            pythia_fp_sqr(norm[i], a[i][0]);
+            pythia_fp_sqr(t, a[i][1]);
+            fp_add(norm[i], norm[i], t);
+        }
+
+        fp_inv0_sim(norm, n);
+
+        for (size_t i = 0; i < n; i++) {
+            pythia_fp_mul(a[i][0], a[i][0], norm[i]);
+            pythia_fp_mul(a[i][1], a[i][1], norm[i]);
+            fp_neg(a[i][1], a[i][1]);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp_free(t);
+        fp_array_free(norm, n);
+    }
+}
+
+// Square root candidate for p = 3 mod 4 (Adj and Rodriguez-Henriquez, algorithm 9), correct whenever a is a square
+static void fp2_srt_ct(fp2_t c, fp2_t a) {
+    fp2_t t; fp2_null(t);
+    fp2_t alpha; fp2_null(alpha);
+    fp2_t x0; fp2_null(x0);
+    fp2_t ix0; fp2_null(ix0);
+    fp2_t m1;
+
+    TRY {
+        fp2_new(t);
+        fp2_new(alpha);
+        fp2_new(x0);
+        fp2_new(ix0);
+        fp2_view(m1, fp2_minus_one);
+
+        // alpha = a^((p - 1) / 2), x0 = a^((p + 1) / 4)
+        fp2_exp_pub(t, a, exp_sqrt2);
+        pythia_fp2_sqr(alpha, t);
+        pythia_fp2_mul(alpha, alpha, a);
+        pythia_fp2_mul(x0, t, a);
+
+        // i * x0 if alpha = -1, (1 + alpha)^((p - 1) / 2) * x0 otherwise
+        fp_neg(ix0[0], x0[1]);
+        fp_copy(ix0[1], x0[0]);
+
+        fp2_copy(t, alpha);
+        fp_add_dig(t[0], t[0], 1);
+        fp2_exp_pub(t, t, exp_half);
+        pythia_fp2_mul(c, t, x0);
+        fp2_cmov(c, ix0, fp2_eq_ct(alpha, m1));
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp2_free(ix0);
+        fp2_free(x0);
+        fp2_free(alpha);
+        fp2_free(t);
+    }
+}
+
+// c = x^3 + A'x + B' of the curve isogenous to the twist
+static void sswu2_curve_rhs(fp2_t c, fp2_t x) {
+    fp2_t a; fp2_view(a, sswu2_a);
+    fp2_t b; fp2_view(b, sswu2_b);
+
+    pythia_fp2_sqr(c, x);
+    fp2_add(c, c, a);
+    pythia_fp2_mul(c, c, x);
+    fp2_add(c, c, b);
+}
+
+// Computes zu2 = Z u^2 and denominator t = Z^2 u^4 + Z u^2 of sswu2_map
+static void sswu2_den(fp2_t t, fp2_t zu2, fp2_t u) {
+    fp2_t z; fp2_view(z, sswu2_z);
+
+    pythia_fp2_sqr(zu2, u);
+    pythia_fp2_mul(zu2, zu2, z);
+    pythia_fp2_sqr(t, zu2);
+    fp2_add(t, t, zu2);
+}
+
+// Simplified SWU map over Fp2, same steps as sswu_map
+static void sswu2_map(fp2_t x, fp2_t y, fp2_t u, fp2_t zu2, fp2_t t_inv) {
+    fp2_t t; fp2_null(t);
+    fp2_t x2; fp2_null(x2);
+    fp2_t y2; fp2_null(y2);
+    fp2_t gx1; fp2_null(gx1);
+    fp2_t gx2; fp2_null(gx2);
+    bn_t b; bn_null(b);
+    fp2_t c1, c2;
+
+    TRY {
+        fp2_new(t);
+        fp2_new(x2);
+        fp2_new(y2);
+        fp2_new(gx1);
+        fp2_new(gx2);
+        bn_new(b);
+        fp2_view(c1, sswu2_c1);
+        fp2_view(c2, sswu2_c2);
+
+        fp2_set_dig(x, 1);
+        fp2_add(x, x, t_inv);
+        pythia_fp2_mul(x, x, c1);
+        fp2_cmov(x, c2, fp2_is_zero_ct(t_inv));
+
+        pythia_fp2_mul(x2, zu2, x);
+        sswu2_curve_rhs(gx1, x);
+        sswu2_curve_rhs(gx2, x2);
+
+        fp2_srt_ct(y, gx1);
+        fp2_srt_ct(y2, gx2);
+        pythia_fp2_sqr(t, y);
+
+        dig_t gx1_square = fp2_eq_ct(t, gx1);
+        fp2_cmov(x, x2, gx1_square ^ 1);
+        fp2_cmov(y, y2, gx1_square ^ 1);
+
+        fp2_neg(t, y);
+        fp2_cmov(y, t, fp2_sgn0(u, b) ^ fp2_sgn0(y, b));
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(b);
+        fp2_free(gx2);
+        fp2_free(gx1);
+        fp2_free(y2);
+        fp2_free(x2);
+        fp2_free(t);
+    }
+}
+
+static void poly2_eval(fp2_t c, fp_st (*coef)[2], size_t n, int monic, fp2_t x) {
+    size_t i = n - 1;
+    fp2_t k;
+
+    fp2_view(k, coef[i]);
+    if (monic) {
+        fp2_add(c, x, k);
+    } else {
+        fp2_copy(c, k);
+    }
+
+    while (i-- > 0) {
+        fp2_view(k, coef[i]);
+        pythia_fp2_mul(c, c, x);
+        fp2_add(c, c, k);
+    }
+}
+
+// Maps point of the isogenous curve to the twist, result is left in Jacobian coordinates
+static void iso2_map(g2_t p, fp2_t x, fp2_t y) {
+    fp2_t xn; fp2_null(xn);
+    fp2_t xd; fp2_null(xd);
+    fp2_t yn; fp2_null(yn);
+    fp2_t yd; fp2_null(yd);
+    fp2_t t; fp2_null(t);
+    fp2_t px, py, pz;
+
+    TRY {
+        fp2_new(xn);
+        fp2_new(xd);
+        fp2_new(yn);
+        fp2_new(yd);
+        fp2_new(t);
+        fp2_view(px, p->x);
+        fp2_view(py, p->y);
+        fp2_view(pz, p->z);
+
+        poly2_eval(xn, iso2_xnum, G2_XNUM_LEN, 0, x);
+        poly2_eval(xd, iso2_xden, G2_XDEN_LEN, 1, x);
+        poly2_eval(yn, iso2_ynum, G2_YNUM_LEN, 0, x);
+        poly2_eval(yd, iso2_yden, G2_YDEN_LEN, 1, x);
+
+        pythia_fp2_mul(pz, xd, yd);
+        pythia_fp2_sqr(t, yd);
+        pythia_fp2_mul(t, t, xd);
+        pythia_fp2_mul(px, xn, t);
+        pythia_fp2_sqr(xd, xd);
+        pythia_fp2_mul(t, t, xd);
+        pythia_fp2_mul(t, t, yn);
+        pythia_fp2_mul(py, t, y);
+        p->norm = 0;
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp2_free(t);
+        fp2_free(yd);
+        fp2_free(yn);
+        fp2_free(xd);
+        fp2_free(xn);
+    }
+}
+
+// Applies psi to every Jacobian coordinate, conjugation commutes with the coordinate map
+static void g2_psi(g2_t r, g2_t p) {
+    fp2_t x, y, z, c1, c2;
+
+    g2_copy(r, p);
+    fp2_view(x, r->x);
+    fp2_view(y, r->y);
+    fp2_view(z, r->z);
+    fp2_view(c1, psi_c1);
+    fp2_view(c2, psi_c2);
+
+    fp_neg(x[1], x[1]);
+    pythia_fp2_mul(x, x, c1);
+    fp_neg(y[1], y[1]);
+    pythia_fp2_mul(y, y, c2);
+    fp_neg(z[1], z[1]);
+}
+
+static void g2_mul_u64(g2_t r, g2_t p, uint64_t k) {
+    g2_t t; g2_null(t);
+
+    TRY {
+        g2_new(t);
+        g2_copy(t, p);
+        g2_copy(r, p);
+
+        int i = 63;
+        while (!((k >> i) & 1))
+            i--;
+
+        while (i-- > 0) {
+            g2_dbl(r, r);
+            if ((k >> i) & 1)
+                g2_add(r, r, t);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g2_free(t);
+    }
+}
+
+// Multiplies by h_eff with psi (Budroni and Pintore), RFC 9380 appendix G.3
+static void g2_clear_cofactor(g2_t r, g2_t p) {
+    g2_t t1; g2_null(t1);
+    g2_t t2; g2_null(t2);
+    g2_t t3; g2_null(t3);
+
+    TRY {
+        g2_new(t1);
+        g2_new(t2);
+        g2_new(t3);
+
+        // t1 = [z]P, t2 = psi(P)
+        g2_mul_u64(t1, p, curve_z_abs);
+        g2_neg(t1, t1);
+        g2_psi(t2, p);
+
+        // t3 = psi^2(2P) - psi(P)
+        g2_dbl(t3, p);
+        g2_psi(t3, t3);
+        g2_psi(t3, t3);
+        g2_sub(t3, t3, t2);
+
+        // t2 = [z]([z]P + psi(P))
+        g2_add(t2, t1, t2);
+        g2_mul_u64(t2, t2, curve_z_abs);
+        g2_neg(t2, t2);
+
+        // r = [z^2 - z - 1]P + [z - 1]psi(P) + psi^2(2P)
+        g2_add(t3, t3, t2);
+        g2_sub(t3, t3, t1);
+        g2_sub(r, t3, p);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g2_free(t3);
+        g2_free(t2);
+        g2_free(t1);
+    }
+}
+
+void g2_map_sswu(g2_t p, const uint8_t *msg, size_t msg_size, const uint8_t *dst, size_t dst_size) {
+    g2_map_sswu_batch(&p, &msg, &msg_size, 1, dst, dst_size);
+}
+
+void g2_map_sswu_batch(g2_t *p, const uint8_t *const *msg, const size_t *msg_sizes, size_t n,
+                       const uint8_t *dst, size_t dst_size) {
+    size_t m = 2 * n;
+
+    fp2_t *u = NULL;
+    fp2_t *zu2 = NULL;
+    fp2_t *t = NULL;
+    fp2_t x; fp2_null(x);
+    fp2_t y; fp2_null(y);
+    g2_t q; g2_null(q);
+
+    if (!n)
+        return;
+
+    TRY {
+        u = fp2_array_new(m);
+        zu2 = fp2_array_new(m);
+        t = fp2_array_new(m);
+        fp2_new(x);
+        fp2_new(y);
+        g2_new(q);
+
+        for (size_t i = 0; i < n; i++) {
+            fp_t e[4] = { u[2 * i][0], u[2 * i][1], u[2 * i + 1][0], u[2 * i + 1][1] };
+            hash_to_fp(e, 4, msg[i], msg_sizes[i], dst, dst_size);
+        }
+
+        for (size_t j = 0; j < m; j++) {
+            sswu2_den(t[j], zu2[j], u[j]);
+        }
+        fp2_inv0_sim(t, m);
+
+        for (size_t i = 0; i < n; i++) {
+            sswu2_map(x, y, u[2 * i], zu2[2 * i], t[2 * i]);
+            iso2_map(p[i], x, y);
+            sswu2_map(x, y, u[2 * i + 1], zu2[2 * i + 1], t[2 * i + 1]);
+            iso2_map(q, x, y);
+
+            g2_add(p[i], p[i], q);
+            g2_clear_cofactor(p[i], p[i]);
+        }
+
+        ep2_norm_sim(p, p, (int)n);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g2_free(q);
+        fp2_free(y);
+        fp2_free(x);
+        fp2_array_free(t, m);
+        fp2_array_free(zu2, m);
+        fp2_array_free(u, m);
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_HASH_H
+#define PYTHIA_PYTHIA_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <relic/relic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Domain separation tag used when hashing to G1 with PYTHIA_HASH_MODE_SSWU
+#define PYTHIA_HASH_G1_DST "PYTHIA-V01-CS01-with-BLS12381G1_XMD:SHA-256_SSWU_RO_"
+
+/// Domain separation tag used when hashing to G2 with PYTHIA_HASH_MODE_SSWU
+#define PYTHIA_HASH_G2_DST "PYTHIA-V01-CS01-with-BLS12381G2_XMD:SHA-256_SSWU_RO_"
+
+/// Prepares constants of hash to curve maps, should be called once during initialization
+void hash_init(void);
+
+/// Frees constants allocated by hash_init
+void hash_deinit(void);
+
+/// Hashes message to G1 as BLS12381G1_XMD:SHA-256_SSWU_RO_ suite of RFC 9380: expand_message_xmd,
+/// simplified SWU map to the 11-isogenous curve, isogeny map and cofactor clearing.
+/// Field arithmetic doesn't branch on message, so the map runs in constant time.
+/// \param [out] p point in G1
+/// \param [in] msg message
+/// \param [in] msg_size message size
+/// \param [in] dst domain separation tag
+/// \param [in] dst_size domain separation tag size, at most 255 bytes
+void g1_map_sswu(g1_t p, const uint8_t *msg, size_t msg_size, const uint8_t *dst, size_t dst_size);
+
+/// Hashes n messages to G1 like g1_map_sswu. Denominators of all SWU maps are inverted at once
+/// (Montgomery's trick) and results are normalized together, so that n hashes cost two inversions.
+/// \param [out] p array of n points in G1
+/// \param [in] msg array of n messages
+/// \param [in] msg_sizes array of n message sizes
+/// \param [in] n number of messages
+/// \param [in] dst domain separation tag
+/// \param [in] dst_size domain separation tag size, at most 255 bytes
+void g1_map_sswu_batch(g1_t *p, const uint8_t *const *msg, const size_t *msg_sizes, size_t n,
+                       const uint8_t *dst, size_t dst_size);
+
+/// Hashes message to G2 as BLS12381G2_XMD:SHA-256_SSWU_RO_ suite of RFC 9380: simplified SWU map over Fp2
+/// to the 3-isogenous curve, isogeny map and cofactor clearing with psi endomorphism instead of
+/// multiplication by the 636-bit effective cofactor.
+/// \param [out] p point in G2
+/// \param [in] msg message
+/// \param [in] msg_size message size
+/// \param [in] dst domain separation tag
+/// \param [in] dst_size domain separation tag size, at most 255 bytes
+void g2_map_sswu(g2_t p, const uint8_t *msg, size_t msg_size, const uint8_t *dst, size_t dst_size);
+
+/// Hashes n messages to G2 like g2_map_sswu, sharing inversions as g1_map_sswu_batch does
+/// \param [out] p array of n points in G2
+/// \param [in] msg array of n messages
+/// \param [in] msg_sizes array of n message sizes
+/// \param [in] n number of messages
+/// \param [in] dst domain separation tag
+/// \param [in] dst_size domain separation tag size, at most 255 bytes
+void g2_map_sswu_batch(g2_t *p, const uint8_t *const *msg, const size_t *msg_sizes, size_t n,
+                       const uint8_t *dst, size_t dst_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_HASH_H
@@ -0,0 +1,372 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <relic/relic.h>
+#include "pythia_md.h"
+#include "pythia_cpu.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MD_X86 1
+#include <immintrin.h>
+#else
+#define MD_X86 0
+#endif
+
+#define BLOCK 128
+#define LANES PYTHIA_MD_MAX_LANES
+
+/*
+ * Kernels compress one block of every lane. State and message words are interleaved by lanes:
+ * h[i * lanes + l] is i-th state word of lane l. Lanes with zero active mask keep their state.
+ */
+typedef void (*compress_t)(uint64_t *h, const uint64_t *w, const uint64_t *active);
+
+static const uint64_t md_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static const uint64_t md_iv[8] = {
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL,
+};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static void compress_x1(uint64_t *h, const uint64_t *w, const uint64_t *active) {
+    uint64_t s[8], x[16];
+
+    if (!active[0])
+        return;
+
+    memcpy(s, h, sizeof(s));
+    memcpy(x, w, sizeof(x));
+
+    for (int t = 0; t < 80; t++) {
+        if (t >= 16) {
+            uint64_t x1 = x[(t - 15) & 15], x14 = x[(t - 2) & 15];
+            x[t & 15] += (ROTR(x14, 19) ^ ROTR(x14, 61) ^ (x14 >> 6)) + x[(t - 7) & 15] +
+                         (ROTR(x1, 1) ^ ROTR(x1, 8) ^ (x1 >> 7));
+        }
+
+        uint64_t t1 = s[7] + (ROTR(s[4], 14) ^ ROTR(s[4], 18) ^ ROTR(s[4], 41)) +
+                      ((s[4] & s[5]) ^ (~s[4] & s[6])) + md_k[t] + x[t & 15];
+        uint64_t t2 = (ROTR(s[0], 28) ^ ROTR(s[0], 34) ^ ROTR(s[0], 39)) +
+                      ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+
+        memmove(s + 1, s, 7 * sizeof(uint64_t));
+        s[4] += t1;
+        s[0] = t1 + t2;
+    }
+
+    for (int i = 0; i < 8; i++)
+        h[i] += s[i];
+}
+
+#if MD_X86
+
+#define V4_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+#define V4_XOR3(a, b, c) _mm256_xor_si256(_mm256_xor_si256(a, b), c)
+
+__attribute__((target("avx2")))
+static void compress_x4(uint64_t *h, const uint64_t *w, const uint64_t *active) {
+    __m256i s[8], x[16];
+
+    for (int i = 0; i < 8; i++)
+        s[i] = _mm256_loadu_si256((const __m256i *)(h + 4 * i));
+    for (int i = 0; i < 16; i++)
+        x[i] = _mm256_loadu_si256((const __m256i *)(w + 4 * i));
+
+    for (int t = 0; t < 80; t++) {
+        if (t >= 16) {
+            __m256i x1 = x[(t - 15) & 15], x14 = x[(t - 2) & 15];
+            __m256i s0 = V4_XOR3(V4_ROTR(x1, 1), V4_ROTR(x1, 8), _mm256_srli_epi64(x1, 7));
+            __m256i s1 = V4_XOR3(V4_ROTR(x14, 19), V4_ROTR(x14, 61), _mm256_srli_epi64(x14, 6));
+            x[t & 15] = _mm256_add_epi64(_mm256_add_epi64(x[t & 15], s0),
+                                         _mm256_add_epi64(s1, x[(t - 7) & 15]));
+        }
+
+        __m256i e = s[4], a = s[0];
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, s[5]), _mm256_andnot_si256(e, s[6]));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, s[1]), _mm256_and_si256(s[2], _mm256_or_si256(a, s[1])));
+        __m256i t1 = _mm256_add_epi64(_mm256_add_epi64(s[7], V4_XOR3(V4_ROTR(e, 14), V4_ROTR(e, 18), V4_ROTR(e, 41))),
+                                      _mm256_add_epi64(_mm256_add_epi64(ch, x[t & 15]),
+                                                       _mm256_set1_epi64x((long long)md_k[t])));
+        __m256i t2 = _mm256_add_epi64(V4_XOR3(V4_ROTR(a, 28), V4_ROTR(a, 34), V4_ROTR(a, 39)), maj);
+
+        for (int i = 7; i > 0; i--)
+            s[i] = s[i - 1];
+        s[4] = _mm256_add_epi64(s[4], t1);
+        s[0] = _mm256_add_epi64(t1, t2);
+    }
+
+    __m256i mask = _mm256_loadu_si256((const __m256i *)active);
+    for (int i = 0; i < 8; i++) {
+        __m256i old = _mm256_loadu_si256((const __m256i *)(h + 4 * i));
+        _mm256_storeu_si256((__m256i *)(h + 4 * i), _mm256_blendv_epi8(old, _mm256_add_epi64(old, s[i]), mask));
+    }
+}
+
+// Ternary logic immediates: 0x96 is a ^ b ^ c, 0xCA is (a & b) | (~a & c), 0xE8 is majority
+#define V8_XOR3(a, b, c) _mm512_ternarylogic_epi64(a, b, c, 0x96)
+
+__attribute__((target("avx512f")))
+static void compress_x8(uint64_t *h, const uint64_t *w, const uint64_t *active) {
+    __m512i s[8], x[16];
+
+    for (int i = 0; i < 8; i++)
+        s[i] = _mm512_loadu_si512((const void *)(h + 8 * i));
+    for (int i = 0; i < 16; i++)
+        x[i] = _mm512_loadu_si512((const void *)(w + 8 * i));
+
+    for (int t = 0; t < 80; t++) {
+        if (t >= 16) {
+            __m512i x1 = x[(t - 15) & 15], x14 = x[(t - 2) & 15];
+            __m512i s0 = V8_XOR3(_mm512_ror_epi64(x1, 1), _mm512_ror_epi64(x1, 8), _mm512_srli_epi64(x1, 7));
+            __m512i s1 = V8_XOR3(_mm512_ror_epi64(x14, 19), _mm512_ror_epi64(x14, 61), _mm512_srli_epi64(x14, 6));
+            x[t & 15] = _mm512_add_epi64(_mm512_add_epi64(x[t & 15], s0),
+                                         _mm512_add_epi64(s1, x[(t - 7) & 15]));
+        }
+
+        __m512i e = s[4], a = s[0];
+        __m512i ch = _mm512_ternarylogic_epi64(e, s[5], s[6], 0xCA);
+        __m512i maj = _mm512_ternarylogic_epi64(a, s[1], s[2], 0xE8);
+        __m512i t1 = _mm512_add_epi64(
+                _mm512_add_epi64(s[7], V8_XOR3(_mm512_ror_epi64(e, 14), _mm512_ror_epi64(e, 18),
+                                               _mm512_ror_epi64(e, 41))),
+                _mm512_add_epi64(_mm512_add_epi64(ch, x[t & 15]), _mm512_set1_epi64((long long)md_k[t])));
+        __m512i t2 = _mm512_add_epi64(V8_XOR3(_mm512_ror_epi64(a, 28), _mm512_ror_epi64(a, 34),
+                                              _mm512_ror_epi64(a, 39)), maj);
+
+        for (int i = 7; i > 0; i--)
+            s[i] = s[i - 1];
+        s[4] = _mm512_add_epi64(s[4], t1);
+        s[0] = _mm512_add_epi64(t1, t2);
+    }
+
+    __m512i act = _mm512_loadu_si512((const void *)active);
+    __mmask8 mask = _mm512_test_epi64_mask(act, act);
+    for (int i = 0; i < 8; i++) {
+        __m512i old = _mm512_loadu_si512((const void *)(h + 8 * i));
+        _mm512_storeu_si512((void *)(h + 8 * i), _mm512_mask_add_epi64(old, mask, old, s[i]));
+    }
+}
+
+#endif
+
+static size_t md_supported = 1;
+static size_t md_lanes = 1;
+static compress_t md_compress = compress_x1;
+
+static void md_select(size_t max_lanes) {
+#if MD_X86
+    if (max_lanes >= 8 && md_supported >= 8) {
+        md_lanes = 8;
+        md_compress = compress_x8;
+        return;
+    }
+    if (max_lanes >= 4 && md_supported >= 4) {
+        md_lanes = 4;
+        md_compress = compress_x4;
+        return;
+    }
+#endif
+    md_lanes = 1;
+    md_compress = compress_x1;
+}
+
+void md_batch_init(void) {
+    md_supported = 1;
+#if MD_X86
+    if (cpu_features() & PYTHIA_CPU_AVX512F)
+        md_supported = 8;
+    else if (cpu_features() & PYTHIA_CPU_AVX2)
+        md_supported = 4;
+#endif
+    md_select(LANES);
+}
+
+size_t md_batch_lanes(void) {
+    return md_lanes;
+}
+
+void md_batch_set_max_lanes(size_t lanes) {
+    md_select(lanes);
+}
+
+/*
+ * Message of a lane is an optional prefix block (HMAC pad), full blocks read in place and one or two padded
+ * tail blocks.
+ */
+typedef struct {
+    const uint8_t *prefix;
+    const uint8_t *msg;
+    size_t full;
+    size_t blocks;
+    uint8_t tail[2 * BLOCK];
+} md_lane_t;
+
+static void lane_init(md_lane_t *l, const uint8_t *prefix, const uint8_t *msg, size_t size) {
+    size_t rem = size % BLOCK;
+    uint64_t bytes = (uint64_t)size + (prefix ? BLOCK : 0);
+
+    l->prefix = prefix;
+    l->msg = msg;
+    l->full = size / BLOCK;
+
+    memset(l->tail, 0, sizeof(l->tail));
+    if (rem)
+        memcpy(l->tail, msg + l->full * BLOCK, rem);
+    l->tail[rem] = 0x80;
+
+    // 128-bit big-endian length in bits closes the last block
+    size_t tail_blocks = rem + 1 + 16 <= BLOCK ? 1 : 2;
+    uint8_t *len = l->tail + tail_blocks * BLOCK - 16;
+    uint64_t hi = bytes >> 61, lo = bytes << 3;
+    for (int i = 0; i < 8; i++) {
+        len[7 - i] = (uint8_t)(hi >> (8 * i));
+        len[15 - i] = (uint8_t)(lo >> (8 * i));
+    }
+
+    l->blocks = (prefix ? 1 : 0) + l->full + tail_blocks;
+}
+
+static const uint8_t *lane_block(const md_lane_t *l, size_t b) {
+    if (l->prefix) {
+        if (b == 0)
+            return l->prefix;
+        b--;
+    }
+    if (b < l->full)
+        return l->msg + b * BLOCK;
+    return l->tail + (b - l->full) * BLOCK;
+}
+
+// Hashes count <= lanes messages with kernel of the given width
+static void hash_lanes(uint8_t (*digest)[MD_LEN_SH384], const md_lane_t *l, size_t count,
+                       size_t lanes, compress_t compress) {
+    uint64_t h[8 * LANES], w[16 * LANES], active[LANES];
+    size_t blocks = 0;
+
+    for (size_t i = 0; i < 8; i++)
+        for (size_t j = 0; j < lanes; j++)
+            h[i * lanes + j] = md_iv[i];
+
+    for (size_t j = 0; j < count; j++)
+        if (l[j].blocks > blocks)
+            blocks = l[j].blocks;
+
+    for (size_t b = 0; b < blocks; b++) {
+        for (size_t j = 0; j < lanes; j++) {
+            if (j < count && b < l[j].blocks) {
+                const uint8_t *p = lane_block(&l[j], b);
+                for (size_t i = 0; i < 16; i++) {
+                    uint64_t v = 0;
+                    for (size_t k = 0; k < 8; k++)
+                        v = (v << 8) | p[8 * i + k];
+                    w[i * lanes + j] = v;
+                }
+                active[j] = ~(uint64_t)0;
+            } else {
+                for (size_t i = 0; i < 16; i++)
+                    w[i * lanes + j] = 0;
+                active[j] = 0;
+            }
+        }
+
+        compress(h, w, active);
+    }
+
+    for (size_t j = 0; j < count; j++)
+        for (size_t i = 0; i < MD_LEN_SH384 / 8; i++)
+            for (size_t k = 0; k < 8; k++)
+                digest[j][8 * i + k] = (uint8_t)(h[i * lanes + j] >> (56 - 8 * k));
+}
+
+// Single message left over from full groups is hashed by scalar kernel, wide kernels would waste their lanes
+static void hash_group(uint8_t (*digest)[MD_LEN_SH384], const md_lane_t *l, size_t count) {
+    if (count == 1)
+        hash_lanes(digest, l, 1, 1, compress_x1);
+    else
+        hash_lanes(digest, l, count, md_lanes, md_compress);
+}
+
+void md_map_sh384_batch(uint8_t (*digest)[MD_LEN_SH384], const uint8_t *const *in, const size_t *in_sizes, size_t n) {
+    md_lane_t l[LANES];
+
+    for (size_t i = 0; i < n; i += md_lanes) {
+        size_t count = n - i < md_lanes ? n - i : md_lanes;
+
+        for (size_t j = 0; j < count; j++)
+            lane_init(&l[j], NULL, in[i + j], in_sizes[i + j]);
+
+        hash_group(digest + i, l, count);
+    }
+}
+
+void md_hmac_sh384_batch(uint8_t (*mac)[MD_LEN_SH384], const uint8_t *const *in, const size_t *in_sizes, size_t n,
+                         const uint8_t *key, size_t key_size) {
+    uint8_t k[BLOCK], ipad[BLOCK], opad[BLOCK];
+    uint8_t inner[LANES][MD_LEN_SH384];
+    md_lane_t l[LANES];
+
+    memset(k, 0, sizeof(k));
+    if (key_size > BLOCK)
+        md_map_sh384(k, key, (int)key_size);
+    else if (key_size)
+        memcpy(k, key, key_size);
+
+    for (size_t i = 0; i < BLOCK; i++) {
+        ipad[i] = (uint8_t)(k[i] ^ 0x36);
+        opad[i] = (uint8_t)(k[i] ^ 0x5C);
+    }
+
+    for (size_t i = 0; i < n; i += md_lanes) {
+        size_t count = n - i < md_lanes ? n - i : md_lanes;
+
+        for (size_t j = 0; j < count; j++)
+            lane_init(&l[j], ipad, in[i + j], in_sizes[i + j]);
+        hash_group(inner, l, count);
+
+        for (size_t j = 0; j < count; j++)
+            lane_init(&l[j], opad, inner[j], MD_LEN_SH384);
+        hash_group(mac + i, l, count);
+    }
+
+    memset(k, 0, sizeof(k));
+    memset(ipad, 0, sizeof(ipad));
+    memset(opad, 0, sizeof(opad));
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_MD_H
+#define PYTHIA_PYTHIA_MD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <relic/relic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Maximum number of messages hashed at once by multi-buffer SHA-384
+#define PYTHIA_MD_MAX_LANES 8
+
+/// Selects the widest multi-buffer SHA-384 kernel allowed by features found by cpu_init: 8 lanes with AVX-512,
+/// 4 lanes with AVX2, portable scalar code otherwise. Should be called once during initialization, after cpu_init
+void md_batch_init(void);
+
+/// \return number of messages hashed at once by the selected kernel
+size_t md_batch_lanes(void);
+
+/// Limits width of the selected kernel, so that narrower kernels can be tested and benchmarked.
+/// Kernels not supported by CPU are never selected.
+/// \param [in] lanes maximum number of lanes, 1 selects portable scalar code
+void md_batch_set_max_lanes(size_t lanes);
+
+/// Hashes n messages with SHA-384. Result is equal to md_map_sh384 called for each message
+/// \param [out] digest array of n digests
+/// \param [in] in array of n messages
+/// \param [in] in_sizes array of n message sizes
+/// \param [in] n number of messages
+void md_map_sh384_batch(uint8_t (*digest)[MD_LEN_SH384], const uint8_t *const *in, const size_t *in_sizes, size_t n);
+
+/// Computes HMAC-SHA-384 of n messages with the same key. Result is equal to md_hmac called for each message
+/// \param [out] mac array of n MACs
+/// \param [in] in array of n messages
+/// \param [in] in_sizes array of n message sizes
+/// \param [in] n number of messages
+/// \param [in] key key
+/// \param [in] key_size key size
+void md_hmac_sh384_batch(uint8_t (*mac)[MD_LEN_SH384], const uint8_t *const *in, const size_t *in_sizes, size_t n,
+                         const uint8_t *key, size_t key_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_MD_H
@@ -0,0 +1,567 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pythia_pool.h"
+#include "pythia_c.h"
+#include "pythia_buf_exports.h"
+#include "pythia_buf_sizes_c.h"
+#include "pythia_init_c.h"
+
+#include <relic/relic.h>
+
+#if RELIC_USE_PTHREAD
+#include <pthread.h>
+#endif // RELIC_USE_PTHREAD
+
+/// Generates one pool entry, throws relic error on failure
+typedef void (*pool_generate_fn)(uint8_t *entry);
+
+/// Bounded ring of precomputed fixed-size entries, refilled by caller or by background threads
+typedef struct pool {
+    uint8_t *entries;           /// Entries storage
+    size_t entry_size;          /// Size of one entry
+    size_t capacity;            /// Maximum number of entries
+    size_t head;                /// Index of the oldest entry
+    size_t count;               /// Number of entries in the pool
+    size_t exhausted;           /// Number of times entry was requested from empty pool
+    pool_generate_fn generate;  /// Entry generator
+#if RELIC_USE_PTHREAD
+    pthread_mutex_t mutex;      /// Guards all fields above
+    pthread_cond_t not_full;    /// Signaled when entry is taken from the pool
+    pthread_t *threads;         /// Background refill threads
+    size_t threads_count;       /// Number of started background threads
+    int stopping;               /// Whether background threads are asked to stop
+    size_t failures;            /// Number of background threads stopped because entry generation failed
+#endif // RELIC_USE_PTHREAD
+} pool_t;
+
+// Blinding factor entry: r || rInv
+#define BLIND_ENTRY_SIZE (2 * FP_BYTES)
+
+// Proof nonce entry: v || t1 size || serialized t1
+#define NONCE_ENTRY_SIZE (FP_BYTES + 1 + DEF_PYTHIA_G1_BUF_SIZE)
+
+struct pythia_blind_pool {
+    pool_t pool;
+};
+
+struct pythia_nonce_pool {
+    pool_t pool;
+};
+
+static void pool_lock(pool_t *pool) {
+#if RELIC_USE_PTHREAD
+    pthread_mutex_lock(&pool->mutex);
+#endif // RELIC_USE_PTHREAD
+}
+
+static void pool_unlock(pool_t *pool) {
+#if RELIC_USE_PTHREAD
+    pthread_mutex_unlock(&pool->mutex);
+#endif // RELIC_USE_PTHREAD
+}
+
+static int pool_init(pool_t *pool, size_t capacity, size_t entry_size, pool_generate_fn generate) {
+    memset(pool, 0, sizeof(pool_t));
+
+    if (!capacity)
+        return -1;
+
+    pool->entries = (uint8_t *)calloc(capacity, entry_size);
+    if (!pool->entries)
+        return -1;
+
+    pool->entry_size = entry_size;
+    pool->capacity = capacity;
+    pool->generate = generate;
+
+#if RELIC_USE_PTHREAD
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->not_full, NULL);
+#endif // RELIC_USE_PTHREAD
+
+    return 0;
+}
+
+static size_t pool_size(pool_t *pool) {
+    pool_lock(pool);
+    size_t count = pool->count;
+    pool_unlock(pool);
+
+    return count;
+}
+
+static int pool_push(pool_t *pool, const uint8_t *entry) {
+    int pushed = 0;
+
+    pool_lock(pool);
+
+    if (pool->count < pool->capacity) {
+        size_t i = (pool->head + pool->count) % pool->capacity;
+
+        memcpy(pool->entries + i * pool->entry_size, entry, pool->entry_size);
+        pool->count++;
+
+        pushed = 1;
+    }
+
+    pool_unlock(pool);
+
+    return pushed;
+}
+
+static int pool_pop(pool_t *pool, uint8_t *entry) {
+    int popped = 0;
+
+    pool_lock(pool);
+
+    if (pool->count > 0) {
+        uint8_t *slot = pool->entries + pool->head * pool->entry_size;
+
+        memcpy(entry, slot, pool->entry_size);
+
+        // Entries are secret and must never be used twice
+        memset(slot, 0, pool->entry_size);
+
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+
+        popped = 1;
+
+#if RELIC_USE_PTHREAD
+        pthread_cond_signal(&pool->not_full);
+#endif // RELIC_USE_PTHREAD
+    }
+    else {
+        pool->exhausted++;
+    }
+
+    pool_unlock(pool);
+
+    return popped;
+}
+
+static int pool_fill(pool_t *pool, size_t count) {
+    uint8_t entry[NONCE_ENTRY_SIZE > BLIND_ENTRY_SIZE ? NONCE_ENTRY_SIZE : BLIND_ENTRY_SIZE];
+
+    pythia_err_init();
+
+    TRY {
+        for (size_t i = 0; i < count; i++) {
+            if (pool_size(pool) == pool->capacity)
+                break;
+
+            pool->generate(entry);
+
+            if (!pool_push(pool, entry))
+                break;
+        }
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        memset(entry, 0, sizeof(entry));
+
+        return -1;
+    }
+    FINALLY {}
+
+    memset(entry, 0, sizeof(entry));
+
+    return 0;
+}
+
+#if RELIC_USE_PTHREAD
+static void *pool_refill(void *arg) {
+    pool_t *pool = (pool_t *)arg;
+    uint8_t entry[NONCE_ENTRY_SIZE > BLIND_ENTRY_SIZE ? NONCE_ENTRY_SIZE : BLIND_ENTRY_SIZE];
+
+    pythia_err_init();
+
+    TRY {
+        for (;;) {
+            pthread_mutex_lock(&pool->mutex);
+            while (!pool->stopping && pool->count == pool->capacity)
+                pthread_cond_wait(&pool->not_full, &pool->mutex);
+            int stopping = pool->stopping;
+            pthread_mutex_unlock(&pool->mutex);
+
+            if (stopping)
+                break;
+
+            pool->generate(entry);
+            pool_push(pool, entry);
+        }
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        pthread_mutex_lock(&pool->mutex);
+        pool->failures++;
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    FINALLY {}
+
+    memset(entry, 0, sizeof(entry));
+
+    return NULL;
+}
+
+static void pool_stop(pool_t *pool) {
+    pthread_mutex_lock(&pool->mutex);
+
+    size_t threads_count = pool->threads_count;
+    pthread_t *threads = pool->threads;
+
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->not_full);
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (size_t i = 0; i < threads_count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    free(pool->threads);
+    pool->threads = NULL;
+    pool->threads_count = 0;
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+static int pool_start(pool_t *pool, size_t threads_count) {
+    pool_stop(pool);
+
+    if (!threads_count)
+        return 0;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    pool->stopping = 0;
+    pool->threads = (pthread_t *)calloc(threads_count, sizeof(pthread_t));
+
+    int res = pool->threads ? 0 : -1;
+
+    for (size_t i = 0; !res && i < threads_count; i++) {
+        if (pthread_create(&pool->threads[i], NULL, pool_refill, pool))
+            res = -1;
+        else
+            pool->threads_count++;
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (res)
+        pool_stop(pool);
+
+    return res;
+}
+
+static size_t pool_failures(pool_t *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    size_t failures = pool->failures;
+    pthread_mutex_unlock(&pool->mutex);
+
+    return failures;
+}
+#endif // RELIC_USE_PTHREAD
+
+static void pool_cleanup(pool_t *pool) {
+#if RELIC_USE_PTHREAD
+    pool_stop(pool);
+
+    pthread_cond_destroy(&pool->not_full);
+    pthread_mutex_destroy(&pool->mutex);
+#endif // RELIC_USE_PTHREAD
+
+    memset(pool->entries, 0, pool->capacity * pool->entry_size);
+    free(pool->entries);
+}
+
+static void blind_entry_generate(uint8_t *entry) {
+    bn_t r_bn; bn_null(r_bn);
+    bn_t rInv_bn; bn_null(rInv_bn);
+
+    TRY {
+        bn_new(r_bn);
+        bn_new(rInv_bn);
+
+        pythia_blind_factor(r_bn, rInv_bn);
+
+        bn_write_bin(entry, FP_BYTES, r_bn);
+        bn_write_bin(entry + FP_BYTES, FP_BYTES, rInv_bn);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(rInv_bn);
+        bn_free(r_bn);
+    }
+}
+
+static void nonce_entry_generate(uint8_t *entry) {
+    bn_t v_bn; bn_null(v_bn);
+
+    TRY {
+        bn_new(v_bn);
+
+        size_t t1_size = pythia_prove_nonce(v_bn, entry + FP_BYTES + 1, DEF_PYTHIA_G1_BUF_SIZE);
+
+        bn_write_bin(entry, FP_BYTES, v_bn);
+        entry[FP_BYTES] = (uint8_t)t1_size;
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        bn_free(v_bn);
+    }
+}
+
+int pythia_w_blind_pool_new(size_t capacity, pythia_blind_pool_t **pool) {
+    pythia_err_init();
+
+    if (!pool)
+        return -1;
+
+    pythia_blind_pool_t *p = (pythia_blind_pool_t *)malloc(sizeof(pythia_blind_pool_t));
+    if (!p)
+        return -1;
+
+    if (pool_init(&p->pool, capacity, BLIND_ENTRY_SIZE, blind_entry_generate)) {
+        free(p);
+
+        return -1;
+    }
+
+    *pool = p;
+
+    return 0;
+}
+
+void pythia_w_blind_pool_free(pythia_blind_pool_t *pool) {
+    if (!pool)
+        return;
+
+    pool_cleanup(&pool->pool);
+    free(pool);
+}
+
+int pythia_w_blind_pool_fill(pythia_blind_pool_t *pool, size_t count) {
+    return pool_fill(&pool->pool, count);
+}
+
+size_t pythia_w_blind_pool_size(pythia_blind_pool_t *pool) {
+    return pool_size(&pool->pool);
+}
+
+#if RELIC_USE_PTHREAD
+int pythia_w_blind_pool_start(pythia_blind_pool_t *pool) {
+    return pool_start(&pool->pool, 1);
+}
+
+void pythia_w_blind_pool_stop(pythia_blind_pool_t *pool) {
+    pool_stop(&pool->pool);
+}
+
+size_t pythia_w_blind_pool_failures(pythia_blind_pool_t *pool) {
+    return pool_failures(&pool->pool);
+}
+#endif // RELIC_USE_PTHREAD
+
+int pythia_w_blind_pooled(pythia_blind_pool_t *pool, const pythia_buf_t *password,
+                          pythia_buf_t *blinded_password, pythia_buf_t *blinding_secret) {
+    pythia_err_init();
+
+    uint8_t entry[BLIND_ENTRY_SIZE];
+
+    g1_t blinded_ep; g1_null(blinded_ep);
+    bn_t r_bn; bn_null(r_bn);
+    bn_t rInv_bn; bn_null(rInv_bn);
+
+    TRY {
+        g1_new(blinded_ep);
+        bn_new(r_bn);
+        bn_new(rInv_bn);
+
+        if (pool_pop(&pool->pool, entry)) {
+            bn_read_bin(r_bn, entry, FP_BYTES);
+            bn_read_bin(rInv_bn, entry + FP_BYTES, FP_BYTES);
+        }
+        else {
+            pythia_blind_factor(r_bn, rInv_bn);
+        }
+
+        pythia_blind_with_factor(password->p, password->len, r_bn, blinded_ep);
+
+        g1_write_buf(blinded_password, blinded_ep);
+        bn_write_buf(blinding_secret, rInv_bn);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        memset(entry, 0, sizeof(entry));
+
+        return -1;
+    }
+    FINALLY {
+        bn_free(rInv_bn);
+        bn_free(r_bn);
+        g1_free(blinded_ep);
+    }
+
+    memset(entry, 0, sizeof(entry));
+
+    return 0;
+}
+
+int pythia_w_nonce_pool_new(size_t depth, pythia_nonce_pool_t **pool) {
+    pythia_err_init();
+
+    if (!pool)
+        return -1;
+
+    pythia_nonce_pool_t *p = (pythia_nonce_pool_t *)malloc(sizeof(pythia_nonce_pool_t));
+    if (!p)
+        return -1;
+
+    if (pool_init(&p->pool, depth, NONCE_ENTRY_SIZE, nonce_entry_generate)) {
+        free(p);
+
+        return -1;
+    }
+
+    *pool = p;
+
+    return 0;
+}
+
+void pythia_w_nonce_pool_free(pythia_nonce_pool_t *pool) {
+    if (!pool)
+        return;
+
+    pool_cleanup(&pool->pool);
+    free(pool);
+}
+
+int pythia_w_nonce_pool_fill(pythia_nonce_pool_t *pool, size_t count) {
+    return pool_fill(&pool->pool, count);
+}
+
+size_t pythia_w_nonce_pool_size(pythia_nonce_pool_t *pool) {
+    return pool_size(&pool->pool);
+}
+
+size_t pythia_w_nonce_pool_exhausted(pythia_nonce_pool_t *pool) {
+    pool_lock(&pool->pool);
+    size_t exhausted = pool->pool.exhausted;
+    pool_unlock(&pool->pool);
+
+    return exhausted;
+}
+
+#if RELIC_USE_PTHREAD
+int pythia_w_nonce_pool_start(pythia_nonce_pool_t *pool, size_t threads) {
+    return pool_start(&pool->pool, threads);
+}
+
+void pythia_w_nonce_pool_stop(pythia_nonce_pool_t *pool) {
+    pool_stop(&pool->pool);
+}
+
+size_t pythia_w_nonce_pool_failures(pythia_nonce_pool_t *pool) {
+    return pool_failures(&pool->pool);
+}
+#endif // RELIC_USE_PTHREAD
+
+int pythia_w_prove_pooled(pythia_nonce_pool_t *pool,
+                          const pythia_buf_t *transformed_password, const pythia_buf_t *blinded_password,
+                          const pythia_buf_t *transformed_tweak, const pythia_buf_t *transformation_private_key,
+                          const pythia_buf_t *transformation_public_key,
+                          pythia_buf_t *proof_value_c, pythia_buf_t *proof_value_u) {
+    pythia_err_init();
+
+    uint8_t entry[NONCE_ENTRY_SIZE];
+
+    g1_t pi_p; g1_null(pi_p);
+    bn_t c_bn; bn_null(c_bn);
+    bn_t u_bn; bn_null(u_bn);
+    bn_t v_bn; bn_null(v_bn);
+    g1_t x_g1; g1_null(x_g1);
+    g2_t tTilde_g2; g2_null(tTilde_g2);
+    bn_t kw_bn; bn_null(kw_bn);
+    gt_t y_gt; gt_null(y_gt);
+
+    TRY {
+        // Reject malformed input before decoding and subgroup checks
+        g1_check_buf(blinded_password);
+        g2_check_buf_trusted(transformed_tweak);
+        bn_check_buf(transformation_private_key);
+        g1_check_buf_trusted(transformation_public_key);
+        gt_check_buf(transformed_password);
+
+        g1_new(x_g1);
+        g1_read_buf(x_g1, blinded_password);
+
+        g2_new(tTilde_g2);
+        g2_read_buf_trusted(tTilde_g2, transformed_tweak);
+
+        bn_new(kw_bn);
+        bn_read_buf(kw_bn, transformation_private_key);
+
+        g1_new(pi_p);
+        g1_read_buf_trusted(pi_p, transformation_public_key);
+
+        gt_new(y_gt);
+        gt_read_buf(y_gt, transformed_password);
+
+        bn_new(v_bn);
+        if (pool_pop(&pool->pool, entry)) {
+            bn_read_bin(v_bn, entry, FP_BYTES);
+        }
+        else {
+            entry[FP_BYTES] = (uint8_t)pythia_prove_nonce(v_bn, entry + FP_BYTES + 1, DEF_PYTHIA_G1_BUF_SIZE);
+        }
+
+        bn_new(c_bn);
+        bn_new(u_bn);
+        pythia_prove_with_nonce(y_gt, x_g1, tTilde_g2, kw_bn, pi_p, v_bn,
+                                entry + FP_BYTES + 1, entry[FP_BYTES], c_bn, u_bn);
+
+        bn_write_buf(proof_value_c, c_bn);
+        bn_write_buf(proof_value_u, u_bn);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        memset(entry, 0, sizeof(entry));
+
+        return -1;
+    }
+    FINALLY {
+        g1_free(pi_p);
+        gt_free(y_gt);
+        bn_free(kw_bn);
+        g2_free(tTilde_g2);
+        g1_free(x_g1);
+        bn_free(v_bn);
+        bn_free(u_bn);
+        bn_free(c_bn);
+    }
+
+    memset(entry, 0, sizeof(entry));
+
+    return 0;
+}
@@ -0,0 +1,459 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <relic/relic.h>
+#include "pythia_conf.h"
+#include "pythia_pp.h"
+#include "pythia_fp8.h"
+
+#if PYTHIA_PP_EXP && FP_PRIME == 381
+#define PP_EXP 1
+#else
+#define PP_EXP 0
+#endif
+
+/// Set bits of |z| = 0xd201000000010000, z = -0xd201000000010000 is the parameter of BLS12-381
+static const int pp_z_bits[] = { 16, 48, 57, 60, 62, 63 };
+
+#define PP_Z_TERMS ((int)(sizeof(pp_z_bits) / sizeof(pp_z_bits[0])))
+
+static int pp_exp_supported = 0;
+static int pp_exp_on = 0;
+static int pp_lanes_supported = 0;
+
+static fp12_t *fp12_array_new(size_t n) {
+    fp12_t *a = (fp12_t *)calloc(n, sizeof(fp12_t));
+    if (!a)
+        THROW(ERR_NO_MEMORY);
+
+    for (size_t i = 0; i < n; i++) {
+        fp12_null(a[i]);
+    }
+    for (size_t i = 0; i < n; i++) {
+        fp12_new(a[i]);
+    }
+
+    return a;
+}
+
+static void fp12_array_free(fp12_t *a, size_t n) {
+    if (!a)
+        return;
+
+    for (size_t i = 0; i < n; i++) {
+        fp12_free(a[i]);
+    }
+    free(a);
+}
+
+/*
+ * c[i] = a[i]^z for n elements of the cyclotomic subgroup, u is scratch space for PP_Z_TERMS * n elements.
+ * Squarings run on compressed elements, a[i]^(2^k) for set bits k of |z| are decompressed together.
+ */
+static void fp12_exp_z_batch(fp12_t *c, fp12_t *a, size_t n, fp12_t *u) {
+    for (size_t i = 0; i < n; i++) {
+        fp12_t *v = u + i * PP_Z_TERMS;
+
+        fp12_sqr_pck(v[0], a[i]);
+        for (int k = 1; k < pp_z_bits[0]; k++)
+            fp12_sqr_pck(v[0], v[0]);
+
+        for (int j = 1; j < PP_Z_TERMS; j++) {
+            fp12_sqr_pck(v[j], v[j - 1]);
+            for (int k = pp_z_bits[j - 1] + 1; k < pp_z_bits[j]; k++)
+                fp12_sqr_pck(v[j], v[j]);
+        }
+    }
+
+    fp12_back_cyc_sim(u, u, (int)(n * PP_Z_TERMS));
+
+    for (size_t i = 0; i < n; i++) {
+        fp12_t *v = u + i * PP_Z_TERMS;
+
+        fp12_mul(c[i], v[0], v[1]);
+        for (int j = 2; j < PP_Z_TERMS; j++)
+            fp12_mul(c[i], c[i], v[j]);
+
+        // z is negative, inversion in the cyclotomic subgroup is conjugation
+        fp12_inv_uni(c[i], c[i]);
+    }
+}
+
+void pp_exp_bls12_batch(fp12_t *c, fp12_t *a, size_t n) {
+    if (!n)
+        return;
+
+    fp12_t *t0 = NULL, *t1 = NULL, *t2 = NULL, *u = NULL;
+
+    TRY {
+        t0 = fp12_array_new(n);
+        t1 = fp12_array_new(n);
+        t2 = fp12_array_new(n);
+        u = fp12_array_new(n * PP_Z_TERMS);
+
+        // Easy part c = a^((p^6 - 1)(p^2 + 1)), inverses of all elements with a single inversion
+        fp12_copy(t0[0], a[0]);
+        for (size_t i = 1; i < n; i++)
+            fp12_mul(t0[i], t0[i - 1], a[i]);
+
+        fp12_inv(t1[0], t0[n - 1]);
+        for (size_t i = n - 1; i > 0; i--) {
+            fp12_mul(t2[i], t1[0], t0[i - 1]);
+            fp12_mul(t1[0], t1[0], a[i]);
+        }
+        fp12_copy(t2[0], t1[0]);
+
+        for (size_t i = 0; i < n; i++) {
+            fp12_inv_uni(t1[i], a[i]);
+            fp12_mul(c[i], t1[i], t2[i]);
+            fp12_frb(t1[i], c[i], 2);
+            fp12_mul(c[i], c[i], t1[i]);
+        }
+
+        // Hard part c^((z - 1)^2 (z + p) (z^2 + p^2 - 1) + 3)
+        for (size_t i = 0; i < n; i++)
+            fp12_sqr_cyc(t0[i], c[i]);
+
+        // t1 = c^(z - 1)
+        fp12_exp_z_batch(t1, c, n, u);
+        for (size_t i = 0; i < n; i++) {
+            fp12_inv_uni(t2[i], c[i]);
+            fp12_mul(t1[i], t1[i], t2[i]);
+        }
+
+        // t1 = c^((z - 1)^2)
+        fp12_exp_z_batch(t2, t1, n, u);
+        for (size_t i = 0; i < n; i++) {
+            fp12_inv_uni(t1[i], t1[i]);
+            fp12_mul(t1[i], t1[i], t2[i]);
+        }
+
+        // t1 = c^((z - 1)^2 (z + p)), c = c^3
+        fp12_exp_z_batch(t2, t1, n, u);
+        for (size_t i = 0; i < n; i++) {
+            fp12_frb(t1[i], t1[i], 1);
+            fp12_mul(t1[i], t1[i], t2[i]);
+            fp12_mul(c[i], c[i], t0[i]);
+        }
+
+        // c = c * t1^(z^2 + p^2 - 1)
+        fp12_exp_z_batch(t0, t1, n, u);
+        fp12_exp_z_batch(t2, t0, n, u);
+        for (size_t i = 0; i < n; i++) {
+            fp12_frb(t0[i], t1[i], 2);
+            fp12_inv_uni(t1[i], t1[i]);
+            fp12_mul(t1[i], t1[i], t2[i]);
+            fp12_mul(t1[i], t1[i], t0[i]);
+            fp12_mul(c[i], c[i], t1[i]);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp12_array_free(u, n * PP_Z_TERMS);
+        fp12_array_free(t2, n);
+        fp12_array_free(t1, n);
+        fp12_array_free(t0, n);
+    }
+}
+
+void pp_exp_bls12(fp12_t c, fp12_t a) {
+    fp12_t t[1];
+    fp12_null(t[0]);
+
+    TRY {
+        fp12_new(t[0]);
+        fp12_copy(t[0], a);
+        pp_exp_bls12_batch(t, t, 1);
+        fp12_copy(c, t[0]);
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        fp12_free(t[0]);
+    }
+}
+
+#if PP_EXP
+
+static g1_t *g1_array_new(size_t n) {
+    g1_t *a = (g1_t *)calloc(n, sizeof(g1_t));
+    if (!a)
+        THROW(ERR_NO_MEMORY);
+
+    for (size_t i = 0; i < n; i++) {
+        g1_null(a[i]);
+    }
+    for (size_t i = 0; i < n; i++) {
+        g1_new(a[i]);
+    }
+
+    return a;
+}
+
+static void g1_array_free(g1_t *a, size_t n) {
+    if (!a)
+        return;
+
+    for (size_t i = 0; i < n; i++) {
+        g1_free(a[i]);
+    }
+    free(a);
+}
+
+static g2_t *g2_array_new(size_t n) {
+    g2_t *a = (g2_t *)calloc(n, sizeof(g2_t));
+    if (!a)
+        THROW(ERR_NO_MEMORY);
+
+    for (size_t i = 0; i < n; i++) {
+        g2_null(a[i]);
+    }
+    for (size_t i = 0; i < n; i++) {
+        g2_new(a[i]);
+    }
+
+    return a;
+}
+
+static void g2_array_free(g2_t *a, size_t n) {
+    if (!a)
+        return;
+
+    for (size_t i = 0; i < n; i++) {
+        g2_free(a[i]);
+    }
+    free(a);
+}
+
+/*
+ * Miller loop of the optimal ate pairing on BLS12-381 with relic's line functions, r = prod f_{z,Q[i]}(P[i])
+ * up to factors that final exponentiation removes. It is the loop pc_map and pc_map_sim run before
+ * pp_exp_k12, owning it lets pairings end in pp_exp_bls12 without touching relic's symbols.
+ * Pairs share squarings of r, pairs with a point at infinity contribute unity.
+ */
+static void pp_mil_sim_bls12(fp12_t r, g1_t *p, g2_t *q, size_t n) {
+    fp12_t l; fp12_null(l);
+    g1_t *np = NULL;
+    g1_t *mp = NULL;
+    g2_t *t = NULL;
+    g2_t *u = NULL;
+    size_t k = 0;
+
+    TRY {
+        fp12_new(l);
+        np = g1_array_new(n);
+        mp = g1_array_new(n);
+        t = g2_array_new(n);
+        u = g2_array_new(n);
+
+        fp12_set_dig(r, 1);
+
+        for (size_t s = 0; s < n; s++) {
+            if (g1_is_infty(p[s]) || g2_is_infty(q[s]))
+                continue;
+
+            g1_norm(np[k], p[s]);
+            g1_neg(mp[k], np[k]);
+            g2_norm(u[k], q[s]);
+            g2_copy(t[k], u[k]);
+            k++;
+        }
+
+        if (k > 0) {
+            fp12_zero(l);
+
+            for (int i = pp_z_bits[PP_Z_TERMS - 1] - 1, j = PP_Z_TERMS - 2; i >= 0; i--) {
+                fp12_sqr(r, r);
+                for (size_t s = 0; s < k; s++) {
+                    pp_dbl_k12(l, t[s], t[s], mp[s]);
+                    fp12_mul_dxs(r, r, l);
+                }
+
+                if (j >= 0 && i == pp_z_bits[j]) {
+                    for (size_t s = 0; s < k; s++) {
+                        pp_add_k12(l, t[s], u[s], np[s]);
+                        fp12_mul_dxs(r, r, l);
+                    }
+                    j--;
+                }
+            }
+
+            // z is negative, f_{z,Q} = 1 / f_{|z|,Q}
+            fp12_inv_uni(r, r);
+        }
+    }
+    CATCH_ANY {
+        THROW(ERR_CAUGHT);
+    }
+    FINALLY {
+        g2_array_free(u, n);
+        g2_array_free(t, n);
+        g1_array_free(mp, n);
+        g1_array_free(np, n);
+        fp12_free(l);
+    }
+}
+
+static void pp_mil_bls12(fp12_t r, g1_t p, g2_t q) {
+    pp_mil_sim_bls12(r, &p, &q, 1);
+}
+
+#endif
+
+void pp_map_bls12(gt_t r, g1_t p, g2_t q) {
+#if PP_EXP
+    if (pp_exp_on) {
+        pp_mil_bls12(r, p, q);
+        pp_exp_bls12(r, r);
+        return;
+    }
+#endif
+
+    pc_map(r, p, q);
+}
+
+void pp_map_sim_bls12(gt_t r, g1_t *p, g2_t *q, size_t n) {
+#if PP_EXP
+    if (pp_exp_on) {
+        pp_mil_sim_bls12(r, p, q, n);
+        pp_exp_bls12(r, r);
+        return;
+    }
+#endif
+
+    pc_map_sim(r, p, q, (int)n);
+}
+
+void pc_map_batch(gt_t *r, g1_t *p, g2_t *q, size_t n) {
+#if PP_EXP
+    if (pp_exp_on) {
+        // Groups of 8 Miller loops run on IFMA lanes if they passed the check of pp_exp_init
+        if (!pp_lanes_supported || !pp_mil_batch(r, p, q, n, pp_z_bits, PP_Z_TERMS)) {
+            for (size_t i = 0; i < n; i++)
+                pp_mil_bls12(r[i], p[i], q[i]);
+        }
+
+        // Pairings with a point at infinity are unity without final exponentiation, that stays unity
+        pp_exp_bls12_batch(r, r, n);
+        return;
+    }
+#endif
+
+    for (size_t i = 0; i < n; i++)
+        pc_map(r[i], p[i], q[i]);
+}
+
+void pp_exp_init(void) {
+    pp_exp_supported = 0;
+    pp_exp_on = 0;
+    pp_lanes_supported = 0;
+
+#if PP_EXP
+    if (fp_param_get() != B12_P381)
+        return;
+
+    // Relic's final exponentiation and pairing must give the same results, otherwise pairings would change
+    fp12_t a; fp12_null(a);
+    fp12_t b; fp12_null(b);
+    fp12_t c; fp12_null(c);
+    g1_t p[2]; g1_null(p[0]); g1_null(p[1]);
+    g2_t q[2]; g2_null(q[0]); g2_null(q[1]);
+    fp12_t m[2]; fp12_null(m[0]); fp12_null(m[1]);
+
+    TRY {
+        fp12_new(a);
+        fp12_new(b);
+        fp12_new(c);
+        fp12_new(m[0]);
+        fp12_new(m[1]);
+        g1_new(p[0]);
+        g1_new(p[1]);
+        g2_new(q[0]);
+        g2_new(q[1]);
+
+        gt_get_gen(a);
+        fp_add_dig(a[0][0][0], a[0][0][0], 1);
+
+        pp_exp_k12(b, a);
+        pp_exp_bls12(c, a);
+
+        if (fp12_cmp(b, c) == CMP_EQ) {
+            g1_get_gen(p[0]);
+            g2_get_gen(q[0]);
+
+            pc_map(b, p[0], q[0]);
+            pp_mil_bls12(c, p[0], q[0]);
+            pp_exp_bls12(c, c);
+
+            if (fp12_cmp(b, c) == CMP_EQ) {
+                g1_dbl(p[1], p[0]);
+                g2_neg(q[1], q[0]);
+
+                pc_map_sim(b, p, q, 2);
+                pp_mil_sim_bls12(c, p, q, 2);
+                pp_exp_bls12(c, c);
+
+                pp_exp_supported = fp12_cmp(b, c) == CMP_EQ;
+            }
+        }
+
+        // Lane Miller loops use their own line functions, so they have to agree with relic's pairing too
+        if (pp_exp_supported && pp_mil_batch(m, p, q, 2, pp_z_bits, PP_Z_TERMS)) {
+            pp_lanes_supported = 1;
+            for (int i = 0; i < 2; i++) {
+                pc_map(b, p[i], q[i]);
+                pp_exp_bls12(c, m[i]);
+                pp_lanes_supported &= fp12_cmp(b, c) == CMP_EQ;
+            }
+        }
+
+        pp_exp_on = pp_exp_supported;
+    }
+    CATCH_ANY {
+        pp_exp_supported = 0;
+        pp_exp_on = 0;
+        pp_lanes_supported = 0;
+    }
+    FINALLY {
+        fp12_free(m[1]);
+        fp12_free(m[0]);
+        g2_free(q[1]);
+        g2_free(q[0]);
+        g1_free(p[1]);
+        g1_free(p[0]);
+        fp12_free(c);
+        fp12_free(b);
+        fp12_free(a);
+    }
+#endif
+}
+
+int pp_exp_enabled(void) {
+    return pp_exp_on;
+}
+
+void pp_exp_set_enabled(int enabled) {
+    pp_exp_on = enabled && pp_exp_supported;
+}
+
+int pp_mil_lanes_enabled(void) {
+    return pp_exp_on && pp_lanes_supported && fp8_enabled();
+}
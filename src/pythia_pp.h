@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_PP_H
+#define PYTHIA_PYTHIA_PP_H
+
+#include <stddef.h>
+#include <relic/relic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Enables pp_map_bls12, pp_map_sim_bls12 and pc_map_batch to end in pp_exp_bls12 if relic is configured with BLS12-381
+/// and both final exponentiation and pairing give the same results as relic's ones.
+/// Miller loops of pc_map_batch on IFMA lanes are checked against relic's pairing the same way.
+/// Does nothing unless library is built with PYTHIA_PP_EXP. Should be called once during initialization, after fp8_init.
+void pp_exp_init(void);
+
+/// \return 1 if pythia's pairings end in pp_exp_bls12, 0 if they are computed with pc_map
+int pp_exp_enabled(void);
+
+/// Enables or disables dedicated final exponentiation, so that it can be compared and benchmarked against relic.
+/// It is never enabled if pp_exp_init didn't bind it.
+/// \param [in] enabled 1 to use pp_exp_bls12, 0 to use relic's final exponentiation
+void pp_exp_set_enabled(int enabled);
+
+/// \return 1 if pc_map_batch runs Miller loops 8 at a time on IFMA lanes with pp_mil_batch,
+/// 0 if they run one by one with relic's line functions
+int pp_mil_lanes_enabled(void);
+
+/// Final exponentiation for BLS12-381, c = a^(3 (p^12 - 1) / r), the exponent relic uses.
+/// Hard part follows the addition chain of Hayashida, Hayasaka and Teruya:
+/// 3 (p^4 - p^2 + 1) / r = (z - 1)^2 (z + p) (z^2 + p^2 - 1) + 3,
+/// exponentiations by z use compressed cyclotomic squarings.
+/// \param [out] c result
+/// \param [in] a Miller loop output, not zero
+void pp_exp_bls12(fp12_t c, fp12_t a);
+
+/// Final exponentiation of n elements like pp_exp_bls12. Inversions of the easy part and decompressions
+/// after squarings are shared, so that n exponentiations cost 6 inversions instead of 6n.
+/// \param [out] c array of n results, may be the same as a
+/// \param [in] a array of n Miller loop outputs, not zero
+/// \param [in] n number of elements
+void pp_exp_bls12_batch(fp12_t *c, fp12_t *a, size_t n);
+
+/// Computes pairing r = e(p, q) as pc_map does, with Miller loop over relic's line functions followed by
+/// pp_exp_bls12. Falls back to pc_map if dedicated final exponentiation is not enabled.
+/// Relic's own pairing functions are never changed.
+/// \param [out] r pairing
+/// \param [in] p point in G1
+/// \param [in] q point in G2
+void pp_map_bls12(gt_t r, g1_t p, g2_t q);
+
+/// Computes product of pairings r = e(p[0], q[0]) * ... * e(p[n - 1], q[n - 1]) as pc_map_sim does.
+/// Miller loops share squarings and the product takes one pp_exp_bls12.
+/// Falls back to pc_map_sim if dedicated final exponentiation is not enabled.
+/// \param [out] r product of pairings
+/// \param [in] p array of n points in G1
+/// \param [in] q array of n points in G2
+/// \param [in] n number of pairings
+void pp_map_sim_bls12(gt_t r, g1_t *p, g2_t *q, size_t n);
+
+/// Computes n independent pairings r[i] = e(p[i], q[i]) like pp_map_bls12, final exponentiations
+/// are done together with pp_exp_bls12_batch. Miller loops run 8 at a time on IFMA lanes while fp8_enabled,
+/// see pp_mil_lanes_enabled.
+/// Falls back to n calls of pc_map if dedicated final exponentiation is not enabled.
+/// \param [out] r array of n pairings
+/// \param [in] p array of n points in G1
+/// \param [in] q array of n points in G2
+/// \param [in] n number of pairings
+void pc_map_batch(gt_t *r, g1_t *p, g2_t *q, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_PP_H
@@ -0,0 +1,286 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <relic/relic.h>
+#include <relic/relic_err.h>
+#include "pythia_scalar.h"
+
+#define N PYTHIA_SC_DIGS
+
+static dig_t sc_ord[N];
+static dig_t sc_ord_inv;   // -ord^-1 mod 2^DIGIT
+static dig_t sc_r2[N];     // 2^(2 * 256) mod ord
+static dig_t sc_one[N];    // plain 1, converts out of Montgomery form
+
+/*
+ * Digit helpers, all operate on N digits and return carry or borrow.
+ */
+static dig_t digs_add(dig_t *c, const dig_t *a, const dig_t *b) {
+    dig_t carry = 0;
+    for (int i = 0; i < N; i++) {
+        dbl_t s = (dbl_t)a[i] + b[i] + carry;
+        c[i] = (dig_t)s;
+        carry = (dig_t)(s >> DIGIT);
+    }
+    return carry;
+}
+
+static dig_t digs_sub(dig_t *c, const dig_t *a, const dig_t *b) {
+    dig_t borrow = 0;
+    for (int i = 0; i < N; i++) {
+        dig_t d = a[i] - b[i] - borrow;
+        borrow = (a[i] < b[i]) || (a[i] == b[i] && borrow);
+        c[i] = d;
+    }
+    return borrow;
+}
+
+static int digs_cmp(const dig_t *a, const dig_t *b) {
+    for (int i = N - 1; i >= 0; i--) {
+        if (a[i] != b[i])
+            return a[i] > b[i] ? CMP_GT : CMP_LT;
+    }
+    return CMP_EQ;
+}
+
+static int digs_is_zero(const dig_t *a) {
+    dig_t t = 0;
+    for (int i = 0; i < N; i++)
+        t |= a[i];
+    return t == 0;
+}
+
+/*
+ * Montgomery multiplication c = a * b / 2^256 mod ord, coarsely integrated operand scanning.
+ */
+static void mont_mul(dig_t *c, const dig_t *a, const dig_t *b) {
+    dig_t t[N + 2];
+
+    memset(t, 0, sizeof(t));
+
+    for (int i = 0; i < N; i++) {
+        dig_t carry = 0;
+        for (int j = 0; j < N; j++) {
+            dbl_t s = (dbl_t)a[j] * b[i] + t[j] + carry;
+            t[j] = (dig_t)s;
+            carry = (dig_t)(s >> DIGIT);
+        }
+        dbl_t s = (dbl_t)t[N] + carry;
+        t[N] = (dig_t)s;
+        t[N + 1] = (dig_t)(s >> DIGIT);
+
+        dig_t m = t[0] * sc_ord_inv;
+        s = (dbl_t)m * sc_ord[0] + t[0];
+        carry = (dig_t)(s >> DIGIT);
+        for (int j = 1; j < N; j++) {
+            s = (dbl_t)m * sc_ord[j] + t[j] + carry;
+            t[j - 1] = (dig_t)s;
+            carry = (dig_t)(s >> DIGIT);
+        }
+        s = (dbl_t)t[N] + carry;
+        t[N - 1] = (dig_t)s;
+        t[N] = t[N + 1] + (dig_t)(s >> DIGIT);
+    }
+
+    // t < 2 * ord
+    if (t[N] || digs_cmp(t, sc_ord) != CMP_LT)
+        digs_sub(t, t, sc_ord);
+
+    memcpy(c, t, N * sizeof(dig_t));
+}
+
+/*
+ * Reduces a < 2^256 modulo ord.
+ */
+static void digs_reduce(dig_t *a) {
+    while (digs_cmp(a, sc_ord) != CMP_LT)
+        digs_sub(a, a, sc_ord);
+}
+
+void sc_init(bn_t ord) {
+    if (bn_sign(ord) == BN_NEG || bn_is_even(ord) || bn_bits(ord) > N * DIGIT)
+        THROW(ERR_NO_VALID);
+
+    memset(sc_ord, 0, sizeof(sc_ord));
+    memcpy(sc_ord, ord->dp, (size_t)ord->used * sizeof(dig_t));
+
+    // Newton iteration doubles the number of correct low bits, starting from 1 for odd ord
+    dig_t inv = 1;
+    for (int i = 0; i < 8; i++)
+        inv *= 2 - sc_ord[0] * inv;
+    sc_ord_inv = (dig_t)0 - inv;
+
+    memset(sc_one, 0, sizeof(sc_one));
+    sc_one[0] = 1;
+
+    memcpy(sc_r2, sc_one, sizeof(sc_r2));
+    for (int i = 0; i < 2 * N * DIGIT; i++) {
+        dig_t carry = digs_add(sc_r2, sc_r2, sc_r2);
+        if (carry || digs_cmp(sc_r2, sc_ord) != CMP_LT)
+            digs_sub(sc_r2, sc_r2, sc_ord);
+    }
+}
+
+void sc_read_bn(pythia_sc_t *c, bn_t a) {
+    dig_t chunk[N], acc[N];
+    int chunks = (a->used + N - 1) / N;
+
+    memset(acc, 0, sizeof(acc));
+
+    // Horner's rule over 256-bit chunks: acc = acc * 2^256 + chunk, in Montgomery form
+    for (int j = chunks - 1; j >= 0; j--) {
+        memset(chunk, 0, sizeof(chunk));
+        for (int i = 0; i < N && j * N + i < a->used; i++)
+            chunk[i] = a->dp[j * N + i];
+
+        digs_reduce(chunk);
+        mont_mul(chunk, chunk, sc_r2);
+        mont_mul(acc, acc, sc_r2);
+        if (digs_add(acc, acc, chunk) || digs_cmp(acc, sc_ord) != CMP_LT)
+            digs_sub(acc, acc, sc_ord);
+    }
+
+    memcpy(c->d, acc, sizeof(acc));
+
+    if (bn_sign(a) == BN_NEG && !digs_is_zero(c->d))
+        digs_sub(c->d, sc_ord, c->d);
+}
+
+void sc_write_bn(bn_t c, const pythia_sc_t *a) {
+    dig_t t[N];
+
+    mont_mul(t, a->d, sc_one);
+
+    bn_grow(c, N);
+    memcpy(c->dp, t, sizeof(t));
+    c->used = N;
+    c->sign = BN_POS;
+    bn_trim(c);
+}
+
+int sc_is_zero(const pythia_sc_t *a) {
+    return digs_is_zero(a->d);
+}
+
+void sc_add(pythia_sc_t *c, const pythia_sc_t *a, const pythia_sc_t *b) {
+    if (digs_add(c->d, a->d, b->d) || digs_cmp(c->d, sc_ord) != CMP_LT)
+        digs_sub(c->d, c->d, sc_ord);
+}
+
+void sc_sub(pythia_sc_t *c, const pythia_sc_t *a, const pythia_sc_t *b) {
+    if (digs_sub(c->d, a->d, b->d))
+        digs_add(c->d, c->d, sc_ord);
+}
+
+void sc_mul(pythia_sc_t *c, const pythia_sc_t *a, const pythia_sc_t *b) {
+    mont_mul(c->d, a->d, b->d);
+}
+
+void sc_inv(pythia_sc_t *c, const pythia_sc_t *a) {
+    dig_t e[N], two[N], r[N];
+
+    // a^(ord - 2), the exponent is public so the square-and-multiply pattern doesn't depend on a
+    memset(two, 0, sizeof(two));
+    two[0] = 2;
+    digs_sub(e, sc_ord, two);
+
+    memcpy(r, a->d, sizeof(r));
+    int top = N * DIGIT - 1;
+    while (!((e[top / DIGIT] >> (top % DIGIT)) & 1))
+        top--;
+
+    for (int i = top - 1; i >= 0; i--) {
+        mont_mul(r, r, r);
+        if ((e[i / DIGIT] >> (i % DIGIT)) & 1)
+            mont_mul(r, r, a->d);
+    }
+
+    memcpy(c->d, r, sizeof(r));
+}
+
+void sc_inv_sim(pythia_sc_t *c, const pythia_sc_t *a, size_t n) {
+    if (!n)
+        return;
+
+    pythia_sc_t *pre = (pythia_sc_t *)malloc(n * sizeof(pythia_sc_t));
+    if (!pre)
+        THROW(ERR_NO_MEMORY);
+
+    // Prefix products, one inversion, then peel off inverses from the end
+    pre[0] = a[0];
+    for (size_t i = 1; i < n; i++)
+        sc_mul(&pre[i], &pre[i - 1], &a[i]);
+
+    pythia_sc_t inv, t;
+    sc_inv(&inv, &pre[n - 1]);
+
+    for (size_t i = n - 1; i > 0; i--) {
+        t = a[i];
+        sc_mul(&c[i], &inv, &pre[i - 1]);
+        sc_mul(&inv, &inv, &t);
+    }
+    c[0] = inv;
+
+    free(pre);
+}
+
+void sc_rec_naf(int8_t *naf, int *len, bn_t k, int w) {
+    dig_t t[N + 1];
+    const dig_t mask = ((dig_t)1 << w) - 1;
+    const int half = 1 << (w - 1);
+    int i = 0;
+
+    if (bn_sign(k) == BN_NEG || bn_bits(k) > N * DIGIT)
+        THROW(ERR_NO_VALID);
+
+    memset(t, 0, sizeof(t));
+    memcpy(t, k->dp, (size_t)k->used * sizeof(dig_t));
+
+    while (!digs_is_zero(t) || t[N]) {
+        if (i >= *len)
+            THROW(ERR_NO_BUFFER);
+
+        int d = 0;
+        if (t[0] & 1) {
+            d = (int)(t[0] & mask);
+            if (d >= half)
+                d -= 1 << w;
+
+            // t -= d, carry or borrow ripples through the extra top digit
+            dig_t u = (dig_t)(d > 0 ? d : -d);
+            for (int j = 0; j <= N && u; j++) {
+                dig_t prev = t[j];
+                if (d > 0) {
+                    t[j] = prev - u;
+                    u = prev < u;
+                } else {
+                    t[j] = prev + u;
+                    u = t[j] < prev;
+                }
+            }
+        }
+        naf[i++] = (int8_t)d;
+
+        for (int j = 0; j < N; j++)
+            t[j] = (t[j] >> 1) | (t[j + 1] << (DIGIT - 1));
+        t[N] >>= 1;
+    }
+
+    *len = i;
+}
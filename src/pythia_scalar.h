@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PYTHIA_PYTHIA_SCALAR_H
+#define PYTHIA_PYTHIA_SCALAR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <relic/relic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of digits in fixed-size scalars
+#define PYTHIA_SC_DIGS (256 / DIGIT)
+
+/// Scalar modulo the group order. Values read with sc_read_bn are kept in Montgomery form.
+typedef struct pythia_sc {
+    dig_t d[PYTHIA_SC_DIGS];
+} pythia_sc_t;
+
+/// Sets group order used by scalar arithmetic, should be called once during initialization
+/// \param [in] ord group order, odd and less than 2^256
+void sc_init(bn_t ord);
+
+/// Reduces integer modulo group order and converts it to Montgomery form
+/// \param [out] c scalar
+/// \param [in] a integer
+void sc_read_bn(pythia_sc_t *c, bn_t a);
+
+/// Converts scalar from Montgomery form to integer in [0, order)
+/// \param [out] c integer
+/// \param [in] a scalar
+void sc_write_bn(bn_t c, const pythia_sc_t *a);
+
+/// \return 1 if scalar is zero, 0 otherwise
+int sc_is_zero(const pythia_sc_t *a);
+
+/// Computes c = a + b
+void sc_add(pythia_sc_t *c, const pythia_sc_t *a, const pythia_sc_t *b);
+
+/// Computes c = a - b
+void sc_sub(pythia_sc_t *c, const pythia_sc_t *a, const pythia_sc_t *b);
+
+/// Computes c = a * b
+void sc_mul(pythia_sc_t *c, const pythia_sc_t *a, const pythia_sc_t *b);
+
+/// Computes c = a^-1 with a fixed sequence of multiplications, a should be non zero
+void sc_inv(pythia_sc_t *c, const pythia_sc_t *a);
+
+/// Computes c[i] = a[i]^-1 with a single inversion, all a[i] should be non zero
+/// \param [out] c inverses, may be the same array as a
+/// \param [in] a scalars
+/// \param [in] n number of scalars
+void sc_inv_sim(pythia_sc_t *c, const pythia_sc_t *a, size_t n);
+
+/// Computes width-w NAF of non-negative integer, least significant digit first
+/// \param [out] naf digits
+/// \param [in, out] len capacity of naf on input, number of digits on output
+/// \param [in] k integer less than 2^256
+/// \param [in] w window width
+void sc_rec_naf(int8_t *naf, int *len, bn_t k, int w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PYTHIA_PYTHIA_SCALAR_H
@@ -16,7 +16,9 @@
  */
 
 #include "pythia_c.h"
+#include "pythia_batch_c.h"
 #include "pythia_buf_exports.h"
+#include "pythia_buf_sizes_c.h"
 #include "pythia_conf.h"
 #include "pythia_init.h"
 #include "pythia_init_c.h"
@@ -24,6 +26,14 @@
 
 #include <relic/relic_bn.h>
 
+struct pythia_prepared_exp {
+    pythia_exp_prep_t prep;
+};
+
+struct pythia_prepared_key {
+    pythia_scalar_prep_t prep;
+};
+
 int pythia_w_blind(const pythia_buf_t *password, pythia_buf_t *blinded_password, pythia_buf_t *blinding_secret) {
     pythia_err_init();
 
@@ -61,6 +71,10 @@ int pythia_w_deblind(const pythia_buf_t *transformed_password, const pythia_buf_
     bn_t rInv_bn; bn_null(rInv_bn);
 
     TRY {
+        // Reject malformed input before decoding and subgroup checks
+        gt_check_buf(transformed_password);
+        bn_check_buf(blinding_secret);
+
         gt_new(a_gt);
         gt_new(y_gt);
         gt_read_buf(y_gt, transformed_password);
@@ -130,6 +144,10 @@ int pythia_w_transform(const pythia_buf_t *blinded_password, const pythia_buf_t
     g1_t x_ep; g1_null(x_ep);
 
     TRY {
+        // Reject malformed input before decoding and subgroup checks
+        g1_check_buf(blinded_password);
+        bn_check_buf(transformation_private_key);
+
         gt_new(y_gt);
         bn_new(kw_bn);
         g2_new(tTilde_g2);
@@ -173,17 +191,24 @@ int pythia_w_prove(const pythia_buf_t *transformed_password, const pythia_buf_t
     gt_t y_gt; gt_null(y_gt);
 
     TRY {
+        // Reject malformed input before decoding and subgroup checks
+        g1_check_buf(blinded_password);
+        g2_check_buf_trusted(transformed_tweak);
+        bn_check_buf(transformation_private_key);
+        g1_check_buf_trusted(transformation_public_key);
+        gt_check_buf(transformed_password);
+
         g1_new(x_g1);
         g1_read_buf(x_g1, blinded_password);
 
         g2_new(tTilde_g2);
-        g2_read_buf(tTilde_g2, transformed_tweak);
+        g2_read_buf_trusted(tTilde_g2, transformed_tweak);
 
         bn_new(kw_bn);
         bn_read_buf(kw_bn, transformation_private_key);
 
         g1_new(pi_p);
-        g1_read_buf(pi_p, transformation_public_key);
+        g1_read_buf_trusted(pi_p, transformation_public_key);
 
         gt_new(y_gt);
         gt_read_buf(y_gt, transformed_password);
@@ -225,6 +250,13 @@ int pythia_w_verify(const pythia_buf_t *transformed_password, const pythia_buf_t
     bn_t u_bn; bn_null(u_bn);
 
     TRY {
+        // Reject malformed input before decoding and subgroup checks
+        g1_check_buf(blinded_password);
+        gt_check_buf(transformed_password);
+        g1_check_buf_trusted(transformation_public_key);
+        bn_check_buf(proof_value_c);
+        bn_check_buf(proof_value_u);
+
         g1_new(x_g1);
         g1_read_buf(x_g1, blinded_password);
 
@@ -232,7 +264,7 @@ int pythia_w_verify(const pythia_buf_t *transformed_password, const pythia_buf_t
         gt_read_buf(y_gt, transformed_password);
 
         g1_new(p_g1);
-        g1_read_buf(p_g1, transformation_public_key);
+        g1_read_buf_trusted(p_g1, transformation_public_key);
 
         bn_new(c_bn);
         bn_read_buf(c_bn, proof_value_c);
@@ -303,6 +335,10 @@ int pythia_w_update_deblinded_with_token(const pythia_buf_t *deblinded_password,
     bn_t delta_bn; bn_null(delta_bn);
 
     TRY {
+        // Reject malformed input before decoding and subgroup checks
+        gt_check_buf(deblinded_password);
+        bn_check_buf(password_update_token);
+
         gt_new(r_gt);
         gt_new(z_gt);
         gt_read_buf(z_gt, deblinded_password);
@@ -327,3 +363,595 @@ int pythia_w_update_deblinded_with_token(const pythia_buf_t *deblinded_password,
 
     return 0;
 }
+
+int pythia_w_point_to_raw(const pythia_buf_t *point, pythia_buf_t *raw_point) {
+    pythia_err_init();
+
+    g1_t p_g1; g1_null(p_g1);
+    g2_t p_g2; g2_null(p_g2);
+
+    TRY {
+        if (!point)
+            THROW(ERR_NO_BUFFER);
+
+        if (point->len == DEF_PYTHIA_G1_BUF_SIZE) {
+            g1_new(p_g1);
+            g1_read_buf(p_g1, point);
+            g1_write_buf_raw(raw_point, p_g1);
+        }
+        else if (point->len == DEF_PYTHIA_G2_BUF_SIZE) {
+            g2_new(p_g2);
+            g2_read_buf(p_g2, point);
+            g2_write_buf_raw(raw_point, p_g2);
+        }
+        else {
+            THROW(ERR_NO_VALID);
+        }
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+    FINALLY {
+        g2_free(p_g2);
+        g1_free(p_g1);
+    }
+
+    return 0;
+}
+
+int pythia_w_prepare_exp(const pythia_buf_t *exponent, pythia_prepared_exp_t **prepared) {
+    pythia_err_init();
+
+    bn_t e_bn; bn_null(e_bn);
+    pythia_prepared_exp_t *prep = NULL;
+
+    TRY {
+        bn_new(e_bn);
+        bn_read_buf(e_bn, exponent);
+
+        prep = (pythia_prepared_exp_t *)malloc(sizeof(pythia_prepared_exp_t));
+        if (!prep)
+            THROW(ERR_NO_MEMORY);
+
+        pythia_exp_prepare(&prep->prep, e_bn);
+
+        *prepared = prep;
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        free(prep);
+
+        return -1;
+    }
+    FINALLY {
+        bn_free(e_bn);
+    }
+
+    return 0;
+}
+
+void pythia_w_prepared_exp_free(pythia_prepared_exp_t *prepared) {
+    free(prepared);
+}
+
+int pythia_w_update_deblinded_with_prepared_token(const pythia_buf_t *deblinded_password,
+                                                  const pythia_prepared_exp_t *password_update_token,
+                                                  pythia_buf_t *updated_deblinded_password) {
+    pythia_err_init();
+
+    gt_t r_gt; gt_null(r_gt);
+    gt_t z_gt; gt_null(z_gt);
+
+    TRY {
+        gt_new(r_gt);
+        gt_new(z_gt);
+        gt_read_buf(z_gt, deblinded_password);
+
+        pythia_update_with_prepared_delta(z_gt, &password_update_token->prep, r_gt);
+
+        gt_write_buf(updated_deblinded_password, r_gt);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+    FINALLY {
+        gt_free(z_gt);
+        gt_free(r_gt);
+    }
+
+    return 0;
+}
+
+int pythia_w_deblind_with_prepared_secret(const pythia_buf_t *transformed_password,
+                                          const pythia_prepared_exp_t *blinding_secret,
+                                          pythia_buf_t *deblinded_password) {
+    pythia_err_init();
+
+    gt_t a_gt; gt_null(a_gt);
+    gt_t y_gt; gt_null(y_gt);
+
+    TRY {
+        gt_new(a_gt);
+        gt_new(y_gt);
+        gt_read_buf(y_gt, transformed_password);
+
+        pythia_deblind_prepared(y_gt, &blinding_secret->prep, a_gt);
+
+        gt_write_buf(deblinded_password, a_gt);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+    FINALLY {
+        gt_free(y_gt);
+        gt_free(a_gt);
+    }
+
+    return 0;
+}
+
+int pythia_w_prepare_transformation_private_key(const pythia_buf_t *transformation_private_key,
+                                                pythia_prepared_key_t **prepared) {
+    pythia_err_init();
+
+    bn_t kw_bn; bn_null(kw_bn);
+    pythia_prepared_key_t *prep = NULL;
+
+    TRY {
+        bn_new(kw_bn);
+        bn_read_buf(kw_bn, transformation_private_key);
+
+        prep = (pythia_prepared_key_t *)malloc(sizeof(pythia_prepared_key_t));
+        if (!prep)
+            THROW(ERR_NO_MEMORY);
+
+        pythia_scalar_prepare(&prep->prep, kw_bn);
+
+        *prepared = prep;
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        free(prep);
+
+        return -1;
+    }
+    FINALLY {
+        bn_free(kw_bn);
+    }
+
+    return 0;
+}
+
+void pythia_w_prepared_key_free(pythia_prepared_key_t *prepared) {
+    free(prepared);
+}
+
+int pythia_w_transform_with_prepared_key(const pythia_buf_t *blinded_password, const pythia_buf_t *tweak,
+                                         const pythia_prepared_key_t *transformation_private_key,
+                                         pythia_buf_t *transformed_password, pythia_buf_t *transformed_tweak) {
+    pythia_err_init();
+
+    gt_t y_gt; gt_null(y_gt);
+    g2_t tTilde_g2; g2_null(tTilde_g2);
+    g1_t x_ep; g1_null(x_ep);
+
+    TRY {
+        gt_new(y_gt);
+        g2_new(tTilde_g2);
+        g1_new(x_ep);
+
+        g1_read_buf(x_ep, blinded_password);
+
+        pythia_eval_prepared(x_ep, tweak->p, tweak->len, &transformation_private_key->prep, y_gt, tTilde_g2);
+
+        gt_write_buf(transformed_password, y_gt);
+        g2_write_buf(transformed_tweak, tTilde_g2);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+
+        return -1;
+    }
+    FINALLY {
+        g1_free(x_ep);
+        g2_free(tTilde_g2);
+        gt_free(y_gt);
+    }
+
+    return 0;
+}
+
+static void transform_batch_free(size_t count, g1_t *x, gt_t *y, g2_t *tTilde,
+                                 const uint8_t **t, size_t *t_sizes) {
+    for (size_t i = 0; i < count; i++) {
+        if (x) {
+            g1_free(x[i]);
+        }
+        if (y) {
+            gt_free(y[i]);
+        }
+        if (tTilde) {
+            g2_free(tTilde[i]);
+        }
+    }
+
+    free(t_sizes);
+    free(t);
+    free(tTilde);
+    free(y);
+    free(x);
+}
+
+int pythia_w_transform_batch(const pythia_buf_t *blinded_passwords, const pythia_buf_t *tweaks, size_t count,
+                             const pythia_prepared_key_t *transformation_private_key,
+                             pythia_buf_t *transformed_passwords, pythia_buf_t *transformed_tweaks) {
+    pythia_err_init();
+
+    if (!count)
+        return 0;
+
+    g1_t *x_g1 = NULL;
+    gt_t *y_gt = NULL;
+    g2_t *tTilde_g2 = NULL;
+    const uint8_t **t = NULL;
+    size_t *t_sizes = NULL;
+
+    TRY {
+        x_g1 = (g1_t *)calloc(count, sizeof(g1_t));
+        y_gt = (gt_t *)calloc(count, sizeof(gt_t));
+        tTilde_g2 = (g2_t *)calloc(count, sizeof(g2_t));
+        t = (const uint8_t **)calloc(count, sizeof(uint8_t *));
+        t_sizes = (size_t *)calloc(count, sizeof(size_t));
+
+        if (!x_g1 || !y_gt || !tTilde_g2 || !t || !t_sizes)
+            THROW(ERR_NO_MEMORY);
+
+        // Reject malformed input before decoding and subgroup checks
+        for (size_t i = 0; i < count; i++)
+            g1_check_buf(&blinded_passwords[i]);
+
+        for (size_t i = 0; i < count; i++) {
+            g1_null(x_g1[i]);
+            gt_null(y_gt[i]);
+            g2_null(tTilde_g2[i]);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            g1_new(x_g1[i]);
+            gt_new(y_gt[i]);
+            g2_new(tTilde_g2[i]);
+
+            g1_read_buf(x_g1[i], &blinded_passwords[i]);
+            t[i] = tweaks[i].p;
+            t_sizes[i] = tweaks[i].len;
+        }
+
+        pythia_eval_batch(x_g1, t, t_sizes, count, &transformation_private_key->prep, y_gt, tTilde_g2);
+
+        for (size_t i = 0; i < count; i++) {
+            gt_write_buf(&transformed_passwords[i], y_gt[i]);
+            g2_write_buf(&transformed_tweaks[i], tTilde_g2[i]);
+        }
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        transform_batch_free(count, x_g1, y_gt, tTilde_g2, t, t_sizes);
+
+        return -1;
+    }
+    FINALLY {
+        transform_batch_free(count, x_g1, y_gt, tTilde_g2, t, t_sizes);
+    }
+
+    return 0;
+}
+
+static void bn_batch_free(size_t count, bn_t *a) {
+    if (!a)
+        return;
+
+    for (size_t i = 0; i < count; i++) {
+        bn_free(a[i]);
+    }
+
+    free(a);
+}
+
+// Array is returned before its elements are allocated, so that caller frees it with bn_batch_free on failure
+static void bn_batch_new(bn_t **a, size_t count) {
+    *a = (bn_t *)calloc(count, sizeof(bn_t));
+
+    if (!*a)
+        THROW(ERR_NO_MEMORY);
+
+    for (size_t i = 0; i < count; i++) {
+        bn_null((*a)[i]);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        bn_new((*a)[i]);
+    }
+}
+
+int pythia_w_blind_batch(const pythia_buf_t *passwords, size_t count,
+                         pythia_buf_t *blinded_passwords, pythia_buf_t *blinding_secrets) {
+    pythia_err_init();
+
+    if (!count)
+        return 0;
+
+    g1_t *blinded_ep = NULL;
+    bn_t *rInv_bn = NULL;
+    const uint8_t **m = NULL;
+    size_t *m_sizes = NULL;
+
+    TRY {
+        blinded_ep = (g1_t *)calloc(count, sizeof(g1_t));
+        m = (const uint8_t **)calloc(count, sizeof(uint8_t *));
+        m_sizes = (size_t *)calloc(count, sizeof(size_t));
+
+        if (!blinded_ep || !m || !m_sizes)
+            THROW(ERR_NO_MEMORY);
+
+        bn_batch_new(&rInv_bn, count);
+
+        for (size_t i = 0; i < count; i++) {
+            g1_null(blinded_ep[i]);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            g1_new(blinded_ep[i]);
+
+            m[i] = passwords[i].p;
+            m_sizes[i] = passwords[i].len;
+        }
+
+        pythia_blind_batch(m, m_sizes, count, blinded_ep, rInv_bn);
+
+        for (size_t i = 0; i < count; i++) {
+            g1_write_buf(&blinded_passwords[i], blinded_ep[i]);
+            bn_write_buf(&blinding_secrets[i], rInv_bn[i]);
+        }
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        bn_batch_free(count, rInv_bn);
+        transform_batch_free(count, blinded_ep, NULL, NULL, m, m_sizes);
+
+        return -1;
+    }
+    FINALLY {
+        bn_batch_free(count, rInv_bn);
+        transform_batch_free(count, blinded_ep, NULL, NULL, m, m_sizes);
+    }
+
+    return 0;
+}
+
+int pythia_w_get_password_update_token_batch(const pythia_buf_t *previous_transformation_private_keys,
+                                             const pythia_buf_t *new_transformation_private_keys, size_t count,
+                                             pythia_buf_t *password_update_tokens) {
+    pythia_err_init();
+
+    if (!count)
+        return 0;
+
+    bn_t *delta_bn = NULL;
+    bn_t *kw0 = NULL;
+    bn_t *kw1 = NULL;
+
+    TRY {
+        bn_batch_new(&delta_bn, count);
+        bn_batch_new(&kw0, count);
+        bn_batch_new(&kw1, count);
+
+        for (size_t i = 0; i < count; i++) {
+            bn_read_buf(kw0[i], &previous_transformation_private_keys[i]);
+            bn_read_buf(kw1[i], &new_transformation_private_keys[i]);
+        }
+
+        pythia_get_delta_batch(kw0, kw1, count, delta_bn);
+
+        for (size_t i = 0; i < count; i++) {
+            bn_write_buf(&password_update_tokens[i], delta_bn[i]);
+        }
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        bn_batch_free(count, kw1);
+        bn_batch_free(count, kw0);
+        bn_batch_free(count, delta_bn);
+
+        return -1;
+    }
+    FINALLY {
+        bn_batch_free(count, kw1);
+        bn_batch_free(count, kw0);
+        bn_batch_free(count, delta_bn);
+    }
+
+    return 0;
+}
+
+int pythia_w_compute_transformation_key_pair_batch(const pythia_buf_t *transformation_key_ids, size_t count,
+                                                   const pythia_buf_t *pythia_secret,
+                                                   const pythia_buf_t *pythia_scope_secret,
+                                                   pythia_buf_t *transformation_private_keys,
+                                                   pythia_buf_t *transformation_public_keys) {
+    pythia_err_init();
+
+    if (!count)
+        return 0;
+
+    bn_t *kw_bn = NULL;
+    g1_t *pi_p_g1 = NULL;
+    const uint8_t **w = NULL;
+    size_t *w_sizes = NULL;
+
+    TRY {
+        pi_p_g1 = (g1_t *)calloc(count, sizeof(g1_t));
+        w = (const uint8_t **)calloc(count, sizeof(uint8_t *));
+        w_sizes = (size_t *)calloc(count, sizeof(size_t));
+
+        if (!pi_p_g1 || !w || !w_sizes)
+            THROW(ERR_NO_MEMORY);
+
+        bn_batch_new(&kw_bn, count);
+
+        for (size_t i = 0; i < count; i++) {
+            g1_null(pi_p_g1[i]);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            g1_new(pi_p_g1[i]);
+
+            w[i] = transformation_key_ids[i].p;
+            w_sizes[i] = transformation_key_ids[i].len;
+        }
+
+        pythia_compute_kw_batch(w, w_sizes, count, pythia_secret->p, pythia_secret->len,
+                                pythia_scope_secret->p, pythia_scope_secret->len, kw_bn, pi_p_g1);
+
+        for (size_t i = 0; i < count; i++) {
+            bn_write_buf(&transformation_private_keys[i], kw_bn[i]);
+            g1_write_buf(&transformation_public_keys[i], pi_p_g1[i]);
+        }
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        bn_batch_free(count, kw_bn);
+        transform_batch_free(count, pi_p_g1, NULL, NULL, w, w_sizes);
+
+        return -1;
+    }
+    FINALLY {
+        bn_batch_free(count, kw_bn);
+        transform_batch_free(count, pi_p_g1, NULL, NULL, w, w_sizes);
+    }
+
+    return 0;
+}
+
+int pythia_w_verify_batch(const pythia_buf_t *transformed_passwords, const pythia_buf_t *blinded_passwords,
+                          const pythia_buf_t *tweaks, size_t count, const pythia_buf_t *transformation_public_key,
+                          const pythia_buf_t *proof_values_c, const pythia_buf_t *proof_values_u, int *verified) {
+    pythia_err_init();
+
+    if (!count)
+        return 0;
+
+    g1_t *x_g1 = NULL;
+    gt_t *y_gt = NULL;
+    bn_t *c_bn = NULL;
+    bn_t *u_bn = NULL;
+    const uint8_t **t = NULL;
+    size_t *t_sizes = NULL;
+    g1_t p_g1; g1_null(p_g1);
+
+    TRY {
+        // Reject malformed input before decoding and subgroup checks
+        g1_check_buf_trusted(transformation_public_key);
+        for (size_t i = 0; i < count; i++) {
+            g1_check_buf(&blinded_passwords[i]);
+            gt_check_buf(&transformed_passwords[i]);
+            bn_check_buf(&proof_values_c[i]);
+            bn_check_buf(&proof_values_u[i]);
+        }
+
+        x_g1 = (g1_t *)calloc(count, sizeof(g1_t));
+        y_gt = (gt_t *)calloc(count, sizeof(gt_t));
+        t = (const uint8_t **)calloc(count, sizeof(uint8_t *));
+        t_sizes = (size_t *)calloc(count, sizeof(size_t));
+
+        if (!x_g1 || !y_gt || !t || !t_sizes)
+            THROW(ERR_NO_MEMORY);
+
+        bn_batch_new(&c_bn, count);
+        bn_batch_new(&u_bn, count);
+
+        for (size_t i = 0; i < count; i++) {
+            g1_null(x_g1[i]);
+            gt_null(y_gt[i]);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            g1_new(x_g1[i]);
+            gt_new(y_gt[i]);
+
+            g1_read_buf(x_g1[i], &blinded_passwords[i]);
+            gt_read_buf(y_gt[i], &transformed_passwords[i]);
+            bn_read_buf(c_bn[i], &proof_values_c[i]);
+            bn_read_buf(u_bn[i], &proof_values_u[i]);
+            t[i] = tweaks[i].p;
+            t_sizes[i] = tweaks[i].len;
+        }
+
+        g1_new(p_g1);
+        g1_read_buf_trusted(p_g1, transformation_public_key);
+
+        pythia_verify_batch(y_gt, x_g1, t, t_sizes, count, p_g1, c_bn, u_bn, verified);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        g1_free(p_g1);
+        bn_batch_free(count, u_bn);
+        bn_batch_free(count, c_bn);
+        transform_batch_free(count, x_g1, y_gt, NULL, t, t_sizes);
+
+        return -1;
+    }
+    FINALLY {
+        g1_free(p_g1);
+        bn_batch_free(count, u_bn);
+        bn_batch_free(count, c_bn);
+        transform_batch_free(count, x_g1, y_gt, NULL, t, t_sizes);
+    }
+
+    return 0;
+}
+
+int pythia_w_update_deblinded_with_token_batch(const pythia_buf_t *deblinded_passwords, size_t count,
+                                               const pythia_buf_t *password_update_token,
+                                               pythia_buf_t *updated_deblinded_passwords) {
+    pythia_err_init();
+
+    if (!count)
+        return 0;
+
+    pythia_gt_batch_t *z_gt = NULL;
+    bn_t delta_bn; bn_null(delta_bn);
+
+    TRY {
+        // Reject malformed token before decoding and subgroup checks of passwords
+        bn_check_buf(password_update_token);
+
+        z_gt = gt_batch_new(count);
+        gt_batch_read_bufs(z_gt, deblinded_passwords);
+
+        bn_new(delta_bn);
+        bn_read_buf(delta_bn, password_update_token);
+
+        pythia_update_with_delta_gt_batch(z_gt, delta_bn, z_gt);
+
+        gt_batch_write_bufs(updated_deblinded_passwords, z_gt);
+    }
+    CATCH_ANY {
+        pythia_err_init();
+        bn_free(delta_bn);
+        gt_batch_free(z_gt);
+
+        return -1;
+    }
+    FINALLY {
+        bn_free(delta_bn);
+        gt_batch_free(z_gt);
+    }
+
+    return 0;
+}
@@ -20,6 +20,16 @@
 #include "pythia_init.h"
 #include "pythia_init_c.h"
 #include "pythia_c.h"
+#include "pythia_hash.h"
+#include "pythia_md.h"
+#include "pythia_fp.h"
+#include "pythia_fp8.h"
+#include "pythia_fp_asm.h"
+#include "pythia_fp_gen.h"
+#include "pythia_pp.h"
+#include "pythia_batch_c.h"
+#include "pythia_buf_sizes_c.h"
+#include "pythia_wrapper.h"
 
 void bench1_BlindEvalProveVerify() {
     TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
@@ -84,12 +94,891 @@ void bench1_BlindEvalProveVerify() {
     pythia_deinit();
 }
 
+void bench2_UpdateWithPreparedDelta() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 100;
+
+    const uint8_t password[9] = "password";
+    const uint8_t w[11] = "virgil.com";
+    const uint8_t t[6] = "alice";
+    const uint8_t msk0[14] = "master secret";
+    const uint8_t msk1[14] = "secret master";
+    const uint8_t ssk[14] = "server secret";
+
+    g1_t blinded; g1_null(blinded);
+    bn_t rInv; bn_null(rInv);
+    gt_t y; gt_null(y);
+    bn_t kw0; bn_null(kw0);
+    bn_t kw1; bn_null(kw1);
+    g2_t tTilde; g2_null(tTilde);
+    g1_t pi_p; g1_null(pi_p);
+    bn_t del; bn_null(del);
+    gt_t u0; gt_null(u0);
+    gt_t u1; gt_null(u1);
+
+    TRY {
+        g1_new(blinded);
+        bn_new(rInv);
+        gt_new(y);
+        bn_new(kw0);
+        bn_new(kw1);
+        g2_new(tTilde);
+        g1_new(pi_p);
+        bn_new(del);
+        gt_new(u0);
+        gt_new(u1);
+
+        pythia_blind(password, 8, blinded, rInv);
+        pythia_compute_kw(w, 10, msk0, 13, ssk, 13, kw0, pi_p);
+        pythia_eval(blinded, t, 5, kw0, y, tTilde);
+        pythia_deblind(y, rInv, u0);
+
+        pythia_compute_kw(w, 10, msk1, 13, ssk, 13, kw1, pi_p);
+        get_delta(kw0, kw1, del);
+
+        pythia_exp_prep_t del_prep;
+        pythia_exp_prepare(&del_prep, del);
+
+        for (int i = 0; i < iterations; i++) {
+            pythia_update_with_prepared_delta(u0, &del_prep, u1);
+            gt_copy(u0, u1);
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        gt_free(u1);
+        gt_free(u0);
+        bn_free(del);
+        g1_free(pi_p);
+        g2_free(tTilde);
+        bn_free(kw1);
+        bn_free(kw0);
+        gt_free(y);
+        bn_free(rInv);
+        g1_free(blinded);
+    }
+
+    pythia_deinit();
+}
+
+void bench3_TransformPrepared() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 100;
+
+    const uint8_t password[9] = "password";
+    const uint8_t w[11] = "virgil.com";
+    const uint8_t t[6] = "alice";
+    const uint8_t msk[14] = "master secret";
+    const uint8_t ssk[14] = "server secret";
+
+    g1_t blinded; g1_null(blinded);
+    bn_t rInv; bn_null(rInv);
+    gt_t y; gt_null(y);
+    bn_t kw; bn_null(kw);
+    g2_t tTilde; g2_null(tTilde);
+    g1_t pi_p; g1_null(pi_p);
+
+    TRY {
+        g1_new(blinded);
+        bn_new(rInv);
+        gt_new(y);
+        bn_new(kw);
+        g2_new(tTilde);
+        g1_new(pi_p);
+
+        pythia_blind(password, 8, blinded, rInv);
+        pythia_compute_kw(w, 10, msk, 13, ssk, 13, kw, pi_p);
+
+        pythia_scalar_prep_t kw_prep;
+        pythia_scalar_prepare(&kw_prep, kw);
+
+        for (int i = 0; i < iterations; i++) {
+            pythia_eval_prepared(blinded, t, 5, &kw_prep, y, tTilde);
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        g1_free(pi_p);
+        g2_free(tTilde);
+        bn_free(kw);
+        gt_free(y);
+        bn_free(rInv);
+        g1_free(blinded);
+    }
+
+    pythia_deinit();
+}
+
+static void bench_gt_membership(int naive) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 100;
+
+    const uint8_t password[9] = "password";
+    const uint8_t w[11] = "virgil.com";
+    const uint8_t t[6] = "alice";
+    const uint8_t msk[14] = "master secret";
+    const uint8_t ssk[14] = "server secret";
+
+    g1_t blinded; g1_null(blinded);
+    bn_t rInv; bn_null(rInv);
+    gt_t y; gt_null(y);
+    bn_t kw; bn_null(kw);
+    g2_t tTilde; g2_null(tTilde);
+    g1_t pi_p; g1_null(pi_p);
+    bn_t ord; bn_null(ord);
+    gt_t e; gt_null(e);
+
+    TRY {
+        g1_new(blinded);
+        bn_new(rInv);
+        gt_new(y);
+        bn_new(kw);
+        g2_new(tTilde);
+        g1_new(pi_p);
+        bn_new(ord);
+        gt_new(e);
+
+        pythia_blind(password, 8, blinded, rInv);
+        pythia_compute_kw(w, 10, msk, 13, ssk, 13, kw, pi_p);
+        pythia_eval(blinded, t, 5, kw, y, tTilde);
+        gt_get_ord(ord);
+
+        for (int i = 0; i < iterations; i++) {
+            if (naive) {
+                gt_exp(e, y, ord);
+                TEST_ASSERT_TRUE(gt_is_unity(e));
+            } else {
+                TEST_ASSERT_NOT_EQUAL(gt_is_member(y), 0);
+            }
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        gt_free(e);
+        bn_free(ord);
+        g1_free(pi_p);
+        g2_free(tTilde);
+        bn_free(kw);
+        gt_free(y);
+        bn_free(rInv);
+        g1_free(blinded);
+    }
+
+    pythia_deinit();
+}
+
+void bench4_GtMembership() {
+    bench_gt_membership(0);
+}
+
+void bench5_GtMembershipNaive() {
+    bench_gt_membership(1);
+}
+
+static void bench_point_membership(int naive) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 100;
+
+    const uint8_t password[9] = "password";
+    const uint8_t w[11] = "virgil.com";
+    const uint8_t t[6] = "alice";
+    const uint8_t msk[14] = "master secret";
+    const uint8_t ssk[14] = "server secret";
+
+    g1_t blinded; g1_null(blinded);
+    bn_t rInv; bn_null(rInv);
+    gt_t y; gt_null(y);
+    bn_t kw; bn_null(kw);
+    g2_t tTilde; g2_null(tTilde);
+    g1_t pi_p; g1_null(pi_p);
+    bn_t ord; bn_null(ord);
+    g1_t e1; g1_null(e1);
+    g2_t e2; g2_null(e2);
+
+    TRY {
+        g1_new(blinded);
+        bn_new(rInv);
+        gt_new(y);
+        bn_new(kw);
+        g2_new(tTilde);
+        g1_new(pi_p);
+        bn_new(ord);
+        g1_new(e1);
+        g2_new(e2);
+
+        pythia_blind(password, 8, blinded, rInv);
+        pythia_compute_kw(w, 10, msk, 13, ssk, 13, kw, pi_p);
+        pythia_eval(blinded, t, 5, kw, y, tTilde);
+        g1_get_ord(ord);
+
+        for (int i = 0; i < iterations; i++) {
+            if (naive) {
+                g1_mul(e1, blinded, ord);
+                TEST_ASSERT_TRUE(g1_is_infty(e1));
+                g2_mul(e2, tTilde, ord);
+                TEST_ASSERT_TRUE(g2_is_infty(e2));
+            } else {
+                TEST_ASSERT_NOT_EQUAL(g1_is_member(blinded), 0);
+                TEST_ASSERT_NOT_EQUAL(g2_is_member(tTilde), 0);
+            }
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        g2_free(e2);
+        g1_free(e1);
+        bn_free(ord);
+        g1_free(pi_p);
+        g2_free(tTilde);
+        bn_free(kw);
+        gt_free(y);
+        bn_free(rInv);
+        g1_free(blinded);
+    }
+
+    pythia_deinit();
+}
+
+void bench6_PointMembership() {
+    bench_point_membership(0);
+}
+
+void bench7_PointMembershipNaive() {
+    bench_point_membership(1);
+}
+
+void bench8_RejectMalformed() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    const int iterations = 1000;
+
+    const uint8_t password[9] = "password";
+    const uint8_t w[11] = "virgil.com";
+    const uint8_t t[6] = "alice";
+    const uint8_t msk[14] = "master secret";
+    const uint8_t ssk[14] = "server secret";
+
+    uint8_t blinded_bin[DEF_PYTHIA_G1_BUF_SIZE], secret_bin[DEF_PYTHIA_BN_BUF_SIZE],
+            private_bin[DEF_PYTHIA_BN_BUF_SIZE], public_bin[DEF_PYTHIA_G1_BUF_SIZE],
+            tweak_bin[DEF_PYTHIA_G2_BUF_SIZE], transformed_bin[DEF_PYTHIA_GT_BUF_SIZE],
+            c_bin[DEF_PYTHIA_BN_BUF_SIZE], u_bin[DEF_PYTHIA_BN_BUF_SIZE];
+
+    pythia_buf_t password_buf = { (uint8_t *)password, 8, 8 };
+    pythia_buf_t w_buf = { (uint8_t *)w, 10, 10 };
+    pythia_buf_t t_buf = { (uint8_t *)t, 5, 5 };
+    pythia_buf_t msk_buf = { (uint8_t *)msk, 13, 13 };
+    pythia_buf_t ssk_buf = { (uint8_t *)ssk, 13, 13 };
+    pythia_buf_t blinded = { blinded_bin, sizeof(blinded_bin), 0 };
+    pythia_buf_t secret = { secret_bin, sizeof(secret_bin), 0 };
+    pythia_buf_t private_key = { private_bin, sizeof(private_bin), 0 };
+    pythia_buf_t public_key = { public_bin, sizeof(public_bin), 0 };
+    pythia_buf_t transformed_tweak = { tweak_bin, sizeof(tweak_bin), 0 };
+    pythia_buf_t transformed = { transformed_bin, sizeof(transformed_bin), 0 };
+    pythia_buf_t c = { c_bin, sizeof(c_bin), 0 };
+    pythia_buf_t u = { u_bin, sizeof(u_bin), 0 };
+
+    TEST_ASSERT_EQUAL_INT(pythia_w_blind(&password_buf, &blinded, &secret), 0);
+    TEST_ASSERT_EQUAL_INT(pythia_w_compute_transformation_key_pair(&w_buf, &msk_buf, &ssk_buf,
+                                                                   &private_key, &public_key), 0);
+    TEST_ASSERT_EQUAL_INT(pythia_w_transform(&blinded, &t_buf, &private_key, &transformed, &transformed_tweak), 0);
+    TEST_ASSERT_EQUAL_INT(pythia_w_prove(&transformed, &blinded, &transformed_tweak, &private_key, &public_key,
+                                         &c, &u), 0);
+
+    // Public key is decoded last, so without pre-validation the other points would be decoded and checked first
+    public_bin[0] = 4;
+
+    int verified = 0;
+    for (int i = 0; i < iterations; i++) {
+        TEST_ASSERT_EQUAL_INT(pythia_w_verify(&transformed, &blinded, &t_buf, &public_key, &c, &u, &verified), -1);
+    }
+
+    pythia_deinit();
+}
+
+static void bench_hash_g1(int sswu) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 1000;
+
+    uint8_t password[16] = "password";
+
+    g1_t p; g1_null(p);
+
+    TRY {
+        g1_new(p);
+
+        for (int i = 0; i < iterations; i++) {
+            password[8] = (uint8_t)i;
+            password[9] = (uint8_t)(i >> 8);
+
+            if (sswu) {
+                g1_map_sswu(p, password, sizeof(password), (const uint8_t *)PYTHIA_HASH_G1_DST,
+                            sizeof(PYTHIA_HASH_G1_DST) - 1);
+            } else {
+                g1_map(p, password, sizeof(password));
+            }
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        g1_free(p);
+    }
+
+    pythia_deinit();
+}
+
+void bench9_HashG1() {
+    bench_hash_g1(0);
+}
+
+void bench10_HashG1Sswu() {
+    bench_hash_g1(1);
+}
+
+static void bench_hash_g2(int sswu) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 1000;
+
+    uint8_t tweak[16] = "alice";
+
+    g2_t p; g2_null(p);
+
+    TRY {
+        g2_new(p);
+
+        for (int i = 0; i < iterations; i++) {
+            tweak[8] = (uint8_t)i;
+            tweak[9] = (uint8_t)(i >> 8);
+
+            if (sswu) {
+                g2_map_sswu(p, tweak, sizeof(tweak), (const uint8_t *)PYTHIA_HASH_G2_DST,
+                            sizeof(PYTHIA_HASH_G2_DST) - 1);
+            } else {
+                g2_map(p, tweak, sizeof(tweak));
+            }
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        g2_free(p);
+    }
+
+    pythia_deinit();
+}
+
+void bench11_HashG2() {
+    bench_hash_g2(0);
+}
+
+void bench12_HashG2Sswu() {
+    bench_hash_g2(1);
+}
+
+static void bench_hash_sswu_batch(int batch) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 20;
+    const size_t n = 64;
+
+    uint8_t tweaks[64][16];
+    const uint8_t *t[64];
+    size_t t_sizes[64];
+    g1_t p1[64];
+    g2_t p2[64];
+
+    for (size_t i = 0; i < n; i++) {
+        memset(tweaks[i], 0, sizeof(tweaks[i]));
+        tweaks[i][0] = (uint8_t)i;
+        t[i] = tweaks[i];
+        t_sizes[i] = sizeof(tweaks[i]);
+        g1_null(p1[i]);
+        g2_null(p2[i]);
+    }
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            g1_new(p1[i]);
+            g2_new(p2[i]);
+        }
+
+        for (int k = 0; k < iterations; k++) {
+            if (batch) {
+                g1_map_sswu_batch(p1, t, t_sizes, n, (const uint8_t *)PYTHIA_HASH_G1_DST,
+                                  sizeof(PYTHIA_HASH_G1_DST) - 1);
+                g2_map_sswu_batch(p2, t, t_sizes, n, (const uint8_t *)PYTHIA_HASH_G2_DST,
+                                  sizeof(PYTHIA_HASH_G2_DST) - 1);
+            } else {
+                for (size_t i = 0; i < n; i++) {
+                    g1_map_sswu(p1[i], t[i], t_sizes[i], (const uint8_t *)PYTHIA_HASH_G1_DST,
+                                sizeof(PYTHIA_HASH_G1_DST) - 1);
+                    g2_map_sswu(p2[i], t[i], t_sizes[i], (const uint8_t *)PYTHIA_HASH_G2_DST,
+                                sizeof(PYTHIA_HASH_G2_DST) - 1);
+                }
+            }
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        for (size_t i = 0; i < n; i++) {
+            g2_free(p2[i]);
+            g1_free(p1[i]);
+        }
+    }
+
+    pythia_deinit();
+}
+
+void bench13_HashSswuBatch() {
+    bench_hash_sswu_batch(1);
+}
+
+void bench14_HashSswuSingle() {
+    bench_hash_sswu_batch(0);
+}
+
+static void bench_hmac_batch(size_t lanes) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    const int iterations = 10000;
+    const size_t n = 64;
+
+    // Key IDs of typical key ring entries after scope secret
+    uint8_t ids[64][45];
+    const uint8_t *in[64];
+    size_t in_sizes[64];
+    uint8_t mac[64][MD_LEN_SH384];
+
+    for (size_t i = 0; i < n; i++) {
+        memset(ids[i], 'a', sizeof(ids[i]));
+        ids[i][0] = (uint8_t)i;
+        in[i] = ids[i];
+        in_sizes[i] = sizeof(ids[i]);
+    }
+
+    md_batch_set_max_lanes(lanes);
+
+    for (int k = 0; k < iterations; k++)
+        md_hmac_sh384_batch(mac, in, in_sizes, n, (const uint8_t *)"master secret", 13);
+
+    md_batch_set_max_lanes(PYTHIA_MD_MAX_LANES);
+
+    pythia_deinit();
+}
+
+void bench15_HmacBatchScalar() {
+    bench_hmac_batch(1);
+}
+
+void bench16_HmacBatch() {
+    bench_hmac_batch(PYTHIA_MD_MAX_LANES);
+}
+
+static void bench_update_batch(int lanes) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 5;
+    const size_t n = 64;
+
+    const uint8_t password[9] = "password";
+    const uint8_t t[6] = "alice";
+
+    g1_t blinded; g1_null(blinded);
+    bn_t rInv; bn_null(rInv);
+    bn_t del; bn_null(del);
+    g2_t tTilde; g2_null(tTilde);
+    gt_t u[64];
+
+    for (size_t i = 0; i < n; i++) {
+        gt_null(u[i]);
+    }
+
+    TRY {
+        g1_new(blinded);
+        bn_new(rInv);
+        bn_new(del);
+        g2_new(tTilde);
+
+        pythia_blind(password, 8, blinded, rInv);
+        bn_rand(del, BN_POS, 255);
+
+        for (size_t i = 0; i < n; i++) {
+            gt_new(u[i]);
+            pythia_eval(blinded, t, 5, del, u[i], tTilde);
+        }
+
+        fp8_set_enabled(lanes);
+
+        for (int k = 0; k < iterations; k++)
+            pythia_update_with_delta_batch(u, del, n, u);
+
+        fp8_set_enabled(1);
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        for (size_t i = 0; i < n; i++) {
+            gt_free(u[i]);
+        }
+        g2_free(tTilde);
+        bn_free(del);
+        bn_free(rInv);
+        g1_free(blinded);
+    }
+
+    pythia_deinit();
+}
+
+void bench17_UpdateBatch() {
+    bench_update_batch(1);
+}
+
+void bench18_UpdateBatchRelic() {
+    bench_update_batch(0);
+}
+
+void bench19_UpdateGtBatch() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 5;
+    const size_t n = 64;
+
+    const uint8_t password[9] = "password";
+    const uint8_t t[6] = "alice";
+
+    g1_t blinded; g1_null(blinded);
+    bn_t rInv; bn_null(rInv);
+    bn_t del; bn_null(del);
+    g2_t tTilde; g2_null(tTilde);
+    gt_t u; gt_null(u);
+    pythia_gt_batch_t *batch = NULL;
+
+    TRY {
+        g1_new(blinded);
+        bn_new(rInv);
+        bn_new(del);
+        g2_new(tTilde);
+        gt_new(u);
+
+        pythia_blind(password, 8, blinded, rInv);
+        bn_rand(del, BN_POS, 255);
+
+        batch = gt_batch_new(n);
+        for (size_t i = 0; i < n; i++) {
+            pythia_eval(blinded, t, 5, del, u, tTilde);
+            gt_batch_set(batch, i, u);
+        }
+
+        for (int k = 0; k < iterations; k++)
+            pythia_update_with_delta_gt_batch(batch, del, batch);
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        gt_batch_free(batch);
+        gt_free(u);
+        g2_free(tTilde);
+        bn_free(del);
+        bn_free(rInv);
+        g1_free(blinded);
+    }
+
+    pythia_deinit();
+}
+
+// Hash to curve maps are what runs on the assembly backend
+static void bench_eval(int backend) {
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_SSWU);
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_SSWU);
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 100;
+
+    const uint8_t password[9] = "password";
+    const uint8_t t[6] = "alice";
+
+    g1_t blinded; g1_null(blinded);
+    bn_t rInv; bn_null(rInv);
+    bn_t kw; bn_null(kw);
+    g2_t tTilde; g2_null(tTilde);
+    gt_t y; gt_null(y);
+
+    TRY {
+        g1_new(blinded);
+        bn_new(rInv);
+        bn_new(kw);
+        g2_new(tTilde);
+        gt_new(y);
+
+        pythia_blind(password, 8, blinded, rInv);
+        bn_rand(kw, BN_POS, 255);
+
+        fp_gen_set_enabled(0);
+        fp_asm_set_enabled(backend);
+
+        for (int i = 0; i < iterations; i++)
+            pythia_eval(blinded, t, 5, kw, y, tTilde);
+
+        fp_asm_set_enabled(1);
+        fp_gen_set_enabled(1);
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        gt_free(y);
+        g2_free(tTilde);
+        bn_free(kw);
+        bn_free(rInv);
+        g1_free(blinded);
+    }
+
+    pythia_deinit();
+
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_LEGACY);
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_LEGACY);
+}
+
+void bench20_EvalFpAsm() {
+    bench_eval(1);
+}
+
+void bench21_EvalFpRelic() {
+    bench_eval(0);
+}
+
+static void bench_fp_gen(int enabled) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 1000;
+
+    fp_t a; fp_null(a);
+    fp_t b; fp_null(b);
+
+    TRY {
+        fp_new(a);
+        fp_new(b);
+
+        fp_rand(a);
+        fp_rand(b);
+
+        fp_gen_set_enabled(enabled);
+        fp_asm_set_enabled(enabled);
+
+        for (int i = 0; i < iterations; i++) {
+            pythia_fp_inv(a, a);
+            for (int j = 0; j < 100; j++)
+                pythia_fp_mul(a, a, b);
+        }
+
+        fp_asm_set_enabled(1);
+        fp_gen_set_enabled(1);
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        fp_free(b);
+        fp_free(a);
+    }
+
+    pythia_deinit();
+}
+
+void bench22_FpGen() {
+    bench_fp_gen(1);
+}
+
+void bench23_FpGenRelic() {
+    bench_fp_gen(0);
+}
+
+static void bench_pairing(int enabled, int batch, int lanes) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 10;
+    const size_t n = 16;
+
+    g1_t p[16];
+    g2_t q[16];
+    gt_t r[16];
+
+    for (size_t i = 0; i < n; i++) {
+        g1_null(p[i]);
+        g2_null(q[i]);
+        gt_null(r[i]);
+    }
+
+    TRY {
+        for (size_t i = 0; i < n; i++) {
+            g1_new(p[i]);
+            g2_new(q[i]);
+            gt_new(r[i]);
+            g1_rand(p[i]);
+            g2_rand(q[i]);
+        }
+
+        pp_exp_set_enabled(enabled);
+        fp8_set_enabled(lanes);
+
+        for (int i = 0; i < iterations; i++) {
+            if (batch) {
+                pc_map_batch(r, p, q, n);
+            }
+            else {
+                for (size_t j = 0; j < n; j++)
+                    pp_map_bls12(r[j], p[j], q[j]);
+            }
+        }
+
+        pp_exp_set_enabled(1);
+        fp8_set_enabled(1);
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        for (size_t i = 0; i < n; i++) {
+            gt_free(r[i]);
+            g2_free(q[i]);
+            g1_free(p[i]);
+        }
+    }
+
+    pythia_deinit();
+}
+
+void bench24_PairingFinalExp() {
+    bench_pairing(1, 0, 1);
+}
+
+void bench25_PairingFinalExpRelic() {
+    bench_pairing(0, 0, 1);
+}
+
+void bench26_PairingBatch() {
+    bench_pairing(1, 1, 1);
+}
+
+static void bench_mul(int g2, int endom) {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    pythia_err_init();
+    const int iterations = 100;
+
+    bn_t k; bn_null(k);
+    bn_t ord; bn_null(ord);
+    g1_t p; g1_null(p);
+    g2_t q; g2_null(q);
+
+    TRY {
+        bn_new(k);
+        bn_new(ord);
+        g1_new(p);
+        g2_new(q);
+
+        g1_get_ord(ord);
+        bn_rand_mod(k, ord);
+        g1_rand(p);
+        g2_rand(q);
+
+        for (int i = 0; i < iterations; i++) {
+            if (g2 && endom)
+                g2_mul_gls(q, q, k);
+            else if (g2)
+                g2_mul(q, q, k);
+            else if (endom)
+                g1_mul_glv(p, p, k);
+            else
+                g1_mul(p, p, k);
+        }
+    }
+    CATCH_ANY {
+        TEST_FAIL();
+    }
+    FINALLY {
+        g2_free(q);
+        g1_free(p);
+        bn_free(ord);
+        bn_free(k);
+    }
+
+    pythia_deinit();
+}
+
+void bench27_G1MulGlv() {
+    bench_mul(0, 1);
+}
+
+void bench28_G1MulRelic() {
+    bench_mul(0, 0);
+}
+
+void bench29_G2MulGls() {
+    bench_mul(1, 1);
+}
+
+void bench30_G2MulRelic() {
+    bench_mul(1, 0);
+}
+
+void bench31_PairingBatchRelicLoop() {
+    bench_pairing(1, 1, 0);
+}
+
 int main() {
     UNITY_BEGIN();
 
     conf_print();
 
     RUN_TEST(bench1_BlindEvalProveVerify);
+    RUN_TEST(bench2_UpdateWithPreparedDelta);
+    RUN_TEST(bench3_TransformPrepared);
+    RUN_TEST(bench4_GtMembership);
+    RUN_TEST(bench5_GtMembershipNaive);
+    RUN_TEST(bench6_PointMembership);
+    RUN_TEST(bench7_PointMembershipNaive);
+    RUN_TEST(bench8_RejectMalformed);
+    RUN_TEST(bench9_HashG1);
+    RUN_TEST(bench10_HashG1Sswu);
+    RUN_TEST(bench11_HashG2);
+    RUN_TEST(bench12_HashG2Sswu);
+    RUN_TEST(bench13_HashSswuBatch);
+    RUN_TEST(bench14_HashSswuSingle);
+    RUN_TEST(bench15_HmacBatchScalar);
+    RUN_TEST(bench16_HmacBatch);
+    RUN_TEST(bench17_UpdateBatch);
+    RUN_TEST(bench18_UpdateBatchRelic);
+    RUN_TEST(bench19_UpdateGtBatch);
+    RUN_TEST(bench20_EvalFpAsm);
+    RUN_TEST(bench21_EvalFpRelic);
+    RUN_TEST(bench22_FpGen);
+    RUN_TEST(bench23_FpGenRelic);
+    RUN_TEST(bench24_PairingFinalExp);
+    RUN_TEST(bench25_PairingFinalExpRelic);
+    RUN_TEST(bench26_PairingBatch);
+    RUN_TEST(bench27_G1MulGlv);
+    RUN_TEST(bench28_G1MulRelic);
+    RUN_TEST(bench29_G2MulGls);
+    RUN_TEST(bench30_G2MulRelic);
+    RUN_TEST(bench31_PairingBatchRelicLoop);
 
     return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+/**
+ * Copyright (C) 2015-2018 Virgil Security Inc.
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pythia.h"
+
+/*
+ * Workload of a Pythia service used to train PGO builds and to compare them with default ones.
+ * Operations come in production ratios: every login is blinded, transformed and deblinded,
+ * one in WORKLOAD_PROOF_RATE is also proven and verified, one in WORKLOAD_UPDATE_RATE stored
+ * password is updated after key rotation.
+ *
+ * Usage: pythia_pgo_workload [logins]
+ */
+
+#define WORKLOAD_LOGINS 200
+#define WORKLOAD_PROOF_RATE 10
+#define WORKLOAD_UPDATE_RATE 100
+
+static pythia_buf_t buf_alloc(size_t size) {
+    pythia_buf_t buf;
+
+    buf.p = (uint8_t *)malloc(size);
+    buf.allocated = size;
+    buf.len = 0;
+
+    if (!buf.p) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+
+    return buf;
+}
+
+static pythia_buf_t buf_const(const char *s) {
+    pythia_buf_t buf;
+
+    buf.p = (uint8_t *)s;
+    buf.allocated = strlen(s);
+    buf.len = buf.allocated;
+
+    return buf;
+}
+
+static double seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    const long logins = argc > 1 ? atol(argv[1]) : WORKLOAD_LOGINS;
+
+    if (logins <= 0) {
+        fprintf(stderr, "Usage: %s [logins]\n", argv[0]);
+        return 1;
+    }
+
+    if (pythia_init(NULL))
+        return 1;
+
+    pythia_buf_t key_id = buf_const("virgil.com");
+    pythia_buf_t secret = buf_const("master secret");
+    pythia_buf_t new_secret = buf_const("secret master");
+    pythia_buf_t scope_secret = buf_const("server secret");
+
+    pythia_buf_t private_key = buf_alloc(PYTHIA_BN_BUF_SIZE);
+    pythia_buf_t public_key = buf_alloc(PYTHIA_G1_BUF_SIZE);
+    pythia_buf_t new_private_key = buf_alloc(PYTHIA_BN_BUF_SIZE);
+    pythia_buf_t new_public_key = buf_alloc(PYTHIA_G1_BUF_SIZE);
+    pythia_buf_t update_token = buf_alloc(PYTHIA_BN_BUF_SIZE);
+    pythia_buf_t blinded_password = buf_alloc(PYTHIA_G1_BUF_SIZE);
+    pythia_buf_t blinding_secret = buf_alloc(PYTHIA_BN_BUF_SIZE);
+    pythia_buf_t transformed_password = buf_alloc(PYTHIA_GT_BUF_SIZE);
+    pythia_buf_t transformed_tweak = buf_alloc(PYTHIA_G2_BUF_SIZE);
+    pythia_buf_t deblinded_password = buf_alloc(PYTHIA_GT_BUF_SIZE);
+    pythia_buf_t updated_password = buf_alloc(PYTHIA_GT_BUF_SIZE);
+    pythia_buf_t proof_value_c = buf_alloc(PYTHIA_BN_BUF_SIZE);
+    pythia_buf_t proof_value_u = buf_alloc(PYTHIA_BN_BUF_SIZE);
+
+    int result = 1;
+    char password[32], tweak[32];
+
+    // Keys are computed once per key rotation and cached by the service
+    if (pythia_w_compute_transformation_key_pair(&key_id, &secret, &scope_secret, &private_key, &public_key)
+        || pythia_w_compute_transformation_key_pair(&key_id, &new_secret, &scope_secret,
+                                                    &new_private_key, &new_public_key)
+        || pythia_w_get_password_update_token(&private_key, &new_private_key, &update_token))
+        goto end;
+
+    const double start = seconds();
+
+    for (long i = 0; i < logins; i++) {
+        snprintf(password, sizeof(password), "password %ld", i);
+        snprintf(tweak, sizeof(tweak), "user %ld", i);
+
+        pythia_buf_t password_buf = buf_const(password);
+        pythia_buf_t tweak_buf = buf_const(tweak);
+
+        if (pythia_w_blind(&password_buf, &blinded_password, &blinding_secret)
+            || pythia_w_transform(&blinded_password, &tweak_buf, &private_key,
+                                  &transformed_password, &transformed_tweak)
+            || pythia_w_deblind(&transformed_password, &blinding_secret, &deblinded_password))
+            goto end;
+
+        if (i % WORKLOAD_PROOF_RATE == 0) {
+            int verified = 0;
+
+            if (pythia_w_prove(&transformed_password, &blinded_password, &transformed_tweak, &private_key,
+                               &public_key, &proof_value_c, &proof_value_u)
+                || pythia_w_verify(&transformed_password, &blinded_password, &tweak_buf, &public_key,
+                                   &proof_value_c, &proof_value_u, &verified)
+                || !verified)
+                goto end;
+        }
+
+        if (i % WORKLOAD_UPDATE_RATE == 0) {
+            if (pythia_w_update_deblinded_with_token(&deblinded_password, &update_token, &updated_password))
+                goto end;
+        }
+    }
+
+    const double elapsed = seconds() - start;
+    printf("%ld logins in %.3f s, %.1f logins/s\n", logins, elapsed, (double)logins / elapsed);
+    result = 0;
+
+end:
+    if (result)
+        fprintf(stderr, "Workload failed\n");
+
+    free(private_key.p);
+    free(public_key.p);
+    free(new_private_key.p);
+    free(new_public_key.p);
+    free(update_token.p);
+    free(blinded_password.p);
+    free(blinding_secret.p);
+    free(transformed_password.p);
+    free(transformed_tweak.p);
+    free(deblinded_password.p);
+    free(updated_password.p);
+    free(proof_value_c.p);
+    free(proof_value_u.p);
+
+    pythia_deinit();
+
+    return result;
+}
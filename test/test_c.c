@@ -15,7 +15,17 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "pythia_c.h"
+#include "pythia_scalar.h"
+#include "pythia_hash.h"
+#include "pythia_md.h"
+#include "pythia_fp.h"
+#include "pythia_fp8.h"
+#include "pythia_fp_asm.h"
+#include "pythia_fp_gen.h"
+#include "pythia_pp.h"
+#include "pythia_cpu.h"
 #include "pythia_init.h"
 #include "pythia_init_c.h"
 
@@ -61,6 +71,9 @@ void blind_eval_deblind(gt_t deblinded) {
 }
 
 void test1_DeblindStability() {
+    // Reference value was computed with relic's maps
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_LEGACY);
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_LEGACY);
     TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
 
     gt_t deblinded1; gt_null(deblinded1);
@@ -220,6 +233,1107 @@ void test3_UpdateDelta() {
     pythia_deinit();
 }
 
+void test4_PreparedExp() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const uint8_t msk1[14] = "secret master";
+
+    g1_t blinded; g1_new(blinded);
+    bn_t rInv; bn_new(rInv);
+    pythia_blind(password, 8, blinded, rInv);
+
+    gt_t y; gt_new(y);
+    g1_t pi_p; g1_new(pi_p);
+    bn_t kw; bn_new(kw);
+    g2_t tTilde; g2_new(tTilde);
+
+    pythia_compute_kw(w, 10, msk, 13, ssk, 13, kw, pi_p);
+    pythia_eval(blinded, t, 5, kw, y, tTilde);
+
+    pythia_exp_prep_t rInv_prep;
+    pythia_exp_prepare(&rInv_prep, rInv);
+
+    gt_t deblinded; gt_new(deblinded);
+    gt_t deblinded_prep; gt_new(deblinded_prep);
+
+    pythia_deblind(y, rInv, deblinded);
+    pythia_deblind_prepared(y, &rInv_prep, deblinded_prep);
+
+    TEST_ASSERT_EQUAL_INT(gt_cmp(deblinded, deblinded_prep), CMP_EQ);
+
+    bn_t kw1; bn_new(kw1);
+    pythia_compute_kw(w, 10, msk1, 13, ssk, 13, kw1, pi_p);
+
+    bn_t del; bn_new(del);
+    get_delta(kw, kw1, del);
+
+    pythia_exp_prep_t del_prep;
+    pythia_exp_prepare(&del_prep, del);
+
+    gt_t updated; gt_new(updated);
+    gt_t updated_prep; gt_new(updated_prep);
+
+    pythia_update_with_delta(deblinded, del, updated);
+    pythia_update_with_prepared_delta(deblinded, &del_prep, updated_prep);
+
+    TEST_ASSERT_EQUAL_INT(gt_cmp(updated, updated_prep), CMP_EQ);
+
+    gt_free(updated_prep);
+    gt_free(updated);
+    bn_free(del);
+    bn_free(kw1);
+    gt_free(deblinded_prep);
+    gt_free(deblinded);
+    g2_free(tTilde);
+    bn_free(kw);
+    g1_free(pi_p);
+    gt_free(y);
+    bn_free(rInv);
+    g1_free(blinded);
+
+    pythia_deinit();
+}
+
+void test5_EvalPrepared() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const size_t n = 3;
+    const uint8_t *tweaks[3] = {t, w, msk};
+    const size_t tweak_sizes[3] = {5, 10, 13};
+
+    g1_t blinded[3];
+    gt_t y[3], y_batch[3];
+    g2_t tTilde[3], tTilde_batch[3];
+    bn_t rInv; bn_new(rInv);
+
+    bn_t kw; bn_new(kw);
+    g1_t pi_p; g1_new(pi_p);
+    pythia_compute_kw(w, 10, msk, 13, ssk, 13, kw, pi_p);
+
+    pythia_scalar_prep_t kw_prep;
+    pythia_scalar_prepare(&kw_prep, kw);
+
+    for (size_t i = 0; i < n; i++) {
+        g1_new(blinded[i]);
+        gt_new(y[i]);
+        gt_new(y_batch[i]);
+        g2_new(tTilde[i]);
+        g2_new(tTilde_batch[i]);
+
+        pythia_blind(password, 8, blinded[i], rInv);
+        pythia_eval(blinded[i], tweaks[i], tweak_sizes[i], kw, y[i], tTilde[i]);
+    }
+
+    pythia_eval_batch(blinded, tweaks, tweak_sizes, n, &kw_prep, y_batch, tTilde_batch);
+
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_INT(gt_cmp(y[i], y_batch[i]), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(g2_cmp(tTilde[i], tTilde_batch[i]), CMP_EQ);
+
+        g2_free(tTilde_batch[i]);
+        g2_free(tTilde[i]);
+        gt_free(y_batch[i]);
+        gt_free(y[i]);
+        g1_free(blinded[i]);
+    }
+
+    g1_free(pi_p);
+    bn_free(kw);
+    bn_free(rInv);
+
+    pythia_deinit();
+}
+
+void test6_BatchInversion() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const uint8_t msk1[14] = "secret master";
+    const uint8_t ssk1[14] = "secret server";
+
+    uint8_t deblinded_bin[384];
+    const char *pos = deblinded_hex;
+    for (size_t count = 0; count < 384; count++) {
+        sscanf(pos, "%2hhx", &deblinded_bin[count]);
+        pos += 2;
+    }
+
+    gt_t expected; gt_new(expected);
+    gt_read_bin(expected, deblinded_bin, 384);
+
+    const uint8_t *passwords[3] = {password, password, password};
+    const size_t password_sizes[3] = {8, 8, 8};
+
+    g1_t blinded[3];
+    bn_t rInv[3], kw0[3], kw1[3], del[3];
+
+    for (int i = 0; i < 3; i++) {
+        g1_new(blinded[i]);
+        bn_new(rInv[i]);
+        bn_new(kw0[i]);
+        bn_new(kw1[i]);
+        bn_new(del[i]);
+    }
+
+    g1_t pi_p; g1_new(pi_p);
+    gt_t y; gt_new(y);
+    g2_t tTilde; g2_new(tTilde);
+    gt_t deblinded; gt_new(deblinded);
+    bn_t del_single; bn_new(del_single);
+
+    pythia_compute_kw(w, 10, msk, 13, ssk, 13, kw0[0], pi_p);
+
+    pythia_blind_batch(passwords, password_sizes, 3, blinded, rInv);
+
+    for (int i = 0; i < 3; i++) {
+        pythia_eval(blinded[i], t, 5, kw0[0], y, tTilde);
+        pythia_deblind(y, rInv[i], deblinded);
+
+        TEST_ASSERT_EQUAL_INT(gt_cmp(expected, deblinded), CMP_EQ);
+    }
+
+    pythia_compute_kw(w, 10, msk1, 13, ssk, 13, kw0[1], pi_p);
+    pythia_compute_kw(w, 10, msk, 13, ssk1, 13, kw0[2], pi_p);
+    pythia_compute_kw(w, 10, msk1, 13, ssk1, 13, kw1[0], pi_p);
+    pythia_compute_kw(t, 5, msk, 13, ssk, 13, kw1[1], pi_p);
+    pythia_compute_kw(t, 5, msk1, 13, ssk1, 13, kw1[2], pi_p);
+
+    pythia_get_delta_batch(kw0, kw1, 3, del);
+
+    for (int i = 0; i < 3; i++) {
+        get_delta(kw0[i], kw1[i], del_single);
+
+        TEST_ASSERT_EQUAL_INT(bn_cmp(del_single, del[i]), CMP_EQ);
+    }
+
+    bn_free(del_single);
+    gt_free(deblinded);
+    g2_free(tTilde);
+    gt_free(y);
+    g1_free(pi_p);
+
+    for (int i = 0; i < 3; i++) {
+        bn_free(del[i]);
+        bn_free(kw1[i]);
+        bn_free(kw0[i]);
+        bn_free(rInv[i]);
+        g1_free(blinded[i]);
+    }
+
+    gt_free(expected);
+
+    pythia_deinit();
+}
+
+void test7_GtMembership() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    gt_t deblinded; gt_new(deblinded);
+    blind_eval_deblind(deblinded);
+
+    TEST_ASSERT_NOT_EQUAL(gt_is_member(deblinded), 0);
+
+    gt_t g; gt_new(g);
+
+    gt_set_unity(g);
+    TEST_ASSERT_EQUAL_INT(gt_is_member(g), 0);
+
+    fp12_rand(g);
+    TEST_ASSERT_EQUAL_INT(gt_is_member(g), 0);
+
+    // Cyclotomic, but outside of the order r subgroup
+    fp12_conv_cyc(g, g);
+    TEST_ASSERT_EQUAL_INT(gt_is_member(g), 0);
+
+    gt_free(g);
+    gt_free(deblinded);
+
+    pythia_deinit();
+}
+
+void test8_PointMembership() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    g1_t blinded; g1_new(blinded);
+    bn_t rInv; bn_new(rInv);
+    pythia_blind(password, 8, blinded, rInv);
+
+    gt_t y; gt_new(y);
+    g1_t pi_p; g1_new(pi_p);
+    bn_t kw; bn_new(kw);
+    g2_t tTilde; g2_new(tTilde);
+
+    pythia_compute_kw(w, 10, msk, 13, ssk, 13, kw, pi_p);
+    pythia_eval(blinded, t, 5, kw, y, tTilde);
+
+    TEST_ASSERT_NOT_EQUAL(g1_is_member(blinded), 0);
+    TEST_ASSERT_NOT_EQUAL(g1_is_member(pi_p), 0);
+    TEST_ASSERT_NOT_EQUAL(g2_is_member(tTilde), 0);
+
+    // Point on curve with small x almost surely has a component outside of G1
+    g1_t p; g1_new(p);
+    fp_t rhs; fp_new(rhs);
+    bn_t ord; bn_new(ord);
+    for (dig_t d = 1;; d++) {
+        fp_set_dig(p->x, d);
+        fp_set_dig(p->z, 1);
+        p->norm = 1;
+        ep_rhs(rhs, p);
+        if (fp_srt(p->y, rhs))
+            break;
+    }
+
+    TEST_ASSERT_NOT_EQUAL(g1_is_valid(p), 0);
+    TEST_ASSERT_EQUAL_INT(g1_is_member(p), 0);
+
+    // Same for G2, whose cofactor is much larger
+    g2_t q; g2_new(q);
+    fp2_t rhs2; fp2_new(rhs2);
+    fp2_t y2;
+    y2[0] = q->y[0];
+    y2[1] = q->y[1];
+    for (dig_t d = 1;; d++) {
+        fp_set_dig(q->x[0], d);
+        fp_zero(q->x[1]);
+        fp_set_dig(q->z[0], 1);
+        fp_zero(q->z[1]);
+        q->norm = 1;
+        ep2_rhs(rhs2, q);
+        if (fp2_srt(y2, rhs2))
+            break;
+    }
+
+    TEST_ASSERT_NOT_EQUAL(g2_is_valid(q), 0);
+    TEST_ASSERT_EQUAL_INT(g2_is_member(q), 0);
+
+    // Multiples of members stay members, including ones computed with endomorphisms
+    g1_get_ord(ord);
+    bn_rand_mod(kw, ord);
+    g1_mul(p, blinded, kw);
+    g2_mul(q, tTilde, kw);
+    TEST_ASSERT_NOT_EQUAL(g1_is_member(p), 0);
+    TEST_ASSERT_NOT_EQUAL(g2_is_member(q), 0);
+
+    fp2_free(rhs2);
+    g2_free(q);
+    bn_free(ord);
+    fp_free(rhs);
+    g1_free(p);
+    g2_free(tTilde);
+    bn_free(kw);
+    g1_free(pi_p);
+    gt_free(y);
+    bn_free(rInv);
+    g1_free(blinded);
+
+    pythia_deinit();
+}
+
+void test9_ScalarArithmetic() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    bn_t ord; bn_new(ord);
+    bn_t a; bn_new(a);
+    bn_t b; bn_new(b);
+    bn_t e; bn_new(e);
+    bn_t g; bn_new(g);
+    bn_t c; bn_new(c);
+    pythia_sc_t sa, sb, sc;
+
+    g1_get_ord(ord);
+
+    for (int i = 0; i < 100; i++) {
+        bn_rand_mod(a, ord);
+        bn_rand(b, BN_POS, 256);
+
+        sc_read_bn(&sa, a);
+        sc_read_bn(&sb, b);
+
+        // a - a * b mod r
+        sc_mul(&sc, &sa, &sb);
+        sc_sub(&sc, &sa, &sc);
+        sc_write_bn(c, &sc);
+
+        bn_mul(e, a, b);
+        bn_sub(e, a, e);
+        bn_mod(e, e, ord);
+        TEST_ASSERT_EQUAL_INT(bn_cmp(c, e), CMP_EQ);
+
+        // a^-1 mod r
+        if (bn_is_zero(a))
+            continue;
+
+        sc_inv(&sc, &sa);
+        sc_write_bn(c, &sc);
+
+        bn_gcd_ext(g, e, NULL, a, ord);
+        bn_mod(e, e, ord);
+        TEST_ASSERT_EQUAL_INT(bn_cmp(c, e), CMP_EQ);
+    }
+
+    bn_free(c);
+    bn_free(g);
+    bn_free(e);
+    bn_free(b);
+    bn_free(a);
+    bn_free(ord);
+
+    pythia_deinit();
+}
+
+// Test vectors of BLS12381G1_XMD:SHA-256_SSWU_RO_ suite, RFC 9380 appendix J.9.1
+static const char *sswu_msgs[2] = { "", "abc" };
+static const char *sswu_points[2][2] = {
+        { "052926ADD2207B76CA4FA57A8734416C8DC95E24501772C814278700EED6D1E4E8CF62D9C09DB0FAC349612B759E79A1",
+          "08BA738453BFED09CB546DBB0783DBB3A5F1F566ED67BB6BE0E8C67E2E81A4CC68EE29813BB7994998F3EAE0C9C6A265" },
+        { "03567BC5EF9C690C2AB2ECDF6A96EF1C139CC0B2F284DCA0A9A7943388A49A3AEE664BA5379A7655D3C68900BE2F6903",
+          "0B9C15F3FE6E5CF4211F346271D7B01C8F3B28BE689C8429C85B67AF215533311F0B8DFAAA154FA6B88176C229F2885D" }
+};
+
+void test10_HashG1Sswu() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const char *dst = "QUUX-V01-CS02-with-BLS12381G1_XMD:SHA-256_SSWU_RO_";
+    g1_t p; g1_new(p);
+    g1_t e; g1_new(e);
+
+    for (int i = 0; i < 2; i++) {
+        g1_map_sswu(p, (const uint8_t *)sswu_msgs[i], strlen(sswu_msgs[i]), (const uint8_t *)dst, strlen(dst));
+
+        fp_read_str(e->x, sswu_points[i][0], (int)strlen(sswu_points[i][0]), 16);
+        fp_read_str(e->y, sswu_points[i][1], (int)strlen(sswu_points[i][1]), 16);
+        fp_set_dig(e->z, 1);
+        e->norm = 1;
+
+        TEST_ASSERT_EQUAL_INT(g1_cmp(p, e), CMP_EQ);
+        TEST_ASSERT_NOT_EQUAL(g1_is_member(p), 0);
+    }
+
+    g1_free(e);
+    g1_free(p);
+
+    pythia_deinit();
+
+    // Switching map changes transformed passwords, but they stay stable within the mode
+    gt_t legacy; gt_new(legacy);
+    gt_t sswu1; gt_new(sswu1);
+    gt_t sswu2; gt_new(sswu2);
+
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_LEGACY);
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    blind_eval_deblind(legacy);
+    pythia_deinit();
+
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_SSWU);
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    blind_eval_deblind(sswu1);
+    blind_eval_deblind(sswu2);
+
+    TEST_ASSERT_EQUAL_INT(gt_cmp(sswu1, sswu2), CMP_EQ);
+    TEST_ASSERT_NOT_EQUAL(gt_cmp(legacy, sswu1), CMP_EQ);
+
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_LEGACY);
+
+    gt_free(sswu2);
+    gt_free(sswu1);
+    gt_free(legacy);
+
+    pythia_deinit();
+}
+
+// Test vectors of BLS12381G2_XMD:SHA-256_SSWU_RO_ suite, RFC 9380 appendix J.10.1, as x0, x1, y0, y1
+static const char *sswu2_points[2][4] = {
+        { "0141EBFBDCA40EB85B87142E130AB689C673CF60F1A3E98D69335266F30D9B8D4AC44C1038E9DCDD5393FAF5C41FB78A",
+          "05CB8437535E20ECFFAEF7752BADDF98034139C38452458BAEEFAB379BA13DFF5BF5DD71B72418717047F5B0F37DA03D",
+          "0503921D7F6A12805E72940B963C0CF3471C7B2A524950CA195D11062EE75EC076DAF2D4BC358C4B190C0C98064FDD92",
+          "12424AC32561493F3FE3C260708A12B7C620E7BE00099A974E259DDC7D1F6395C3C811CDD19F1E8DBF3E9ECFDCBAB8D6" },
+        { "02C2D18E033B960562AAE3CAB37A27CE00D80CCD5BA4B7FE0E7A210245129DBEC7780CCC7954725F4168AFF2787776E6",
+          "139CDDBCCDC5E91B9623EFD38C49F81A6F83F175E80B06FC374DE9EB4B41DFE4CA3A230ED250FBE3A2ACF73A41177FD8",
+          "1787327B68159716A37440985269CF584BCB1E621D3A7202BE6EA05C4CFE244AEB197642555A0645FB87BF7466B2BA48",
+          "00AA65DAE3C8D732D10ECD2C50F8A1BAF3001578F71C694E03866E9F3D49AC1E1CE70DD94A733534F106D4CEC0EDDD16" }
+};
+
+void test11_HashG2Sswu() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const char *dst = "QUUX-V01-CS02-with-BLS12381G2_XMD:SHA-256_SSWU_RO_";
+    g2_t p; g2_new(p);
+    g2_t e; g2_new(e);
+
+    for (int i = 0; i < 2; i++) {
+        g2_map_sswu(p, (const uint8_t *)sswu_msgs[i], strlen(sswu_msgs[i]), (const uint8_t *)dst, strlen(dst));
+
+        fp_read_str(e->x[0], sswu2_points[i][0], (int)strlen(sswu2_points[i][0]), 16);
+        fp_read_str(e->x[1], sswu2_points[i][1], (int)strlen(sswu2_points[i][1]), 16);
+        fp_read_str(e->y[0], sswu2_points[i][2], (int)strlen(sswu2_points[i][2]), 16);
+        fp_read_str(e->y[1], sswu2_points[i][3], (int)strlen(sswu2_points[i][3]), 16);
+        fp_set_dig(e->z[0], 1);
+        fp_zero(e->z[1]);
+        e->norm = 1;
+
+        TEST_ASSERT_EQUAL_INT(g2_cmp(p, e), CMP_EQ);
+        TEST_ASSERT_NOT_EQUAL(g2_is_member(p), 0);
+    }
+
+    g2_free(e);
+    g2_free(p);
+
+    pythia_deinit();
+
+    gt_t legacy; gt_new(legacy);
+    gt_t sswu1; gt_new(sswu1);
+    gt_t sswu2; gt_new(sswu2);
+
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_LEGACY);
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    blind_eval_deblind(legacy);
+    pythia_deinit();
+
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_SSWU);
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+    blind_eval_deblind(sswu1);
+    blind_eval_deblind(sswu2);
+
+    TEST_ASSERT_EQUAL_INT(gt_cmp(sswu1, sswu2), CMP_EQ);
+    TEST_ASSERT_NOT_EQUAL(gt_cmp(legacy, sswu1), CMP_EQ);
+
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_LEGACY);
+
+    gt_free(sswu2);
+    gt_free(sswu1);
+    gt_free(legacy);
+
+    pythia_deinit();
+}
+
+void test12_HashSswuBatch() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const size_t n = 5;
+    const uint8_t *msgs[5] = { (const uint8_t *)"", (const uint8_t *)"abc", (const uint8_t *)"password",
+                               (const uint8_t *)"alice", (const uint8_t *)"abc" };
+    const size_t sizes[5] = { 0, 3, 8, 5, 3 };
+    const uint8_t *dst = (const uint8_t *)PYTHIA_HASH_G1_DST;
+    const uint8_t *dst2 = (const uint8_t *)PYTHIA_HASH_G2_DST;
+
+    g1_t p1[5];
+    g2_t p2[5];
+    g1_t e1; g1_new(e1);
+    g2_t e2; g2_new(e2);
+
+    for (size_t i = 0; i < n; i++) {
+        g1_new(p1[i]);
+        g2_new(p2[i]);
+    }
+
+    g1_map_sswu_batch(p1, msgs, sizes, n, dst, sizeof(PYTHIA_HASH_G1_DST) - 1);
+    g2_map_sswu_batch(p2, msgs, sizes, n, dst2, sizeof(PYTHIA_HASH_G2_DST) - 1);
+
+    for (size_t i = 0; i < n; i++) {
+        g1_map_sswu(e1, msgs[i], sizes[i], dst, sizeof(PYTHIA_HASH_G1_DST) - 1);
+        g2_map_sswu(e2, msgs[i], sizes[i], dst2, sizeof(PYTHIA_HASH_G2_DST) - 1);
+
+        TEST_ASSERT_EQUAL_INT(g1_cmp(p1[i], e1), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(g2_cmp(p2[i], e2), CMP_EQ);
+    }
+
+    TEST_ASSERT_EQUAL_INT(g1_cmp(p1[1], p1[4]), CMP_EQ);
+    TEST_ASSERT_NOT_EQUAL(g1_cmp(p1[0], p1[1]), CMP_EQ);
+
+    for (size_t i = 0; i < n; i++) {
+        g2_free(p2[i]);
+        g1_free(p1[i]);
+    }
+
+    g2_free(e2);
+    g1_free(e1);
+
+    pythia_deinit();
+}
+
+void test13_MdBatch() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    // Sizes around block boundaries, where padding takes one or two blocks
+    const size_t sizes[11] = { 0, 3, 111, 112, 127, 128, 129, 240, 256, 300, 1000 };
+    const size_t n = 11;
+    const size_t key_sizes[3] = { 13, 128, 200 };
+    const size_t lanes[3] = { 1, 4, 8 };
+
+    uint8_t buf[1000], key[200];
+    const uint8_t *in[11];
+    uint8_t digest[11][MD_LEN_SH384], expected[MD_LEN_SH384];
+
+    for (size_t i = 0; i < sizeof(buf); i++)
+        buf[i] = (uint8_t)(i * 7 + 1);
+    for (size_t i = 0; i < sizeof(key); i++)
+        key[i] = (uint8_t)(i * 3 + 5);
+    for (size_t i = 0; i < n; i++)
+        in[i] = buf + i;
+
+    for (size_t l = 0; l < 3; l++) {
+        md_batch_set_max_lanes(lanes[l]);
+        TEST_ASSERT_TRUE(md_batch_lanes() <= lanes[l]);
+
+        md_map_sh384_batch(digest, in, sizes, n);
+        for (size_t i = 0; i < n; i++) {
+            md_map_sh384(expected, in[i], (int)sizes[i]);
+            TEST_ASSERT_EQUAL_MEMORY(expected, digest[i], MD_LEN_SH384);
+        }
+
+        for (size_t k = 0; k < 3; k++) {
+            md_hmac_sh384_batch(digest, in, sizes, n, key, key_sizes[k]);
+            for (size_t i = 0; i < n; i++) {
+                md_hmac(expected, in[i], (int)sizes[i], key, (int)key_sizes[k]);
+                TEST_ASSERT_EQUAL_MEMORY(expected, digest[i], MD_LEN_SH384);
+            }
+        }
+    }
+
+    md_batch_set_max_lanes(PYTHIA_MD_MAX_LANES);
+
+    pythia_deinit();
+}
+
+void test14_KeyPairVerifyBatch() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const size_t n = 5;
+    const uint8_t *ids[5] = { (const uint8_t *)"virgil.com", (const uint8_t *)"a", (const uint8_t *)"b.example",
+                              (const uint8_t *)"tenant-4", (const uint8_t *)"virgil.com" };
+    const size_t id_sizes[5] = { 10, 1, 9, 8, 10 };
+    const uint8_t *tweaks[5] = { t, (const uint8_t *)"bob", (const uint8_t *)"carol", t, (const uint8_t *)"dave" };
+    const size_t tweak_sizes[5] = { 5, 3, 5, 5, 4 };
+
+    bn_t kw[5], kw1, rInv, c[5], u[5];
+    g1_t pi_p[5], pi_p1, blinded[5];
+    gt_t y[5];
+    g2_t tTilde;
+    int verified[5];
+
+    bn_null(kw1); bn_null(rInv);
+    g1_null(pi_p1);
+    g2_null(tTilde);
+
+    bn_new(kw1); bn_new(rInv);
+    g1_new(pi_p1);
+    g2_new(tTilde);
+
+    for (size_t i = 0; i < n; i++) {
+        bn_null(kw[i]); bn_null(c[i]); bn_null(u[i]);
+        g1_null(pi_p[i]); g1_null(blinded[i]);
+        gt_null(y[i]);
+
+        bn_new(kw[i]); bn_new(c[i]); bn_new(u[i]);
+        g1_new(pi_p[i]); g1_new(blinded[i]);
+        gt_new(y[i]);
+    }
+
+    pythia_compute_kw_batch(ids, id_sizes, n, msk, 13, ssk, 13, kw, pi_p);
+
+    for (size_t i = 0; i < n; i++) {
+        pythia_compute_kw(ids[i], id_sizes[i], msk, 13, ssk, 13, kw1, pi_p1);
+
+        TEST_ASSERT_EQUAL_INT(bn_cmp(kw[i], kw1), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(g1_cmp(pi_p[i], pi_p1), CMP_EQ);
+    }
+
+    // Transformations with the first key, proofs of the last one are spoiled
+    for (size_t i = 0; i < n; i++) {
+        pythia_blind(password, 8, blinded[i], rInv);
+        pythia_eval(blinded[i], tweaks[i], tweak_sizes[i], kw[0], y[i], tTilde);
+        pythia_prove(y[i], blinded[i], tTilde, kw[0], pi_p[0], c[i], u[i]);
+    }
+
+    bn_add_dig(u[n - 1], u[n - 1], 1);
+
+    pythia_verify_batch(y, blinded, tweaks, tweak_sizes, n, pi_p[0], c, u, verified);
+
+    for (size_t i = 0; i < n; i++) {
+        int expected = 0;
+        pythia_verify(y[i], blinded[i], tweaks[i], tweak_sizes[i], pi_p[0], c[i], u[i], &expected);
+
+        TEST_ASSERT_EQUAL_INT(expected != 0, verified[i] != 0);
+        TEST_ASSERT_EQUAL_INT(i != n - 1, verified[i] != 0);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        gt_free(y[i]);
+        g1_free(blinded[i]); g1_free(pi_p[i]);
+        bn_free(u[i]); bn_free(c[i]); bn_free(kw[i]);
+    }
+
+    g2_free(tTilde);
+    g1_free(pi_p1);
+    bn_free(rInv); bn_free(kw1);
+
+    pythia_deinit();
+}
+
+void test15_BatchGtExp() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    // 11 elements make one full group of lanes and one partial group
+    const size_t n = 11;
+    const uint8_t tweaks[11][2] = { "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k" };
+
+    fp_t a[11], b[11], c[11], d;
+    gt_t y[11], z[11], expected;
+    bn_t e[11], k, rInv;
+    g1_t blinded;
+    g2_t tTilde;
+
+    fp_null(d); gt_null(expected); bn_null(k); bn_null(rInv); g1_null(blinded); g2_null(tTilde);
+    fp_new(d); gt_new(expected); bn_new(k); bn_new(rInv); g1_new(blinded); g2_new(tTilde);
+
+    pythia_blind(password, 8, blinded, rInv);
+    bn_rand(k, BN_POS, 255);
+
+    for (size_t i = 0; i < n; i++) {
+        fp_null(a[i]); fp_null(b[i]); fp_null(c[i]);
+        gt_null(y[i]); gt_null(z[i]);
+        bn_null(e[i]);
+
+        fp_new(a[i]); fp_new(b[i]); fp_new(c[i]);
+        gt_new(y[i]); gt_new(z[i]);
+        bn_new(e[i]);
+
+        bn_rand(e[i], BN_POS, 380);
+        fp_prime_conv(a[i], e[i]);
+        bn_rand(e[i], BN_POS, 380);
+        fp_prime_conv(b[i], e[i]);
+
+        pythia_eval(blinded, tweaks[i], 1, k, y[i], tTilde);
+        bn_rand(e[i], BN_POS, 255);
+    }
+
+    // Edge exponents
+    bn_zero(e[0]);
+    bn_set_dig(e[1], 1);
+    bn_set_dig(e[2], 16);
+
+    for (int enabled = 1; enabled >= 0; enabled--) {
+        fp8_set_enabled(enabled);
+
+        fp_mul_batch(c, a, b, n);
+        for (size_t i = 0; i < n; i++) {
+            fp_mul(d, a[i], b[i]);
+            TEST_ASSERT_EQUAL_INT(fp_cmp(c[i], d), CMP_EQ);
+        }
+
+        gt_exp_batch(z, y, e, n);
+        for (size_t i = 0; i < n; i++) {
+            gt_exp(expected, y[i], e[i]);
+            TEST_ASSERT_EQUAL_INT(gt_cmp(z[i], expected), CMP_EQ);
+        }
+
+        pythia_update_with_delta_batch(y, k, n, z);
+        for (size_t i = 0; i < n; i++) {
+            pythia_update_with_delta(y[i], k, expected);
+            TEST_ASSERT_EQUAL_INT(gt_cmp(z[i], expected), CMP_EQ);
+        }
+    }
+
+    // Element outside of the cyclotomic subgroup must not go through cyclotomic squarings
+    fp8_set_enabled(1);
+    fp_add_dig(y[n - 1][0][0][0], y[n - 1][0][0][0], 1);
+
+    gt_exp_batch(z, y, e, n);
+    for (size_t i = 0; i < n; i++) {
+        gt_exp(expected, y[i], e[i]);
+        TEST_ASSERT_EQUAL_INT(gt_cmp(z[i], expected), CMP_EQ);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        bn_free(e[i]);
+        gt_free(z[i]); gt_free(y[i]);
+        fp_free(c[i]); fp_free(b[i]); fp_free(a[i]);
+    }
+
+    g2_free(tTilde); g1_free(blinded); bn_free(rInv); bn_free(k); gt_free(expected); fp_free(d);
+
+    pythia_deinit();
+}
+
+void test16_FpAsm() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const int count = 200;
+    const int asm_enabled = fp_asm_enabled();
+
+    // Generated field code takes precedence over the assembly backend, so it is off here
+    const int gen_enabled = fp_gen_enabled();
+    fp_gen_set_enabled(0);
+
+    fp_t a, b, c, d;
+    bn_t e, k, rInv;
+    g1_t blinded;
+    g2_t tTilde;
+    gt_t y, expected;
+
+    fp_null(a); fp_null(b); fp_null(c); fp_null(d); bn_null(e); bn_null(k); bn_null(rInv);
+    g1_null(blinded); g2_null(tTilde); gt_null(y); gt_null(expected);
+    fp_new(a); fp_new(b); fp_new(c); fp_new(d); bn_new(e); bn_new(k); bn_new(rInv);
+    g1_new(blinded); g2_new(tTilde); gt_new(y); gt_new(expected);
+
+    // Entry points must be bound to the backend, not only give the same results
+    TEST_ASSERT_EQUAL_INT(asm_enabled ? PYTHIA_FP_BACKEND_ASM : PYTHIA_FP_BACKEND_RELIC, fp_backend());
+    fp_asm_set_enabled(0);
+    TEST_ASSERT_EQUAL_INT(PYTHIA_FP_BACKEND_RELIC, fp_backend());
+    fp_asm_set_enabled(asm_enabled);
+    TEST_ASSERT_EQUAL_INT(asm_enabled ? PYTHIA_FP_BACKEND_ASM : PYTHIA_FP_BACKEND_RELIC, fp_backend());
+
+    for (int i = 0; i < count; i++) {
+        if (i == 0) {
+            // p - 1 is the largest reduced element
+            fp_zero(a);
+            fp_sub_dig(a, a, 1);
+            fp_copy(b, a);
+        } else {
+            fp_rand(a);
+            fp_rand(b);
+        }
+
+        fp_mul(c, a, b);
+        fp_sqr(d, a);
+
+        // Outputs alias inputs as relic allows
+        pythia_fp_mul(b, a, b);
+        pythia_fp_sqr(a, a);
+
+        TEST_ASSERT_EQUAL_INT(fp_cmp(b, c), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(fp_cmp(a, d), CMP_EQ);
+    }
+
+    bn_rand(e, BN_POS, 381);
+    fp_exp(c, a, e);
+    pythia_fp_exp(d, a, e);
+    TEST_ASSERT_EQUAL_INT(fp_cmp(c, d), CMP_EQ);
+
+    // Whole protocol step, hash to curve maps run on the entry points
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_SSWU);
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_SSWU);
+
+    pythia_blind(password, 8, blinded, rInv);
+    bn_rand(k, BN_POS, 255);
+
+    fp_asm_set_enabled(0);
+    pythia_eval(blinded, t, 5, k, expected, tTilde);
+
+    fp_asm_set_enabled(asm_enabled);
+    pythia_eval(blinded, t, 5, k, y, tTilde);
+
+    TEST_ASSERT_EQUAL_INT(gt_cmp(y, expected), CMP_EQ);
+
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_LEGACY);
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_LEGACY);
+    fp_gen_set_enabled(gen_enabled);
+
+    gt_free(expected); gt_free(y); g2_free(tTilde); g1_free(blinded);
+    bn_free(rInv); bn_free(k); bn_free(e); fp_free(d); fp_free(c); fp_free(b); fp_free(a);
+
+    pythia_deinit();
+}
+
+// Scalar, compressed G1 point and compressed GT element for each of 3 key ids
+#define DISPATCH_OUT_SIZE (3 * (FP_BYTES + (FP_BYTES + 1) + 8 * FP_BYTES))
+
+/*
+ * Computes key pairs and batch GT exponentiations whose results don't depend on randomness,
+ * so that runs with different kernels can be compared byte by byte.
+ */
+static void dispatch_outputs(uint8_t *out) {
+    const uint8_t *ids[3] = { w, t, password };
+    const size_t ids_sizes[3] = { 10, 5, 8 };
+    const size_t n = 3;
+
+    bn_t kw[3], e[3];
+    g1_t pi_p[3];
+    gt_t y[3], z[3];
+    size_t len = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        bn_null(kw[i]); bn_null(e[i]); g1_null(pi_p[i]); gt_null(y[i]); gt_null(z[i]);
+        bn_new(kw[i]); bn_new(e[i]); g1_new(pi_p[i]); gt_new(y[i]); gt_new(z[i]);
+    }
+
+    pythia_compute_kw_batch(ids, ids_sizes, n, msk, 13, ssk, 13, kw, pi_p);
+
+    for (size_t i = 0; i < n; i++) {
+        gt_get_gen(y[i]);
+        bn_copy(e[i], kw[i]);
+    }
+    gt_exp_batch(z, y, e, n);
+
+    for (size_t i = 0; i < n; i++) {
+        bn_write_bin(out + len, FP_BYTES, kw[i]);
+        len += FP_BYTES;
+        g1_write_bin(out + len, FP_BYTES + 1, pi_p[i], 1);
+        len += FP_BYTES + 1;
+        gt_write_bin(out + len, 8 * FP_BYTES, z[i], 1);
+        len += 8 * FP_BYTES;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        gt_free(z[i]); gt_free(y[i]); g1_free(pi_p[i]); bn_free(e[i]); bn_free(kw[i]);
+    }
+}
+
+void test17_CpuDispatch() {
+    uint8_t portable[DISPATCH_OUT_SIZE], dispatched[DISPATCH_OUT_SIZE];
+
+    // Portable kernels only
+    pythia_set_cpu_features_mask(0);
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    TEST_ASSERT_EQUAL_INT(0, pythia_get_cpu_features());
+    TEST_ASSERT_EQUAL_INT(1, md_batch_lanes());
+    TEST_ASSERT_EQUAL_INT(0, fp8_enabled());
+    TEST_ASSERT_EQUAL_INT(0, fp_asm_enabled());
+
+    dispatch_outputs(portable);
+    pythia_deinit();
+
+    // Fastest kernels the CPU supports
+    pythia_set_cpu_features_mask(PYTHIA_CPU_ALL);
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    unsigned int features = pythia_get_cpu_features();
+    if (features & PYTHIA_CPU_AVX512F)
+        TEST_ASSERT_EQUAL_INT(8, md_batch_lanes());
+    else if (features & PYTHIA_CPU_AVX2)
+        TEST_ASSERT_EQUAL_INT(4, md_batch_lanes());
+    if (!(features & PYTHIA_CPU_AVX512IFMA))
+        TEST_ASSERT_EQUAL_INT(0, fp8_enabled());
+    if (!(features & PYTHIA_CPU_BMI2_ADX))
+        TEST_ASSERT_EQUAL_INT(0, fp_asm_enabled());
+
+    dispatch_outputs(dispatched);
+    pythia_deinit();
+
+    TEST_ASSERT_EQUAL_MEMORY(portable, dispatched, sizeof(portable));
+}
+
+void test18_FpGen() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const int count = 200;
+    const int gen_enabled = fp_gen_enabled();
+
+    fp_t a, b, c, e;
+    fp2_t x, y, z, u;
+    bn_t k, rInv;
+    g1_t blinded;
+    g2_t tTilde;
+    gt_t r, expected;
+
+    fp_null(a); fp_null(b); fp_null(c); fp_null(e);
+    fp2_null(x); fp2_null(y); fp2_null(z); fp2_null(u); bn_null(k); bn_null(rInv);
+    g1_null(blinded); g2_null(tTilde); gt_null(r); gt_null(expected);
+    fp_new(a); fp_new(b); fp_new(c); fp_new(e);
+    fp2_new(x); fp2_new(y); fp2_new(z); fp2_new(u); bn_new(k); bn_new(rInv);
+    g1_new(blinded); g2_new(tTilde); gt_new(r); gt_new(expected);
+
+    // Entry points must be bound to generated code, relic's functions are never replaced
+    if (gen_enabled)
+        TEST_ASSERT_EQUAL_INT(PYTHIA_FP_BACKEND_GEN, fp_backend());
+    fp_gen_set_enabled(0);
+    TEST_ASSERT_NOT_EQUAL(PYTHIA_FP_BACKEND_GEN, fp_backend());
+    fp_gen_set_enabled(gen_enabled);
+
+    for (int i = 0; i < count; i++) {
+        if (i == 0) {
+            // p - 1 is the largest reduced element
+            fp_zero(a);
+            fp_sub_dig(a, a, 1);
+            fp_copy(b, a);
+        } else {
+            fp_rand(a);
+            fp_rand(b);
+        }
+        fp2_rand(x);
+        fp2_rand(y);
+
+        fp_mul(c, a, b);
+        fp_inv(e, b);
+        fp2_mul(z, x, y);
+        fp2_sqr(u, x);
+
+        // Outputs alias inputs as relic allows
+        pythia_fp_mul(a, a, b);
+        pythia_fp_inv(b, b);
+        pythia_fp2_mul(y, x, y);
+        pythia_fp2_sqr(x, x);
+
+        TEST_ASSERT_EQUAL_INT(fp_cmp(a, c), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(fp_cmp(b, e), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(fp2_cmp(y, z), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(fp2_cmp(x, u), CMP_EQ);
+
+        fp_sqr(c, a);
+        pythia_fp_sqr(a, a);
+        TEST_ASSERT_EQUAL_INT(fp_cmp(a, c), CMP_EQ);
+    }
+
+    // Inversion maps zero to zero with and without generated code
+    for (int on = 0; on < 2; on++) {
+        fp_gen_set_enabled(on && gen_enabled);
+        fp_zero(a);
+        fp_set_dig(b, 1);
+        pythia_fp_inv(b, a);
+        TEST_ASSERT_TRUE(fp_is_zero(b));
+    }
+    fp_gen_set_enabled(gen_enabled);
+
+    // Whole protocol step, hash to curve maps run on the entry points
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_SSWU);
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_SSWU);
+
+    pythia_blind(password, 8, blinded, rInv);
+    bn_rand(k, BN_POS, 255);
+
+    fp_gen_set_enabled(0);
+    pythia_eval(blinded, t, 5, k, expected, tTilde);
+
+    fp_gen_set_enabled(gen_enabled);
+    pythia_eval(blinded, t, 5, k, r, tTilde);
+
+    TEST_ASSERT_EQUAL_INT(gt_cmp(r, expected), CMP_EQ);
+
+    pythia_set_hash_g1(PYTHIA_HASH_MODE_LEGACY);
+    pythia_set_hash_g2(PYTHIA_HASH_MODE_LEGACY);
+
+    gt_free(expected); gt_free(r); g2_free(tTilde); g1_free(blinded); bn_free(rInv); bn_free(k);
+    fp2_free(u); fp2_free(z); fp2_free(y); fp2_free(x);
+    fp_free(e); fp_free(c); fp_free(b); fp_free(a);
+
+    pythia_deinit();
+}
+
+void test19_FinalExp() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    // A full group of 8 lanes and a partial one
+    const size_t n = 10;
+    const int exp_enabled = pp_exp_enabled();
+
+#if PYTHIA_PP_EXP && FP_PRIME == 381
+    // Self-check of pp_exp_init must pass with relic's BLS12-381, otherwise pairings silently run on relic
+    if (fp_param_get() == B12_P381) {
+        TEST_ASSERT_EQUAL_INT(1, exp_enabled);
+        TEST_ASSERT_EQUAL_INT(fp8_enabled(), pp_mil_lanes_enabled());
+    }
+#endif
+
+    g1_t p[10];
+    g2_t q[10];
+    gt_t r[10], expected[10], prod;
+
+    for (size_t i = 0; i < n; i++) {
+        g1_null(p[i]); g2_null(q[i]); gt_null(r[i]); gt_null(expected[i]);
+    }
+    gt_null(prod);
+
+    for (size_t i = 0; i < n; i++) {
+        g1_new(p[i]); g2_new(q[i]); gt_new(r[i]); gt_new(expected[i]);
+        g1_rand(p[i]);
+        g2_rand(q[i]);
+    }
+    gt_new(prod);
+
+    // Pairing with a point at infinity is unity
+    g1_set_infty(p[n - 1]);
+
+    pp_exp_set_enabled(0);
+    for (size_t i = 0; i < n; i++)
+        pc_map(expected[i], p[i], q[i]);
+
+    pp_exp_set_enabled(exp_enabled);
+    for (size_t i = 0; i < n; i++) {
+        pp_map_bls12(r[i], p[i], q[i]);
+        TEST_ASSERT_EQUAL_INT(gt_cmp(r[i], expected[i]), CMP_EQ);
+        gt_set_unity(r[i]);
+    }
+    TEST_ASSERT_TRUE(gt_is_unity(expected[n - 1]));
+
+    // Miller loops of the batch run on IFMA lanes, if there are any, and one by one
+    for (int lanes = 1; lanes >= 0; lanes--) {
+        fp8_set_enabled(lanes);
+        pc_map_batch(r, p, q, n);
+        for (size_t i = 0; i < n; i++) {
+            TEST_ASSERT_EQUAL_INT(gt_cmp(r[i], expected[i]), CMP_EQ);
+            gt_set_unity(r[i]);
+        }
+    }
+    fp8_set_enabled(1);
+
+    // Product of pairings shares the Miller loop and the final exponentiation
+    pp_map_sim_bls12(prod, p, q, n);
+    for (size_t i = 1; i < n; i++)
+        gt_mul(expected[0], expected[0], expected[i]);
+    TEST_ASSERT_EQUAL_INT(gt_cmp(prod, expected[0]), CMP_EQ);
+
+    pc_map_sim(expected[1], p, q, (int)n);
+    TEST_ASSERT_EQUAL_INT(gt_cmp(prod, expected[1]), CMP_EQ);
+
+    for (size_t i = 0; i < n; i++) {
+        gt_free(expected[i]); gt_free(r[i]); g2_free(q[i]); g1_free(p[i]);
+    }
+    gt_free(prod);
+
+    pythia_deinit();
+}
+
+void test20_GlvGls() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    const int count = 20;
+
+    bn_t k, ord;
+    g1_t p, r1, e1;
+    g2_t q, r2, e2;
+
+    bn_null(k); bn_null(ord); g1_null(p); g1_null(r1); g1_null(e1); g2_null(q); g2_null(r2); g2_null(e2);
+    bn_new(k); bn_new(ord); g1_new(p); g1_new(r1); g1_new(e1); g2_new(q); g2_new(r2); g2_new(e2);
+
+    g1_get_ord(ord);
+
+    for (int i = 0; i < count; i++) {
+        g1_rand(p);
+        g2_rand(q);
+
+        // Edge scalars first, then unreduced and random ones
+        switch (i) {
+            case 0: bn_zero(k); break;
+            case 1: bn_set_dig(k, 1); break;
+            case 2: bn_sub_dig(k, ord, 1); break;
+            case 3: bn_add_dig(k, ord, 5); break;
+            default: bn_rand_mod(k, ord); break;
+        }
+
+        g1_mul_glv(r1, p, k);
+        g2_mul_gls(r2, q, k);
+
+        bn_mod(k, k, ord);
+        g1_mul(e1, p, k);
+        g2_mul(e2, q, k);
+
+        TEST_ASSERT_EQUAL_INT(g1_cmp(r1, e1), CMP_EQ);
+        TEST_ASSERT_EQUAL_INT(g2_cmp(r2, e2), CMP_EQ);
+    }
+
+    // Point at infinity
+    g1_set_infty(p);
+    g2_set_infty(q);
+    g1_mul_glv(r1, p, k);
+    g2_mul_gls(r2, q, k);
+    TEST_ASSERT_TRUE(g1_is_infty(r1));
+    TEST_ASSERT_TRUE(g2_is_infty(r2));
+
+    g2_free(e2); g2_free(r2); g2_free(q); g1_free(e1); g1_free(r1); g1_free(p); bn_free(ord); bn_free(k);
+
+    pythia_deinit();
+}
+
 int main() {
     UNITY_BEGIN();
 
@@ -228,6 +1342,23 @@ int main() {
     RUN_TEST(test1_DeblindStability);
     RUN_TEST(test2_BlindEvalProveVerify);
     RUN_TEST(test3_UpdateDelta);
+    RUN_TEST(test4_PreparedExp);
+    RUN_TEST(test5_EvalPrepared);
+    RUN_TEST(test6_BatchInversion);
+    RUN_TEST(test7_GtMembership);
+    RUN_TEST(test8_PointMembership);
+    RUN_TEST(test9_ScalarArithmetic);
+    RUN_TEST(test10_HashG1Sswu);
+    RUN_TEST(test11_HashG2Sswu);
+    RUN_TEST(test12_HashSswuBatch);
+    RUN_TEST(test13_MdBatch);
+    RUN_TEST(test14_KeyPairVerifyBatch);
+    RUN_TEST(test15_BatchGtExp);
+    RUN_TEST(test16_FpAsm);
+    RUN_TEST(test17_CpuDispatch);
+    RUN_TEST(test18_FpGen);
+    RUN_TEST(test19_FinalExp);
+    RUN_TEST(test20_GlvGls);
 
     return UNITY_END();
 }
@@ -356,6 +356,902 @@ void test4_BlindHugePassword() {
     pythia_deinit();
 }
 
+void test5_UpdateWithPreparedToken() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    pythia_buf_t transformation_private_key, new_transformation_private_key, transformation_public_key,
+            password_update_token, transformation_key_id_buf, pythia_secret_buf, new_pythia_secret_buf,
+            pythia_scope_secret_buf, deblinded_password, updated_deblinded_password, prepared_deblinded_password;
+
+    transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    new_transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    new_transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformation_public_key.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    transformation_public_key.allocated = PYTHIA_G1_BUF_SIZE;
+
+    password_update_token.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    password_update_token.allocated = PYTHIA_BN_BUF_SIZE;
+
+    deblinded_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    deblinded_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    updated_deblinded_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    updated_deblinded_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    prepared_deblinded_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    prepared_deblinded_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_key_id_buf.p = (uint8_t *)w;
+    transformation_key_id_buf.len = 10;
+
+    pythia_secret_buf.p = (uint8_t *)msk;
+    pythia_secret_buf.len = 13;
+
+    new_pythia_secret_buf.p = (uint8_t *)msk1;
+    new_pythia_secret_buf.len = 13;
+
+    pythia_scope_secret_buf.p = (uint8_t *)ssk;
+    pythia_scope_secret_buf.len = 13;
+
+    blind_eval_deblind(&deblinded_password);
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &new_pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &new_transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_get_password_update_token(&transformation_private_key, &new_transformation_private_key,
+                                           &password_update_token))
+        TEST_FAIL();
+
+    if (pythia_w_update_deblinded_with_token(&deblinded_password, &password_update_token, &updated_deblinded_password))
+        TEST_FAIL();
+
+    pythia_prepared_exp_t *prepared_token = NULL;
+    if (pythia_w_prepare_exp(&password_update_token, &prepared_token))
+        TEST_FAIL();
+
+    if (pythia_w_update_deblinded_with_prepared_token(&deblinded_password, prepared_token,
+                                                      &prepared_deblinded_password))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(updated_deblinded_password.len, prepared_deblinded_password.len);
+    TEST_ASSERT_EQUAL_MEMORY(updated_deblinded_password.p, prepared_deblinded_password.p,
+                             updated_deblinded_password.len);
+
+    pythia_w_prepared_exp_free(prepared_token);
+
+    free(prepared_deblinded_password.p);
+    free(updated_deblinded_password.p);
+    free(deblinded_password.p);
+    free(password_update_token.p);
+    free(transformation_public_key.p);
+    free(new_transformation_private_key.p);
+    free(transformation_private_key.p);
+
+    pythia_deinit();
+}
+
+void test6_BlindPooled() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    uint8_t deblinded_bin[384];
+    const char *pos = deblinded_hex;
+    for (size_t count = 0; count < 384; count++) {
+        sscanf(pos, "%2hhx", &deblinded_bin[count]);
+        pos += 2;
+    }
+
+    pythia_buf_t blinded_password, blinding_secret, transformed_password,
+            transformation_private_key, transformation_public_key, transformed_tweak,
+            transformation_key_id_buf, tweak_buf, pythia_secret_buf,
+            pythia_scope_secret_buf, password_buf, deblinded_password;
+
+    blinded_password.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    blinded_password.allocated = PYTHIA_G1_BUF_SIZE;
+
+    blinding_secret.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    blinding_secret.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformed_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    transformed_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformation_public_key.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    transformation_public_key.allocated = PYTHIA_G1_BUF_SIZE;
+
+    transformed_tweak.p = (uint8_t *)malloc(PYTHIA_G2_BUF_SIZE);
+    transformed_tweak.allocated = PYTHIA_G2_BUF_SIZE;
+
+    deblinded_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    deblinded_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_key_id_buf.p = (uint8_t *)w;
+    transformation_key_id_buf.len = 10;
+
+    tweak_buf.p = (uint8_t *)t;
+    tweak_buf.len = 5;
+
+    pythia_secret_buf.p = (uint8_t *)msk;
+    pythia_secret_buf.len = 13;
+
+    pythia_scope_secret_buf.p = (uint8_t *)ssk;
+    pythia_scope_secret_buf.len = 13;
+
+    password_buf.p = (uint8_t *)password;
+    password_buf.len = 8;
+
+    pythia_blind_pool_t *pool = NULL;
+    if (pythia_w_blind_pool_new(4, &pool))
+        TEST_FAIL();
+
+    if (pythia_w_blind_pool_fill(pool, 10))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(4, pythia_w_blind_pool_size(pool));
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+#if RELIC_USE_PTHREAD
+    if (pythia_w_blind_pool_start(pool))
+        TEST_FAIL();
+#endif // RELIC_USE_PTHREAD
+
+    // More blinds than pool capacity, so that pooled and freshly generated factors are both used
+    for (int i = 0; i < 6; i++) {
+        if (pythia_w_blind_pooled(pool, &password_buf, &blinded_password, &blinding_secret))
+            TEST_FAIL();
+
+        if (pythia_w_transform(&blinded_password, &tweak_buf, &transformation_private_key, &transformed_password,
+                               &transformed_tweak))
+            TEST_FAIL();
+
+        if (pythia_w_deblind(&transformed_password, &blinding_secret, &deblinded_password))
+            TEST_FAIL();
+
+        TEST_ASSERT_EQUAL_MEMORY(deblinded_bin, deblinded_password.p, 384);
+    }
+
+#if RELIC_USE_PTHREAD
+    TEST_ASSERT_EQUAL_INT(0, pythia_w_blind_pool_failures(pool));
+#endif // RELIC_USE_PTHREAD
+
+    pythia_w_blind_pool_free(pool);
+
+    free(deblinded_password.p);
+    free(transformed_tweak.p);
+    free(transformation_public_key.p);
+    free(transformation_private_key.p);
+    free(transformed_password.p);
+    free(blinding_secret.p);
+    free(blinded_password.p);
+
+    pythia_deinit();
+}
+
+void test7_ProvePooled() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    pythia_buf_t blinded_password, blinding_secret, transformed_password,
+            transformation_private_key, transformed_tweak,
+            transformation_public_key, proof_value_c, proof_value_u,
+            transformation_key_id_buf, tweak_buf, pythia_secret_buf,
+            pythia_scope_secret_buf, password_buf;
+
+    blinded_password.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    blinded_password.allocated = PYTHIA_G1_BUF_SIZE;
+
+    blinding_secret.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    blinding_secret.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformed_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    transformed_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformed_tweak.p = (uint8_t *)malloc(PYTHIA_G2_BUF_SIZE);
+    transformed_tweak.allocated = PYTHIA_G2_BUF_SIZE;
+
+    transformation_public_key.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    transformation_public_key.allocated = PYTHIA_G1_BUF_SIZE;
+
+    proof_value_c.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    proof_value_c.allocated = PYTHIA_BN_BUF_SIZE;
+
+    proof_value_u.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    proof_value_u.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformation_key_id_buf.p = (uint8_t *)w;
+    transformation_key_id_buf.len = 10;
+
+    tweak_buf.p = (uint8_t *)t;
+    tweak_buf.len = 5;
+
+    pythia_secret_buf.p = (uint8_t *)msk;
+    pythia_secret_buf.len = 13;
+
+    pythia_scope_secret_buf.p = (uint8_t *)ssk;
+    pythia_scope_secret_buf.len = 13;
+
+    password_buf.p = (uint8_t *)password;
+    password_buf.len = 8;
+
+    if (pythia_w_blind(&password_buf, &blinded_password, &blinding_secret))
+        TEST_FAIL();
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_transform(&blinded_password, &tweak_buf, &transformation_private_key, &transformed_password,
+                           &transformed_tweak))
+        TEST_FAIL();
+
+    pythia_nonce_pool_t *pool = NULL;
+    if (pythia_w_nonce_pool_new(2, &pool))
+        TEST_FAIL();
+
+    if (pythia_w_nonce_pool_fill(pool, 2))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(2, pythia_w_nonce_pool_size(pool));
+
+    for (int i = 0; i < 6; i++) {
+#if RELIC_USE_PTHREAD
+        if (i == 3 && pythia_w_nonce_pool_start(pool, 2))
+            TEST_FAIL();
+#endif // RELIC_USE_PTHREAD
+
+        if (pythia_w_prove_pooled(pool, &transformed_password, &blinded_password, &transformed_tweak,
+                                  &transformation_private_key, &transformation_public_key,
+                                  &proof_value_c, &proof_value_u))
+            TEST_FAIL();
+
+        int verified = 0;
+        if (pythia_w_verify(&transformed_password, &blinded_password, &tweak_buf, &transformation_public_key,
+                            &proof_value_c, &proof_value_u, &verified))
+            TEST_FAIL();
+
+        TEST_ASSERT_NOT_EQUAL(0, verified);
+
+        // Two pooled nonces are used first, then the pool is exhausted until refill threads start
+        if (i == 2)
+            TEST_ASSERT_EQUAL_INT(1, pythia_w_nonce_pool_exhausted(pool));
+    }
+
+    pythia_w_nonce_pool_free(pool);
+
+    free(blinded_password.p);
+    free(blinding_secret.p);
+    free(transformed_password.p);
+    free(transformation_private_key.p);
+    free(transformed_tweak.p);
+    free(transformation_public_key.p);
+    free(proof_value_c.p);
+    free(proof_value_u.p);
+
+    pythia_deinit();
+}
+
+void test8_TorusEncoding() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    uint8_t deblinded_bin[384];
+    const char *pos = deblinded_hex;
+    for (size_t count = 0; count < 384; count++) {
+        sscanf(pos, "%2hhx", &deblinded_bin[count]);
+        pos += 2;
+    }
+
+    pythia_buf_t torus_password, deblinded_password, one_buf;
+
+    torus_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    torus_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    deblinded_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    deblinded_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    pythia_w_set_gt_encoding(PYTHIA_GT_ENCODING_TORUS);
+
+    blind_eval_deblind(&torus_password);
+
+    TEST_ASSERT_EQUAL_INT(PYTHIA_GT_TORUS_BUF_SIZE, torus_password.len);
+
+    pythia_w_set_gt_encoding(PYTHIA_GT_ENCODING_DEFAULT);
+
+    // Deblinding with secret 1 re-encodes the value
+    uint8_t one[2] = { 0x00, 0x01 };
+    one_buf.p = one;
+    one_buf.len = 2;
+
+    if (pythia_w_deblind(&torus_password, &one_buf, &deblinded_password))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(PYTHIA_GT_BUF_SIZE, deblinded_password.len);
+    TEST_ASSERT_EQUAL_MEMORY(deblinded_bin, deblinded_password.p, 384);
+
+    // Two Fp2 coordinates of the T6 torus, and encoding is canonical
+    TEST_ASSERT_EQUAL_INT(192, PYTHIA_GT_TORUS_BUF_SIZE);
+
+    pythia_w_set_gt_encoding(PYTHIA_GT_ENCODING_TORUS);
+    if (pythia_w_deblind(&torus_password, &one_buf, &deblinded_password))
+        TEST_FAIL();
+    pythia_w_set_gt_encoding(PYTHIA_GT_ENCODING_DEFAULT);
+
+    TEST_ASSERT_EQUAL_INT(PYTHIA_GT_TORUS_BUF_SIZE, deblinded_password.len);
+    TEST_ASSERT_EQUAL_MEMORY(torus_password.p, deblinded_password.p, PYTHIA_GT_TORUS_BUF_SIZE);
+
+    // Exceptional form is accepted only for coordinates that satisfy the torus equation with m1 = 0
+    torus_password.p[0] ^= 0x80;
+    TEST_ASSERT_NOT_EQUAL(0, pythia_w_deblind(&torus_password, &one_buf, &deblinded_password));
+    torus_password.p[0] ^= 0x80;
+
+    // m1 = 0 outside of exceptional form is only valid for unity
+    memset(torus_password.p, 0, 96);
+    TEST_ASSERT_NOT_EQUAL(0, pythia_w_deblind(&torus_password, &one_buf, &deblinded_password));
+
+    free(torus_password.p);
+    free(deblinded_password.p);
+
+    pythia_deinit();
+}
+
+void test9_RejectMalformed() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    pythia_buf_t blinded_password, blinding_secret, transformed_password,
+            transformation_private_key, transformed_tweak,
+            transformation_key_id_buf, tweak_buf, pythia_secret_buf,
+            pythia_scope_secret_buf, password_buf, transformation_public_key,
+            proof_value_c, proof_value_u, malformed;
+
+    blinded_password.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    blinded_password.allocated = PYTHIA_G1_BUF_SIZE;
+
+    blinding_secret.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    blinding_secret.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformed_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    transformed_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformation_public_key.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    transformation_public_key.allocated = PYTHIA_G1_BUF_SIZE;
+
+    transformed_tweak.p = (uint8_t *)malloc(PYTHIA_G2_BUF_SIZE);
+    transformed_tweak.allocated = PYTHIA_G2_BUF_SIZE;
+
+    proof_value_c.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    proof_value_c.allocated = PYTHIA_BN_BUF_SIZE;
+
+    proof_value_u.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    proof_value_u.allocated = PYTHIA_BN_BUF_SIZE;
+
+    malformed.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    malformed.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_key_id_buf.p = (uint8_t *)w;
+    transformation_key_id_buf.len = 10;
+
+    tweak_buf.p = (uint8_t *)t;
+    tweak_buf.len = 5;
+
+    pythia_secret_buf.p = (uint8_t *)msk;
+    pythia_secret_buf.len = 13;
+
+    pythia_scope_secret_buf.p = (uint8_t *)ssk;
+    pythia_scope_secret_buf.len = 13;
+
+    password_buf.p = (uint8_t *)password;
+    password_buf.len = 8;
+
+    if (pythia_w_blind(&password_buf, &blinded_password, &blinding_secret))
+        TEST_FAIL();
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_transform(&blinded_password, &tweak_buf, &transformation_private_key, &transformed_password,
+                           &transformed_tweak))
+        TEST_FAIL();
+
+    if (pythia_w_prove(&transformed_password, &blinded_password, &transformed_tweak, &transformation_private_key,
+                       &transformation_public_key, &proof_value_c, &proof_value_u))
+        TEST_FAIL();
+
+    int verified = 0;
+
+    // Unknown compression prefix
+    memcpy(malformed.p, blinded_password.p, blinded_password.len);
+    malformed.len = blinded_password.len;
+    malformed.p[0] = 4;
+    TEST_ASSERT_EQUAL_INT(pythia_w_verify(&transformed_password, &malformed, &tweak_buf,
+                                          &transformation_public_key, &proof_value_c, &proof_value_u,
+                                          &verified), -1);
+
+    // Coordinate not reduced modulo p
+    memset(malformed.p + 1, 0xFF, malformed.len - 1);
+    malformed.p[0] = 2;
+    TEST_ASSERT_EQUAL_INT(pythia_w_transform(&malformed, &tweak_buf, &transformation_private_key,
+                                             &transformed_password, &transformed_tweak), -1);
+
+    // Truncated point
+    memcpy(malformed.p, transformation_public_key.p, transformation_public_key.len);
+    malformed.len = transformation_public_key.len - 1;
+    TEST_ASSERT_EQUAL_INT(pythia_w_verify(&transformed_password, &blinded_password, &tweak_buf,
+                                          &malformed, &proof_value_c, &proof_value_u, &verified), -1);
+
+    // GT value of unsupported length, and with a coefficient not reduced modulo p
+    memcpy(malformed.p, transformed_password.p, transformed_password.len);
+    malformed.len = transformed_password.len - 1;
+    TEST_ASSERT_EQUAL_INT(pythia_w_deblind(&malformed, &blinding_secret, &transformed_password), -1);
+
+    malformed.len = transformed_password.len;
+    memset(malformed.p, 0xFF, 48);
+    TEST_ASSERT_EQUAL_INT(pythia_w_deblind(&malformed, &blinding_secret, &transformed_password), -1);
+
+    // Invalid sign byte
+    memcpy(malformed.p, proof_value_c.p, proof_value_c.len);
+    malformed.len = proof_value_c.len;
+    malformed.p[0] = 7;
+    TEST_ASSERT_EQUAL_INT(pythia_w_verify(&transformed_password, &blinded_password, &tweak_buf,
+                                          &transformation_public_key, &malformed, &proof_value_u,
+                                          &verified), -1);
+
+    free(blinded_password.p);
+    free(blinding_secret.p);
+    free(transformed_password.p);
+    free(transformation_private_key.p);
+    free(transformation_public_key.p);
+    free(transformed_tweak.p);
+    free(proof_value_c.p);
+    free(proof_value_u.p);
+    free(malformed.p);
+
+    pythia_deinit();
+}
+
+void test10_RawPoints() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    pythia_buf_t blinded_password, blinding_secret, transformed_password,
+            transformation_private_key, transformed_tweak,
+            transformation_key_id_buf, tweak_buf, pythia_secret_buf,
+            pythia_scope_secret_buf, password_buf, transformation_public_key,
+            proof_value_c, proof_value_u, raw_public_key, raw_tweak, raw_blinded_password;
+
+    blinded_password.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    blinded_password.allocated = PYTHIA_G1_BUF_SIZE;
+
+    blinding_secret.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    blinding_secret.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformed_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    transformed_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformation_public_key.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    transformation_public_key.allocated = PYTHIA_G1_BUF_SIZE;
+
+    transformed_tweak.p = (uint8_t *)malloc(PYTHIA_G2_BUF_SIZE);
+    transformed_tweak.allocated = PYTHIA_G2_BUF_SIZE;
+
+    proof_value_c.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    proof_value_c.allocated = PYTHIA_BN_BUF_SIZE;
+
+    proof_value_u.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    proof_value_u.allocated = PYTHIA_BN_BUF_SIZE;
+
+    raw_public_key.p = (uint8_t *)malloc(PYTHIA_G1_RAW_BUF_SIZE);
+    raw_public_key.allocated = PYTHIA_G1_RAW_BUF_SIZE;
+
+    raw_tweak.p = (uint8_t *)malloc(PYTHIA_G2_RAW_BUF_SIZE);
+    raw_tweak.allocated = PYTHIA_G2_RAW_BUF_SIZE;
+
+    raw_blinded_password.p = (uint8_t *)malloc(PYTHIA_G1_RAW_BUF_SIZE);
+    raw_blinded_password.allocated = PYTHIA_G1_RAW_BUF_SIZE;
+
+    transformation_key_id_buf.p = (uint8_t *)w;
+    transformation_key_id_buf.len = 10;
+
+    tweak_buf.p = (uint8_t *)t;
+    tweak_buf.len = 5;
+
+    pythia_secret_buf.p = (uint8_t *)msk;
+    pythia_secret_buf.len = 13;
+
+    pythia_scope_secret_buf.p = (uint8_t *)ssk;
+    pythia_scope_secret_buf.len = 13;
+
+    password_buf.p = (uint8_t *)password;
+    password_buf.len = 8;
+
+    if (pythia_w_blind(&password_buf, &blinded_password, &blinding_secret))
+        TEST_FAIL();
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_transform(&blinded_password, &tweak_buf, &transformation_private_key, &transformed_password,
+                           &transformed_tweak))
+        TEST_FAIL();
+
+    if (pythia_w_point_to_raw(&transformation_public_key, &raw_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_point_to_raw(&transformed_tweak, &raw_tweak))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(PYTHIA_G1_RAW_BUF_SIZE, raw_public_key.len);
+    TEST_ASSERT_EQUAL_INT(PYTHIA_G2_RAW_BUF_SIZE, raw_tweak.len);
+
+    // Raw points are rejected unless enabled
+    TEST_ASSERT_EQUAL_INT(pythia_w_prove(&transformed_password, &blinded_password, &raw_tweak,
+                                         &transformation_private_key, &raw_public_key,
+                                         &proof_value_c, &proof_value_u), -1);
+
+    pythia_raw_points_t modes[2] = { PYTHIA_RAW_POINTS_CHECK_CURVE, PYTHIA_RAW_POINTS_TRUSTED };
+
+    for (int i = 0; i < 2; i++) {
+        pythia_w_set_raw_points(modes[i]);
+
+        if (pythia_w_prove(&transformed_password, &blinded_password, &raw_tweak,
+                           &transformation_private_key, &raw_public_key, &proof_value_c, &proof_value_u))
+            TEST_FAIL();
+
+        int verified = 0;
+
+        if (pythia_w_verify(&transformed_password, &blinded_password, &tweak_buf, &raw_public_key,
+                            &proof_value_c, &proof_value_u, &verified))
+            TEST_FAIL();
+
+        TEST_ASSERT_NOT_EQUAL(verified, 0);
+    }
+
+    // Blinded passwords come from clients and are never accepted raw
+    if (pythia_w_point_to_raw(&blinded_password, &raw_blinded_password))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(pythia_w_transform(&raw_blinded_password, &tweak_buf, &transformation_private_key,
+                                             &transformed_password, &transformed_tweak), -1);
+
+    TEST_ASSERT_EQUAL_INT(pythia_w_prove(&transformed_password, &raw_blinded_password, &raw_tweak,
+                                         &transformation_private_key, &raw_public_key,
+                                         &proof_value_c, &proof_value_u), -1);
+
+    pythia_w_set_raw_points(PYTHIA_RAW_POINTS_DISABLED);
+
+    free(raw_blinded_password.p);
+    free(blinded_password.p);
+    free(blinding_secret.p);
+    free(transformed_password.p);
+    free(transformation_private_key.p);
+    free(transformation_public_key.p);
+    free(transformed_tweak.p);
+    free(proof_value_c.p);
+    free(proof_value_u.p);
+    free(raw_public_key.p);
+    free(raw_tweak.p);
+
+    pythia_deinit();
+}
+
+void test11_FixedScalars() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    uint8_t deblinded_bin[384];
+    const char *pos = deblinded_hex;
+    for (size_t count = 0; count < 384; count++) {
+        sscanf(pos, "%2hhx", &deblinded_bin[count]);
+        pos += 2;
+    }
+
+    pythia_buf_t blinded_password, blinding_secret, transformed_password,
+            transformation_private_key, transformed_tweak,
+            transformation_key_id_buf, tweak_buf, pythia_secret_buf,
+            pythia_scope_secret_buf, password_buf, transformation_public_key,
+            proof_value_c, proof_value_u, deblinded_password;
+
+    blinded_password.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    blinded_password.allocated = PYTHIA_G1_BUF_SIZE;
+
+    blinding_secret.p = (uint8_t *)malloc(PYTHIA_SCALAR_BUF_SIZE);
+    blinding_secret.allocated = PYTHIA_SCALAR_BUF_SIZE;
+
+    transformed_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    transformed_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_private_key.p = (uint8_t *)malloc(PYTHIA_SCALAR_BUF_SIZE);
+    transformation_private_key.allocated = PYTHIA_SCALAR_BUF_SIZE;
+
+    transformation_public_key.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    transformation_public_key.allocated = PYTHIA_G1_BUF_SIZE;
+
+    transformed_tweak.p = (uint8_t *)malloc(PYTHIA_G2_BUF_SIZE);
+    transformed_tweak.allocated = PYTHIA_G2_BUF_SIZE;
+
+    proof_value_c.p = (uint8_t *)malloc(PYTHIA_SCALAR_BUF_SIZE);
+    proof_value_c.allocated = PYTHIA_SCALAR_BUF_SIZE;
+
+    proof_value_u.p = (uint8_t *)malloc(PYTHIA_SCALAR_BUF_SIZE);
+    proof_value_u.allocated = PYTHIA_SCALAR_BUF_SIZE;
+
+    deblinded_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    deblinded_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_key_id_buf.p = (uint8_t *)w;
+    transformation_key_id_buf.len = 10;
+
+    tweak_buf.p = (uint8_t *)t;
+    tweak_buf.len = 5;
+
+    pythia_secret_buf.p = (uint8_t *)msk;
+    pythia_secret_buf.len = 13;
+
+    pythia_scope_secret_buf.p = (uint8_t *)ssk;
+    pythia_scope_secret_buf.len = 13;
+
+    password_buf.p = (uint8_t *)password;
+    password_buf.len = 8;
+
+    pythia_w_set_scalar_encoding(PYTHIA_SCALAR_ENCODING_FIXED);
+
+    if (pythia_w_blind(&password_buf, &blinded_password, &blinding_secret))
+        TEST_FAIL();
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_transform(&blinded_password, &tweak_buf, &transformation_private_key, &transformed_password,
+                           &transformed_tweak))
+        TEST_FAIL();
+
+    if (pythia_w_prove(&transformed_password, &blinded_password, &transformed_tweak, &transformation_private_key,
+                       &transformation_public_key, &proof_value_c, &proof_value_u))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(PYTHIA_SCALAR_BUF_SIZE, blinding_secret.len);
+    TEST_ASSERT_EQUAL_INT(PYTHIA_SCALAR_BUF_SIZE, transformation_private_key.len);
+    TEST_ASSERT_EQUAL_INT(PYTHIA_SCALAR_BUF_SIZE, proof_value_c.len);
+    TEST_ASSERT_EQUAL_INT(PYTHIA_SCALAR_BUF_SIZE, proof_value_u.len);
+
+    int verified = 0;
+
+    if (pythia_w_verify(&transformed_password, &blinded_password, &tweak_buf, &transformation_public_key,
+                        &proof_value_c, &proof_value_u, &verified))
+        TEST_FAIL();
+
+    TEST_ASSERT_NOT_EQUAL(verified, 0);
+
+    if (pythia_w_deblind(&transformed_password, &blinding_secret, &deblinded_password))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_MEMORY(deblinded_bin, deblinded_password.p, 384);
+
+    // Inverse of the blinding factor comes out of extended gcd with either sign, about half of the time each,
+    // so that a run of 40 blinds covers both signs
+    for (int i = 0; i < 40; i++) {
+        if (pythia_w_blind(&password_buf, &blinded_password, &blinding_secret))
+            TEST_FAIL();
+
+        if (pythia_w_transform(&blinded_password, &tweak_buf, &transformation_private_key, &transformed_password,
+                               &transformed_tweak))
+            TEST_FAIL();
+
+        if (pythia_w_deblind(&transformed_password, &blinding_secret, &deblinded_password))
+            TEST_FAIL();
+
+        TEST_ASSERT_EQUAL_MEMORY(deblinded_bin, deblinded_password.p, 384);
+    }
+
+    pythia_w_set_scalar_encoding(PYTHIA_SCALAR_ENCODING_DEFAULT);
+
+    free(blinded_password.p);
+    free(blinding_secret.p);
+    free(transformed_password.p);
+    free(transformation_private_key.p);
+    free(transformation_public_key.p);
+    free(transformed_tweak.p);
+    free(proof_value_c.p);
+    free(proof_value_u.p);
+    free(deblinded_password.p);
+
+    pythia_deinit();
+}
+
+void test12_BatchContainers() {
+    TEST_ASSERT_EQUAL_INT(pythia_init(NULL), 0);
+
+    // Not a multiple of 8, so that the last group of lanes is partial
+    const size_t n = 11;
+
+    pythia_buf_t blinded[11], blinding_secret, transformed_password, tweaks[11], transformed_tweaks[11],
+            deblinded[11], updated[11], buf, transformation_private_key, transformation_public_key,
+            transformation_key_id_buf, pythia_secret_buf, pythia_scope_secret_buf, password_update_token,
+            new_transformation_private_key, new_pythia_secret_buf;
+    uint8_t tweak_data[11][6];
+
+    transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    new_transformation_private_key.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    new_transformation_private_key.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformation_public_key.p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+    transformation_public_key.allocated = PYTHIA_G1_BUF_SIZE;
+
+    password_update_token.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    password_update_token.allocated = PYTHIA_BN_BUF_SIZE;
+
+    blinding_secret.p = (uint8_t *)malloc(PYTHIA_BN_BUF_SIZE);
+    blinding_secret.allocated = PYTHIA_BN_BUF_SIZE;
+
+    transformed_password.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    transformed_password.allocated = PYTHIA_GT_BUF_SIZE;
+
+    buf.p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+    buf.allocated = PYTHIA_GT_BUF_SIZE;
+
+    transformation_key_id_buf.p = (uint8_t *)w;
+    transformation_key_id_buf.len = 10;
+
+    pythia_secret_buf.p = (uint8_t *)msk;
+    pythia_secret_buf.len = 13;
+
+    new_pythia_secret_buf.p = (uint8_t *)msk1;
+    new_pythia_secret_buf.len = 13;
+
+    pythia_scope_secret_buf.p = (uint8_t *)ssk;
+    pythia_scope_secret_buf.len = 13;
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_compute_transformation_key_pair(&transformation_key_id_buf, &new_pythia_secret_buf,
+                                                 &pythia_scope_secret_buf,
+                                                 &new_transformation_private_key, &transformation_public_key))
+        TEST_FAIL();
+
+    if (pythia_w_get_password_update_token(&transformation_private_key, &new_transformation_private_key,
+                                           &password_update_token))
+        TEST_FAIL();
+
+    for (size_t i = 0; i < n; i++) {
+        pythia_buf_t password_buf;
+
+        blinded[i].p = (uint8_t *)malloc(PYTHIA_G1_BUF_SIZE);
+        blinded[i].allocated = PYTHIA_G1_BUF_SIZE;
+
+        transformed_tweaks[i].p = (uint8_t *)malloc(PYTHIA_G2_BUF_SIZE);
+        transformed_tweaks[i].allocated = PYTHIA_G2_BUF_SIZE;
+
+        deblinded[i].p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+        deblinded[i].allocated = PYTHIA_GT_BUF_SIZE;
+
+        updated[i].p = (uint8_t *)malloc(PYTHIA_GT_BUF_SIZE);
+        updated[i].allocated = PYTHIA_GT_BUF_SIZE;
+
+        memcpy(tweak_data[i], t, 5);
+        tweak_data[i][4] = (uint8_t)('a' + i);
+        tweaks[i].p = tweak_data[i];
+        tweaks[i].len = 5;
+
+        password_buf.p = (uint8_t *)password;
+        password_buf.len = 8;
+
+        if (pythia_w_blind(&password_buf, &blinded[i], &blinding_secret))
+            TEST_FAIL();
+
+        if (pythia_w_transform(&blinded[i], &tweaks[i], &transformation_private_key, &transformed_password,
+                               &transformed_tweaks[i]))
+            TEST_FAIL();
+
+        if (pythia_w_deblind(&transformed_password, &blinding_secret, &deblinded[i]))
+            TEST_FAIL();
+    }
+
+    pythia_g1_batch_t *g1_batch = NULL;
+    pythia_g2_batch_t *g2_batch = NULL;
+    pythia_gt_batch_t *gt_batch = NULL;
+
+    if (pythia_w_g1_batch_new(n, &g1_batch) || pythia_w_g2_batch_new(n, &g2_batch)
+        || pythia_w_gt_batch_new(n, &gt_batch))
+        TEST_FAIL();
+
+    TEST_ASSERT_EQUAL_INT(n, pythia_w_gt_batch_count(gt_batch));
+
+    // Bulk deserialization followed by bulk serialization gives the same bytes
+    if (pythia_w_g1_batch_read(g1_batch, blinded) || pythia_w_g1_batch_write(updated, g1_batch))
+        TEST_FAIL();
+
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_INT(blinded[i].len, updated[i].len);
+        TEST_ASSERT_EQUAL_MEMORY(blinded[i].p, updated[i].p, blinded[i].len);
+    }
+
+    if (pythia_w_g2_batch_read(g2_batch, transformed_tweaks) || pythia_w_g2_batch_write(updated, g2_batch))
+        TEST_FAIL();
+
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_INT(transformed_tweaks[i].len, updated[i].len);
+        TEST_ASSERT_EQUAL_MEMORY(transformed_tweaks[i].p, updated[i].p, transformed_tweaks[i].len);
+    }
+
+    if (pythia_w_gt_batch_read(gt_batch, deblinded) || pythia_w_gt_batch_write(updated, gt_batch))
+        TEST_FAIL();
+
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_INT(deblinded[i].len, updated[i].len);
+        TEST_ASSERT_EQUAL_MEMORY(deblinded[i].p, updated[i].p, deblinded[i].len);
+    }
+
+    // Updating in place gives the same passwords as updating them one by one
+    if (pythia_w_gt_batch_update_with_token(gt_batch, &password_update_token, gt_batch)
+        || pythia_w_gt_batch_write(updated, gt_batch))
+        TEST_FAIL();
+
+    for (size_t i = 0; i < n; i++) {
+        if (pythia_w_update_deblinded_with_token(&deblinded[i], &password_update_token, &buf))
+            TEST_FAIL();
+
+        TEST_ASSERT_EQUAL_INT(buf.len, updated[i].len);
+        TEST_ASSERT_EQUAL_MEMORY(buf.p, updated[i].p, buf.len);
+    }
+
+    // Malformed element fails the whole read
+    deblinded[n - 1].len--;
+    TEST_ASSERT_NOT_EQUAL(0, pythia_w_gt_batch_read(gt_batch, deblinded));
+    deblinded[n - 1].len++;
+
+    pythia_w_gt_batch_free(gt_batch);
+    pythia_w_g2_batch_free(g2_batch);
+    pythia_w_g1_batch_free(g1_batch);
+
+    for (size_t i = 0; i < n; i++) {
+        free(updated[i].p);
+        free(deblinded[i].p);
+        free(transformed_tweaks[i].p);
+        free(blinded[i].p);
+    }
+
+    free(buf.p);
+    free(transformed_password.p);
+    free(blinding_secret.p);
+    free(password_update_token.p);
+    free(transformation_public_key.p);
+    free(new_transformation_private_key.p);
+    free(transformation_private_key.p);
+
+    pythia_deinit();
+}
+
 int main() {
     UNITY_BEGIN();
 
@@ -363,6 +1259,14 @@ int main() {
     RUN_TEST(test2_BlindEvalProveVerify);
     RUN_TEST(test3_UpdateDelta);
     RUN_TEST(test4_BlindHugePassword);
+    RUN_TEST(test5_UpdateWithPreparedToken);
+    RUN_TEST(test6_BlindPooled);
+    RUN_TEST(test7_ProvePooled);
+    RUN_TEST(test8_TorusEncoding);
+    RUN_TEST(test9_RejectMalformed);
+    RUN_TEST(test10_RawPoints);
+    RUN_TEST(test11_FixedScalars);
+    RUN_TEST(test12_BatchContainers);
 
     return UNITY_END();
 }
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2015-2018 Virgil Security Inc.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Affero General Public License as
+# published by the Free Software Foundation, either version 3 of the
+# License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Affero General Public License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#
+
+"""
+Selects relic methods for the host: builds pythia with candidate FP_METHD, FPX_METHD, PP_METHD and COMP,
+runs pythia_test_c, pythia_test_w and pythia_test_bench for each build and writes the fastest set as an initial
+cache script, which relic/CMakeLists.txt loads on later configures.
+
+Candidates are walked one dimension at a time starting from the values relic/relic-args.cmake puts into
+relic's cache, a change is kept if it makes the benchmark faster by more than --min-gain. Builds that fail
+to configure, compile or pass the tests are skipped. Compiler flags stay portable, the selected set may
+be used on other hosts of the same kind.
+
+Usage: autotune_relic.py --source DIR --build-dir DIR --output FILE [-- CMAKE_ARGS...]
+"""
+
+import argparse
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+# Methods and flags that are tuned, they start from relic/relic-args.cmake
+TUNED = ("FP_METHD", "FPX_METHD", "PP_METHD", "COMP")
+
+# (variable, position, choices), position None means the whole value.
+# Positions follow relic's method lists, FP_RDC stays MONTY for BLS12-381 and PP_MAP stays OATEP,
+# other pairings would change every stored value.
+DIMENSIONS = [
+    ("FP_METHD", 1, ["COMBA", "INTEG", "KARAT"]),
+    ("FP_METHD", 2, ["COMBA", "INTEG", "MULTP"]),
+    ("FP_METHD", 4, ["EXGCD", "BINAR", "MONTY"]),
+    ("FP_METHD", 5, ["SLIDE", "MONTY"]),
+    ("FPX_METHD", 0, ["INTEG", "BASIC"]),
+    ("FPX_METHD", 1, ["INTEG", "BASIC"]),
+    ("FPX_METHD", 2, ["LAZYR", "BASIC"]),
+    ("PP_METHD", 0, ["LAZYR", "PROJC"]),
+    ("COMP", None, ["-O3 -funroll-loops -fPIC", "-O2 -fPIC"]),
+]
+
+
+def baseline(source):
+    """Values relic is built with by default. Only cached ones reach relic's configure through -C."""
+    values = {}
+    with open(os.path.join(source, "relic", "relic-args.cmake")) as f:
+        for line in f:
+            match = re.match(r'\s*set\((\w+)\s+"([^"]*)"\s+CACHE\s', line)
+            if match and match.group(1) in TUNED:
+                value = match.group(2)
+                values[match.group(1)] = value if match.group(1) == "COMP" else value.split(";")
+
+    missing = [name for name in TUNED if name not in values]
+    if missing:
+        sys.exit("relic/relic-args.cmake doesn't cache %s" % ", ".join(missing))
+    return values
+
+
+def cpu_model():
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor() or platform.machine()
+
+
+def render(methods):
+    lines = []
+    for name in ("FP_METHD", "FPX_METHD", "PP_METHD"):
+        lines.append('set(%s "%s" CACHE INTERNAL "")' % (name, ";".join(methods[name])))
+    lines.append('set(COMP "%s" CACHE INTERNAL "")' % methods["COMP"])
+    return "\n".join(lines) + "\n"
+
+
+def run(cmd, log, cwd=None):
+    with open(log, "a") as f:
+        f.write("$ %s\n" % " ".join(cmd))
+        f.flush()
+        return subprocess.call(cmd, stdout=f, stderr=subprocess.STDOUT, cwd=cwd) == 0
+
+
+def measure(args, methods, index):
+    build = os.path.join(args.build_dir, "candidate-%d" % index)
+    shutil.rmtree(build, ignore_errors=True)
+    os.makedirs(build)
+
+    methods_file = os.path.join(build, "relic-methods.cmake")
+    with open(methods_file, "w") as f:
+        f.write(render(methods))
+
+    log = os.path.join(build, "autotune.log")
+    configure = [args.cmake, os.path.abspath(args.source), "-DCMAKE_BUILD_TYPE=Release", "-DENABLE_TESTING=ON",
+                 "-DPYTHIA_RELIC_TUNE_FILE=" + methods_file] + args.cmake_args
+    tests = ("pythia_test_c", "pythia_test_w")
+    compile = [[args.cmake, "--build", ".", "--target", target] for target in tests + ("pythia_test_bench",)]
+
+    if not run(configure, log, build) or not all(run(cmd, log, build) for cmd in compile):
+        return None
+
+    # Methods that build but compute wrong results are rejected before timing
+    if not all(run([os.path.join(build, "test", test)], log) for test in tests):
+        return None
+
+    bench = os.path.join(build, "test", "pythia_test_bench")
+    best = None
+    for _ in range(args.repeat):
+        start = time.perf_counter()
+        if not run([bench], log):
+            return None
+        elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+
+    if not args.keep:
+        shutil.rmtree(build, ignore_errors=True)
+
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--source", required=True, help="pythia source directory")
+    parser.add_argument("--build-dir", required=True, help="directory for candidate builds")
+    parser.add_argument("--output", required=True, help="initial cache script with the selected methods")
+    parser.add_argument("--cmake", default="cmake", help="cmake executable")
+    parser.add_argument("--repeat", type=int, default=3, help="benchmark runs per candidate, the fastest counts")
+    parser.add_argument("--min-gain", type=float, default=0.02,
+                        help="fraction of time a change has to save to be kept, smaller ones are noise")
+    parser.add_argument("--keep", action="store_true", help="keep candidate builds")
+    parser.add_argument("cmake_args", nargs="*", help="arguments passed to every configure, after --")
+    args = parser.parse_args()
+    os.environ.setdefault("CMAKE_BUILD_PARALLEL_LEVEL", str(os.cpu_count() or 1))
+
+    best = baseline(args.source)
+    index = 0
+    best_time = measure(args, best, index)
+    if best_time is None:
+        sys.exit("Baseline build failed, see %s" % os.path.join(args.build_dir, "candidate-0", "autotune.log"))
+    baseline_time = best_time
+    print("baseline: %.2f s" % baseline_time)
+
+    for name, pos, choices in DIMENSIONS:
+        current = best[name] if pos is None else best[name][pos]
+        for choice in choices:
+            if choice == current:
+                continue
+
+            candidate = {k: list(v) if isinstance(v, list) else v for k, v in best.items()}
+            if pos is None:
+                candidate[name] = choice
+            else:
+                candidate[name][pos] = choice
+
+            index += 1
+            elapsed = measure(args, candidate, index)
+            print("%s = %s: %s" % (name if pos is None else "%s[%d]" % (name, pos), choice,
+                                   "failed" if elapsed is None else "%.2f s" % elapsed))
+
+            if elapsed is not None and elapsed < best_time * (1 - args.min_gain):
+                best, best_time = candidate, elapsed
+
+    with open(args.output, "w") as f:
+        f.write("# Generated by tools/autotune_relic.py on %s\n" % time.strftime("%Y-%m-%d"))
+        f.write("# Host: %s\n" % cpu_model())
+        f.write("# pythia_test_bench: %.2f s, %.2f s with relic-args.cmake\n" % (best_time, baseline_time))
+        f.write(render(best))
+
+    print("selected methods are written to %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()
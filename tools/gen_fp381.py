@@ -0,0 +1,339 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2015-2018 Virgil Security Inc.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Affero General Public License as
+# published by the Free Software Foundation, either version 3 of the
+# License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Affero General Public License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#
+
+"""
+Generates straight-line Montgomery arithmetic for the BLS12-381 base field in the style of fiat-crypto:
+single static assignment over 64-bit words, carries and borrows kept in explicit 1-bit variables,
+selection with cmovznz instead of branches, and the modulus baked in as constants.
+
+Elements are 6 little-endian words in Montgomery form with R = 2^384, the representation relic uses
+for FP_PRIME 381, so functions can replace relic's ones without conversion.
+
+Usage: gen_fp381.py OUTPUT
+"""
+
+import sys
+
+P = 0x1a0111ea397fe69a4b1ba7b6434bacd764774b84f38512bf6730d2a0f6b0f6241eabfffeb153ffffb9feffffffffaaab
+W = 64
+N = 6
+MASK = (1 << W) - 1
+PINV = (-pow(P, -1, 1 << W)) & MASK
+P_WORDS = [(P >> (W * i)) & MASK for i in range(N)]
+PREFIX = "fiat_bls12_381_fp"
+
+
+def const(v):
+    return "UINT64_C(0x%016x)" % v
+
+
+class Emitter:
+    """Emits SSA statements, every value gets a fresh name."""
+
+    def __init__(self):
+        self.lines = []
+        self.count = 0
+
+    def fresh(self, ctype):
+        self.count += 1
+        name = "x%d" % self.count
+        self.lines.append("    %s %s;" % (ctype, name))
+        return name
+
+    def mulx(self, a, b):
+        lo, hi = self.fresh("uint64_t"), self.fresh("uint64_t")
+        self.lines.append("    %s_mulx_u64(&%s, &%s, %s, %s);" % (PREFIX, lo, hi, a, b))
+        return lo, hi
+
+    def mul_lo(self, a, b):
+        r = self.fresh("uint64_t")
+        self.lines.append("    %s = %s * %s;" % (r, a, b))
+        return r
+
+    def addcarry(self, c, a, b):
+        r, co = self.fresh("uint64_t"), self.fresh("%s_uint1" % PREFIX)
+        self.lines.append("    %s_addcarryx_u64(&%s, &%s, %s, %s, %s);" % (PREFIX, r, co, c, a, b))
+        return r, co
+
+    def subborrow(self, c, a, b):
+        r, bo = self.fresh("uint64_t"), self.fresh("%s_uint1" % PREFIX)
+        self.lines.append("    %s_subborrowx_u64(&%s, &%s, %s, %s, %s);" % (PREFIX, r, bo, c, a, b))
+        return r, bo
+
+    def cmovznz(self, c, z, nz):
+        r = self.fresh("uint64_t")
+        self.lines.append("    %s_cmovznz_u64(&%s, %s, %s, %s);" % (PREFIX, r, c, z, nz))
+        return r
+
+    def add_chain(self, a, b):
+        out, c = [], "0x0"
+        for x, y in zip(a, b):
+            r, c = self.addcarry(c, x, y)
+            out.append(r)
+        return out, c
+
+    def sub_chain(self, a, b, borrow="0x0"):
+        out = []
+        for x, y in zip(a, b):
+            r, borrow = self.subborrow(borrow, x, y)
+            out.append(r)
+        return out, borrow
+
+    def product_row(self, a, b):
+        """Returns 7 words of a[0..5] * b"""
+        lo, hi = zip(*[self.mulx(x, b) for x in a])
+        row, c = [lo[0]], "0x0"
+        for j in range(1, N):
+            r, c = self.addcarry(c, lo[j], hi[j - 1])
+            row.append(r)
+        r, _ = self.addcarry(c, hi[N - 1], "0x0")
+        row.append(r)
+        return row
+
+
+def reduce_final(e, t):
+    """t < 2p in 7 words, returns t mod p selecting without branches"""
+    s, borrow = e.sub_chain(t[:N], [const(w) for w in P_WORDS])
+    _, borrow = e.subborrow(borrow, t[N], "0x0")
+    return [e.cmovznz(borrow, s[i], t[i]) for i in range(N)]
+
+
+def gen_mul(name, square):
+    e = Emitter()
+    a = ["arg1[%d]" % i for i in range(N)]
+    b = a if square else ["arg2[%d]" % i for i in range(N)]
+    t = None
+
+    # Coarsely integrated operand scanning, t < 2p after every round
+    for i in range(N):
+        row = e.product_row(a, b[i])
+        if t is None:
+            t, top = row, "0x0"
+        else:
+            s, c = e.add_chain(t, row)
+            t, top = s, c
+        m = e.mul_lo(t[0], const(PINV))
+        rowp = e.product_row([const(w) for w in P_WORDS], m)
+        s, c = e.add_chain(t, rowp)
+        t7, _ = e.addcarry(c, top, "0x0")
+        t = s[1:] + [t7]
+
+    out = reduce_final(e, t)
+    args = "uint64_t out1[6], const uint64_t arg1[6]" + ("" if square else ", const uint64_t arg2[6]")
+    body = e.lines + ["    out1[%d] = %s;" % (i, out[i]) for i in range(N)]
+    return "static void %s_%s(%s) {\n%s\n}\n" % (PREFIX, name, args, "\n".join(body))
+
+
+def gen_add():
+    e = Emitter()
+    s, c = e.add_chain(["arg1[%d]" % i for i in range(N)], ["arg2[%d]" % i for i in range(N)])
+    out = reduce_final(e, s + [c])
+    body = e.lines + ["    out1[%d] = %s;" % (i, out[i]) for i in range(N)]
+    return "static void %s_add(uint64_t out1[6], const uint64_t arg1[6], const uint64_t arg2[6]) {\n%s\n}\n" % (
+        PREFIX, "\n".join(body))
+
+
+def gen_sub():
+    e = Emitter()
+    s, borrow = e.sub_chain(["arg1[%d]" % i for i in range(N)], ["arg2[%d]" % i for i in range(N)])
+    mask = e.cmovznz(borrow, "0x0", const(MASK))
+    masked = []
+    for w in P_WORDS:
+        r = e.fresh("uint64_t")
+        e.lines.append("    %s = %s & %s;" % (r, mask, const(w)))
+        masked.append(r)
+    out, _ = e.add_chain(s, masked)
+    body = e.lines + ["    out1[%d] = %s;" % (i, out[i]) for i in range(N)]
+    return "static void %s_sub(uint64_t out1[6], const uint64_t arg1[6], const uint64_t arg2[6]) {\n%s\n}\n" % (
+        PREFIX, "\n".join(body))
+
+
+def gen_inv():
+    """Fermat inversion a^(p-2) with a fixed sliding-window chain over odd powers a^1..a^31"""
+    e = P - 2
+    bits = bin(e)[2:]
+    k = 5
+    steps = []
+    i = 0
+    while i < len(bits):
+        if bits[i] == "0":
+            steps.append(("sqr", 1))
+            i += 1
+            continue
+        j = min(i + k, len(bits))
+        while bits[j - 1] == "0":
+            j -= 1
+        v = int(bits[i:j], 2)
+        steps.append(("sqr", j - i))
+        steps.append(("mul", v))
+        i = j
+
+    # Merge runs of squarings, the leading ones are skipped because the accumulator starts at the first window
+    merged = []
+    for op, v in steps:
+        if op == "sqr" and merged and merged[-1][0] == "sqr":
+            merged[-1] = ("sqr", merged[-1][1] + v)
+        else:
+            merged.append((op, v))
+    assert merged[0][0] == "sqr" and merged[1][0] == "mul"
+    first = merged[1][1]
+    merged = merged[2:]
+
+    lines = [
+        "    uint64_t t[16][6], x[6];",
+        "    int i;",
+        "",
+        "    // t[k] = arg1^(2k + 1)",
+        "    %s_square(x, arg1);" % PREFIX,
+        "    memcpy(t[0], arg1, sizeof(t[0]));",
+        "    for (i = 1; i < 16; i++)",
+        "        %s_mul(t[i], t[i - 1], x);" % PREFIX,
+        "",
+        "    memcpy(x, t[%d], sizeof(x));" % (first // 2),
+    ]
+    sqrs = muls = 0
+    for op, v in merged:
+        if op == "sqr":
+            sqrs += v
+            if v == 1:
+                lines.append("    %s_square(x, x);" % PREFIX)
+            else:
+                lines.append("    for (i = 0; i < %d; i++)" % v)
+                lines.append("        %s_square(x, x);" % PREFIX)
+        else:
+            muls += 1
+            lines.append("    %s_mul(x, x, t[%d]);" % (PREFIX, v // 2))
+    lines.append("")
+    lines.append("    memcpy(out1, x, sizeof(x));")
+
+    doc = "/*\n * out1 = arg1^(p - 2): %d squarings and %d multiplications after the table of odd powers.\n" \
+          " * The chain depends only on p, so inversion takes the same time for every input.\n */\n" % (sqrs, muls)
+    return doc + "static void %s_inv(uint64_t out1[6], const uint64_t arg1[6]) {\n%s\n}\n" % (PREFIX, "\n".join(lines))
+
+
+def gen_fp2():
+    return """/*
+ * Fp2 = Fp[i] / (i^2 + 1). Outputs are written after all reads, so they may alias inputs.
+ */
+static void %(p)s2_mul(uint64_t out1[6], uint64_t out2[6], const uint64_t a0[6], const uint64_t a1[6],
+                       const uint64_t b0[6], const uint64_t b1[6]) {
+    uint64_t t0[6], t1[6], t2[6], t3[6];
+
+    // Karatsuba: (a0 b0 - a1 b1) + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) i
+    %(p)s_mul(t0, a0, b0);
+    %(p)s_mul(t1, a1, b1);
+    %(p)s_add(t2, a0, a1);
+    %(p)s_add(t3, b0, b1);
+    %(p)s_mul(t2, t2, t3);
+    %(p)s_sub(t2, t2, t0);
+    %(p)s_sub(t2, t2, t1);
+    %(p)s_sub(out1, t0, t1);
+    memcpy(out2, t2, sizeof(t2));
+}
+
+static void %(p)s2_square(uint64_t out1[6], uint64_t out2[6], const uint64_t a0[6], const uint64_t a1[6]) {
+    uint64_t t0[6], t1[6], t2[6];
+
+    // (a0 + a1)(a0 - a1) + 2 a0 a1 i
+    %(p)s_add(t0, a0, a1);
+    %(p)s_sub(t1, a0, a1);
+    %(p)s_mul(t2, a0, a1);
+    %(p)s_mul(out1, t0, t1);
+    %(p)s_add(out2, t2, t2);
+}
+""" % {"p": PREFIX}
+
+
+HELPERS = """typedef unsigned char %(p)s_uint1;
+typedef unsigned __int128 %(p)s_uint128;
+
+// GCC doesn't recognize carry chains written with 128-bit additions, the intrinsics keep them in the flags
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+
+static void %(p)s_addcarryx_u64(uint64_t *out1, %(p)s_uint1 *out2, %(p)s_uint1 arg1, uint64_t arg2,
+                                        uint64_t arg3) {
+    unsigned long long x1;
+    *out2 = _addcarry_u64(arg1, arg2, arg3, &x1);
+    *out1 = x1;
+}
+
+static void %(p)s_subborrowx_u64(uint64_t *out1, %(p)s_uint1 *out2, %(p)s_uint1 arg1, uint64_t arg2,
+                                         uint64_t arg3) {
+    unsigned long long x1;
+    *out2 = _subborrow_u64(arg1, arg2, arg3, &x1);
+    *out1 = x1;
+}
+#else
+static void %(p)s_addcarryx_u64(uint64_t *out1, %(p)s_uint1 *out2, %(p)s_uint1 arg1, uint64_t arg2,
+                                        uint64_t arg3) {
+    %(p)s_uint128 x1 = ((%(p)s_uint128)arg1 + arg2) + arg3;
+    *out1 = (uint64_t)x1;
+    *out2 = (%(p)s_uint1)(x1 >> 64);
+}
+
+static void %(p)s_subborrowx_u64(uint64_t *out1, %(p)s_uint1 *out2, %(p)s_uint1 arg1, uint64_t arg2,
+                                         uint64_t arg3) {
+    %(p)s_uint128 x1 = ((%(p)s_uint128)arg2 - arg1) - arg3;
+    *out1 = (uint64_t)x1;
+    *out2 = (%(p)s_uint1)(0x0 - (uint64_t)(x1 >> 64));
+}
+#endif
+
+static void %(p)s_mulx_u64(uint64_t *out1, uint64_t *out2, uint64_t arg1, uint64_t arg2) {
+    %(p)s_uint128 x1 = (%(p)s_uint128)arg1 * arg2;
+    *out1 = (uint64_t)x1;
+    *out2 = (uint64_t)(x1 >> 64);
+}
+
+// out1 = arg1 ? arg3 : arg2 without branches
+static void %(p)s_cmovznz_u64(uint64_t *out1, %(p)s_uint1 arg1, uint64_t arg2, uint64_t arg3) {
+    uint64_t x1 = 0x0 - (uint64_t)(!!arg1);
+    *out1 = (x1 & arg3) | (~x1 & arg2);
+}
+""" % {"p": PREFIX}
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+
+    parts = [
+        "/*\n * Generated by tools/gen_fp381.py, do not edit.\n *\n"
+        " * Montgomery arithmetic modulo the BLS12-381 base field prime\n"
+        " * p = 0x%x\n * with 6 words of 64 bits, R = 2^384.\n */\n" % P,
+        "#ifndef PYTHIA_PYTHIA_FP381_H\n#define PYTHIA_PYTHIA_FP381_H\n",
+        "#include <stdint.h>\n#include <string.h>\n",
+        "// Modulus the functions are specialized for\n"
+        "static const uint64_t %s_modulus[6] = {%s};\n" % (PREFIX, ", ".join(const(w) for w in P_WORDS)),
+        HELPERS,
+        "// out1 = arg1 * arg2 / R mod p\n" + gen_mul("mul", False),
+        "// out1 = arg1^2 / R mod p\n" + gen_mul("square", True),
+        "// out1 = arg1 + arg2 mod p\n" + gen_add(),
+        "// out1 = arg1 - arg2 mod p\n" + gen_sub(),
+        gen_inv(),
+        gen_fp2(),
+        "#endif //PYTHIA_PYTHIA_FP381_H\n",
+    ]
+
+    with open(sys.argv[1], "w") as f:
+        f.write("\n".join(parts))
+
+
+if __name__ == "__main__":
+    main()
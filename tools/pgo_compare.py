@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2015-2018 Virgil Security Inc.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Affero General Public License as
+# published by the Free Software Foundation, either version 3 of the
+# License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Affero General Public License for more details.
+#
+# You should have received a copy of the GNU Affero General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#
+
+"""
+Compares PGO build of pythia and relic with the default one on pythia_pgo_workload.
+
+Default build is configured in BUILD_DIR/default. PGO build is configured in BUILD_DIR/pgo with
+PYTHIA_PGO=GENERATE, trained with pythia_pgo_train and reconfigured in place with PYTHIA_PGO=USE,
+GCC finds profiles by object file paths, so both steps have to share the directory.
+Each workload runs --repeat times, the fastest run counts.
+
+Usage: pgo_compare.py --source DIR --build-dir DIR [--logins N] [-- CMAKE_ARGS...]
+"""
+
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+
+def run(cmd, log, cwd=None):
+    with open(log, "a") as f:
+        f.write("$ %s\n" % " ".join(cmd))
+        f.flush()
+        return subprocess.call(cmd, stdout=f, stderr=subprocess.STDOUT, cwd=cwd) == 0
+
+
+def build(args, name, steps):
+    path = os.path.join(args.build_dir, name)
+    shutil.rmtree(path, ignore_errors=True)
+    os.makedirs(path)
+
+    log = os.path.join(path, "pgo_compare.log")
+    for options, target in steps:
+        configure = [args.cmake, os.path.abspath(args.source), "-DCMAKE_BUILD_TYPE=Release",
+                     "-DENABLE_TESTING=ON"] + options + args.cmake_args
+        compile = [args.cmake, "--build", ".", "--target", target]
+        if not run(configure, log, path) or not run(compile, log, path):
+            sys.exit("%s build failed, see %s" % (name, log))
+
+    return path
+
+
+def measure(args, path):
+    workload = os.path.join(path, "test", "pythia_pgo_workload")
+    best = None
+    for _ in range(args.repeat):
+        output = subprocess.check_output([workload, str(args.logins)]).decode()
+        match = re.search(r"([0-9.]+) logins/s", output)
+        if not match:
+            sys.exit("Unexpected workload output: %s" % output)
+        rate = float(match.group(1))
+        best = rate if best is None else max(best, rate)
+
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--source", required=True, help="pythia source directory")
+    parser.add_argument("--build-dir", required=True, help="directory for default and PGO builds")
+    parser.add_argument("--cmake", default="cmake", help="cmake executable")
+    parser.add_argument("--logins", type=int, default=1000, help="logins per measured workload run")
+    parser.add_argument("--repeat", type=int, default=3, help="measured runs per build, the fastest counts")
+    parser.add_argument("cmake_args", nargs="*", help="arguments passed to every configure, after --")
+    args = parser.parse_args()
+    os.environ.setdefault("CMAKE_BUILD_PARALLEL_LEVEL", str(os.cpu_count() or 1))
+
+    default = build(args, "default", [(["-DPYTHIA_PGO=OFF"], "pythia_pgo_workload")])
+    default_rate = measure(args, default)
+    print("default: %.1f logins/s" % default_rate)
+
+    pgo = build(args, "pgo", [
+        (["-DPYTHIA_PGO=GENERATE"], "pythia_pgo_train"),
+        (["-DPYTHIA_PGO=USE"], "pythia_pgo_workload"),
+    ])
+    pgo_rate = measure(args, pgo)
+    print("pgo: %.1f logins/s" % pgo_rate)
+
+    print("gain: %+.1f%%" % ((pgo_rate / default_rate - 1) * 100))
+
+
+if __name__ == "__main__":
+    main()